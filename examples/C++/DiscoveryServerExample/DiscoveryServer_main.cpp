@@ -0,0 +1,102 @@
+// Copyright 2016 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file DiscoveryServer_main.cpp
+ *
+ */
+
+#include <fastrtps/Domain.h>
+#include <fastrtps/participant/Participant.h>
+#include <fastrtps/participant/ParticipantListener.h>
+#include <fastrtps/attributes/ParticipantAttributes.h>
+
+#include <fastrtps/utils/IPFinder.h>
+#include <fastrtps/log/Log.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+using namespace eprosima;
+using namespace fastrtps;
+using namespace rtps;
+using namespace std;
+
+class ServerListener : public ParticipantListener
+{
+public:
+	void onParticipantDiscovery(Participant*, ParticipantDiscoveryInfo info)
+	{
+		if(info.rtps.m_status == DISCOVERED_RTPSPARTICIPANT)
+			cout << "Client discovered: " << info.rtps.m_RTPSParticipantName << " " << info.rtps.m_guid << endl;
+		else if(info.rtps.m_status == REMOVED_RTPSPARTICIPANT)
+			cout << "Client removed: " << info.rtps.m_guid << endl;
+	}
+};
+
+int main(int argc, char** argv)
+{
+	if(argc < 2)
+	{
+		cout << "Usage: DiscoveryServerExample <port> [IPv4 address]" << endl;
+		cout << "Clients must set builtin.discoveryServerLocatorList to the same address and port." << endl;
+		Log::Reset();
+		return 0;
+	}
+
+	uint32_t port = static_cast<uint32_t>(strtoul(argv[1], nullptr, 10));
+
+	ParticipantAttributes PParam;
+	PParam.rtps.builtin.isDiscoveryServer = true;
+	PParam.rtps.builtin.domainId = 0;
+	PParam.rtps.setName("DiscoveryServer");
+
+	// The server listens on the given address, or on every local IPv4 address.
+	if(argc > 2)
+	{
+		Locator_t locator;
+		locator.kind = LOCATOR_KIND_UDPv4;
+		locator.set_IP4_address(std::string(argv[2]));
+		locator.port = port;
+		PParam.rtps.builtin.metatrafficUnicastLocatorList.push_back(locator);
+	}
+	else
+	{
+		LocatorList_t locators;
+		IPFinder::getIP4Address(&locators);
+		for(auto it = locators.begin(); it != locators.end(); ++it)
+		{
+			it->port = port;
+			PParam.rtps.builtin.metatrafficUnicastLocatorList.push_back(*it);
+		}
+	}
+
+	ServerListener listener;
+	Participant* participant = Domain::createParticipant(PParam, &listener);
+	if(participant == nullptr)
+	{
+		cout << "Discovery server could not be created" << endl;
+		Log::Reset();
+		return 1;
+	}
+
+	cout << "Discovery server running on port " << port << ". Press Enter to stop it." << endl;
+	cin.ignore();
+
+	Domain::removeParticipant(participant);
+	Domain::stopAll();
+	Log::Reset();
+	return 0;
+}
@@ -43,7 +43,7 @@ namespace fastrtps {
 class  TopicDataType {
     public:
         RTPS_DllAPI TopicDataType()
-            : m_typeSize(0), m_isGetKeyDefined(false)
+            : m_typeSize(0), m_isGetKeyDefined(false), m_plainSize(0)
         {}
 
         RTPS_DllAPI virtual ~TopicDataType(){};
@@ -85,6 +85,15 @@ class  TopicDataType {
          */
         RTPS_DllAPI virtual bool getKey(void* data, InstanceHandle_t* ihandle){ (void) data; (void) ihandle; return false; }
 
+        /**
+         * Get the key associated with a serialized sample, deserializing only what is needed to obtain it.
+         * It is optional. When it is not implemented the whole sample is deserialized and getKey is used.
+         * @param[in] payload Pointer to the payload.
+         * @param[out] ihandle Pointer to the Handle.
+         * @return True if correct.
+         */
+        RTPS_DllAPI virtual bool getKeyFromPayload(SerializedPayload_t* payload, InstanceHandle_t* ihandle){ (void) payload; (void) ihandle; return false; }
+
         /**
          * Set topic data type name
          * @param nam Topic data type name
@@ -103,6 +112,17 @@ class  TopicDataType {
 
         //! Indicates whether the method to obtain the key has been implemented.
         bool m_isGetKeyDefined;
+
+        //! Size in bytes of the data when the type is plain, 0 otherwise.
+        //! The serialized payload of a plain type is a copy of the data in memory, in the endianness of the host,
+        //! so its samples can be written and read in place. It cannot be greater than m_typeSize.
+        uint32_t m_plainSize;
+
+        /**
+         * Get whether the type is plain.
+         * @return True if m_plainSize is set.
+         */
+        RTPS_DllAPI inline bool isPlain() const { return m_plainSize != 0; }
     private:
         //! Data Type Name.
         std::string m_topicDataTypeName;
@@ -63,6 +63,8 @@ class PublisherAttributes {
         ThroughputControllerDescriptor throughputController;
         //!Underlying History memory policy
         MemoryManagementPolicy_t historyMemoryPolicy;
+        //!Batching of the written samples, only used in SYNCHRONOUS_PUBLISH_MODE
+        BatchingDescriptor batching;
 
         /**
          * Get the user defined ID
@@ -22,8 +22,10 @@
 
 #include "../fastrtps_dll.h"
 #include <cstdio>
+#include <vector>
 #include "../rtps/common/Guid.h"
 #include "../rtps/common/Time_t.h"
+#include "../rtps/common/BatchingStatistics.h"
 #include "../rtps/flowcontrol/FlowController.h"
 #include "../attributes/PublisherAttributes.h"
 
@@ -69,6 +71,36 @@ public:
 	 */
 	bool write(void*Data, WriteParams &wparams);
 
+	/**
+	 * Write several data to the topic at once. The changes are reserved together, added to the history
+	 * under one lock and sent in as few messages as possible.
+	 * @param data Pointers to the data.
+	 * Nothing is written if the history cannot reserve a change for every data.
+	 * @return True if all the data were written. If false, the first ones may have been written.
+	 */
+	bool write(const std::vector<void*>& data);
+
+	/**
+	 * Loan a sample to be filled and written without copying it. Only for plain types (TopicDataType::isPlain).
+	 * The sample lives in a change reserved in the history of the publisher until it is written or discarded.
+	 * @return Pointer to the sample, nullptr if the type is not plain or the history is full.
+	 */
+	void* loan_sample();
+
+	/**
+	 * Write a sample obtained with loan_sample. After this call the sample cannot be used again, even if it fails.
+	 * @param sample Pointer to the loaned sample.
+	 * @return True if correct.
+	 */
+	bool write_loaned(void* sample);
+
+	/**
+	 * Return without writing it a sample obtained with loan_sample.
+	 * @param sample Pointer to the loaned sample.
+	 * @return True if the sample was loaned by this publisher.
+	 */
+	bool discard_loan(void* sample);
+
 	/**
 	 * Dispose of a previously written data.
 	 * @param Data Pointer to the data.
@@ -97,6 +129,18 @@ public:
 
    bool wait_for_all_acked(const Time_t& max_wait);
 
+	/**
+	 * Send the samples waiting to complete a batch. Does nothing when batching is disabled.
+	 * @return Number of samples sent.
+	 */
+	size_t flush();
+
+	/**
+	 * Get the statistics of the batches sent by this Publisher.
+	 * @return Statistics of the batches.
+	 */
+	BatchingStatistics getBatchingStatistics();
+
 	/**
 	 * Get the GUID_t of the associated RTPSWriter.
 	 * @return GUID_t.
@@ -25,6 +25,9 @@
 
 #include "../rtps/history/WriterHistory.h"
 #include "../qos/QosPolicies.h"
+#include "../utils/RingBuffer.h"
+
+#include <unordered_map>
 
 using namespace eprosima::fastrtps::rtps;
 
@@ -41,8 +44,9 @@ class PublisherImpl;
 class PublisherHistory:public WriterHistory
 {
 public:
-	typedef std::pair<InstanceHandle_t,std::vector<CacheChange_t*>> t_p_I_Change;
-	typedef std::vector<t_p_I_Change> t_v_Inst_Caches;
+	//!Changes of one instance, ordered by sequence number.
+	typedef RingBuffer<CacheChange_t*> t_Inst_Changes;
+	typedef std::unordered_map<InstanceHandle_t, t_Inst_Changes, InstanceHandleHash> t_m_Inst_Caches;
 	/**
 	* Constructor of the PublisherHistory.
 	* @param pimpl Pointer to the PublisherImpl.
@@ -65,6 +69,15 @@ public:
 	*/
 	bool add_pub_change(CacheChange_t* change, WriteParams &wparams);
 
+	/**
+	* Add several changes comming from the Publisher under one lock of the history.
+	* The writer gets them as a group, so they are sent in as few messages as possible.
+	* Adding stops at the first change that cannot be added.
+	* @param changes Changes to add.
+	* @return Number of changes added, which are the first ones of the vector.
+	*/
+	size_t add_pub_changes(const std::vector<CacheChange_t*>& changes);
+
 	/**
 	* Remove all change from the associated history.
 	* @param removed Number of elements removed.
@@ -81,24 +94,40 @@ public:
 	/**
 	* Remove a change by the publisher History.
 	* @param change Pointer to the CacheChange_t.
-	* @param vit Pointer to the iterator of the Keyed history vector.
+	* @param vit Pointer to the iterator of the instance the change belongs to.
 	* @return True if removed.
 	*/
-	bool remove_change_pub(CacheChange_t* change,t_v_Inst_Caches::iterator* vit=nullptr);
+	bool remove_change_pub(CacheChange_t* change,t_m_Inst_Caches::iterator* vit=nullptr);
 
     virtual bool remove_change_g(CacheChange_t* a_change);
 
 private:
-	//!Vector of pointer to the CacheChange_t divided by key.
-	t_v_Inst_Caches m_keyedChanges;
+	//!Pointers to the CacheChange_t divided by key.
+	t_m_Inst_Caches m_keyedChanges;
 	//!HistoryQosPolicy values.
 	HistoryQosPolicy m_historyQos;
 	//!ResourceLimitsQosPolicy values.
 	ResourceLimitsQosPolicy m_resourceLimitsQos;
 	//!Publisher Pointer
 	PublisherImpl* mp_pubImpl;
+	//!Initial capacity of the buffer of each instance.
+	size_t m_instanceCapacity;
 
-	bool find_Key(CacheChange_t* a_change,t_v_Inst_Caches::iterator* vecPairIterrator);
+	/**
+	* Add a change comming from the Publisher, with the history mutex locked and a change group begun.
+	* @param change Pointer to the change
+	* @param wparams Extra write parameters.
+	* @return True if added.
+	*/
+	bool add_pub_change_nts(CacheChange_t* change, WriteParams &wparams);
+
+	/**
+	* Find the instance of a change, creating it if it is new and the resource limits allow it.
+	* @param a_change Pointer to the change.
+	* @param map_it Pointer to store the iterator of the instance.
+	* @return True if the instance was found or created.
+	*/
+	bool find_Key(CacheChange_t* a_change,t_m_Inst_Caches::iterator* map_it);
 };
 
 } /* namespace fastrtps */
@@ -24,12 +24,15 @@
 #include "../rtps/common/CDRMessage_t.h"
 #include "../rtps/messages/CDRMessage.h"
 #include "../rtps/common/CacheChange.h"
+#include "../utils/Arena.h"
 
 namespace eprosima {
 namespace fastrtps {
 
 /**
  * ParameterList_t class, used to store multiple parameters as a vector of pointers to the base class.
+ * The parameters read from a message are constructed in the list arena, so reading a list
+ * only allocates while the arena grows to the size of the largest list received.
  * @ingroup PARAMETER_MODULE
  */
 class ParameterList_t {
@@ -46,7 +49,11 @@ public:
 	{
 		for(std::vector<Parameter_t*>::iterator it = m_parameters.begin();
 				it!=m_parameters.end();++it)
-			delete(*it);
+		{
+			if(!m_arena.owns(*it))
+				delete(*it);
+		}
+		m_arena.clear();
 		resetList();
 	}
 	/**
@@ -63,6 +70,8 @@ public:
 	CDRMessage_t m_cdrmsg;
 	//! Bool variable to indicate whether a new parameter has been added.
 	bool m_hasChanged;
+	//! Arena where the parameters read from a message are constructed.
+	Arena m_arena;
 };
 
 /**
@@ -87,6 +96,15 @@ public:
 	 * @return Number of bytes of the parameter list.
 	 */
 	static int32_t readParameterListfromCDRMsg(CDRMessage_t* msg, ParameterList_t* plist, CacheChange_t* change);
+	/**
+	 * Read the inline QoS of a DATA or the serialized key and status of a DATA with the key flag.
+	 * Only the parameters a reader consumes are decoded into the change (PID_KEY_HASH, PID_STATUS_INFO
+	 * and PID_RELATED_SAMPLE_IDENTITY). The rest are skipped by their length, without being stored.
+	 * @param[in] msg Pointer to the message (the pos should be correct, otherwise the behaviour is undefined).
+	 * @param[out] change Pointer to the cache change.
+	 * @return Number of bytes of the parameter list, or -1 if it is malformed.
+	 */
+	static int32_t readInlineQosFromCDRMsg(CDRMessage_t* msg, CacheChange_t* change);
 
 };
 
@@ -147,13 +147,27 @@ class BuiltinAttributes{
         LocatorList_t metatrafficUnicastLocatorList;
         //!Metatraffic Multicast Locator List.
         LocatorList_t metatrafficMulticastLocatorList;
+        /**
+         * Metatraffic unicast locators of the discovery servers. If not empty, the RTPSParticipant is a discovery
+         * client: it only announces itself to these locators instead of the multicast ones, and it learns about
+         * other RTPSParticipants from the servers.
+         */
+        LocatorList_t discoveryServerLocatorList;
+        /**
+         * If set to true, the RTPSParticipant is a discovery server. It relays the announcement of each client only
+         * to the clients that have endpoints in the same topics. Its metatraffic unicast locators must be set to the
+         * ones configured in the clients.
+         */
+        bool isDiscoveryServer;
 
         BuiltinAttributes()
         {
             use_SIMPLE_RTPSParticipantDiscoveryProtocol = true;
+            isDiscoveryServer = false;
             use_SIMPLE_EndpointDiscoveryProtocol = true;
             use_STATIC_EndpointDiscoveryProtocol = false;
             m_staticEndpointXMLFilename = "";
+            m_staticEndpointBinaryFilename = "";
             domainId = 0;
             leaseDuration.seconds = 500;
             leaseDuration_announcementperiod.seconds = 250;
@@ -171,9 +185,23 @@ class BuiltinAttributes{
          * @param str Static endpoint XML filename
          */
         void setStaticEndpointXMLFilename(const char* str){ m_staticEndpointXMLFilename = std::string(str); };
+        /**
+         * Get the filename of the compiled copy of the static endpoint XML file
+         * @return Compiled static endpoint filename, empty if not used
+         */
+        const char* getStaticEndpointBinaryFilename(){ return m_staticEndpointBinaryFilename.c_str(); };
+        /**
+         * Set the filename of the compiled copy of the static endpoint XML file. While the XML file does not change,
+         * the compiled copy is memory mapped instead of parsing the XML file. If it is missing or out of date, it is
+         * written again after parsing the XML file. Empty by default, the XML file is always parsed.
+         * @param str Compiled static endpoint filename
+         */
+        void setStaticEndpointBinaryFilename(const char* str){ m_staticEndpointBinaryFilename = std::string(str); };
     private:
         //! StaticEDP XML filename, only necessary if use_STATIC_EndpointDiscoveryProtocol=true
         std::string m_staticEndpointXMLFilename;
+        //! Compiled StaticEDP filename, optional
+        std::string m_staticEndpointBinaryFilename;
 };
 
 
@@ -196,6 +224,7 @@ class RTPSParticipantAttributes
             use_IP6_to_send = false;
             participantID = -1;
             useBuiltinTransports = true;
+            useSharedEventThread = false;
         }
 
         virtual ~RTPSParticipantAttributes(){};
@@ -250,6 +279,8 @@ class RTPSParticipantAttributes
         std::vector<std::shared_ptr<TransportDescriptorInterface> > userTransports;
         //!Set as false to disable the default UDPv4 implementation.
         bool useBuiltinTransports;
+        //!Set as true to run the timed events in a thread shared with the other participants of the process that set it.
+        bool useSharedEventThread;
 
     private:
         //!Name of the participant.
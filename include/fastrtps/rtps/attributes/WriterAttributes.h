@@ -61,6 +61,31 @@ public:
 	Duration_t nackSupressionDuration;
 };
 
+/**
+ * Class BatchingDescriptor, defining how a synchronous writer packs consecutive changes in a single message.
+ * A batch is sent when it reaches maxBytes or maxSamples, when maxDelay has passed since its first change
+ * was written, or when it is flushed explicitly. Asynchronous writers already group their unsent changes.
+ * @ingroup RTPS_ATTRIBUTES_MODULE
+ */
+class BatchingDescriptor
+{
+public:
+	BatchingDescriptor() : enabled(false), maxBytes(0), maxSamples(0)
+	{
+		maxDelay.fraction = 4294967;
+	};
+	virtual ~BatchingDescriptor(){};
+
+	//!Whether the changes are batched, default value false.
+	bool enabled;
+	//!Bytes of DATA submessages that fill a batch. 0 means as many as fit in a message of the writer, the default.
+	uint32_t maxBytes;
+	//!Changes that fill a batch. 0 means no limit, the default.
+	uint32_t maxSamples;
+	//!Maximum time a change waits in the batch, default value ~1ms.
+	Duration_t maxDelay;
+};
+
 /**
  * Class WriterAttributes, defining the attributes of a RTPSWriter.
  * @ingroup RTPS_ATTRIBUTES_MODULE
@@ -83,6 +108,8 @@ public:
 	RTPSWriterPublishMode mode;
    // Throughput controller, always the last one to apply 
    ThroughputControllerDescriptor throughputController;
+	//!Batching of the changes of a synchronous writer
+	BatchingDescriptor batching;
 };
 
 /**
@@ -25,6 +25,8 @@
 
 #include "../../attributes/WriterAttributes.h"
 #include "../../attributes/ReaderAttributes.h"
+#include "../../common/SerializedPayload.h"
+#include "../../common/SequenceNumber.h"
 
 #define DISCOVERY_PARTICIPANT_DATA_MAX_SIZE 5000
 #define DISCOVERY_TOPIC_DATA_MAX_SIZE 500
@@ -56,7 +58,6 @@ namespace rtps {
 
 struct CDRMessage_t;
 class PDPSimple;
-class RemoteParticipantLeaseDuration;
 class RTPSParticipantImpl;
 class ReaderProxyData;
 class WriterProxyData;
@@ -107,8 +108,6 @@ public:
 	//!
 	bool m_hasChanged;
 	//!
-	RemoteParticipantLeaseDuration* mp_leaseDurationTimer;
-	//!
 	std::vector<ReaderProxyData*> m_readers;
 	//!
 	std::vector<WriterProxyData*> m_writers;
@@ -116,6 +115,10 @@ public:
 	std::vector<RemoteReaderAttributes> m_builtinReaders;
 	//!
 	std::vector<RemoteWriterAttributes> m_builtinWriters;
+	//!Serialized SPDP announcement last processed, used to skip parsing it again when it does not change.
+	SerializedPayload_t m_lastAnnouncement;
+	//!Sequence number of the last SPDP announcement processed.
+	SequenceNumber_t m_lastAnnouncementSeqNum;
 
 	boost::recursive_mutex* mp_mutex;
 	/**
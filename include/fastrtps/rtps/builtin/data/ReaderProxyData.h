@@ -25,6 +25,8 @@
 #include "../../../qos/ParameterList.h"
 #include "../../../qos/ReaderQos.h"
 
+#include "../../../utils/PartitionMatcher.h"
+
 #include "../../attributes/WriterAttributes.h"
 
 using namespace eprosima::fastrtps;
@@ -45,10 +47,16 @@ public:
 	ReaderProxyData();
 	virtual ~ReaderProxyData();
 	/**
-	 * Convert the data to a parameter list to send this information as a RTPS message.
+	 * Serialize the data as a parameter list in m_parameterList.m_cdrmsg, to send this information as a RTPS message.
+	 * The parameters that do not depend on the QoS are serialized once, and the QoS ones are only serialized again
+	 * after invalidateSerializedQos() is called.
 	 * @return true if correct.
 	 */
 	bool toParameterList();
+	/**
+	 * Mark the serialized QoS parameters as outdated, after the QoS of a local reader is updated.
+	 */
+	void invalidateSerializedQos();
 	/**
 	 *  Read the information from a CDRMessage_t. The position of hte message must be in the beggining on the parameter list.
 	 * @param msg Pointer to the message.
@@ -76,6 +84,8 @@ public:
 	uint16_t m_userDefinedId;
 	//!Reader Qos	
 	ReaderQos m_qos;
+	//!Compiled partition names of m_qos, refreshed by the EDP before matching.
+	PartitionMatcher m_partitionMatcher;
 	//!Field to indicate if the Reader is Alive.
 	bool m_isAlive;
 	//!Topic kind
@@ -105,6 +115,20 @@ public:
 
 	//!Remote Attributes associated with this proxy data.
 	RemoteReaderAttributes m_remoteAtt;
+
+private:
+
+	//!Add the parameters that do not depend on the QoS to a message.
+	bool addIdentityToCDRMessage(CDRMessage_t* msg);
+
+	//!Add the QoS parameters to a message.
+	bool addQosToCDRMessage(CDRMessage_t* msg);
+
+	//!Length of the serialized parameters that do not depend on the QoS. Zero if they are not serialized.
+	uint32_t m_serializedIdentityLength;
+
+	//!Whether the serialized QoS parameters are up to date.
+	bool m_serializedQosValid;
 };
 
 }
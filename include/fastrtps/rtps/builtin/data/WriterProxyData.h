@@ -25,6 +25,8 @@
 #include "../../../qos/ParameterList.h"
 #include "../../../qos/WriterQos.h"
 
+#include "../../../utils/PartitionMatcher.h"
+
 #include "../../attributes/ReaderAttributes.h"
 
 using namespace eprosima::fastrtps;
@@ -248,6 +250,8 @@ public:
 
 	//!WriterQOS
 	WriterQos m_qos;
+	//!Compiled partition names of m_qos, refreshed by the EDP before matching.
+	PartitionMatcher m_partitionMatcher;
 	//!
 	ParameterList_t m_parameterList;
 	//!Clear the information and return the object to the default state.
@@ -256,8 +260,15 @@ public:
 	void update(WriterProxyData* rdata);
 	//!Copy all information from another object.
 	void copy(WriterProxyData* rdata);
-	//!Convert the information to a parameter list to be send in a CDRMessage.
+	/**
+	 * Serialize the information as a parameter list in m_parameterList.m_cdrmsg, to be send in a CDRMessage.
+	 * The parameters that do not depend on the QoS are serialized once, and the QoS ones are only serialized again
+	 * after invalidateSerializedQos() is called.
+	 * @return true if correct.
+	 */
 	bool toParameterList();
+	//!Mark the serialized QoS parameters as outdated, after the QoS of a local writer is updated.
+	void invalidateSerializedQos();
 	//!Read a parameter list from a CDRMessage_t.
 	RTPS_DllAPI bool readFromCDRMessage(CDRMessage_t* msg);
 	/**
@@ -302,6 +313,18 @@ private:
 
 	//!Topic kind
 	TopicKind_t m_topicKind;
+
+	//!Add the parameters that do not depend on the QoS to a message.
+	bool addIdentityToCDRMessage(CDRMessage_t* msg);
+
+	//!Add the QoS parameters to a message.
+	bool addQosToCDRMessage(CDRMessage_t* msg);
+
+	//!Length of the serialized parameters that do not depend on the QoS. Zero if they are not serialized.
+	uint32_t m_serializedIdentityLength;
+
+	//!Whether the serialized QoS parameters are up to date.
+	bool m_serializedQosValid;
 };
 
 }
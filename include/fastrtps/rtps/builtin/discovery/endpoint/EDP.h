@@ -24,6 +24,11 @@
 #include "../../../attributes/RTPSParticipantAttributes.h"
 #include "../../../common/Guid.h"
 
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
 namespace eprosima {
 namespace fastrtps{
 
@@ -185,6 +190,47 @@ public:
 	 */
     bool pairingWriterProxy(ParticipantProxyData* pdata, WriterProxyData* wdata);
 
+	/** @name Matching index.
+	 * Every ReaderProxyData and WriterProxyData known by the PDP is indexed by its (topic, type) pair,
+	 * so matching only considers endpoints of the same topic. PDPSimple keeps the index updated when
+	 * proxies are added or removed. Must be called with the PDP mutex taken.
+	 * @param pdata Pointer to the participant proxy data the endpoint belongs to.
+	 */
+	///@{
+	void indexReaderProxy(ParticipantProxyData* pdata, ReaderProxyData* rdata);
+	void indexWriterProxy(ParticipantProxyData* pdata, WriterProxyData* wdata);
+	void unindexReaderProxy(ReaderProxyData* rdata);
+	void unindexWriterProxy(WriterProxyData* wdata);
+	///@}
+
+	/**
+	 * Remove a local Reader from the matching index. Called before the reader is destroyed.
+	 * @param R Pointer to the Reader.
+	 */
+	void unindexLocalReader(RTPSReader* R);
+	/**
+	 * Remove a local Writer from the matching index. Called before the writer is destroyed.
+	 * @param W Pointer to the Writer.
+	 */
+	void unindexLocalWriter(RTPSWriter* W);
+
+	/**
+	 * Get the RTPSParticipants with endpoints of a kind in a topic. Must be called with the PDP mutex taken.
+	 * @param topicName Name of the topic.
+	 * @param typeName Name of the type.
+	 * @param kind WRITER to get the RTPSParticipants with writers in the topic, READER for readers.
+	 * @param participants Vector where the RTPSParticipants are added, each one once.
+	 */
+	void topicParticipants(const std::string& topicName, const std::string& typeName, EndpointKind_t kind,
+			std::vector<ParticipantProxyData*>& participants);
+
+	/**
+	 * Assert the liveliness of a remote writer in the local reliable readers of its topic that are matched with it.
+	 * Must be called with the PDP mutex taken.
+	 * @param wdata Pointer to the WriterProxyData of the remote writer.
+	 */
+	void assertRemoteWriterLiveliness(WriterProxyData* wdata);
+
 	//! Pointer to the PDPSimple object that contains the endpoint discovery protocol.
 	PDPSimple* mp_PDP;
 	//! Pointer to the RTPSParticipant.
@@ -192,18 +238,69 @@ public:
 
     private:
 
+        //!Endpoints of one (topic, type) pair.
+        struct TopicEndpoints
+        {
+            //!Reader proxies, local and remote, with the participant they belong to.
+            std::vector<std::pair<ParticipantProxyData*, ReaderProxyData*>> readers;
+            //!Writer proxies, local and remote, with the participant they belong to.
+            std::vector<std::pair<ParticipantProxyData*, WriterProxyData*>> writers;
+            //!Local user readers with their proxy.
+            std::vector<std::pair<RTPSReader*, ReaderProxyData*>> localReaders;
+            //!Local user writers with their proxy.
+            std::vector<std::pair<RTPSWriter*, WriterProxyData*>> localWriters;
+
+            bool empty() const
+            {
+                return readers.empty() && writers.empty() && localReaders.empty() && localWriters.empty();
+            }
+        };
+
+        typedef std::map<std::pair<std::string, std::string>, TopicEndpoints> t_m_TopicEndpoints;
+
+        /**
+        * Check the partitions of a reader and a writer with their cached partition matchers.
+        * @param rdata Pointer to the ReaderProxyData.
+        * @param wdata Pointer to the WriterProxyData.
+        * @return true if the partitions match.
+        */
+        static bool matchPartitions(ReaderProxyData* rdata, WriterProxyData* wdata);
+
+        /**
+        * Find the endpoints of a topic.
+        * @param topicName Name of the topic.
+        * @param typeName Name of the type.
+        * @param create Whether to create the entry if there is none.
+        * @return Pointer to the endpoints, or nullptr if there is no entry.
+        */
+        TopicEndpoints* findTopic(const std::string& topicName, const std::string& typeName, bool create);
+
         /**
-        * Try to pair/unpair a local Reader against all possible writerProxy Data.
+        * Remove the entry of a topic if it has no endpoints left.
+        * @param topicName Name of the topic.
+        * @param typeName Name of the type.
+        */
+        void releaseTopic(const std::string& topicName, const std::string& typeName);
+
+        /**
+        * Try to pair/unpair a local Reader against all possible writerProxy Data of its topic.
         * @param R Pointer to the Reader
+        * @param pdata Pointer to the local participant proxy data.
+        * @param rdata Pointer to the ReaderProxyData of the Reader.
         * @return True
         */
-        bool pairingReader(RTPSReader* R);
-        /**l
-        * Try to pair/unpair a local Writer against all possible readerProxy Data.
+        bool pairingReader(RTPSReader* R, ParticipantProxyData* pdata, ReaderProxyData* rdata);
+        /**
+        * Try to pair/unpair a local Writer against all possible readerProxy Data of its topic.
         * @param W Pointer to the Writer
+        * @param pdata Pointer to the local participant proxy data.
+        * @param wdata Pointer to the WriterProxyData of the Writer.
         * @return True
         */
-        bool pairingWriter(RTPSWriter* W);
+        bool pairingWriter(RTPSWriter* W, ParticipantProxyData* pdata, WriterProxyData* wdata);
+
+        //!Matching index.
+        t_m_TopicEndpoints m_topics;
 
 };
 
@@ -21,6 +21,9 @@
 #define EDPSTATICXML_H_
 #ifndef DOXYGEN_SHOULD_SKIP_THIS_PUBLIC
 
+#include "../../../common/Types.h"
+
+#include <map>
 #include <set>
 #include <vector>
 #include <cstdint>
@@ -28,9 +31,12 @@
 #include <boost/foreach.hpp>
 #include <boost/property_tree/ptree.hpp>
 #include <boost/property_tree/xml_parser.hpp>
+#include <boost/thread/mutex.hpp>
 
 using boost::property_tree::ptree;
 
+namespace boost { namespace interprocess { class file_mapping; class mapped_region; } }
+
 namespace eprosima {
 namespace fastrtps{
 namespace rtps {
@@ -64,11 +70,30 @@ public:
 	EDPStaticXML();
 	virtual ~EDPStaticXML();
 	/**
-	 * Load the XML file
+	 * Load the XML file.
+	 * If a compiled file is given, while the XML file does not change the compiled file is memory mapped and
+	 * its endpoints are decoded on demand, without parsing the XML. Otherwise it is written after parsing.
 	 * @param filename Name of the file to load and parse.
+	 * @param binaryFilename Name of the compiled file, empty to always parse the XML file.
 	 * @return True if correct.
 	 */
-	bool loadXMLFile(std::string& filename);
+	bool loadXMLFile(std::string& filename, const std::string& binaryFilename = std::string());
+
+	/**
+	 * Write the endpoints loaded from an XML file in the compiled format.
+	 * @param filename Name of the file to write.
+	 * @param xmlHash Hash of the contents of the XML file.
+	 * @return True if correct, false if it cannot be written or two endpoints share a user Id.
+	 */
+	bool saveBinaryFile(const std::string& filename, uint64_t xmlHash);
+
+	/**
+	 * Map a compiled file to look for the endpoints in it.
+	 * @param filename Name of the file to map.
+	 * @param xmlHash Hash of the contents of the XML file the compiled file must come from.
+	 * @return True if the file is valid and was generated from that XML file.
+	 */
+	bool loadBinaryFile(const std::string& filename, uint64_t xmlHash);
 
     void loadXMLParticipantEndpoint(ptree::value_type& xml_endpoint, StaticRTPSParticipantInfo* pdata);
 
@@ -104,10 +129,26 @@ public:
 	bool lookforWriter(std::string partname,uint16_t id,WriterProxyData** wdataptr);
 
 private:
+	/**
+	 * Look for an endpoint in the index of the mapped file.
+	 * @param[in] isReader Whether to look for a reader or for a writer.
+	 * @param[in] id User Id of the endpoint.
+	 * @param[out] length Length of the record of the endpoint.
+	 * @return Pointer to the record of the first endpoint with that Id, or nullptr if not found.
+	 */
+	const octet* findBinaryEndpoint(bool isReader, uint16_t id, uint32_t* length);
+
 	std::set<int16_t> m_endpointIds;
 	std::set<uint32_t> m_entityIds;
 
 	std::vector<StaticRTPSParticipantInfo*> m_RTPSParticipants;
+
+	boost::interprocess::file_mapping* mp_binaryFile;
+	boost::interprocess::mapped_region* mp_binaryRegion;
+	//!Endpoints already decoded from the mapped file, by user Id.
+	std::map<uint16_t, ReaderProxyData*> m_binaryReaders;
+	std::map<uint16_t, WriterProxyData*> m_binaryWriters;
+	boost::mutex m_binaryMutex;
 };
 
 }
@@ -0,0 +1,101 @@
+// Copyright 2016 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file PDPServer.h
+ *
+ */
+
+#ifndef PDPSERVER_H_
+#define PDPSERVER_H_
+#ifndef DOXYGEN_SHOULD_SKIP_THIS_PUBLIC
+
+#include "PDPSimple.h"
+
+#include <string>
+
+namespace eprosima {
+namespace fastrtps{
+namespace rtps {
+
+/**
+ * Class PDPServer that implements the server side of the client/server discovery.
+ * Clients only announce themselves to the servers through unicast. The server learns the endpoints of each client
+ * with the SimpleEDP, and relays the announcement of a client only to the clients that have endpoints in the same
+ * topics. The endpoints are then exchanged directly between those clients.
+ *@ingroup DISCOVERY_MODULE
+ */
+class PDPServer : public PDPSimple {
+public:
+	/**
+	 * Constructor
+	 * @param builtin Pointer to the BuiltinProcols object.
+	 */
+	PDPServer(BuiltinProtocols* builtin);
+	virtual ~PDPServer();
+
+	/**
+	 * Resend the local RTPSParticipant information and the relayed announcements, so clients recover from lost
+	 * relays.
+	 */
+	void periodicAnnouncement();
+
+	/**
+	 * This method removes a remote RTPSParticipant and all its writers and readers, and forgets its relays.
+	 * @param partGUID GUID_t of the remote RTPSParticipant.
+	 * @return true if correct.
+	 */
+	bool removeRemoteParticipant(GUID_t& partGUID);
+
+protected:
+
+	void remoteReaderProxyDataAdded(ParticipantProxyData* pdata, ReaderProxyData* rdata);
+
+	void remoteWriterProxyDataAdded(ParticipantProxyData* pdata, WriterProxyData* wdata);
+
+private:
+
+	/**
+	 * Relay the announcements between a client and the clients with endpoints of a kind in a topic.
+	 * @param pdata Pointer to the RTPSParticipantProxyData of the client.
+	 * @param topicName Name of the topic.
+	 * @param typeName Name of the type.
+	 * @param kind Kind of the endpoints of the other clients.
+	 */
+	void relayTopic(ParticipantProxyData* pdata, const std::string& topicName, const std::string& typeName,
+			EndpointKind_t kind);
+
+	/**
+	 * Relay the announcement of a client to another one, if it was not relayed before.
+	 * @param source Pointer to the RTPSParticipantProxyData whose announcement is relayed.
+	 * @param destination Pointer to the RTPSParticipantProxyData that receives it.
+	 */
+	void addRelay(ParticipantProxyData* source, ParticipantProxyData* destination);
+
+	/**
+	 * Send the last announcement of a client to the metatraffic unicast locators of another one.
+	 * @param source Pointer to the RTPSParticipantProxyData whose announcement is relayed.
+	 * @param destination Pointer to the RTPSParticipantProxyData that receives it.
+	 */
+	void relay(ParticipantProxyData* source, ParticipantProxyData* destination);
+
+	//!For each client, the clients whose announcement has been relayed to it.
+	std::unordered_map<GuidPrefix_t, std::vector<GuidPrefix_t>, GuidPrefixHash> m_relays;
+};
+
+}
+} /* namespace rtps */
+} /* namespace eprosima */
+#endif
+#endif /* PDPSERVER_H_ */
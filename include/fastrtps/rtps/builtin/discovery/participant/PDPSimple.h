@@ -26,6 +26,10 @@
 
 #include "../../../../qos/QosPolicies.h"
 
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
 using namespace eprosima::fastrtps;
 
 namespace boost
@@ -58,7 +62,7 @@ class PDPSimpleListener;
  */
 class PDPSimple {
 	friend class ResendRTPSParticipantProxyDataPeriod;
-	friend class RemoteRTPSParticipantLeaseDuration;
+	friend class RemoteParticipantLeaseDuration;
 	friend class PDPSimpleListener;
 public:
 	/**
@@ -80,6 +84,9 @@ public:
     * @param dispose Sets change kind to NOT_ALIVE_DISPOSED_UNREGISTERED 
 	 */
 	void announceParticipantState(bool new_change, bool dispose = false);
+
+	//!Resend the local RTPSParticipant information. Called periodically.
+	virtual void periodicAnnouncement();
 	//!Stop the RTPSParticipantAnnouncement (only used in tests).
 	void stopParticipantAnnouncement();
 	//!Reset the RTPSParticipantAnnouncement (only used in tests).
@@ -164,7 +171,7 @@ public:
 	 * @param partGUID GUID_t of the remote RTPSParticipant.
 	 * @return true if correct.
 	 */
-	bool removeRemoteParticipant(GUID_t& partGUID);
+	virtual bool removeRemoteParticipant(GUID_t& partGUID);
 	//!Pointer to the builtin protocols object.
 	BuiltinProtocols* mp_builtin;
 	/**
@@ -229,7 +236,7 @@ public:
 	 */
 	inline boost::recursive_mutex* getMutex() const {return mp_mutex;}
 
-private:
+protected:
 	//!Pointer to the local RTPSParticipant.
 	RTPSParticipantImpl* mp_RTPSParticipant;
 	//!Discovery attributes.
@@ -242,10 +249,18 @@ private:
 	EDP* mp_EDP;
 	//!Registered RTPSParticipants (including the local one, that is the first one.)
 	std::vector<ParticipantProxyData*> m_participantProxies;
+	//!Registered RTPSParticipants indexed by their GuidPrefix_t.
+	std::unordered_map<GuidPrefix_t, ParticipantProxyData*, GuidPrefixHash> m_participantsByPrefix;
+	//!Known readers indexed by their GUID_t, with the participant they belong to.
+	std::unordered_map<GUID_t, std::pair<ParticipantProxyData*, ReaderProxyData*>, GUIDHash> m_readerProxies;
+	//!Known writers indexed by their GUID_t, with the participant they belong to.
+	std::unordered_map<GUID_t, std::pair<ParticipantProxyData*, WriterProxyData*>, GUIDHash> m_writerProxies;
 	//!Variable to indicate if any parameter has changed.
 	bool m_hasChangedLocalPDP;
 	//!TimedEvent to periodically resend the local RTPSParticipant information.
 	ResendParticipantProxyDataPeriod* mp_resendParticipantTimer;
+	//!TimedEvent that tracks the leases of all the remote RTPSParticipants.
+	RemoteParticipantLeaseDuration* mp_leaseDurationTimer;
 	//!Listener for the SPDP messages.
 	PDPSimpleListener* mp_listener;
 	//!WriterHistory
@@ -258,6 +273,34 @@ private:
 	 * @return True if correct.
 	 */
 	bool createSPDPEndpoints();
+
+	/**
+	 * Register a new RTPSParticipant. Must be called with the PDP mutex taken.
+	 * @param pdata Pointer to the RTPSParticipantProxyData.
+	 */
+	void addParticipantProxyData(ParticipantProxyData* pdata);
+
+	/**
+	 * Find a registered RTPSParticipant. Must be called with the PDP mutex taken.
+	 * @param guidP GuidPrefix_t of the RTPSParticipant.
+	 * @return Pointer to the RTPSParticipantProxyData, or nullptr if it is not registered.
+	 */
+	ParticipantProxyData* findParticipantProxyData(const GuidPrefix_t& guidP);
+
+	/**
+	 * Called when the ReaderProxyData of a remote reader is added. Must be called with the PDP mutex taken.
+	 * @param pdata Pointer to the RTPSParticipantProxyData the reader belongs to.
+	 * @param rdata Pointer to the ReaderProxyData.
+	 */
+	virtual void remoteReaderProxyDataAdded(ParticipantProxyData* /*pdata*/, ReaderProxyData* /*rdata*/) {}
+
+	/**
+	 * Called when the WriterProxyData of a remote writer is added. Must be called with the PDP mutex taken.
+	 * @param pdata Pointer to the RTPSParticipantProxyData the writer belongs to.
+	 * @param wdata Pointer to the WriterProxyData.
+	 */
+	virtual void remoteWriterProxyDataAdded(ParticipantProxyData* /*pdata*/, WriterProxyData* /*wdata*/) {}
+
 	boost::recursive_mutex* mp_mutex;
 
 
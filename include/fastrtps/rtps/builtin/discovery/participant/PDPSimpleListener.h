@@ -69,6 +69,13 @@ public:
 	 * @return True on success
 	 */
 	bool getKey(CacheChange_t* change);
+	/**
+	 * Check whether a change repeats the last announcement processed for its RTPSParticipant.
+	 * In that case the liveliness of the RTPSParticipant is asserted.
+	 * @param change Pointer to the CacheChange_t, with its instance handle already set.
+	 * @return True if the announcement did not change and it does not need to be parsed.
+	 */
+	bool isKnownAnnouncement(CacheChange_t* change);
 	//!Temporal RTPSParticipantProxyData object used to read the messages.
 	ParticipantProxyData m_ParticipantProxyData;
 	//!Auxiliary message.
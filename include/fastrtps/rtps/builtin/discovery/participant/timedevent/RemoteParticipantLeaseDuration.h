@@ -21,6 +21,14 @@
 #define RTPSPARTICIPANTLEASEDURATION_H_
 #ifndef DOXYGEN_SHOULD_SKIP_THIS_PUBLIC
 #include "fastrtps/rtps/resources/TimedEvent.h"
+#include "fastrtps/rtps/common/Guid.h"
+#include "fastrtps/rtps/common/Time_t.h"
+
+#include <map>
+#include <unordered_map>
+
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/thread/mutex.hpp>
 
 
 namespace eprosima {
@@ -28,12 +36,13 @@ namespace fastrtps{
 namespace rtps {
 
 class PDPSimple;
-class ParticipantProxyData;
 
 /**
- * Class RemoteRTPSParticipantLeaseDuration, TimedEvent designed to remove a
- * remote RTPSParticipant and all its Readers and Writers from the local RTPSParticipant if it fails to
- * announce its liveliness each leaseDuration period.
+ * Class RemoteParticipantLeaseDuration, TimedEvent designed to remove the
+ * remote RTPSParticipants and all their Readers and Writers from the local RTPSParticipant if they fail to
+ * announce their liveliness each leaseDuration period.
+ * The leases of all the remote RTPSParticipants are kept ordered by expiration time, and the timer
+ * only waits for the first one to expire.
  *@ingroup DISCOVERY_MODULE
  */
 class RemoteParticipantLeaseDuration:public TimedEvent
@@ -42,25 +51,48 @@ public:
 	/**
 	 * Constructor
 	 * @param p_SPDP Pointer to the PDPSimple object.
-	 * @param pdata Pointer to the ParticipantProxyData associated with this TimedEvent.
-	 * @param interval Interval in ms.
 	 */
-	RemoteParticipantLeaseDuration(PDPSimple* p_SPDP,
-			ParticipantProxyData* pdata,
-			double interval);
+	RemoteParticipantLeaseDuration(PDPSimple* p_SPDP);
 	virtual ~RemoteParticipantLeaseDuration();
 
+	/**
+	 * Start or renew the lease of a remote RTPSParticipant.
+	 * @param guid GUID_t of the RTPSParticipant.
+	 * @param leaseDuration Lease duration announced by the RTPSParticipant.
+	 */
+	void assertLease(const GUID_t& guid, const Duration_t& leaseDuration);
+
+	/**
+	 * Stop tracking the lease of a remote RTPSParticipant.
+	 * @param guidP GuidPrefix_t of the RTPSParticipant.
+	 */
+	void removeLease(const GuidPrefix_t& guidP);
+
  	/**
-	*  Temporal event that check if the RTPSParticipant is alive, and removes it if not.
+	*  Temporal event that removes the RTPSParticipants whose lease expired.
 	* @param code Code representing the status of the event
 	* @param msg Message associated to the event
 	*/
 	void event(EventCode code, const char* msg= nullptr);
 	//!Pointer to the PDPSimple object.
 	PDPSimple* mp_PDP;
-	//!Pointer to the RTPSParticipantProxyData object that contains this temporal event.
-	ParticipantProxyData* mp_participantProxyData;
 
+private:
+	typedef std::multimap<boost::posix_time::ptime, GUID_t> t_expirations;
+
+	/**
+	 * Arm the timer for the first lease to expire, unless it already waits for an earlier time.
+	 * Must be called with m_mutex taken.
+	 */
+	void schedule();
+
+	//!Expiration time of the leases, ordered.
+	t_expirations m_expirations;
+	//!Leases indexed by the GuidPrefix_t of their RTPSParticipant.
+	std::unordered_map<GuidPrefix_t, t_expirations::iterator, GuidPrefixHash> m_leases;
+	//!Expiration time the timer waits for, or not_a_date_time if it is not armed.
+	boost::posix_time::ptime m_scheduled;
+	boost::mutex m_mutex;
 };
 
 }
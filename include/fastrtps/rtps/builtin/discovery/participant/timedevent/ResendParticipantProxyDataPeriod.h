@@ -54,8 +54,6 @@ public:
 	*/
 	void event(EventCode code, const char* msg= nullptr);
 	
-	//!Auxiliar data message.
-	CDRMessage_t m_data_msg;
 	//!Pointer to the PDPSimple object.
 	PDPSimple* mp_PDP;
 };
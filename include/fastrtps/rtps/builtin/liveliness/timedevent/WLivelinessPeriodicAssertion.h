@@ -59,8 +59,6 @@ public:
 	bool AutomaticLivelinessAssertion();
 	//!Assert the liveliness of MANUAL_BY_PARTICIPANT kind writers.
 	bool ManualByRTPSParticipantLivelinessAssertion();
-	//!Message to store the data.
-	CDRMessage_t m_msg;
 	//!Instance Handle
 	InstanceHandle_t m_iHandle;
 	//!GuidPrefix_t
@@ -0,0 +1,85 @@
+// Copyright 2016 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file BatchingStatistics.h
+ *
+ */
+
+#ifndef BATCHINGSTATISTICS_H_
+#define BATCHINGSTATISTICS_H_
+
+#include "../../fastrtps_dll.h"
+#include <cstdint>
+
+namespace eprosima{
+namespace fastrtps{
+namespace rtps{
+
+/**
+ * Class BatchingStatistics, counters of the batches sent by a writer since it was created.
+ * @ingroup COMMON_MODULE
+ */
+class RTPS_DllAPI BatchingStatistics
+{
+public:
+	//!Reason why a batch was sent.
+	enum FlushReason
+	{
+		FLUSHED_BY_SIZE,//!< The batch reached its maximum bytes or samples.
+		FLUSHED_BY_DELAY,//!< The first change of the batch waited the maximum delay.
+		FLUSHED_EXPLICITLY//!< The batch was flushed by the user, or before a change that cannot be batched.
+	};
+
+	BatchingStatistics():
+		batches(0), samples(0), bytes(0), capacity(0),
+		flushedBySize(0), flushedByDelay(0), flushedExplicitly(0){};
+	~BatchingStatistics(){};
+
+	//!Batches sent.
+	uint64_t batches;
+	//!Changes sent in batches.
+	uint64_t samples;
+	//!Bytes of DATA submessages sent in batches.
+	uint64_t bytes;
+	//!Bytes that fill a batch.
+	uint32_t capacity;
+	//!Batches sent because they were full.
+	uint64_t flushedBySize;
+	//!Batches sent because their delay expired.
+	uint64_t flushedByDelay;
+	//!Batches sent because they were flushed explicitly.
+	uint64_t flushedExplicitly;
+
+	/**
+	 * Get the average number of changes in a batch.
+	 * @return Changes per batch, 0 when no batch was sent.
+	 */
+	double averageSamples() const { return batches == 0 ? 0.0 : (double)samples / (double)batches; }
+
+	/**
+	 * Get the average fraction of the capacity filled by a batch.
+	 * @return Fill ratio between 0 and 1, 0 when no batch was sent.
+	 */
+	double averageFill() const
+	{
+		return (batches == 0 || capacity == 0) ? 0.0 : (double)bytes / ((double)batches * (double)capacity);
+	}
+};
+
+}
+}
+}
+
+#endif /* BATCHINGSTATISTICS_H_ */
@@ -241,8 +241,7 @@ namespace eprosima
                 is_relevant_(true), seq_num_(change->sequenceNumber), change_(change)
                 {
                    if (change->getFragmentSize() != 0)
-                    for (uint32_t i = 1; i != change->getFragmentCount() + 1; i++)
-                       unsent_fragments_.add(i); // Indexed on 1
+                       unsent_fragments_.addRange(1, change->getFragmentCount()); // Indexed on 1
                 }
 
                 ChangeForReader_t(const SequenceNumber_t& seq_num) : status_(UNSENT),
@@ -317,8 +316,7 @@ namespace eprosima
                 void markAllFragmentsAsUnsent()
                 {
                    if (change_->getFragmentSize() != 0)
-                    for (uint32_t i = 1; i != change_->getFragmentCount() + 1; i++)
-                       unsent_fragments_.add(i); // Indexed on 1
+                       unsent_fragments_.addRange(1, change_->getFragmentCount()); // Indexed on 1
                 }
 
                 void markFragmentsAsSent(const FragmentNumberSet_t& sentFragments)
@@ -20,6 +20,7 @@
 #define RPTS_ELEM_FRAGNUM_H_
 #include "../../fastrtps_dll.h"
 #include "Types.h"
+#include "NumberSetBitmap.h"
 
 #include <set>
 #include <cmath>
@@ -32,9 +33,13 @@ namespace rtps{
 typedef uint32_t FragmentNumber_t;
 
 //!Structure FragmentNumberSet_t, contains a group of fragmentnumbers.
+//!The numbers are kept as a bitmap relative to the base, so the base has to be set before adding any number.
 //!@ingroup COMMON_MODULE
 class FragmentNumberSet_t {
 public:
+	//!Iterator through the fragment numbers of the set, in increasing order.
+	typedef NumberSetIterator<FragmentNumber_t> const_iterator;
+
 	//!Base fragment number
 	FragmentNumber_t base;
 
@@ -45,20 +50,21 @@ public:
 	FragmentNumberSet_t& operator=(const FragmentNumberSet_t& set2)
 	{
 		base = set2.base;
-		set = set2.set;
+		bitmap_ = set2.bitmap_;
 		return *this;
 	}
 
-   FragmentNumberSet_t(): base(0), set()
+   FragmentNumberSet_t(): base(0)
    {
    }
 
    FragmentNumberSet_t(const std::set<FragmentNumber_t>& set2): base(0)
    {
-      set = set2;
-      auto min = set.begin();
-      if (min != set.end())
+      auto min = set2.begin();
+      if (min != set2.end())
          base = *min;
+      for (auto element : set2)
+         add(element);
    }
 
 	/**
@@ -66,11 +72,11 @@ public:
 	* @param other FragmentNumberSet_t to compare
 	* @return True if equal
 	*/
-	bool operator==(const FragmentNumberSet_t& other) {
+	bool operator==(const FragmentNumberSet_t& other) const {
 
 		if (base != other.base)
 			return false;
-      return other.set == set;	
+      return other.bitmap_ == bitmap_;
    }
 
 
@@ -81,77 +87,165 @@ public:
 	*/
 	bool add(FragmentNumber_t in)
 	{
-		if (in >= base && in <= base + 255)
-			set.insert(in);
+		if (in >= base && in - base < NumberSetBitmap::max_bits)
+			bitmap_.set(in - base);
 		else
 			return false;
 		return true;
 	}
 
+	/**
+	* Add a range of fragment numbers to the set
+	* @param first First fragment number of the range
+	* @param last Last fragment number of the range, included
+	* @return True if the whole range fits in the set. Otherwise only the part that fits is added.
+	*/
+	bool addRange(FragmentNumber_t first, FragmentNumber_t last)
+	{
+		if (last < first)
+			return true;
+		if (last < base)
+			return false;
+		bool fits = first >= base && last - base < NumberSetBitmap::max_bits;
+		uint32_t from = first > base ? first - base : 0;
+		uint32_t to = NumberSetBitmap::max_bits;
+		if (last - base < to)
+			to = last - base + 1;
+		if (from < to)
+			bitmap_.set(from, to);
+		return fits;
+	}
+
+	/**
+	* Remove a fragment number from the set
+	* @param in FragmentNumber_t to remove
+	*/
+	void remove(FragmentNumber_t in)
+	{
+		if (in >= base && in - base < NumberSetBitmap::max_bits)
+			bitmap_.reset(in - base);
+	}
+
+	/**
+	* Check if a fragment number is in the set
+	* @param in FragmentNumber_t to look for
+	* @return True if it is in the set
+	*/
+	bool contains(FragmentNumber_t in) const
+	{
+		return in >= base && in - base < NumberSetBitmap::max_bits && bitmap_.test(in - base);
+	}
+
+	/**
+	* Get the maximum fragment number in the set. The set must not be empty.
+	* @return maximum fragment number in the set
+	*/
+	FragmentNumber_t get_maxFragNum() const
+	{
+		return base + bitmap_.last();
+	}
+
 	/**
 	* Check if the set is empty
 	* @return True if the set is empty
 	*/
 	bool isSetEmpty() const
 	{
-		return set.empty();
+		return bitmap_.empty();
 	}
 
 	/**
 	* Get the begin of the set
-	* @return Vector iterator pointing to the begin of the set
+	* @return Iterator pointing to the lowest fragment number of the set
 	*/
-	std::set<FragmentNumber_t>::const_iterator get_begin() const
+	const_iterator get_begin() const
 	{
-		return set.begin();
+		return const_iterator(base, &bitmap_, bitmap_.next(0));
 	}
 
 	/**
 	* Get the end of the set
-	* @return Vector iterator pointing to the end of the set
+	* @return Iterator pointing to the end of the set
 	*/
-	std::set<FragmentNumber_t>::const_iterator get_end() const
+	const_iterator get_end() const
+	{
+		return const_iterator(base, &bitmap_, NumberSetBitmap::max_bits);
+	}
+
+	//!@return Iterator pointing to the lowest fragment number of the set
+	const_iterator begin() const
 	{
-		return set.end();
+		return get_begin();
+	}
+
+	//!@return Iterator pointing to the end of the set
+	const_iterator end() const
+	{
+		return get_end();
 	}
 
 	/**
 	* Get the number of FragmentNumbers in the set
 	* @return Size of the set
 	*/
-	size_t get_size()
+	size_t get_size() const
+	{
+		return bitmap_.count();
+	}
+
+	/**
+	* Get the bitmap of the set, in wire layout.
+	* @return Bitmap relative to the base
+	*/
+	const NumberSetBitmap& get_bitmap() const
+	{
+		return bitmap_;
+	}
+
+	/**
+	* Get the bitmap of the set, to fill it directly from a message.
+	* @return Bitmap relative to the base
+	*/
+	NumberSetBitmap& get_bitmap()
 	{
-		return set.size();
+		return bitmap_;
 	}
 
 	/**
 	* Get a string representation of the set
 	* @return string representation of the set
 	*/
-	std::string print()
+	std::string print() const
 	{
 		std::stringstream ss;
 		ss << base << ":";
-		for (auto it = set.begin(); it != set.end(); ++it)
+		for (auto it = get_begin(); it != get_end(); ++it)
 			ss << *it << "-";
 		return ss.str();
 	}
 
    FragmentNumberSet_t& operator-=(const FragmentNumberSet_t& rhs)
    {
-      for ( auto element : rhs.set)
-         set.erase(element);
+      if (rhs.base == base)
+         bitmap_.subtract(rhs.bitmap_);
+      else
+         for (auto element : rhs)
+            remove(element);
       return *this;
    }
 
    FragmentNumberSet_t& operator+=(const FragmentNumberSet_t& rhs)
    {
-      for ( auto element : rhs.set )
-         add(element);
+      if (rhs.base == base)
+         bitmap_.merge(rhs.bitmap_);
+      else
+         for (auto element : rhs)
+            add(element);
       return *this;
    }
 
-	std::set<FragmentNumber_t> set;
+private:
+	NumberSetBitmap bitmap_;
 };
 
 /**
@@ -160,21 +254,19 @@ public:
 * @param sns SequenceNumber set
 * @return OStream.
 */
-inline std::ostream& operator<<(std::ostream& output, FragmentNumberSet_t& sns){
+inline std::ostream& operator<<(std::ostream& output, const FragmentNumberSet_t& sns){
 	return output << sns.print();
 }
 
 inline FragmentNumberSet_t operator-(FragmentNumberSet_t lhs, const FragmentNumberSet_t& rhs)
 {
-   for ( auto element : rhs.set)
-      lhs.set.erase(element);
+   lhs -= rhs;
    return lhs;
 }
 
 inline FragmentNumberSet_t operator+(FragmentNumberSet_t lhs, const FragmentNumberSet_t& rhs)
 {
-   for ( auto element : rhs.set)
-      lhs.add(element);
+   lhs += rhs;
    return lhs;
 }
 
@@ -421,6 +421,47 @@ inline bool operator<(const GUID_t& g1, const GUID_t& g2){
 	}
 	return false;
 }
+
+/*!
+ * @brief Defines the STL hash function for type GuidPrefix_t.
+ */
+struct GuidPrefixHash
+{
+    std::size_t operator()(const GuidPrefix_t& guidP) const
+    {
+        // FNV-1a over the prefix.
+        std::size_t hash = static_cast<std::size_t>(14695981039346656037ULL);
+        for(uint8_t i = 0; i < 12; ++i)
+        {
+            hash ^= guidP.value[i];
+            hash *= static_cast<std::size_t>(1099511628211ULL);
+        }
+        return hash;
+    }
+};
+
+/*!
+ * @brief Defines the STL hash function for type GUID_t.
+ */
+struct GUIDHash
+{
+    std::size_t operator()(const GUID_t& guid) const
+    {
+        // FNV-1a over the prefix and the entity id.
+        std::size_t hash = static_cast<std::size_t>(14695981039346656037ULL);
+        for(uint8_t i = 0; i < 12; ++i)
+        {
+            hash ^= guid.guidPrefix.value[i];
+            hash *= static_cast<std::size_t>(1099511628211ULL);
+        }
+        for(uint8_t i = 0; i < 4; ++i)
+        {
+            hash ^= guid.entityId.value[i];
+            hash *= static_cast<std::size_t>(1099511628211ULL);
+        }
+        return hash;
+    }
+};
 #endif
 
 const GUID_t c_Guid_Unknown;
@@ -108,6 +108,24 @@ inline bool operator==(const InstanceHandle_t & ihandle1, const InstanceHandle_t
 	}
 	return true;
 }
+
+/*!
+ * @brief Defines the STL hash function for type InstanceHandle_t.
+ */
+struct InstanceHandleHash
+{
+    std::size_t operator()(const InstanceHandle_t& ihandle) const
+    {
+        // FNV-1a. Keys are often small integers padded with zeros, so every byte is mixed in.
+        std::size_t hash = static_cast<std::size_t>(14695981039346656037ULL);
+        for(uint8_t i = 0; i < 16; ++i)
+        {
+            hash ^= ihandle.value[i];
+            hash *= static_cast<std::size_t>(1099511628211ULL);
+        }
+        return hash;
+    }
+};
 #endif
 
 /**
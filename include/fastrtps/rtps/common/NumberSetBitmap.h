@@ -0,0 +1,308 @@
+// Copyright 2016 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file NumberSetBitmap.h
+ */
+
+#ifndef RPTS_ELEM_NUMBERSETBITMAP_H_
+#define RPTS_ELEM_NUMBERSETBITMAP_H_
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace eprosima{
+namespace fastrtps{
+namespace rtps{
+
+/**
+ * Fixed bitmap of the number sets sent in ACKNACK, GAP and NACK_FRAG submessages.
+ * Bit N is the number base + N. The words keep the wire layout, where the first number is the most
+ * significant bit of the first word, so they can be (de)serialized without touching each bit.
+ * @ingroup COMMON_MODULE
+ */
+class NumberSetBitmap
+{
+public:
+
+	//!Maximum number of bits of the set, fixed by the RTPS specification.
+	static const uint32_t max_bits = 256;
+
+	//!Number of 32 bits words of the bitmap.
+	static const uint32_t max_words = max_bits / 32;
+
+	NumberSetBitmap()
+	{
+		clear();
+	}
+
+	//!Remove all the bits.
+	void clear()
+	{
+		memset(m_words, 0, sizeof(m_words));
+	}
+
+	//!@return True if no bit is set.
+	bool empty() const
+	{
+		for(uint32_t i = 0; i < max_words; ++i)
+			if(m_words[i] != 0)
+				return false;
+		return true;
+	}
+
+	//!@return True if the bit is set.
+	bool test(uint32_t bit) const
+	{
+		return (m_words[bit / 32] & (0x80000000u >> (bit % 32))) != 0;
+	}
+
+	//!Set one bit, that has to be lower than max_bits.
+	void set(uint32_t bit)
+	{
+		m_words[bit / 32] |= 0x80000000u >> (bit % 32);
+	}
+
+	//!Clear one bit, that has to be lower than max_bits.
+	void reset(uint32_t bit)
+	{
+		m_words[bit / 32] &= ~(0x80000000u >> (bit % 32));
+	}
+
+	/**
+	 * Set all the bits of a range.
+	 * @param from First bit of the range.
+	 * @param to Bit after the last one of the range. It has to be lower or equal than max_bits.
+	 */
+	void set(uint32_t from, uint32_t to)
+	{
+		while(from < to)
+		{
+			uint32_t word = from / 32;
+			uint32_t last = to < (word + 1) * 32 ? to : (word + 1) * 32;
+			uint32_t mask = 0xFFFFFFFFu >> (from % 32);
+			if(last % 32 != 0)
+				mask &= ~(0xFFFFFFFFu >> (last % 32));
+			m_words[word] |= mask;
+			from = last;
+		}
+	}
+
+	//!@return Number of bits set.
+	uint32_t count() const
+	{
+		uint32_t n = 0;
+		for(uint32_t i = 0; i < max_words; ++i)
+			n += popcount(m_words[i]);
+		return n;
+	}
+
+	/**
+	 * Look for the first bit set starting at a given one.
+	 * @param bit Bit where the search starts.
+	 * @return First bit set greater or equal than bit, or max_bits if there is none.
+	 */
+	uint32_t next(uint32_t bit) const
+	{
+		if(bit >= max_bits)
+			return max_bits;
+
+		uint32_t word = bit / 32;
+		uint32_t bits = m_words[word] & (0xFFFFFFFFu >> (bit % 32));
+		while(bits == 0)
+		{
+			if(++word == max_words)
+				return max_bits;
+			bits = m_words[word];
+		}
+		return word * 32 + clz(bits);
+	}
+
+	//!@return Greatest bit set, or max_bits if there is none.
+	uint32_t last() const
+	{
+		for(uint32_t word = max_words; word > 0; --word)
+		{
+			if(m_words[word - 1] != 0)
+				return (word - 1) * 32 + 31 - ctz(m_words[word - 1]);
+		}
+		return max_bits;
+	}
+
+	//!@return Number of bits needed to send the set, zero if it is empty.
+	uint32_t numBits() const
+	{
+		uint32_t bit = last();
+		return bit == max_bits ? 0 : bit + 1;
+	}
+
+	//!Set the bits set in other.
+	void merge(const NumberSetBitmap& other)
+	{
+		for(uint32_t i = 0; i < max_words; ++i)
+			m_words[i] |= other.m_words[i];
+	}
+
+	//!Clear the bits set in other.
+	void subtract(const NumberSetBitmap& other)
+	{
+		for(uint32_t i = 0; i < max_words; ++i)
+			m_words[i] &= ~other.m_words[i];
+	}
+
+	//!@return Word of the bitmap, in wire layout.
+	uint32_t word(uint32_t index) const
+	{
+		return m_words[index];
+	}
+
+	//!Replace a word of the bitmap, in wire layout.
+	void word(uint32_t index, uint32_t value)
+	{
+		m_words[index] = value;
+	}
+
+	bool operator==(const NumberSetBitmap& other) const
+	{
+		return memcmp(m_words, other.m_words, sizeof(m_words)) == 0;
+	}
+
+	bool operator!=(const NumberSetBitmap& other) const
+	{
+		return !(*this == other);
+	}
+
+private:
+
+	static uint32_t popcount(uint32_t value)
+	{
+#if defined(__GNUC__)
+		return static_cast<uint32_t>(__builtin_popcount(value));
+#else
+		value = value - ((value >> 1) & 0x55555555u);
+		value = (value & 0x33333333u) + ((value >> 2) & 0x33333333u);
+		return (((value + (value >> 4)) & 0x0F0F0F0Fu) * 0x01010101u) >> 24;
+#endif
+	}
+
+	//!Leading zeros of a word that is not zero.
+	static uint32_t clz(uint32_t value)
+	{
+#if defined(__GNUC__)
+		return static_cast<uint32_t>(__builtin_clz(value));
+#elif defined(_MSC_VER)
+		unsigned long index;
+		_BitScanReverse(&index, value);
+		return 31 - static_cast<uint32_t>(index);
+#else
+		uint32_t n = 0;
+		while((value & 0x80000000u) == 0)
+		{
+			value <<= 1;
+			++n;
+		}
+		return n;
+#endif
+	}
+
+	//!Trailing zeros of a word that is not zero.
+	static uint32_t ctz(uint32_t value)
+	{
+#if defined(__GNUC__)
+		return static_cast<uint32_t>(__builtin_ctz(value));
+#elif defined(_MSC_VER)
+		unsigned long index;
+		_BitScanForward(&index, value);
+		return static_cast<uint32_t>(index);
+#else
+		uint32_t n = 0;
+		while((value & 1u) == 0)
+		{
+			value >>= 1;
+			++n;
+		}
+		return n;
+#endif
+	}
+
+	uint32_t m_words[max_words];
+};
+
+/**
+ * Forward iterator over the numbers of a set stored as a base and a NumberSetBitmap.
+ * It goes through the numbers in increasing order and returns them by value.
+ * @ingroup COMMON_MODULE
+ */
+template<class T>
+class NumberSetIterator
+{
+public:
+
+	typedef std::forward_iterator_tag iterator_category;
+	typedef T value_type;
+	typedef std::ptrdiff_t difference_type;
+	typedef const T* pointer;
+	typedef T reference;
+
+	NumberSetIterator(const T& base, const NumberSetBitmap* bitmap, uint32_t bit):
+		m_base(base), mp_bitmap(bitmap), m_bit(bit)
+	{
+	}
+
+	T operator*() const
+	{
+		return m_base + m_bit;
+	}
+
+	NumberSetIterator& operator++()
+	{
+		m_bit = mp_bitmap->next(m_bit + 1);
+		return *this;
+	}
+
+	NumberSetIterator operator++(int)
+	{
+		NumberSetIterator old(*this);
+		++(*this);
+		return old;
+	}
+
+	bool operator==(const NumberSetIterator& other) const
+	{
+		return mp_bitmap == other.mp_bitmap && m_bit == other.m_bit;
+	}
+
+	bool operator!=(const NumberSetIterator& other) const
+	{
+		return !(*this == other);
+	}
+
+private:
+
+	T m_base;
+	const NumberSetBitmap* mp_bitmap;
+	uint32_t m_bit;
+};
+
+}
+}
+}
+
+#endif /* RPTS_ELEM_NUMBERSETBITMAP_H_ */
@@ -20,6 +20,7 @@
 #define RPTS_ELEM_SEQNUM_H_
 #include "../../fastrtps_dll.h"
 #include "Types.h"
+#include "NumberSetBitmap.h"
 
 #include <vector>
 #include <algorithm>
@@ -353,10 +354,14 @@ struct SequenceNumberHash
 #endif
 
 //!Structure SequenceNumberSet_t, contains a group of sequencenumbers.
+//!The numbers are kept as a bitmap relative to the base, so the base has to be set before adding any number.
 //!@ingroup COMMON_MODULE
 class SequenceNumberSet_t
 {
 public:
+	//!Iterator through the sequence numbers of the set, in increasing order.
+	typedef NumberSetIterator<SequenceNumber_t> const_iterator;
+
 	//!Base sequence number
 	SequenceNumber_t base;
 	
@@ -367,9 +372,19 @@ public:
 	SequenceNumberSet_t& operator=(const SequenceNumberSet_t& set2)
 	{
 		base = set2.base;
-		set = set2.set;
+		bitmap_ = set2.bitmap_;
 		return *this;
 	}
+
+	/**
+	* Compares object with other SequenceNumberSet_t.
+	* @param other SequenceNumberSet_t to compare
+	* @return True if equal
+	*/
+	bool operator==(const SequenceNumberSet_t& other) const
+	{
+		return base == other.base && bitmap_ == other.bitmap_;
+	}
 	
 	/**
 	* Add a sequence number to the set
@@ -378,73 +393,157 @@ public:
 	*/
 	bool add(const SequenceNumber_t& in)
 	{
-		if(in >= base && in < base + 255)
-			set.push_back(in);
+		if(in >= base && in < base + NumberSetBitmap::max_bits)
+			bitmap_.set((in - base).low);
 		else
 			return false;
 
 		return true;
 	}
+
+	/**
+	* Remove a sequence number from the set
+	* @param in SequenceNumber_t to remove
+	*/
+	void remove(const SequenceNumber_t& in)
+	{
+		if(in >= base && in < base + NumberSetBitmap::max_bits)
+			bitmap_.reset((in - base).low);
+	}
+
+	/**
+	* Check if a sequence number is in the set
+	* @param in SequenceNumber_t to look for
+	* @return True if it is in the set
+	*/
+	bool contains(const SequenceNumber_t& in) const
+	{
+		return in >= base && in < base + NumberSetBitmap::max_bits && bitmap_.test((in - base).low);
+	}
 	
 	/**
-	* Get the maximum sequence number in the set
+	* Get the maximum sequence number in the set. The set must not be empty.
 	* @return maximum sequence number in the set
 	*/
-	SequenceNumber_t get_maxSeqNum()
+	SequenceNumber_t get_maxSeqNum() const
 	{
-		return *std::max_element(set.begin(),set.end(),sort_seqNum);
+		return base + bitmap_.last();
 	}
 	
 	/**
 	* Check if the set is empty
 	* @return True if the set is empty
 	*/
-	bool isSetEmpty()
+	bool isSetEmpty() const
 	{
-		return set.empty();
+		return bitmap_.empty();
 	}
 	
 	/**
 	* Get the begin of the set
-	* @return Vector iterator pointing to the begin of the set
+	* @return Iterator pointing to the lowest sequence number of the set
 	*/
-	std::vector<SequenceNumber_t>::iterator get_begin()
+	const_iterator get_begin() const
 	{
-		return set.begin();
+		return const_iterator(base, &bitmap_, bitmap_.next(0));
 	}
 	
 	/**
 	* Get the end of the set
-	* @return Vector iterator pointing to the end of the set
+	* @return Iterator pointing to the end of the set
 	*/
-	std::vector<SequenceNumber_t>::iterator get_end()
+	const_iterator get_end() const
 	{
-		return set.end();
+		return const_iterator(base, &bitmap_, NumberSetBitmap::max_bits);
+	}
+
+	//!@return Iterator pointing to the lowest sequence number of the set
+	const_iterator begin() const
+	{
+		return get_begin();
+	}
+
+	//!@return Iterator pointing to the end of the set
+	const_iterator end() const
+	{
+		return get_end();
 	}
 	
 	/**
 	* Get the number of SequenceNumbers in the set
 	* @return Size of the set
 	*/
-	size_t get_size()
+	size_t get_size() const
 	{
-		return set.size();
+		return bitmap_.count();
 	}
 	
 	/**
 	* Get the set of SequenceNumbers 
 	* @return Set of SequenceNumbers
 	*/
-	std::vector<SequenceNumber_t> get_set()
+	std::vector<SequenceNumber_t> get_set() const
     {
+		std::vector<SequenceNumber_t> set;
+		set.reserve(get_size());
+		for(const_iterator it = get_begin(); it != get_end(); ++it)
+			set.push_back(*it);
 		return set;
     }
+
+	/**
+	* Add the sequence numbers of other set. The ones out of the range of this set are ignored.
+	* @param rhs Set to add
+	* @return Reference to this set
+	*/
+	SequenceNumberSet_t& operator+=(const SequenceNumberSet_t& rhs)
+	{
+		if(rhs.base == base)
+			bitmap_.merge(rhs.bitmap_);
+		else
+			for(const_iterator it = rhs.get_begin(); it != rhs.get_end(); ++it)
+				add(*it);
+		return *this;
+	}
+
+	/**
+	* Remove the sequence numbers of other set.
+	* @param rhs Set to remove
+	* @return Reference to this set
+	*/
+	SequenceNumberSet_t& operator-=(const SequenceNumberSet_t& rhs)
+	{
+		if(rhs.base == base)
+			bitmap_.subtract(rhs.bitmap_);
+		else
+			for(const_iterator it = rhs.get_begin(); it != rhs.get_end(); ++it)
+				remove(*it);
+		return *this;
+	}
+
+	/**
+	* Get the bitmap of the set, in wire layout.
+	* @return Bitmap relative to the base
+	*/
+	const NumberSetBitmap& get_bitmap() const
+	{
+		return bitmap_;
+	}
+
+	/**
+	* Get the bitmap of the set, to fill it directly from a message.
+	* @return Bitmap relative to the base
+	*/
+	NumberSetBitmap& get_bitmap()
+	{
+		return bitmap_;
+	}
 									
 	/**
 	* Get a string representation of the set
 	* @return string representation of the set
 	*/
-	std::string print()
+	std::string print() const
 	{
 		std::stringstream ss;
 
@@ -453,19 +552,20 @@ public:
 #else
 		ss << "{high: " << base.high << ", low: " << base.low << "} :";
 #endif
-		for(std::vector<SequenceNumber_t>::iterator it = set.begin(); it != set.end(); ++it)
+		for(const_iterator it = get_begin(); it != get_end(); ++it)
         {
+			SequenceNumber_t seqNum = *it;
 #ifdef LLONG_MAX
-			ss << it->to64long() << "-";
+			ss << seqNum.to64long() << "-";
 #else
-            ss << "{high: " << it->high << ", low: " << it->low << "} -";
+            ss << "{high: " << seqNum.high << ", low: " << seqNum.low << "} -";
 #endif
         }
 		return ss.str();
 	}
 	
 private:
-	std::vector<SequenceNumber_t> set;
+	NumberSetBitmap bitmap_;
 };
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS_PUBLIC
@@ -476,7 +576,7 @@ private:
  * @param sns SequenceNumber set
  * @return OStream.
  */
-inline std::ostream& operator<<(std::ostream& output, SequenceNumberSet_t& sns)
+inline std::ostream& operator<<(std::ostream& output, const SequenceNumberSet_t& sns)
 {
 	return output << sns.print();
 }
@@ -75,6 +75,18 @@ class CacheChangePool {
          */
         bool reserve_Cache(CacheChange_t** chan, uint32_t dataSize);
 
+        /*!
+         * @brief Reserves several CacheChanges from the pool, taking its mutex once.
+         * @param changes Vector where the reserved CacheChanges are appended.
+         * @param count Number of CacheChanges to reserve.
+         * @param calculateSizeFunc Function that returns the size of the data which will go into the CacheChange
+         * with the given index. It is executed, before locking the pool, depending on the memory management policy
+         * (DYNAMIC_RESERVE_MEMORY_MODE and PREALLOCATED_WITH_REALLOC_MEMORY_MODE)
+         * @return True whether all the CacheChanges could be allocated. In other case none is reserved and returns false.
+         */
+        bool reserve_Caches(std::vector<CacheChange_t*>& changes, size_t count,
+                const std::function<uint32_t(size_t)>& calculateSizeFunc);
+
         //!Release a Cache back to the pool.
         void release_Cache(CacheChange_t*);
         //!Get the size of the cache vector; all of them (reserved and not reserved).
@@ -91,6 +103,10 @@ class CacheChangePool {
         std::vector<CacheChange_t*> m_freeCaches;
         std::vector<CacheChange_t*> m_allCaches;
         bool allocateGroup(uint32_t pool_size);
+        //!Reserve a Cache. The mutex has to be locked by the caller.
+        bool reserve_Cache_nts(CacheChange_t** chan, uint32_t dataSize);
+        //!Release a Cache. The mutex has to be locked by the caller.
+        void release_Cache_nts(CacheChange_t* ch);
         CacheChange_t* allocateSingle(uint32_t dataSize);
         boost::mutex* mp_mutex;
         MemoryManagementPolicy_t memoryMode;
@@ -69,6 +69,19 @@ public:
         return m_changePool.reserve_Cache(change, dataSize);
     }
 
+	/**
+	 * Reserve several CacheChange_t from the CacheChange pool at once.
+	 * @param[out] changes Vector where the reserved changes are appended.
+	 * @param count Number of changes to reserve.
+	 * @param calculateSizeFunc Function returning the size of the data of the change with the given index.
+	 * @return True if all were reserved. In other case none is reserved.
+	 */
+	RTPS_DllAPI inline bool reserve_Caches(std::vector<CacheChange_t*>& changes, size_t count,
+            const std::function<uint32_t(size_t)>& calculateSizeFunc)
+    {
+        return m_changePool.reserve_Caches(changes, count, calculateSizeFunc);
+    }
+
 	/**
 	 * release a previously reserved CacheChange_t.
 	 * @param ch Pointer to the CacheChange_t.
@@ -106,6 +106,23 @@ public:
 	RTPS_DllAPI bool thereIsUpperRecordOf(GUID_t& guid, SequenceNumber_t& seq);
 
 protected:
+	/**
+	 * Remove a CacheChange_t from the ReaderHistory without releasing it to the pool.
+	 * The mutex of the history must be locked.
+	 * @param a_change Pointer to the CacheChange to remove.
+	 * @return True if removed.
+	 */
+	bool detach_change(CacheChange_t* a_change);
+
+	/**
+	 * Remove several CacheChange_t from the ReaderHistory in one pass, without releasing them to the pool.
+	 * The mutex of the history must be locked.
+	 * @param[in,out] changes Changes to remove, in the order they have in the history. The ones not found in
+	 * the history are set to nullptr, so only the remaining ones have been removed.
+	 * @return Number of changes removed.
+	 */
+	size_t detach_changes(std::vector<CacheChange_t*>& changes);
+
 	//!Pointer to the reader
 	RTPSReader* mp_reader;
 	//!Pointer to the semaphore, used to halt execution until new message arrives.
@@ -48,10 +48,19 @@ public:
 	RTPS_DllAPI void updateMaxMinSeqNum();
 	/**
 	 * Add a CacheChange_t to the ReaderHistory.
+	 * A synchronous writer sends the change once the history mutex is released.
 	 * @param a_change Pointer to the CacheChange to add.
 	 * @return True if added.
 	 */
 	RTPS_DllAPI bool add_change(CacheChange_t* a_change);
+	/**
+	 * Add several CacheChange_t to the history, locking it once and handing them to the writer as a group,
+	 * so they are sent in as few messages as possible.
+	 * Adding stops at the first change that cannot be added.
+	 * @param changes Changes to add.
+	 * @return Number of changes added, which are the first ones of the vector.
+	 */
+	RTPS_DllAPI size_t add_changes(const std::vector<CacheChange_t*>& changes);
 	/**
 	 * Remove a specific change from the history.
 	 * @param a_change Pointer to the CacheChange_t.
@@ -73,6 +82,32 @@ protected:
 	SequenceNumber_t m_lastCacheChangeSeqNum;
 	//!Pointer to the associated RTPSWriter;
 	RTPSWriter* mp_writer;
+	//!Changes added since begin_change_group(), not yet handed to the writer.
+	std::vector<CacheChange_t*>* mp_changeGroup;
+
+	/**
+	 * Start collecting the changes added, instead of handing them to the writer one by one.
+	 * The history mutex has to be locked by the caller until end_change_group().
+	 * @param group Vector where the changes are collected.
+	 */
+	void begin_change_group(std::vector<CacheChange_t*>* group);
+
+	/**
+	 * Hand the changes collected so far to the writer, and keep collecting.
+	 * Used before cleaning the history, so the changes of the group are known by the writer.
+	 */
+	void flush_change_group();
+
+	/**
+	 * Hand the changes collected since begin_change_group() to the writer.
+	 */
+	void end_change_group();
+
+	/**
+	 * Send the changes left pending by a synchronous writer. Called after releasing the history mutex,
+	 * so other threads can add changes while these are on the network.
+	 */
+	void send_pending_changes();
 };
 }
 } /* namespace fastrtps */
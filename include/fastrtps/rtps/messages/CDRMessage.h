@@ -51,11 +51,13 @@ namespace CDRMessage{
 	  inline bool readDataReversed(CDRMessage_t* msg, octet* o, uint32_t length);
 	  inline bool readInt32(CDRMessage_t* msg,int32_t* lo);
 	  inline bool readUInt32(CDRMessage_t* msg, uint32_t* ulo);
+	  inline bool readUInt32Array(CDRMessage_t* msg, uint32_t* values, uint32_t count);
 	  inline bool readSequenceNumber(CDRMessage_t* msg, SequenceNumber_t* sn);
 	  inline bool readInt16(CDRMessage_t* msg,int16_t* i16);
 	  inline bool readUInt16(CDRMessage_t* msg,uint16_t* i16);
 	  inline bool readLocator(CDRMessage_t* msg,Locator_t* loc);
 	  inline bool readOctet(CDRMessage_t* msg, octet* o);
+	  inline bool readNumberSetBitmap(CDRMessage_t* msg, NumberSetBitmap* bitmap);
 	  inline bool readSequenceNumberSet(CDRMessage_t* msg, SequenceNumberSet_t* snset);
 	  inline bool readFragmentNumberSet(CDRMessage_t* msg, FragmentNumberSet_t* snset);
 	  inline bool readTimestamp(CDRMessage_t*msg,Time_t* ts);
@@ -64,6 +66,19 @@ namespace CDRMessage{
 	///@}
 
 
+	/** @name Byte order.
+	 * Methods to swap the bytes of scalars, and of arrays of them in place, to convert them between the byte
+	 * order of a message and the one of the host. They use the byte swap instructions of the compiler,
+	 * and SSSE3 for the arrays when it is enabled.
+	 */
+	/// @{
+	  inline uint16_t swapBytes(uint16_t value);
+	  inline uint32_t swapBytes(uint32_t value);
+	  inline uint64_t swapBytes(uint64_t value);
+	  inline void swapBytes(uint32_t* values, uint32_t count);
+	///@}
+
+
 	/**
 	 * Initialize given CDR message with default size. It frees the memory already allocated and reserves new one.
 	 * @param[in,out] msg Pointer to the message to initialize.
@@ -99,9 +114,11 @@ namespace CDRMessage{
 	  inline bool addUInt16(CDRMessage_t*msg,uint16_t us);
 	  inline bool addInt32(CDRMessage_t*msg,int32_t lo);
 	  inline bool addUInt32(CDRMessage_t*msg,uint32_t lo);
+	  inline bool addUInt32Array(CDRMessage_t*msg, const uint32_t* values, uint32_t count);
 	  inline bool addInt64(CDRMessage_t*msg,int64_t lo);
 	  inline bool addEntityId(CDRMessage_t*msg,const EntityId_t* id);
 	  inline bool addSequenceNumber(CDRMessage_t*msg, const SequenceNumber_t* sn);
+	  inline bool addNumberSetBitmap(CDRMessage_t*msg, const NumberSetBitmap* bitmap);
 	  inline bool addSequenceNumberSet(CDRMessage_t*msg, SequenceNumberSet_t* sns);
 	  inline bool addFragmentNumberSet(CDRMessage_t*msg, FragmentNumberSet_t* fns);
 	  inline bool addLocator(CDRMessage_t*msg,Locator_t*loc);
@@ -20,13 +20,69 @@
  */
 
 #include <cassert>
+#include <cstring>
 #include <algorithm>
 #include <vector>
 
+#if defined(_MSC_VER)
+#include <stdlib.h>
+#endif
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#endif
+
 namespace eprosima {
 namespace fastrtps{
 namespace rtps {
 
+inline uint16_t CDRMessage::swapBytes(uint16_t value)
+{
+#if defined(__GNUC__)
+    return __builtin_bswap16(value);
+#elif defined(_MSC_VER)
+    return _byteswap_ushort(value);
+#else
+    return (uint16_t)((value << 8) | (value >> 8));
+#endif
+}
+
+inline uint32_t CDRMessage::swapBytes(uint32_t value)
+{
+#if defined(__GNUC__)
+    return __builtin_bswap32(value);
+#elif defined(_MSC_VER)
+    return _byteswap_ulong(value);
+#else
+    return (value << 24) | ((value << 8) & 0x00FF0000u) | ((value >> 8) & 0x0000FF00u) | (value >> 24);
+#endif
+}
+
+inline uint64_t CDRMessage::swapBytes(uint64_t value)
+{
+#if defined(__GNUC__)
+    return __builtin_bswap64(value);
+#elif defined(_MSC_VER)
+    return _byteswap_uint64(value);
+#else
+    return ((uint64_t)swapBytes((uint32_t)value) << 32) | swapBytes((uint32_t)(value >> 32));
+#endif
+}
+
+inline void CDRMessage::swapBytes(uint32_t* values, uint32_t count)
+{
+    uint32_t i = 0;
+#if defined(__SSSE3__)
+    const __m128i mask = _mm_set_epi8(12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3);
+    for(; i + 4 <= count; i += 4)
+    {
+        __m128i block = _mm_loadu_si128((const __m128i*)(values + i));
+        _mm_storeu_si128((__m128i*)(values + i), _mm_shuffle_epi8(block, mask));
+    }
+#endif
+    for(; i < count; ++i)
+        values[i] = swapBytes(values[i]);
+}
+
 inline bool CDRMessage::initCDRMsg(CDRMessage_t*msg,uint32_t payload_size)
 {
     if(msg->buffer==NULL)
@@ -69,9 +125,7 @@ inline bool CDRMessage::appendMsg(CDRMessage_t*first, CDRMessage_t*second) {
 inline bool CDRMessage::readEntityId(CDRMessage_t* msg,const EntityId_t* id) {
     if(msg->pos+4>msg->length)
         return false;
-    uint32_t* aux1 = (uint32_t*) id->value;
-    uint32_t* aux2 = (uint32_t*) &msg->buffer[msg->pos];
-    *aux1 = *aux2;
+    memcpy((octet*)id->value, &msg->buffer[msg->pos], 4);
     msg->pos+=4;
     return true;
 }
@@ -83,110 +137,84 @@ inline bool CDRMessage::readData(CDRMessage_t* msg, octet* o, uint32_t length) {
 }
 
 inline bool CDRMessage::readDataReversed(CDRMessage_t* msg, octet* o, uint32_t length) {
-    for(uint16_t i=0;i<length;i++)
-    {
-        *(o+i)=*(msg->buffer+msg->pos+length-1-i);
-    }
+    std::reverse_copy(msg->buffer + msg->pos, msg->buffer + msg->pos + length, o);
     msg->pos+=length;
     return true;
 }
 
 inline bool CDRMessage::readInt32(CDRMessage_t* msg,int32_t* lo) {
+    return readUInt32(msg, (uint32_t*)lo);
+}
+
+inline bool CDRMessage::readUInt32(CDRMessage_t* msg,uint32_t* ulo) {
     if(msg->pos+4>msg->length)
         return false;
-    octet* dest = (octet*)lo;
-    if(msg->msg_endian == DEFAULT_ENDIAN){
-        for(uint8_t i =0;i<4;i++)
-            dest[i] = msg->buffer[msg->pos+i];
-        msg->pos+=4;
-    }
-    else{
-        readDataReversed(msg,dest,4);
-    }
+    uint32_t value;
+    memcpy(&value, &msg->buffer[msg->pos], 4);
+    *ulo = msg->msg_endian == DEFAULT_ENDIAN ? value : swapBytes(value);
+    msg->pos+=4;
     return true;
 }
 
-inline bool CDRMessage::readUInt32(CDRMessage_t* msg,uint32_t* ulo) {
-    if(msg->pos+4>msg->length)
+inline bool CDRMessage::readUInt32Array(CDRMessage_t* msg, uint32_t* values, uint32_t count) {
+    if(msg->pos + 4 * count > msg->length)
         return false;
-    octet* dest = (octet*)ulo;
-    if(msg->msg_endian == DEFAULT_ENDIAN){
-        for(uint8_t i =0;i<4;i++)
-            dest[i] = msg->buffer[msg->pos+i];
-        msg->pos+=4;
-    }
-    else{
-        readDataReversed(msg,dest,4);
-    }
+    memcpy(values, &msg->buffer[msg->pos], 4 * count);
+    if(msg->msg_endian != DEFAULT_ENDIAN)
+        swapBytes(values, count);
+    msg->pos += 4 * count;
     return true;
 }
 
 inline bool CDRMessage::readSequenceNumber(CDRMessage_t* msg,SequenceNumber_t* sn) {
-    if(msg->pos+8>msg->length)
+    uint32_t words[2];
+    if(!readUInt32Array(msg, words, 2))
         return false;
-    bool valid=readInt32(msg,&sn->high);
-    valid&=readUInt32(msg,&sn->low);
+    sn->high = (int32_t)words[0];
+    sn->low = words[1];
     return true;
 }
 
-inline bool CDRMessage::readSequenceNumberSet(CDRMessage_t* msg,SequenceNumberSet_t* sns)
+inline bool CDRMessage::readNumberSetBitmap(CDRMessage_t* msg, NumberSetBitmap* bitmap)
 {
-    bool valid = true;
-    valid &=CDRMessage::readSequenceNumber(msg,&sns->base);
     uint32_t numBits;
-    valid &=CDRMessage::readUInt32(msg,&numBits);
-    int32_t bitmap;
-    SequenceNumber_t seqNum;
-    for(uint32_t i=0;i<(numBits+31)/32;++i)
-    {
-        valid &= CDRMessage::readInt32(msg,&bitmap);
-        for(uint8_t bit=0;bit<32;++bit)
-        {
-            if((bitmap & (1<<(31-bit%32)))==(1<<(31-bit%32)))
-            {
-                seqNum = sns->base+(i*32+bit);
-                if(!sns->add(seqNum))
-                {
-                    return false;
-                }
-            }
-        }
-    }
+    if(!CDRMessage::readUInt32(msg,&numBits) || numBits > NumberSetBitmap::max_bits)
+        return false;
+    bitmap->clear();
+    uint32_t n_longs = (numBits + 31) / 32;
+    uint32_t words[NumberSetBitmap::max_words];
+    if(!CDRMessage::readUInt32Array(msg, words, n_longs))
+        return false;
+    for(uint32_t i = 0; i < n_longs; ++i)
+        bitmap->word(i, words[i]);
+    // Bits beyond numBits are not part of the set.
+    if(numBits % 32 != 0)
+        bitmap->word(n_longs - 1, bitmap->word(n_longs - 1) & ~(0xFFFFFFFFu >> (numBits % 32)));
+    return true;
+}
+
+inline bool CDRMessage::readSequenceNumberSet(CDRMessage_t* msg,SequenceNumberSet_t* sns)
+{
+    bool valid = CDRMessage::readSequenceNumber(msg,&sns->base);
+    valid &= CDRMessage::readNumberSetBitmap(msg,&sns->get_bitmap());
     return valid;
 }
 
 inline bool CDRMessage::readFragmentNumberSet(CDRMessage_t* msg, FragmentNumberSet_t* fns)
 {
-    bool valid = true;
-    valid &= CDRMessage::readUInt32(msg, &fns->base);
-    uint32_t numBits;
-    valid &= CDRMessage::readUInt32(msg, &numBits);
-    int32_t bitmap;
-    FragmentNumber_t fragNum;
-    for (uint32_t i = 0; i<(numBits + 31) / 32; ++i)
-    {
-        valid &= CDRMessage::readInt32(msg, &bitmap);
-        for (uint8_t bit = 0; bit<32; ++bit)
-        {
-            if ((bitmap & (1 << (31 - bit % 32))) == (1 << (31 - bit % 32)))
-            {
-                fragNum = fns->base + (i * 32 + bit);
-                if (!fns->add(fragNum))
-                {
-                    return false;
-                }
-            }
-        }
-    }
+    bool valid = CDRMessage::readUInt32(msg, &fns->base);
+    valid &= CDRMessage::readNumberSetBitmap(msg, &fns->get_bitmap());
     return valid;
 }
 
 inline bool CDRMessage::readTimestamp(CDRMessage_t* msg, Time_t* ts)
 {
-    bool valid = true;
-    valid &=CDRMessage::readInt32(msg,&ts->seconds);
-    valid &=CDRMessage::readUInt32(msg,&ts->fraction);
-    return valid;
+    uint32_t words[2];
+    if(!readUInt32Array(msg, words, 2))
+        return false;
+    ts->seconds = (int32_t)words[0];
+    ts->fraction = words[1];
+    return true;
 }
 
 
@@ -194,45 +222,27 @@ inline bool CDRMessage::readLocator(CDRMessage_t* msg,Locator_t* loc)
 {
     if(msg->pos+24>msg->length)
         return false;
-    bool valid = readInt32(msg,&loc->kind);
-    valid&=readUInt32(msg,&loc->port);
-
-    valid&=readData(msg,loc->address,16);
+    uint32_t words[2];
+    if(!readUInt32Array(msg, words, 2))
+        return false;
+    loc->kind = (int32_t)words[0];
+    loc->port = words[1];
 
-    return valid;
+    return readData(msg,loc->address,16);
 }
 
 inline bool CDRMessage::readInt16(CDRMessage_t* msg,int16_t* i16)
 {
-    if(msg->pos+2>msg->length)
-        return false;
-    octet* o = (octet*)i16;
-    if(msg->msg_endian == DEFAULT_ENDIAN)
-    {
-        *o = msg->buffer[msg->pos];
-        *(o+1) = msg->buffer[msg->pos+1];
-    }
-    else{
-        *o = msg->buffer[msg->pos+1];
-        *(o+1) = msg->buffer[msg->pos];
-    }
-    msg->pos+=2;
-    return true;
+    return readUInt16(msg, (uint16_t*)i16);
 }
 
 inline bool CDRMessage::readUInt16(CDRMessage_t* msg,uint16_t* i16)
 {
     if(msg->pos+2>msg->length)
         return false;
-    octet* o = (octet*)i16;
-    if(msg->msg_endian == DEFAULT_ENDIAN){
-        *o = msg->buffer[msg->pos];
-        *(o+1) = msg->buffer[msg->pos+1];
-    }
-    else{
-        *o = msg->buffer[msg->pos+1];
-        *(o+1) = msg->buffer[msg->pos];
-    }
+    uint16_t value;
+    memcpy(&value, &msg->buffer[msg->pos], 2);
+    *i16 = msg->msg_endian == DEFAULT_ENDIAN ? value : swapBytes(value);
     msg->pos+=2;
     return true;
 }
@@ -266,17 +276,11 @@ inline bool CDRMessage::readString(CDRMessage_t*msg, std::string* stri)
     valid&=CDRMessage::readUInt32(msg,&str_size);
     if(str_size>1)
     {
-        *stri = std::string();stri->resize(str_size-1);
-        octet* oc1 = (octet*)malloc(str_size);
-        valid &= CDRMessage::readData(msg,oc1,str_size);
-        for(uint32_t i =0;i<str_size-1;i++)
-            stri->at(i) = oc1[i];
-        free((void*)oc1);
-    }
-    else
-    {
-        msg->pos+=str_size;
+        if(msg->pos + str_size > msg->length)
+            return false;
+        stri->assign((const char*)&msg->buffer[msg->pos], str_size-1);
     }
+    msg->pos+=str_size;
     uint32_t rest = (uint32_t)(str_size-4*floor((float)str_size/4));
     rest = rest==0 ? 0 : 4-rest;
     msg->pos+=rest;
@@ -304,10 +308,7 @@ inline bool CDRMessage::addDataReversed(CDRMessage_t*msg, const octet *data, con
     {
         return false;
     }
-    for(uint32_t i = 0;i<length;i++)
-    {
-        msg->buffer[msg->pos+i] = *(data+length-1-i);
-    }
+    std::reverse_copy(data, data + length, msg->buffer + msg->pos);
     msg->pos +=length;
     msg->length+=length;
     return true;
@@ -332,17 +333,9 @@ inline bool CDRMessage::addUInt16(CDRMessage_t*msg,uint16_t us)
     {
         return false;
     }
-    octet* o= (octet*)&us;
-    if(msg->msg_endian == DEFAULT_ENDIAN)
-    {
-        msg->buffer[msg->pos] = *(o);
-        msg->buffer[msg->pos+1] = *(o+1);
-    }
-    else
-    {
-        msg->buffer[msg->pos] = *(o+1);
-        msg->buffer[msg->pos+1] = *(o);
-    }
+    if(msg->msg_endian != DEFAULT_ENDIAN)
+        us = swapBytes(us);
+    memcpy(&msg->buffer[msg->pos], &us, 2);
     msg->pos+=2;
     msg->length+=2;
     return true;
@@ -357,77 +350,57 @@ inline bool CDRMessage::addParameterId(CDRMessage_t* msg, ParameterId_t pid)
 
 
 inline bool CDRMessage::addInt32(CDRMessage_t* msg, int32_t lo) {
-    octet* o= (octet*)&lo;
+    return addUInt32(msg, (uint32_t)lo);
+}
+
+
+
+inline bool CDRMessage::addUInt32(CDRMessage_t* msg, uint32_t ulo) {
     if(msg->pos + 4 > msg->max_size)
     {
         return false;
     }
-    if(msg->msg_endian == DEFAULT_ENDIAN)
-    {
-        for(uint8_t i=0;i<4;i++)
-        {
-            msg->buffer[msg->pos+i] = *(o+i);
-        }
-    }
-    else
-    {
-        for(uint8_t i=0;i<4;i++)
-        {
-            msg->buffer[msg->pos+i] = *(o+3-i);
-        }
-    }
+    if(msg->msg_endian != DEFAULT_ENDIAN)
+        ulo = swapBytes(ulo);
+    memcpy(&msg->buffer[msg->pos], &ulo, 4);
     msg->pos+=4;
     msg->length+=4;
     return true;
 }
 
-
-
-inline bool CDRMessage::addUInt32(CDRMessage_t* msg, uint32_t ulo) {
-    octet* o= (octet*)&ulo;
-    if(msg->pos + 4 > msg->max_size)
+inline bool CDRMessage::addUInt32Array(CDRMessage_t* msg, const uint32_t* values, uint32_t count) {
+    if(msg->pos + 4 * count > msg->max_size)
     {
         return false;
     }
+    octet* dest = &msg->buffer[msg->pos];
     if(msg->msg_endian == DEFAULT_ENDIAN)
     {
-        for(uint8_t i=0;i<4;i++)
-        {
-            msg->buffer[msg->pos+i] = *(o+i);
-        }
+        memcpy(dest, values, 4 * count);
     }
     else
     {
-        for(uint8_t i=0;i<4;i++)
+        // Swapped in a local copy, as the position in the buffer may not be aligned for uint32_t.
+        for(uint32_t i = 0; i < count; ++i)
         {
-            msg->buffer[msg->pos+i] = *(o+3-i);
+            uint32_t value = swapBytes(values[i]);
+            memcpy(dest + 4 * i, &value, 4);
         }
     }
-    msg->pos+=4;
-    msg->length+=4;
+    msg->pos += 4 * count;
+    msg->length += 4 * count;
     return true;
 }
 
 inline bool CDRMessage::addInt64(CDRMessage_t* msg, int64_t lolo) {
-    octet* o= (octet*)&lolo;
     if(msg->pos + 8 > msg->max_size)
     {
         return false;
     }
-    if(msg->msg_endian == DEFAULT_ENDIAN)
-    {
-        for(uint8_t i=0;i<8;i++)
-        {
-            msg->buffer[msg->pos+i] = *(o+i);
-        }
-    }
-    else
-    {
-        for(uint8_t i=0;i<8;i++)
-        {
-            msg->buffer[msg->pos+i] = *(o+7-i);
-        }
-    }
+    uint64_t value = (uint64_t)lolo;
+    if(msg->msg_endian != DEFAULT_ENDIAN)
+        value = swapBytes(value);
+    memcpy(&msg->buffer[msg->pos], &value, 8);
     msg->pos+=8;
     msg->length+=8;
     return true;
@@ -463,11 +436,7 @@ inline bool CDRMessage::addEntityId(CDRMessage_t* msg, const EntityId_t*ID) {
     {
         return false;
     }
-    int* aux1;
-    int* aux2;
-    aux1 = (int*)(&msg->buffer[msg->pos]);
-    aux2 = (int*) ID->value;
-    *aux1 = *aux2;
+    memcpy(&msg->buffer[msg->pos], ID->value, 4);
     msg->pos +=4;
     msg->length+=4;
     return true;
@@ -480,56 +449,30 @@ inline bool CDRMessage::addEntityId(CDRMessage_t* msg, const EntityId_t*ID) {
 inline bool CDRMessage::addSequenceNumber(CDRMessage_t* msg,
         const SequenceNumber_t* sn)
 {
-    addInt32(msg,sn->high);
-    addUInt32(msg,sn->low);
+    uint32_t words[2] = {(uint32_t)sn->high, sn->low};
+    addUInt32Array(msg, words, 2);
 
     return true;
 }
 
+inline bool CDRMessage::addNumberSetBitmap(CDRMessage_t* msg,
+        const NumberSetBitmap* bitmap)
+{
+    uint32_t numBits = bitmap->numBits();
+    uint32_t n_longs = (numBits + 31) / 32;
+    uint32_t words[NumberSetBitmap::max_words];
+    for(uint32_t i = 0; i < n_longs; ++i)
+        words[i] = bitmap->word(i);
+    bool valid = addUInt32(msg, numBits);
+    valid &= addUInt32Array(msg, words, n_longs);
+    return valid;
+}
+
 inline bool CDRMessage::addSequenceNumberSet(CDRMessage_t* msg,
         SequenceNumberSet_t* sns)
 {
     CDRMessage::addSequenceNumber(msg, &sns->base);
-
-    //Add set
-    if(sns->isSetEmpty())
-    {
-        addUInt32(msg,0); //numbits 0
-        return true;
-    }
-
-    SequenceNumber_t maxseqNum = sns->get_maxSeqNum();
-
-    uint32_t numBits = (maxseqNum - sns->base + 1).low;
-    assert((maxseqNum - sns->base + 1).high == 0);
-
-    if(numBits >= 256)
-        numBits = 255;
-
-    addUInt32(msg, numBits);
-    uint8_t n_longs = (uint8_t)((numBits + 31) / 32);
-    int32_t* bitmap = new int32_t[n_longs];
-
-    for(uint32_t i = 0; i < n_longs; i++)
-        bitmap[i] = 0;
-
-    uint32_t deltaN = 0;
-    for(std::vector<SequenceNumber_t>::iterator it = sns->get_begin();
-            it != sns->get_end(); ++it)
-    {
-        deltaN = (*it - sns->base).low;
-        assert((*it - sns->base).high == 0);
-        if(deltaN < 256)
-            bitmap[(uint32_t)(deltaN/32)] = (bitmap[(uint32_t)(deltaN/32)] | (1<<(31-deltaN%32)));
-        else
-            break;
-    }
-
-    for(uint32_t i= 0;i<n_longs;i++)
-        addInt32(msg,bitmap[i]);
-
-    delete[] bitmap;
-    return true;
+    return CDRMessage::addNumberSetBitmap(msg, &sns->get_bitmap());
 }
 
 inline bool CDRMessage::addFragmentNumberSet(CDRMessage_t* msg,
@@ -539,48 +482,12 @@ inline bool CDRMessage::addFragmentNumberSet(CDRMessage_t* msg,
         return false;
 
     CDRMessage::addUInt32(msg, fns->base);
-
-    //Add set
-    if (fns->isSetEmpty())
-    {
-        addUInt32(msg, 0); //numbits 0
-        return true;
-    }
-
-    FragmentNumber_t maxfragNum = *(std::prev(fns->set.end()));
-
-    uint32_t numBits = (uint32_t)(maxfragNum - fns->base + 1);
-
-    if (numBits > 256)
-        return false;
-
-    addUInt32(msg, numBits);
-    uint8_t n_longs = (uint8_t)((numBits + 31) / 32);
-    int32_t* bitmap = new int32_t[n_longs];
-
-    for (uint32_t i = 0; i<n_longs; i++)
-        bitmap[i] = 0;
-
-    uint32_t deltaN = 0;
-
-    for (auto it = fns->get_begin();
-            it != fns->get_end(); ++it)
-    {
-        deltaN = (uint32_t)(*it - fns->base);
-        bitmap[(uint32_t)(deltaN / 32)] = (bitmap[(uint32_t)(deltaN / 32)] | (1 << (31 - deltaN % 32)));
-    }
-
-    for (uint32_t i = 0; i<n_longs; i++)
-        addInt32(msg, bitmap[i]);
-
-    delete[] bitmap;
-
-    return true;
+    return CDRMessage::addNumberSetBitmap(msg, &fns->get_bitmap());
 }
 
 inline bool CDRMessage::addLocator(CDRMessage_t* msg, Locator_t* loc) {
-    addInt32(msg,loc->kind);
-    addUInt32(msg,loc->port);
+    uint32_t words[2] = {(uint32_t)loc->kind, loc->port};
+    addUInt32Array(msg, words, 2);
 
     addData(msg,loc->address,16);
 
@@ -595,10 +502,8 @@ inline bool CDRMessage::addParameterStatus(CDRMessage_t* msg, octet status)
     }
     CDRMessage::addUInt16(msg,PID_STATUS_INFO);
     CDRMessage::addUInt16(msg,4);
-    CDRMessage::addOctet(msg,0);
-    CDRMessage::addOctet(msg,0);
-    CDRMessage::addOctet(msg,0);
-    CDRMessage::addOctet(msg,status);
+    octet flags[4] = {0, 0, 0, status};
+    CDRMessage::addData(msg,flags,4);
     return true;
 }
 
@@ -611,8 +516,7 @@ inline bool CDRMessage::addParameterKey(CDRMessage_t* msg, const InstanceHandle_
     }
     CDRMessage::addUInt16(msg,PID_KEY_HASH);
     CDRMessage::addUInt16(msg,16);
-    for(uint8_t i=0;i<16;i++)
-        msg->buffer[msg->pos+i] = iHandle->value[i];
+    memcpy(&msg->buffer[msg->pos], iHandle->value, 16);
     msg->pos+=16;
     msg->length+=16;
     return true;
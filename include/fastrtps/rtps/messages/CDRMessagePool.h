@@ -33,14 +33,18 @@ namespace fastrtps{
 namespace rtps {
 
 /**
+ * Pool of CDRMessage_t buffers.
+ * Each thread keeps a small cache of released messages, so reserving and releasing a message
+ * usually does not take the pool mutex.
 *@ingroup COMMON_MODULE
 */
 class CDRMessagePool {
 public:
 	/**
 	* @param defaultGroupSize Number of messages per allocated group.
+	* @param messageSize Size in bytes of the buffer of each message.
 	*/
-	CDRMessagePool(uint32_t defaultGroupSize);
+	CDRMessagePool(uint32_t defaultGroupSize, uint32_t messageSize = RTPSMESSAGE_DEFAULT_SIZE);
 	virtual ~CDRMessagePool();
 	
 	//!
@@ -55,13 +59,25 @@ public:
 	* @param obj
 	*/
 	void release_CDRMsg(CDRMessage_t& obj);
+
+	//! Size in bytes of the buffer of the messages created by this pool.
+	uint32_t getMessageSize() const { return m_message_size; }
+
+	//! Return to the pool the messages cached by the calling thread.
+	void flushThreadCache();
 protected:
 	std::vector<CDRMessage_t*> m_free_objects;
 	std::vector<CDRMessage_t*> m_all_objects;
 	uint16_t m_group_size;
+	uint32_t m_message_size;
+	//! Unique identifier of this pool, used to tag the messages kept in the thread caches.
+	uint64_t m_id;
 	void allocateGroup();
 	void allocateGroup(uint16_t payload);
+	void release_to_pool(CDRMessage_t** objs, size_t count);
     boost::mutex *mutex_;
+
+    friend struct CDRMessageThreadCache;
 };
 
 
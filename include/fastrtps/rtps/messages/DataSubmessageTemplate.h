@@ -0,0 +1,121 @@
+// Copyright 2016 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file DataSubmessageTemplate.h
+ */
+
+#ifndef DATASUBMESSAGETEMPLATE_H_
+#define DATASUBMESSAGETEMPLATE_H_
+#ifndef DOXYGEN_SHOULD_SKIP_THIS_PUBLIC
+
+#include "../common/CDRMessage_t.h"
+#include "../common/Guid.h"
+#include "../common/Types.h"
+#include "CDRMessage.h"
+#include "RTPS_messages.h"
+
+#include <cstring>
+
+namespace eprosima {
+namespace fastrtps{
+namespace rtps {
+
+/**
+ * DATA submessage header precomputed for a writer, a destination reader and an inline QoS mode.
+ * The submessage id, the extra flags, the octets to inline QoS and both entity ids never change
+ * for that combination, so a DATA is built copying the template and patching its flags,
+ * length and sequence number. The template is written in the byte order of the host, as every
+ * message created by RTPSMessageCreator.
+ * @ingroup WRITER_MODULE
+ */
+class DataSubmessageTemplate_t
+{
+public:
+	//! Bytes of the template: submessage header, extra flags, octets to inline QoS, entity ids and sequence number.
+	static const uint32_t size = 24;
+	//! Offset of the flags in the template.
+	static const uint32_t flags_offset = 1;
+	//! Offset of the submessage length in the template.
+	static const uint32_t length_offset = 2;
+	//! Offset of the sequence number in the template.
+	static const uint32_t sequence_number_offset = 16;
+
+	DataSubmessageTemplate_t():
+		m_topicKind(NO_KEY),
+		m_expectsInlineQos(false)
+	{
+		memset(m_header, 0, size);
+	}
+
+	/**
+	 * Build the template.
+	 * @param writerId Entity id of the writer.
+	 * @param readerId Entity id of the destination reader.
+	 * @param topicKind Kind of the topic of the writer.
+	 * @param expectsInlineQos Whether the destination reader expects the inline QoS.
+	 */
+	void init(const EntityId_t& writerId, const EntityId_t& readerId, TopicKind_t topicKind, bool expectsInlineQos)
+	{
+		m_readerId = readerId;
+		m_topicKind = topicKind;
+		m_expectsInlineQos = expectsInlineQos;
+
+		CDRMessage_t msg(0);
+		msg.wraps = true;
+		msg.buffer = m_header;
+		msg.max_size = size;
+#if EPROSIMA_BIG_ENDIAN
+		msg.msg_endian = BIGEND;
+		octet flags = 0x0;
+#else
+		msg.msg_endian = LITTLEEND;
+		octet flags = BIT(0);
+#endif
+		CDRMessage::addOctet(&msg, DATA);
+		CDRMessage::addOctet(&msg, flags);
+		CDRMessage::addUInt16(&msg, 0); // Submessage length, patched per change.
+		CDRMessage::addUInt16(&msg, 0); // Extra flags, not in this version.
+		CDRMessage::addUInt16(&msg, RTPSMESSAGE_OCTETSTOINLINEQOS_DATASUBMSG);
+		CDRMessage::addEntityId(&msg, &readerId);
+		CDRMessage::addEntityId(&msg, &writerId);
+		// The sequence number is patched per change.
+	}
+
+	//! Reports whether this template was built for the given destination reader and inline QoS mode.
+	bool matches(const EntityId_t& readerId, bool expectsInlineQos) const
+	{
+		return m_expectsInlineQos == expectsInlineQos && m_readerId == readerId;
+	}
+
+	//! Constant bytes of the header.
+	const octet* header() const { return m_header; }
+
+	TopicKind_t topicKind() const { return m_topicKind; }
+
+	bool expectsInlineQos() const { return m_expectsInlineQos; }
+
+private:
+	octet m_header[size];
+	EntityId_t m_readerId;
+	TopicKind_t m_topicKind;
+	bool m_expectsInlineQos;
+};
+
+}
+} /* namespace rtps */
+} /* namespace eprosima */
+
+#endif
+#endif /* DATASUBMESSAGETEMPLATE_H_ */
@@ -46,9 +46,8 @@ struct SubmessageHeader_t;
 class MessageReceiver {
 public:
 	/**
-	* @param rec_buffer_size
+	* The received messages are not owned by the receiver. They are passed to processCDRMsg.
 	*/
-	MessageReceiver(uint32_t rec_buffer_size);
 	MessageReceiver();
 	virtual ~MessageReceiver();
 	//!Reset the MessageReceiver to process a new message.
@@ -70,10 +69,6 @@ public:
 
 	//!Pointer to the Listen Resource that contains this MessageReceiver.
 
-	//!Received message
-	CDRMessage_t m_rec_msg;
-	//!PArameter list
-	ParameterList_t m_ParamList;
 	// Functions to associate/remove associatedendpoints
 	void associateEndpoint(Endpoint *to_add);
 	void removeEndpoint(Endpoint *to_remove);
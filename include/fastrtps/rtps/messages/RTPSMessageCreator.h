@@ -36,6 +36,8 @@ class ParameterList_t;
 
 namespace rtps{
 
+class DataSubmessageTemplate_t;
+
 /**
  * @brief Class RTPSMessageCreator, allows the generation of serialized CDR RTPS Messages.
  * @ingroup MANAGEMENT_MODULE
@@ -96,6 +98,16 @@ public:
 			TopicKind_t topicKind, const EntityId_t& readerId, bool expectsInlineQos, ParameterList_t* inlineQos);
 	static bool addSubmessageData(CDRMessage_t* msg, const CacheChange_t* change,
 			TopicKind_t topicKind, const EntityId_t& readerId, bool expectsInlineQos, ParameterList_t* inlineQos);
+	/**
+	 * Create a DATA submessage from a precomputed template, writing it directly in the message.
+	 * Only the flags, the length and the sequence number are computed for the change.
+	 * @param[out] msg Pointer to the message where the submessage is added.
+	 * @param[in] change Change to send.
+	 * @param[in] dataTemplate Template of the writer for the destination reader.
+	 * @return True if correct. False if the submessage does not fit, leaving the message unchanged.
+	 */
+	static bool addSubmessageData(CDRMessage_t* msg, const CacheChange_t* change,
+			const DataSubmessageTemplate_t& dataTemplate);
 
 	static bool addMessageDataFrag(CDRMessage_t* msg, GuidPrefix_t& guidprefix, const CacheChange_t* change, uint32_t fragment_number,
 		TopicKind_t topicKind, const EntityId_t& readerId, bool expectsInlineQos, ParameterList_t* inlineQos);
@@ -22,8 +22,10 @@
 #ifndef DOXYGEN_SHOULD_SKIP_THIS_PUBLIC
 
 #include "../common/CDRMessage_t.h"
+#include "CDRMessagePool.h"
 #include "../../qos/ParameterList.h"
 #include <fastrtps/rtps/common/FragmentNumber.h>
+#include <fastrtps/rtps/common/Time_t.h>
 
 #include <vector>
 #include <cassert>
@@ -40,8 +42,7 @@ namespace eprosima {
                    change_(change)
                 {
                     fragments_cleared_for_sending_.base = 0;
-                    for (uint32_t i = 1; i != change->getFragmentCount() + 1; i++)
-                       fragments_cleared_for_sending_.add(i); // Indexed on 1
+                    fragments_cleared_for_sending_.addRange(1, change->getFragmentCount()); // Indexed on 1
 
                 }
 
@@ -84,6 +85,12 @@ namespace eprosima {
                     fragments_cleared_for_sending_ = fragments;
                 }
 
+                //! Removes a fragment from the ones cleared for sending, once it is in a message.
+                void fragmentSent(FragmentNumber_t fragment)
+                {
+                    fragments_cleared_for_sending_.remove(fragment);
+                }
+
                 private:
                     const CacheChange_t* change_;
 
@@ -92,17 +99,57 @@ namespace eprosima {
 
             /**
              * Class RTPSMessageGroup_t that contains the messages used to send multiples changes as one message.
+             * The submessage and full message buffers are reserved from a pool while the group exists.
+             * All the messages sent with a group carry the same source timestamp, taken when it is first needed.
              * @ingroup WRITER_MODULE
              */
             class RTPSMessageGroup_t{
                 public:
-                    CDRMessage_t m_rtpsmsg_header;
-                    CDRMessage_t m_rtpsmsg_submessage;
-                    CDRMessage_t m_rtpsmsg_fullmsg;
-                    RTPSMessageGroup_t(uint32_t payload):
-                        m_rtpsmsg_header(RTPSMESSAGE_HEADER_SIZE),
-                        m_rtpsmsg_submessage(payload),
-                        m_rtpsmsg_fullmsg(payload){};
+                    /**
+                     * @param pool Pool the message buffers are reserved from.
+                     * @param header Message holding the RTPS header of the writer.
+                     * @param payload Maximum size of the messages built with this group.
+                     */
+                    RTPSMessageGroup_t(CDRMessagePool& pool, CDRMessage_t& header, uint32_t payload):
+                        m_rtpsmsg_header(header),
+                        m_rtpsmsg_submessage(pool.reserve_CDRMsg()),
+                        m_rtpsmsg_fullmsg(pool.reserve_CDRMsg()),
+                        pool_(pool),
+                        submessage_max_size_(m_rtpsmsg_submessage.max_size),
+                        fullmsg_max_size_(m_rtpsmsg_fullmsg.max_size),
+                        has_timestamp_(false)
+                    {
+                        // Pooled buffers can be bigger than what this writer is allowed to send.
+                        if(payload < m_rtpsmsg_submessage.max_size)
+                            m_rtpsmsg_submessage.max_size = payload;
+                        if(payload < m_rtpsmsg_fullmsg.max_size)
+                            m_rtpsmsg_fullmsg.max_size = payload;
+                    }
+
+                    ~RTPSMessageGroup_t()
+                    {
+                        m_rtpsmsg_submessage.max_size = submessage_max_size_;
+                        m_rtpsmsg_fullmsg.max_size = fullmsg_max_size_;
+                        pool_.release_CDRMsg(m_rtpsmsg_fullmsg);
+                        pool_.release_CDRMsg(m_rtpsmsg_submessage);
+                    }
+
+                    CDRMessage_t& m_rtpsmsg_header;
+                    CDRMessage_t& m_rtpsmsg_submessage;
+                    CDRMessage_t& m_rtpsmsg_fullmsg;
+
+                    //! Source timestamp of the messages of this group.
+                    Time_t& timestamp();
+
+                private:
+                    RTPSMessageGroup_t(const RTPSMessageGroup_t&) = delete;
+                    RTPSMessageGroup_t& operator=(const RTPSMessageGroup_t&) = delete;
+
+                    CDRMessagePool& pool_;
+                    uint32_t submessage_max_size_;
+                    uint32_t fullmsg_max_size_;
+                    Time_t timestamp_;
+                    bool has_timestamp_;
             };
 
             class RTPSWriter;
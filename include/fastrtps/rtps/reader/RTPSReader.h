@@ -162,6 +162,17 @@ namespace eprosima
                  */
                 RTPS_DllAPI virtual bool nextUntakenCache(CacheChange_t** change, WriterProxy** wp) = 0;
 
+                /**
+                 * Get several CacheChange_t from the history to take, in the order nextUntakenCache would
+                 * return them if each one were removed before getting the next.
+                 * @param changes Vector where the changes are appended.
+                 * @param wps Vector where the WriterProxy of each change is appended, nullptr if there is none.
+                 * @param max Maximum number of changes to get.
+                 * @return Number of changes appended.
+                 */
+                RTPS_DllAPI virtual size_t nextUntakenCaches(std::vector<CacheChange_t*>& changes,
+                        std::vector<WriterProxy*>& wps, size_t max) = 0;
+
                 /**
                  * @return True if the reader expects Inline QOS.
                  */
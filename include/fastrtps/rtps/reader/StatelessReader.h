@@ -123,6 +123,15 @@ public:
 	 */
 	bool nextUntakenCache(CacheChange_t** change,WriterProxy** wpout=nullptr);
 
+	/**
+	 * Get several CacheChange_t from the history to take.
+	 * @param changes Vector where the changes are appended.
+	 * @param wps Vector where the matched writer proxy of each change is appended.
+	 * @param max Maximum number of changes to get.
+	 * @return Number of changes appended.
+	 */
+	size_t nextUntakenCaches(std::vector<CacheChange_t*>& changes, std::vector<WriterProxy*>& wps, size_t max);
+
 	/**
 	 * Get the number of matched writers
 	 * @return Number of matched writers
@@ -54,8 +54,6 @@ public:
 	
 	//!Pointer to the WriterProxy associated with this specific event.
 	WriterProxy* mp_WP;
-	//!CDRMessage_t used in the response.
-	CDRMessage_t m_heartbeat_response_msg;
 
 };
 }
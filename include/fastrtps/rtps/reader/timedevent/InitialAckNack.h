@@ -56,8 +56,6 @@ public:
 	void event(EventCode code, const char* msg= nullptr);
 
 	//!
-	CDRMessage_t initial_acknack_msg_;
-	//!
     WriterProxy* wp_;
 };
 
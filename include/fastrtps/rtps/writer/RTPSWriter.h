@@ -21,17 +21,26 @@
 
 #include "../Endpoint.h"
 #include "../messages/RTPSMessageGroup.h"
+#include "../messages/DataSubmessageTemplate.h"
+#include "../common/BatchingStatistics.h"
 #include "../attributes/WriterAttributes.h"
 #include "../flowcontrol/FlowController.h"
 #include <vector>
 #include <memory>
 
+namespace boost
+{
+    class mutex;
+    class condition_variable;
+}
+
 namespace eprosima {
 namespace fastrtps{
 namespace rtps {
 
 class WriterListener;
 class WriterHistory;
+class BatchFlushDelay;
 struct CacheChange_t;
 
 
@@ -44,6 +53,7 @@ class RTPSWriter : public Endpoint
     friend class WriterHistory;
     friend class RTPSParticipantImpl;
     friend class RTPSMessageGroup;
+    friend class BatchFlushDelay;
     protected:
     RTPSWriter(RTPSParticipantImpl*,GUID_t& guid,WriterAttributes& att,WriterHistory* hist,WriterListener* listen=nullptr);
     virtual ~RTPSWriter();
@@ -66,6 +76,18 @@ class RTPSWriter : public Endpoint
     RTPS_DllAPI CacheChange_t* new_change(const std::function<uint32_t()>& dataCdrSerializedSize,
             ChangeKind_t changeKind, InstanceHandle_t handle = c_InstanceHandle_Unknown);
 
+    /**
+     * Create several new changes at once, reserving them from the history pool in one operation.
+     * The instance handle of the changes of keyed writers has to be set by the caller.
+     * @param[out] changes Vector where the new changes are appended.
+     * @param count Number of changes to create.
+     * @param dataCdrSerializedSize Function returning the serialized size of the data of the change with the given index.
+     * @param changeKind The type of the changes.
+     * @return True if all the changes were created. In other case none is.
+     */
+    RTPS_DllAPI bool new_changes(std::vector<CacheChange_t*>& changes, size_t count,
+            const std::function<uint32_t(size_t)>& dataCdrSerializedSize, ChangeKind_t changeKind);
+
     /**
      * Add a matched reader.
      * @param ratt Pointer to the ReaderProxyData object added.
@@ -161,12 +183,27 @@ class RTPSWriter : public Endpoint
      */
     virtual void add_flow_controller(std::unique_ptr<FlowController> controller) = 0;
 
+    /**
+     * Send the changes waiting in the batch, if any.
+     * Must be called without the writer mutex locked.
+     * @return Number of changes sent.
+     */
+    RTPS_DllAPI size_t flush();
+
+    /**
+     * Get the statistics of the batches sent by this writer.
+     * @return Copy of the statistics.
+     */
+    RTPS_DllAPI BatchingStatistics getBatchingStatistics();
+
     protected:
 
     //!Is the data sent directly or announced by HB and THEN send to the ones who ask for it?.
     bool m_pushMode;
-    //!Group created to send messages more efficiently
-    RTPSMessageGroup_t m_cdrmessages;
+    //!Message holding the RTPS header prepended to every message sent by this writer
+    CDRMessage_t m_cdrmessage_header;
+    //!Maximum size of the messages sent by this writer
+    uint32_t m_max_message_size;
     //!INdicates if the liveliness has been asserted
     bool m_livelinessAsserted;
     //!WriterHistory
@@ -175,11 +212,116 @@ class RTPSWriter : public Endpoint
     WriterListener* mp_listener;
     //Asynchronout publication activated
     bool is_async_;
+    //!Templates of the DATA submessages sent by this writer, one per destination reader and inline QoS mode
+    std::vector<DataSubmessageTemplate_t> m_dataTemplates;
+    //!Template replaced next when all the templates are in use
+    size_t m_nextDataTemplate;
+    //!Batching configuration
+    BatchingDescriptor m_batching;
+    //!Changes written and waiting to be sent in the next batch
+    std::vector<CacheChangeForGroup_t> m_batch;
+    //!Estimated bytes of the DATA submessages of the changes in the batch
+    uint32_t m_batchBytes;
+    //!Event sending the batch when its delay expires
+    BatchFlushDelay* mp_batchFlushDelay;
+    //!Statistics of the batches sent
+    BatchingStatistics m_batchingStatistics;
+    //!Changes of a synchronous writer already given to the readers and waiting to be sent, in order
+    std::vector<CacheChangeForGroup_t> m_pendingChanges;
+    //!Changes being sent without the writer mutex, with the send turn of their group
+    std::vector<std::pair<const CacheChange_t*, uint64_t>> m_changesInFlight;
+    //!Turn given to the next group of pending changes taken to be sent
+    uint64_t m_nextSendTurn;
+    //!Turn of the group of changes allowed to be sent
+    uint64_t m_sendTurn;
+    //!Mutex protecting the send turn and the DATA templates
+    boost::mutex* mp_sendMutex;
+    //!Condition notified when the send turn advances
+    boost::condition_variable* mp_sendTurnCond;
     /**
      * Initialize the header of hte CDRMessages.
      */
     void init_header();
 
+    /**
+     * Get the template of the DATA submessages for a destination reader, building it the first time.
+     * Can be called without the writer mutex locked, while the pending changes are sent.
+     * @param readerId Entity id of the destination reader.
+     * @param expectsInlineQos Whether the destination reader expects the inline QoS.
+     * @return Copy of the template.
+     */
+    DataSubmessageTemplate_t getDataTemplate(const EntityId_t& readerId, bool expectsInlineQos);
+
+    /**
+     * Add a change to the batch, moving the batch to the pending changes if the change fills it.
+     * Must be called with the writer mutex locked.
+     * @param change Pointer to the change.
+     * @return True if the change was batched, false if batching is disabled or the change is fragmented,
+     * and it has to be added to the pending changes right away.
+     */
+    bool add_to_batch(CacheChange_t* change);
+
+    /**
+     * Remove a change from the batch, without sending it.
+     * Must be called with the writer mutex locked.
+     * @param change Pointer to the change.
+     */
+    void remove_from_batch(const CacheChange_t* change);
+
+    /**
+     * Move the changes in the batch to the pending changes. Must be called with the writer mutex locked.
+     * @param reason Reason recorded in the statistics.
+     * @return Number of changes moved.
+     */
+    size_t flush_batch(BatchingStatistics::FlushReason reason);
+
+    /**
+     * Remove a change from the pending changes, without sending it.
+     * Must be called with the writer mutex locked.
+     * @param change Pointer to the change.
+     */
+    void remove_from_pending(const CacheChange_t* change);
+
+    /**
+     * Send the pending changes to all the matched readers, in as few messages as possible.
+     * The writer mutex is only locked to take the changes, so the other threads writing on this writer
+     * are not blocked by the network. Groups of changes are sent in the order they were taken.
+     * Should be called without the writer mutex locked.
+     * @return Number of changes sent.
+     */
+    size_t send_pending_changes();
+
+    /**
+     * Wait until a change is sent, if it is being sent, so it can be released.
+     * Must be called with the writer mutex locked. The sending threads do not lock it until their turn ends,
+     * so waiting with it locked is safe.
+     * @param change Pointer to the change.
+     */
+    void wait_until_sent(const CacheChange_t* change);
+
+    /**
+     * Destroy the event of the batch delay. Called by the child destructors, before the writer is torn down.
+     */
+    void destroy_batch_flush_delay();
+
+    /**
+     * Get the destinations of the pending changes, before they are sent.
+     * Must be called with the writer mutex locked.
+     * @param[out] unicast Unicast locators of the destinations.
+     * @param[out] multicast Multicast locators of the destinations.
+     * @param[out] readerId Entity id of the destination reader, unknown for several readers.
+     * @param[out] expectsInlineQos Whether any destination expects the inline QoS.
+     * @return False if there is no destination, and the changes are not sent.
+     */
+    virtual bool prepare_pending_send(LocatorList_t& unicast, LocatorList_t& multicast,
+            EntityId_t& readerId, bool& expectsInlineQos) = 0;
+
+    /**
+     * Add a group of changes to the unsent list, sending them together.
+     * @param changes Changes to add.
+     */
+    virtual void unsent_changes_added_to_history(const std::vector<CacheChange_t*>& changes)=0;
+
     /**
      * Add a change to the unsent list.
      * @param change Pointer to the change to add.
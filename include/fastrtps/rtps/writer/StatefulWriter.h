@@ -67,6 +67,9 @@ namespace eprosima
                 size_t m_readers_to_walk;
                 bool wrap_around_readers();
 
+                //!Add changes to all the ReaderProxies and, in synchronous mode, batch them or leave them pending.
+                void add_unsent_changes(CacheChange_t* const* changes, size_t count);
+
                 //! Vector containin all the associated ReaderProxies.
                 std::vector<ReaderProxy*> matched_readers;
                 //!EntityId used to send the HB.(only for builtin types performance)
@@ -83,6 +86,11 @@ namespace eprosima
                  * @param p Pointer to the change.
                  */
                 void unsent_change_added_to_history(CacheChange_t* p);
+                /**
+                 * Add a group of changes to all ReaderLocators, sending them together.
+                 * @param changes Changes to add.
+                 */
+                void unsent_changes_added_to_history(const std::vector<CacheChange_t*>& changes);
                 /**
                  * Indicate the writer that a change has been removed by the history due to some HistoryQos requirement.
                  * @param a_change Pointer to the change that is going to be removed.
@@ -94,6 +102,17 @@ namespace eprosima
                  */
                 size_t send_any_unsent_changes();
 
+                /**
+                 * Get the matched readers as the destinations of the pending changes, restarting the heartbeat.
+                 * @param[out] unicast Unicast locators of the destinations.
+                 * @param[out] multicast Multicast locators of the destinations.
+                 * @param[out] readerId Entity id of the destination reader.
+                 * @param[out] expectsInlineQos Whether any destination expects the inline QoS.
+                 * @return False if there is no matched reader.
+                 */
+                bool prepare_pending_send(LocatorList_t& unicast, LocatorList_t& multicast,
+                        EntityId_t& readerId, bool& expectsInlineQos);
+
                 //!Increment the HB count.
                 inline void incrementHBCount(){ ++m_heartbeatCount; };
                 /**
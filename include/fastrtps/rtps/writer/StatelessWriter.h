@@ -48,6 +48,11 @@ class StatelessWriter : public RTPSWriter
      * @param p Pointer to the change.
      */
     void unsent_change_added_to_history(CacheChange_t* p);
+    /**
+     * Add a group of changes to all ReaderLocators, sending them together.
+     * @param changes Changes to add.
+     */
+    void unsent_changes_added_to_history(const std::vector<CacheChange_t*>& changes);
     /**
      * Indicate the writer that a change has been removed by the history due to some HistoryQos requirement.
      * @param a_change Pointer to the change that is going to be removed.
@@ -77,6 +82,17 @@ class StatelessWriter : public RTPSWriter
      */
     size_t send_any_unsent_changes();
 
+    /**
+     * Get the reader locators as the destinations of the pending changes.
+     * @param[out] unicast Unicast locators of the destinations.
+     * @param[out] multicast Multicast locators of the destinations.
+     * @param[out] readerId Entity id of the destination reader.
+     * @param[out] expectsInlineQos Whether any destination expects the inline QoS.
+     * @return False if there is no reader locator.
+     */
+    bool prepare_pending_send(LocatorList_t& unicast, LocatorList_t& multicast,
+            EntityId_t& readerId, bool& expectsInlineQos);
+
     /**
      * Update the Attributes of the Writer.
      * @param att New attributes
@@ -126,6 +142,9 @@ class StatelessWriter : public RTPSWriter
     std::vector<RemoteReaderAttributes> m_matched_readers;
     std::vector<std::unique_ptr<FlowController> > m_controllers;
 
+    //!Batch the changes or leave them pending in synchronous mode, or queue them for the asynchronous thread.
+    void add_unsent_changes(CacheChange_t* const* changes, size_t count);
+
     /**
      * Vector containing pointers to the unsent changes from this writer.
      * it's crucial to notify the async writer
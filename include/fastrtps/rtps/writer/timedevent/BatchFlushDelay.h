@@ -0,0 +1,62 @@
+// Copyright 2016 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file BatchFlushDelay.h
+ *
+ */
+
+#ifndef BATCHFLUSHDELAY_H_
+#define BATCHFLUSHDELAY_H_
+#ifndef DOXYGEN_SHOULD_SKIP_THIS_PUBLIC
+#include "../../resources/TimedEvent.h"
+
+namespace eprosima {
+namespace fastrtps{
+namespace rtps{
+
+class RTPSWriter;
+
+
+/**
+ * BatchFlushDelay class, sends the batch of a writer when its first change has waited the maximum delay.
+ * @ingroup WRITER_MODULE
+ */
+class BatchFlushDelay: public TimedEvent {
+public:
+	/**
+	*
+	* @param writer Writer owning the batch.
+	* @param interval Maximum delay of the batch, in milliseconds.
+	*/
+	BatchFlushDelay(RTPSWriter* writer,double interval);
+	virtual ~BatchFlushDelay();
+
+	/**
+	* Method invoked when the event occurs
+	*
+	* @param code Code representing the status of the event
+	* @param msg Message associated to the event
+	*/
+	void event(EventCode code, const char* msg= nullptr);
+
+	//!Writer owning the batch
+	RTPSWriter* mp_writer;
+};
+
+}
+}
+} /* namespace eprosima */
+#endif
+#endif /* BATCHFLUSHDELAY_H_ */
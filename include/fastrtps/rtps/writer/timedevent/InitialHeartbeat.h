@@ -55,8 +55,6 @@ public:
 	void event(EventCode code, const char* msg= nullptr);
 
 	//!
-	CDRMessage_t initial_hb_msg_;
-	//!
     ReaderProxy* rp_;
 };
 
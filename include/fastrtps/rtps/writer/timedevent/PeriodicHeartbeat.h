@@ -52,8 +52,6 @@ public:
 	*/
 	void event(EventCode code, const char* msg= nullptr);
 
-	//!
-	CDRMessage_t m_periodic_hb_msg;
 	//!
 	StatefulWriter* mp_SFW;
 };
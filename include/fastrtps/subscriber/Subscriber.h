@@ -23,11 +23,20 @@
 #include "../rtps/common/Guid.h"
 #include "../attributes/SubscriberAttributes.h"
 
+#include <vector>
+#include <functional>
+#include <type_traits>
+
 using namespace eprosima::fastrtps::rtps;
 
 namespace eprosima {
 namespace fastrtps{
 
+namespace rtps
+{
+struct SerializedPayload_t;
+}
+
 class SubscriberImpl;
 class SampleInfo_t;
 
@@ -74,6 +83,41 @@ public:
 	 */
 	bool takeNextData(void* data,SampleInfo_t* info);
 
+	/**
+	 * Take several samples at once. The history is locked once and the samples are removed from it together.
+	 * The samples are deserialized into the elements of data from the first one. The elements already there
+	 * are reused and data grows when more samples are taken, so an empty vector can be passed. When T is not
+	 * default constructible data cannot grow, and at most data.size() samples are taken.
+	 * @param[in,out] data Objects where the samples are stored, from the first one.
+	 * @param[out] infos SampleInfo_t of each sample taken. It is cleared first.
+	 * @param max Maximum number of samples to take.
+	 * @return Number of samples taken. data[i] is only valid when infos[i].sampleKind is ALIVE.
+	 */
+	template<typename T>
+	size_t take(std::vector<T>& data, std::vector<SampleInfo_t>& infos, size_t max)
+	{
+		return take(data, infos, max, std::is_default_constructible<T>());
+	}
+
+	/**
+	 * Take several samples without copying them. Each sample is lent as the payload received, which stays
+	 * reserved by the Subscriber until it is returned, so it can be used without blocking the reception.
+	 * For plain types (TopicDataType::isPlain) the data of a payload with the encapsulation of the host
+	 * is the sample itself. The payloads must be returned before removing the Subscriber.
+	 * @param[out] payloads Vector where the payloads of the samples are appended.
+	 * @param[out] infos Vector where the SampleInfo_t of each sample is appended.
+	 * @param max Maximum number of samples to take.
+	 * @return Number of samples taken.
+	 */
+	size_t take_loan(std::vector<const SerializedPayload_t*>& payloads, std::vector<SampleInfo_t>& infos, size_t max);
+
+	/**
+	 * Return the payloads obtained with take_loan. The vector is cleared.
+	 * @param payloads Payloads to return.
+	 * @return True if all the payloads were loaned by this Subscriber.
+	 */
+	bool return_loan(std::vector<const SerializedPayload_t*>& payloads);
+
 
 	/**
 	 * Update the Attributes of the subscriber;
@@ -97,6 +141,25 @@ public:
     bool isInCleanState() const;
 
 private:
+	template<typename T>
+	size_t take(std::vector<T>& data, std::vector<SampleInfo_t>& infos, size_t max, std::true_type)
+	{
+		return take_samples([&data](size_t i) -> void* {
+				if(i == data.size())
+					data.resize(i + 1);
+				return &data[i];
+				}, infos, max);
+	}
+
+	template<typename T>
+	size_t take(std::vector<T>& data, std::vector<SampleInfo_t>& infos, size_t max, std::false_type)
+	{
+		return take_samples([&data](size_t i) -> void* { return &data[i]; }, infos,
+				max < data.size() ? max : data.size());
+	}
+
+	size_t take_samples(const std::function<void*(size_t)>& data, std::vector<SampleInfo_t>& infos, size_t max);
+
 	SubscriberImpl* mp_impl;
 };
 
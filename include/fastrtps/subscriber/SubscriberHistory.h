@@ -24,8 +24,13 @@
 #include <fastrtps/rtps/resources/ResourceManagement.h>
 #include "../rtps/history/ReaderHistory.h"
 #include "../qos/QosPolicies.h"
+#include "../utils/RingBuffer.h"
 #include "SampleInfo.h"
 
+#include <unordered_map>
+#include <vector>
+#include <functional>
+
 using namespace eprosima::fastrtps::rtps;
 
 namespace eprosima {
@@ -44,8 +49,12 @@ class SubscriberImpl;
  */
 class SubscriberHistory: public ReaderHistory {
 public:
-	typedef std::pair<InstanceHandle_t,std::vector<CacheChange_t*>> t_p_I_Change;
-	typedef std::vector<t_p_I_Change> t_v_Inst_Caches;
+	//!Changes of one instance, ordered by sequence number.
+	typedef RingBuffer<CacheChange_t*> t_Inst_Changes;
+	typedef std::unordered_map<InstanceHandle_t, t_Inst_Changes, InstanceHandleHash> t_m_Inst_Caches;
+	//!Changes of one writer, ordered by sequence number.
+	typedef RingBuffer<CacheChange_t*> t_Writer_Changes;
+	typedef std::unordered_map<GUID_t, t_Writer_Changes, GUIDHash> t_m_Writer_Caches;
 	
 	/**
 	* Constructor. Requires information about the subscriner
@@ -77,6 +86,32 @@ public:
 	bool readNextData(void* data, SampleInfo_t* info);
 	bool takeNextData(void* data, SampleInfo_t* info);
 	///@}
+
+	/**
+	 * Take several changes at once, locking the history once and removing them from it in one pass.
+	 * @param data Function returning the object where the sample with the given index is deserialized.
+	 * @param[out] infos Vector where the information of each taken change is appended.
+	 * @param max Maximum number of changes to take.
+	 * @return Number of changes taken.
+	 */
+	size_t take_samples(const std::function<void*(size_t)>& data, std::vector<SampleInfo_t>& infos, size_t max);
+
+	/**
+	 * Take several changes without deserializing them. The changes leave the history but are not released,
+	 * so their payloads can be used without locking the history until they are returned.
+	 * @param[out] payloads Vector where the payloads of the taken changes are appended.
+	 * @param[out] infos Vector where the information of each taken change is appended.
+	 * @param max Maximum number of changes to take.
+	 * @return Number of changes taken.
+	 */
+	size_t take_loan(std::vector<const SerializedPayload_t*>& payloads, std::vector<SampleInfo_t>& infos, size_t max);
+
+	/**
+	 * Release the changes of payloads obtained with take_loan.
+	 * @param payloads Payloads to return.
+	 * @return True if all the payloads were lent by this history.
+	 */
+	bool return_loan(const std::vector<const SerializedPayload_t*>& payloads);
 	
 	/**
 	 * Method to know whether there are unread CacheChange_t.
@@ -87,10 +122,17 @@ public:
 	/**
 	* This method is called to remove a change from the SubscriberHistory.
 	* @param change Pointer to the CacheChange_t.
-	* @param vit Pointer to the iterator of the key-ordered cacheChange vector.
+	* @param vit Pointer to the iterator of the instance the change belongs to.
+	* @return True if removed.
+	*/
+	bool remove_change_sub(CacheChange_t* change,t_m_Inst_Caches::iterator* vit=nullptr);
+
+	/**
+	* Remove a change from the history and from the instance and writer indexes.
+	* @param a_change Pointer to the CacheChange_t.
 	* @return True if removed.
 	*/
-	bool remove_change_sub(CacheChange_t* change,t_v_Inst_Caches::iterator* vit=nullptr);
+	bool remove_change(CacheChange_t* a_change);
 
 	//!Increase the unread count.
 	inline void increaseUnreadCount()
@@ -115,20 +157,94 @@ public:
 private:
 	//!Number of unread CacheChange_t.
 	uint64_t m_unreadCacheCount;
-	//!Vector of pointer to the CacheChange_t divided by key.
-	t_v_Inst_Caches m_keyedChanges;
+	//!Pointers to the CacheChange_t divided by key.
+	t_m_Inst_Caches m_keyedChanges;
+	//!Pointers to the CacheChange_t divided by writer. Only kept for KEEP_LAST.
+	t_m_Writer_Caches m_writerChanges;
+	//!Buffer of the last writer entry removed, reused by the next writer.
+	std::vector<t_Writer_Changes> m_spareWriterChanges;
 	//!HistoryQosPolicy values.
 	HistoryQosPolicy m_historyQos;
 	//!ResourceLimitsQosPolicy values.
 	ResourceLimitsQosPolicy m_resourceLimitsQos;
 	//!Publisher Pointer
 	SubscriberImpl* mp_subImpl;
+	//!Initial capacity of the buffer of each instance.
+	size_t m_instanceCapacity;
 
 	//!Type object to deserialize Key
 	void * mp_getKeyObject;
 
+	//!Changes taken by take_loan and not returned yet.
+	std::vector<CacheChange_t*> m_loanedChanges;
 
-	bool find_Key(CacheChange_t* a_change,t_v_Inst_Caches::iterator* vecPairIterrator);
+	//!Changes being taken at once, kept to reuse the storage.
+	std::vector<CacheChange_t*> m_takenChanges;
+
+	//!Writer proxies of the changes being taken at once.
+	std::vector<WriterProxy*> m_takenProxies;
+
+	/**
+	* Remove from the history and its indexes the changes in m_takenChanges, without releasing them.
+	* The ones that were not in the history are set to nullptr, and must not be taken.
+	* @return Number of changes removed.
+	*/
+	size_t detach_taken_changes();
+
+	/**
+	* Remove a change from its instance and from the writer index, and from the reader history.
+	* @param change Pointer to the CacheChange_t.
+	* @param vit Pointer to the iterator of the instance the change belongs to.
+	* @param release Whether the change is released to the pool.
+	* @return True if removed.
+	*/
+	bool erase_change_sub(CacheChange_t* change, t_m_Inst_Caches::iterator* vit, bool release);
+
+	/**
+	* Fill the information of a change that is being read or taken.
+	* @param change Pointer to the change.
+	* @param wp Writer proxy of the change, if known.
+	* @param info Pointer to the information.
+	*/
+	void fill_sample_info(CacheChange_t* change, WriterProxy* wp, SampleInfo_t* info);
+
+
+	/**
+	* Find the instance of a change, creating it if it is new and the resource limits allow it.
+	* @param a_change Pointer to the change.
+	* @param map_it Pointer to store the iterator of the instance.
+	* @return True if the instance was found or created.
+	*/
+	bool find_Key(CacheChange_t* a_change,t_m_Inst_Caches::iterator* map_it);
+
+	/**
+	* Find the changes of the writer of a change, creating the entry if it is new.
+	* @param a_change Pointer to the change.
+	* @return Changes of the writer.
+	*/
+	t_Writer_Changes& find_Writer(CacheChange_t* a_change);
+
+	/**
+	* Get the changes of the writer of a change, without creating the entry.
+	* @param a_change Pointer to the change.
+	* @return Changes of the writer, nullptr if it has none.
+	*/
+	t_Writer_Changes* get_Writer(CacheChange_t* a_change);
+
+	/**
+	* Remove a change from the changes of its writer, removing the entry of the writer when it is left empty.
+	* @param a_change Pointer to the change.
+	*/
+	void remove_from_Writer(CacheChange_t* a_change);
+
+	/**
+	* Remove a change from the writer index and from the reader history.
+	* The change must have been removed from its instance before.
+	* @param a_change Pointer to the change.
+	* @param release Whether the change is released to the pool.
+	* @return True if removed.
+	*/
+	bool remove_indexed_change(CacheChange_t* a_change, bool release = true);
 
 };
 
@@ -19,6 +19,7 @@
 #include <fastrtps/rtps/common/SequenceNumber.h>
 #include <fastrtps/rtps/messages/CDRMessage.h>
 #include <boost/thread.hpp>
+#include <atomic>
 #include <vector>
 
 #include "test_UDPv4TransportDescriptor.h"
@@ -42,6 +43,10 @@ public:
    RTPS_DllAPI static std::vector<std::vector<octet> > DropLog;
    RTPS_DllAPI static uint32_t DropLogLength;
 
+   // Packets and bytes given to Send by all the instances, including the dropped ones.
+   RTPS_DllAPI static std::atomic<uint64_t> SentPackets;
+   RTPS_DllAPI static std::atomic<uint64_t> SentBytes;
+
 private:
    uint8_t mDropDataMessagesPercentage;
    uint8_t mDropDataFragMessagesPercentage;
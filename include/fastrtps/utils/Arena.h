@@ -0,0 +1,164 @@
+// Copyright 2016 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file Arena.h
+ *
+ */
+
+#ifndef ARENA_H_
+#define ARENA_H_
+#ifndef DOXYGEN_SHOULD_SKIP_THIS_PUBLIC
+
+#include <vector>
+#include <cstddef>
+#include <new>
+#include <utility>
+
+namespace eprosima {
+namespace fastrtps{
+
+/**
+ * Region where objects of any type are constructed one after another and destroyed all at once.
+ * Memory is taken from blocks that are kept after clear(), so an arena that is cleared and filled
+ * again with a similar set of objects does not allocate.
+ * @ingroup UTILITIESMODULE
+ */
+class Arena {
+
+public:
+   /**
+    * @param blockSize Bytes of each block. Objects larger than this get a block of their own.
+    */
+   explicit Arena(size_t blockSize = 4096):
+      mBlockSize(blockSize),
+      mCurrent(0),
+      mUsed(0)
+   {}
+
+   ~Arena()
+   {
+      clear();
+      for(size_t i = 0; i < mBlocks.size(); ++i)
+         delete[] mBlocks[i].data;
+   }
+
+   /**
+    * Constructs an object in the arena. It lives until clear() is called.
+    * @return Pointer to the new object.
+    */
+   template<class T, class... Args>
+   T* create(Args&&... args)
+   {
+      T* object = new(allocate(sizeof(T))) T(std::forward<Args>(args)...);
+      mObjects.push_back(Object(object, &destroy<T>));
+      return object;
+   }
+
+   //! Reports whether the given pointer lies in memory of this arena.
+   bool owns(const void* pointer) const
+   {
+      const char* p = static_cast<const char*>(pointer);
+      for(size_t i = 0; i < mBlocks.size(); ++i)
+      {
+         if(p >= mBlocks[i].data && p < mBlocks[i].data + mBlocks[i].size)
+            return true;
+      }
+      return false;
+   }
+
+   //! Destroys all the objects, in reverse order of creation, keeping the memory for reuse.
+   void clear()
+   {
+      for(size_t i = mObjects.size(); i > 0; --i)
+         mObjects[i - 1].destroy(mObjects[i - 1].pointer);
+      mObjects.clear();
+      mCurrent = 0;
+      mUsed = 0;
+   }
+
+   //! Number of live objects.
+   size_t size() const { return mObjects.size(); }
+
+   //! Bytes reserved by the arena.
+   size_t capacity() const
+   {
+      size_t bytes = 0;
+      for(size_t i = 0; i < mBlocks.size(); ++i)
+         bytes += mBlocks[i].size;
+      return bytes;
+   }
+
+private:
+   Arena(const Arena&);
+   Arena& operator=(const Arena&);
+
+   //! Alignment of every object, enough for any fundamental type.
+   static const size_t alignment = 16;
+
+   struct Block
+   {
+      Block(char* d, size_t s): data(d), size(s) {}
+      char* data;
+      size_t size;
+   };
+
+   struct Object
+   {
+      Object(void* p, void (*d)(void*)): pointer(p), destroy(d) {}
+      void* pointer;
+      void (*destroy)(void*);
+   };
+
+   template<class T>
+   static void destroy(void* object)
+   {
+      static_cast<T*>(object)->~T();
+   }
+
+   void* allocate(size_t size)
+   {
+      size = (size + alignment - 1) & ~(alignment - 1);
+
+      // Blocks are used in order. The ones too small for this object are left behind until clear().
+      while(mCurrent < mBlocks.size() && mUsed + size > mBlocks[mCurrent].size)
+      {
+         ++mCurrent;
+         mUsed = 0;
+      }
+
+      if(mCurrent == mBlocks.size())
+      {
+         size_t blockSize = size > mBlockSize ? size : mBlockSize;
+         mBlocks.push_back(Block(new char[blockSize], blockSize));
+         mUsed = 0;
+      }
+
+      void* memory = mBlocks[mCurrent].data + mUsed;
+      mUsed += size;
+      return memory;
+   }
+
+   std::vector<Block> mBlocks;
+   std::vector<Object> mObjects;
+   size_t mBlockSize;
+   size_t mCurrent;
+   size_t mUsed;
+};
+
+} // namespace fastrtps
+} // namespace eprosima
+
+#endif
+#endif /* ARENA_H_ */
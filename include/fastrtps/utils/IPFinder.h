@@ -61,8 +61,19 @@ public:
 	IPFinder();
 	virtual ~IPFinder();
 
+	/**
+    * Get the IPs of all interfaces. The interfaces are enumerated once and kept for the whole process.
+    * @param[out] vec_name Vector to be populated with the IPs.
+    * @param[in] return_loopback Whether to include the loopback IPs.
+    */
 	RTPS_DllAPI static bool getIPs(std::vector<info_IP>* vec_name, bool return_loopback = false);
 
+	/**
+    * Forget the interfaces kept by getIPs, so they are enumerated again on the next call.
+    * Call it after the network configuration of the host changes.
+    */
+	RTPS_DllAPI static void clearCache();
+
 	/**
     * Get the IP4Adresses in all interfaces.
     * @param[out] locators List of locators to be populated with the IP4 addresses.
@@ -85,6 +96,11 @@ public:
     * */
 	RTPS_DllAPI static bool parseIP4(info_IP& info);
 	RTPS_DllAPI static bool parseIP6(info_IP& info);
+
+private:
+
+	//!Enumerate the IPs of the interfaces of the host.
+	static bool queryIPs(std::vector<info_IP>* vec_name, bool return_loopback);
 };
 }
 } /* namespace eprosima */
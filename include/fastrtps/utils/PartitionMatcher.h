@@ -0,0 +1,103 @@
+// Copyright 2016 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/*!
+ * @file PartitionMatcher.h
+ *
+ */
+
+#ifndef PARTITIONMATCHER_H_
+#define PARTITIONMATCHER_H_
+#ifndef DOXYGEN_SHOULD_SKIP_THIS_PUBLIC
+
+#include <bitset>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace eprosima {
+namespace fastrtps{
+namespace rtps {
+
+/**
+ * Class PartitionMatcher, that keeps the partition names of an endpoint compiled, so two sets of partitions are
+ * matched without parsing the names again.
+ * Names without wildcards are kept in a hash set, and the wildcard names are compiled to a sequence of tokens
+ * that is matched with the POSIX fnmatch rules (FNM_PATHNAME), as StringMatching does.
+ * @ingroup UTILITIES_MODULE
+ */
+class PartitionMatcher {
+public:
+	PartitionMatcher();
+	virtual ~PartitionMatcher();
+
+	/**
+	 * Compile a list of partition names. Nothing is done if the names are the ones already compiled.
+	 * @param names Partition names of the endpoint.
+	 */
+	void compile(const std::vector<std::string>& names);
+
+	/**
+	 * Check if the partitions of two endpoints match. Two empty lists match, an empty list matches the default
+	 * partition (""), and otherwise any pair of names has to match in either direction.
+	 * @param other Matcher of the other endpoint.
+	 * @return true if the partitions match.
+	 */
+	bool matches(const PartitionMatcher& other) const;
+
+private:
+
+	struct Token
+	{
+		enum Kind { LITERAL, ANY, STAR, SET };
+		Kind kind;
+		char literal;
+		bool negated;
+		std::bitset<256> set;
+	};
+
+	struct Pattern
+	{
+		//!Name as written by the user.
+		std::string name;
+		//!Literal characters before the first wildcard.
+		std::string prefix;
+		//!Compiled name. Empty if the name uses features not compiled, like character classes.
+		std::vector<Token> tokens;
+	};
+
+	static bool hasWildcards(const std::string& name);
+
+	static void compilePattern(Pattern& pattern);
+
+	static bool matchPattern(const Pattern& pattern, const std::string& input);
+
+	//!Whether a pattern matches any name of this matcher.
+	bool matchesAnyName(const Pattern& pattern) const;
+
+	//!Names compiled.
+	std::vector<std::string> m_names;
+	//!Names without wildcards.
+	std::unordered_set<std::string> m_exact;
+	//!Names without wildcards, sorted to look them up by prefix.
+	std::vector<std::string> m_sortedExact;
+	//!Names with wildcards.
+	std::vector<Pattern> m_patterns;
+};
+
+}
+} /* namespace rtps */
+} /* namespace eprosima */
+#endif
+#endif /* PARTITIONMATCHER_H_ */
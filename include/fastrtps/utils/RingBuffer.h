@@ -0,0 +1,174 @@
+// Copyright 2016 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file RingBuffer.h
+ *
+ */
+
+#ifndef RINGBUFFER_H_
+#define RINGBUFFER_H_
+#ifndef DOXYGEN_SHOULD_SKIP_THIS_PUBLIC
+
+#include <vector>
+#include <cstddef>
+#include <cassert>
+
+namespace eprosima {
+namespace fastrtps{
+
+/**
+ * Ordered sequence stored in a circular buffer.
+ * Adding at the back and removing from the front are O(1). The buffer only grows when it is full,
+ * so a buffer created with the final capacity never allocates again.
+ * @ingroup UTILITIESMODULE
+ */
+template<class T>
+class RingBuffer {
+
+public:
+   /**
+    * @param initialCapacity Number of elements that fit before the buffer grows.
+    */
+   explicit RingBuffer(size_t initialCapacity = 1):
+      mBuffer(initialCapacity > 0 ? initialCapacity : 1),
+      mHead(0),
+      mSize(0)
+   {}
+
+   //! Number of elements stored.
+   size_t size() const { return mSize; }
+
+   //! Reports whether there are no elements stored.
+   bool empty() const { return mSize == 0; }
+
+   //! Number of elements that fit before the buffer grows.
+   size_t capacity() const { return mBuffer.size(); }
+
+   //! Element at the given position, counting from the front.
+   T& operator[](size_t index)
+   {
+      assert(index < mSize);
+      return mBuffer[physical(index)];
+   }
+
+   const T& operator[](size_t index) const
+   {
+      assert(index < mSize);
+      return mBuffer[physical(index)];
+   }
+
+   T& front() { return (*this)[0]; }
+   const T& front() const { return (*this)[0]; }
+
+   T& back() { return (*this)[mSize - 1]; }
+   const T& back() const { return (*this)[mSize - 1]; }
+
+   //! Adds an element at the back, growing the buffer if it is full.
+   void push_back(const T& item)
+   {
+      if(mSize == mBuffer.size())
+         grow();
+
+      mBuffer[physical(mSize)] = item;
+      ++mSize;
+   }
+
+   //! Removes the element at the front.
+   void pop_front()
+   {
+      assert(mSize > 0);
+      mHead = physical(1);
+      --mSize;
+   }
+
+   //! Removes the element at the back.
+   void pop_back()
+   {
+      assert(mSize > 0);
+      --mSize;
+   }
+
+   /**
+    * Removes the element at the given position, keeping the order of the rest.
+    * Elements are shifted from the nearest end.
+    * @param index Position of the element, counting from the front.
+    */
+   void erase(size_t index)
+   {
+      assert(index < mSize);
+
+      if(index < mSize / 2)
+      {
+         for(size_t i = index; i > 0; --i)
+            mBuffer[physical(i)] = mBuffer[physical(i - 1)];
+         pop_front();
+      }
+      else
+      {
+         for(size_t i = index; i + 1 < mSize; ++i)
+            mBuffer[physical(i)] = mBuffer[physical(i + 1)];
+         pop_back();
+      }
+   }
+
+   /**
+    * Position of the first element equal to the given one.
+    * @return Position of the element, or size() if it is not stored.
+    */
+   size_t find(const T& item) const
+   {
+      for(size_t i = 0; i < mSize; ++i)
+      {
+         if(mBuffer[physical(i)] == item)
+            return i;
+      }
+
+      return mSize;
+   }
+
+   //! Removes all the elements, keeping the capacity.
+   void clear()
+   {
+      mHead = 0;
+      mSize = 0;
+   }
+
+private:
+
+   size_t physical(size_t index) const
+   {
+      size_t position = mHead + index;
+      return position < mBuffer.size() ? position : position - mBuffer.size();
+   }
+
+   void grow()
+   {
+      std::vector<T> buffer(mBuffer.size() * 2);
+      for(size_t i = 0; i < mSize; ++i)
+         buffer[i] = mBuffer[physical(i)];
+      mBuffer.swap(buffer);
+      mHead = 0;
+   }
+
+   std::vector<T> mBuffer;
+   size_t mHead;
+   size_t mSize;
+};
+
+} // namespace fastrtps
+} // namespace eprosima
+
+#endif
+#endif /* RINGBUFFER_H_ */
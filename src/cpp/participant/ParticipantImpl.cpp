@@ -178,6 +178,7 @@ Publisher* ParticipantImpl::createPublisher(PublisherAttributes& att,
     if(att.getUserDefinedID()>0)
         watt.endpoint.setUserDefinedID((uint8_t)att.getUserDefinedID());
     watt.times = att.times;
+    watt.batching = att.batching;
 
     RTPSWriter* writer = RTPSDomain::createRTPSWriter(this->mp_rtpsParticipant,
             watt,
@@ -344,6 +345,11 @@ bool ParticipantImpl::registerType(TopicDataType* type)
         logError(PARTICIPANT, "Registered Type must have maximum byte size > 0");
         return false;
     }
+    if (type->m_plainSize > type->m_typeSize)
+    {
+        logError(PARTICIPANT, "Registered Type cannot have a plain size greater than its maximum byte size");
+        return false;
+    }
     if (std::string(type->getName()).size() <= 0)
     {
         logError(PARTICIPANT, "Registered Type must have a name");
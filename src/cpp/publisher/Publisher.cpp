@@ -47,6 +47,24 @@ bool Publisher::write(void* Data, WriteParams &wparams) {
 	return mp_impl->create_new_change_with_params(ALIVE, Data, wparams);
 }
 
+bool Publisher::write(const std::vector<void*>& data) {
+	logInfo(PUBLISHER,"Writing " << data.size() << " new data");
+	return mp_impl->create_new_changes(ALIVE, data);
+}
+
+void* Publisher::loan_sample() {
+	return mp_impl->loan_sample();
+}
+
+bool Publisher::write_loaned(void* sample) {
+	logInfo(PUBLISHER,"Writing loaned data");
+	return mp_impl->write_loaned(sample);
+}
+
+bool Publisher::discard_loan(void* sample) {
+	return mp_impl->discard_loan(sample);
+}
+
 bool Publisher::dispose(void* Data)
 {
 	logInfo(PUBLISHER,"Disposing of Data");
@@ -78,6 +96,17 @@ bool Publisher::wait_for_all_acked(const Time_t& max_wait)
 	return mp_impl->wait_for_all_acked(max_wait);
 }
 
+size_t Publisher::flush()
+{
+	logInfo(PUBLISHER,"Flushing batched samples");
+	return mp_impl->flush();
+}
+
+BatchingStatistics Publisher::getBatchingStatistics()
+{
+	return mp_impl->getBatchingStatistics();
+}
+
 const GUID_t& Publisher::getGuid()
 {
 	return mp_impl->getGuid();
@@ -39,7 +39,8 @@ PublisherHistory::PublisherHistory(PublisherImpl* pimpl,uint32_t payloadMaxSize,
 										WriterHistory(HistoryAttributes(mempolicy, payloadMaxSize,resource.allocated_samples,resource.max_samples)),
 										m_historyQos(history),
 										m_resourceLimitsQos(resource),
-										mp_pubImpl(pimpl)
+										mp_pubImpl(pimpl),
+										m_instanceCapacity(history.kind == KEEP_LAST_HISTORY_QOS && history.depth > 0 ? history.depth : 1)
 {
 	// TODO Auto-generated constructor stub
 
@@ -59,7 +60,25 @@ bool PublisherHistory::add_pub_change(CacheChange_t* change, WriteParams &wparam
 		return false;
 	}
 
-	boost::lock_guard<boost::recursive_mutex> guard(*this->mp_mutex);
+	bool returnedValue = false;
+	{
+		boost::lock_guard<boost::recursive_mutex> guard(*this->mp_mutex);
+		std::vector<CacheChange_t*> group;
+		begin_change_group(&group);
+		returnedValue = add_pub_change_nts(change, wparams);
+		end_change_group();
+	}
+
+	// The change was serialized before locking and is sent after unlocking, so concurrent writes
+	// only contend for the update of the history and the readers.
+	send_pending_changes();
+	return returnedValue;
+}
+
+bool PublisherHistory::add_pub_change_nts(CacheChange_t* change, WriteParams &wparams)
+{
+	if(m_isHistoryFull)
+		flush_change_group();
 	if(m_isHistoryFull && !this->mp_pubImpl->clean_history(1))
 	{
 		logWarning(RTPS_HISTORY,"Attempting to add Data to Full WriterCache: "<<this->mp_pubImpl->getGuid().entityId);
@@ -91,7 +110,7 @@ bool PublisherHistory::add_pub_change(CacheChange_t* change, WriteParams &wparam
 	//HISTORY WITH KEY
 	else if(mp_pubImpl->getAttributes().topic.getTopicKind() == WITH_KEY)
 	{
-		t_v_Inst_Caches::iterator vit;
+		t_m_Inst_Caches::iterator vit;
 		if(find_Key(change,&vit))
 		{
 			logInfo(RTPS_HISTORY,"Found key: "<< vit->first);
@@ -157,45 +176,58 @@ bool PublisherHistory::add_pub_change(CacheChange_t* change, WriteParams &wparam
     return returnedValue;
 }
 
-bool PublisherHistory::find_Key(CacheChange_t* a_change,t_v_Inst_Caches::iterator* vit_out)
+size_t PublisherHistory::add_pub_changes(const std::vector<CacheChange_t*>& changes)
 {
-	t_v_Inst_Caches::iterator vit;
-	bool found = false;
-	for(vit= m_keyedChanges.begin();vit!=m_keyedChanges.end();++vit)
+	if(mp_writer == nullptr || mp_mutex == nullptr)
 	{
-		if(a_change->instanceHandle == vit->first)
-		{
-			*vit_out = vit;
-			return true;
-		}
+		logError(RTPS_HISTORY,"You need to create a Writer with this History before using it");
+		return 0;
+	}
+
+	size_t added = 0;
+	{
+		boost::lock_guard<boost::recursive_mutex> guard(*this->mp_mutex);
+		std::vector<CacheChange_t*> group;
+		begin_change_group(&group);
+
+		while(added < changes.size() && add_pub_change_nts(changes[added], WRITE_PARAM_DEFAULT))
+			++added;
+
+		end_change_group();
+	}
+
+	send_pending_changes();
+	return added;
+}
+
+bool PublisherHistory::find_Key(CacheChange_t* a_change,t_m_Inst_Caches::iterator* vit_out)
+{
+	t_m_Inst_Caches::iterator vit = m_keyedChanges.find(a_change->instanceHandle);
+	if(vit != m_keyedChanges.end())
+	{
+		*vit_out = vit;
+		return true;
 	}
-	if(!found)
+
+	if((int)m_keyedChanges.size() < m_resourceLimitsQos.max_instances)
 	{
-		if((int)m_keyedChanges.size() < m_resourceLimitsQos.max_instances)
+		*vit_out = m_keyedChanges.insert(std::make_pair(a_change->instanceHandle, t_Inst_Changes(m_instanceCapacity))).first;
+		return true;
+	}
+
+	// Reuse an instance without changes, keeping its buffer.
+	for(vit = m_keyedChanges.begin(); vit != m_keyedChanges.end(); ++vit)
+	{
+		if(vit->second.empty())
 		{
-			t_p_I_Change newpair;
-			newpair.first = a_change->instanceHandle;
-			m_keyedChanges.push_back(newpair);
-			*vit_out = m_keyedChanges.end()-1;
+			t_Inst_Changes changes(std::move(vit->second));
+			m_keyedChanges.erase(vit);
+			*vit_out = m_keyedChanges.insert(std::make_pair(a_change->instanceHandle, std::move(changes))).first;
 			return true;
 		}
-		else
-		{
-			for (vit = m_keyedChanges.begin(); vit != m_keyedChanges.end(); ++vit)
-			{
-				if (vit->second.size() == 0)
-				{
-					m_keyedChanges.erase(vit);
-					t_p_I_Change newpair;
-					newpair.first = a_change->instanceHandle;
-					m_keyedChanges.push_back(newpair);
-					*vit_out = m_keyedChanges.end() - 1;
-					return true;
-				}
-			}
-			logWarning(SUBSCRIBER, "History has reached the maximum number of instances" << endl;)
-		}
 	}
+
+	logWarning(PUBLISHER, "History has reached the maximum number of instances" << endl;)
 	return false;
 }
 
@@ -235,7 +267,7 @@ bool PublisherHistory::removeMinChange()
 	return false;
 }
 
-bool PublisherHistory::remove_change_pub(CacheChange_t* change,t_v_Inst_Caches::iterator* vit_in)
+bool PublisherHistory::remove_change_pub(CacheChange_t* change,t_m_Inst_Caches::iterator* vit_in)
 {
 
 	if(mp_writer == nullptr || mp_mutex == nullptr)
@@ -257,27 +289,23 @@ bool PublisherHistory::remove_change_pub(CacheChange_t* change,t_v_Inst_Caches::
 	}
 	else
 	{
-		t_v_Inst_Caches::iterator vit;
+		t_m_Inst_Caches::iterator vit;
 		if(vit_in!=nullptr)
 			vit = *vit_in;
-		else if(this->find_Key(change,&vit))
-		{
-
-		}
 		else
+			vit = m_keyedChanges.find(change->instanceHandle);
+
+		if(vit == m_keyedChanges.end())
 			return false;
-		for(auto chit = vit->second.begin();
-				chit!= vit->second.end();++chit)
+
+		size_t index = vit->second.find(change);
+		if(index < vit->second.size())
 		{
-			if( ((*chit)->sequenceNumber == change->sequenceNumber)
-				&& ((*chit)->writerGUID == change->writerGUID) )
+			if(remove_change(change))
 			{
-				if(remove_change(change))
-				{
-					vit->second.erase(chit);
-                                        m_isHistoryFull = false;
-					return true;
-				}
+				vit->second.erase(index);
+				m_isHistoryFull = false;
+				return true;
 			}
 		}
 		logError(PUBLISHER,"Change not found, something is wrong");
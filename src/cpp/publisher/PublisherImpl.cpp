@@ -31,6 +31,9 @@
 
 #include <fastrtps/log/Log.h>
 
+#include <boost/thread/recursive_mutex.hpp>
+#include <boost/thread/lock_guard.hpp>
+
 using namespace eprosima::fastrtps;
 using namespace ::rtps;
 
@@ -58,6 +61,8 @@ PublisherImpl::PublisherImpl(ParticipantImpl* p,TopicDataType*pdatatype,
 PublisherImpl::~PublisherImpl()
 {
     logInfo(PUBLISHER,this->getGuid().entityId << " in topic: "<<this->m_att.topic.topicName);
+    for(size_t i = 0; i < m_loanedChanges.size(); ++i)
+        m_history.release_Cache(m_loanedChanges[i]);
     RTPSDomain::removeRTPSWriter(mp_writer);
     delete(this->mp_userPublisher);
 }
@@ -109,33 +114,10 @@ bool PublisherImpl::create_new_change_with_params(ChangeKind_t changeKind, void*
             }
         }
 
-        if(high_mark_for_frag_ == 0)
-        {
-            high_mark_for_frag_ = mp_rtpsParticipant->getMaxMessageSize() > m_att.throughputController.bytesPerPeriod ? m_att.throughputController.bytesPerPeriod :
-                mp_rtpsParticipant->getMaxMessageSize();
-            if(high_mark_for_frag_ > mp_rtpsParticipant->getRTPSParticipantAttributes().throughputController.bytesPerPeriod)
-                high_mark_for_frag_ = mp_rtpsParticipant->getRTPSParticipantAttributes().throughputController.bytesPerPeriod;
-            if(high_mark_for_frag_ > RTPSMESSAGE_COMMON_RTPS_PAYLOAD_SIZE)
-                high_mark_for_frag_ -= RTPSMESSAGE_COMMON_RTPS_PAYLOAD_SIZE;
-        }
-
-        // If it is big data, fragment it.
-        if(ch->serializedPayload.length > high_mark_for_frag_)
+        if(!set_fragment_size(ch))
         {
-            // Check ASYNCHRONOUS_PUBLISH_MODE is being used, but it is an error case.
-            if( m_att.qos.m_publishMode.kind != ASYNCHRONOUS_PUBLISH_MODE)
-            {
-                logError(PUBLISHER, "Data cannot be sent. It's serialized size is " <<
-                        ch->serializedPayload.length << "' which exceeds the maximum payload size of '" <<
-                        high_mark_for_frag_ << "' and therefore ASYNCHRONOUS_PUBLISH_MODE must be used.");
-                m_history.release_Cache(ch);
-                return false;
-            }
-
-            /// Fragment the data.
-            // Set the fragment size to the cachechange.
-            // Note: high_mark will always be a value that can be casted to uint16_t)
-            ch->setFragmentSize((uint16_t)high_mark_for_frag_);
+            m_history.release_Cache(ch);
+            return false;
         }
 
         if(&wparams != &WRITE_PARAM_DEFAULT)
@@ -156,6 +138,172 @@ bool PublisherImpl::create_new_change_with_params(ChangeKind_t changeKind, void*
 }
 
 
+bool PublisherImpl::create_new_changes(ChangeKind_t changeKind, const std::vector<void*>& data)
+{
+    /// Preconditions
+    for(size_t i = 0; i < data.size(); ++i)
+    {
+        if(data[i] == nullptr)
+        {
+            logError(PUBLISHER, "Data pointer not valid");
+            return false;
+        }
+    }
+
+    if(changeKind == NOT_ALIVE_UNREGISTERED || changeKind == NOT_ALIVE_DISPOSED ||
+            changeKind == NOT_ALIVE_DISPOSED_UNREGISTERED)
+    {
+        if(m_att.topic.topicKind == NO_KEY)
+        {
+            logError(PUBLISHER,"Topic is NO_KEY, operation not permitted");
+            return false;
+        }
+    }
+
+    if(data.empty())
+        return true;
+
+    std::vector<CacheChange_t*> changes;
+    if(!mp_writer->new_changes(changes, data.size(),
+                [&](size_t i) -> uint32_t { return mp_type->getSerializedSizeProvider(data[i])(); }, changeKind))
+    {
+        return false;
+    }
+
+    // Serialization happens before locking the history.
+    bool prepared = true;
+    for(size_t i = 0; prepared && i < changes.size(); ++i)
+    {
+        CacheChange_t* ch = changes[i];
+
+        if(m_att.topic.topicKind == WITH_KEY)
+            mp_type->getKey(data[i], &ch->instanceHandle);
+
+        if(changeKind == ALIVE && !mp_type->serialize(data[i], &ch->serializedPayload))
+        {
+            logWarning(RTPS_WRITER,"RTPSWriter:Serialization returns false";);
+            prepared = false;
+        }
+        else
+            prepared = set_fragment_size(ch);
+    }
+
+    size_t added = prepared ? m_history.add_pub_changes(changes) : 0;
+
+    for(size_t i = added; i < changes.size(); ++i)
+        m_history.release_Cache(changes[i]);
+
+    return added == changes.size();
+}
+
+void* PublisherImpl::loan_sample()
+{
+    if(!mp_type->isPlain())
+    {
+        logError(PUBLISHER, "Type " << mp_type->getName() << " is not plain, its samples cannot be loaned");
+        return nullptr;
+    }
+
+    uint32_t plainSize = mp_type->m_plainSize;
+    CacheChange_t* ch = mp_writer->new_change([plainSize]() -> uint32_t { return plainSize; }, ALIVE);
+    if(ch == nullptr)
+        return nullptr;
+
+    boost::lock_guard<boost::recursive_mutex> guard(*mp_writer->getMutex());
+    m_loanedChanges.push_back(ch);
+    return ch->serializedPayload.data;
+}
+
+bool PublisherImpl::write_loaned(void* sample)
+{
+    CacheChange_t* ch = take_loaned_change(sample);
+    if(ch == nullptr)
+    {
+        logError(PUBLISHER, "Sample not loaned by this publisher");
+        return false;
+    }
+
+    // The payload already holds the sample, only its description is missing.
+#if EPROSIMA_BIG_ENDIAN
+    ch->serializedPayload.encapsulation = CDR_BE;
+#else
+    ch->serializedPayload.encapsulation = CDR_LE;
+#endif
+    ch->serializedPayload.length = mp_type->m_plainSize;
+
+    if(m_att.topic.topicKind == WITH_KEY)
+        mp_type->getKey(sample, &ch->instanceHandle);
+
+    if(!set_fragment_size(ch) || !m_history.add_pub_change(ch, WRITE_PARAM_DEFAULT))
+    {
+        m_history.release_Cache(ch);
+        return false;
+    }
+
+    return true;
+}
+
+bool PublisherImpl::discard_loan(void* sample)
+{
+    CacheChange_t* ch = take_loaned_change(sample);
+    if(ch == nullptr)
+    {
+        logError(PUBLISHER, "Sample not loaned by this publisher");
+        return false;
+    }
+
+    m_history.release_Cache(ch);
+    return true;
+}
+
+CacheChange_t* PublisherImpl::take_loaned_change(void* sample)
+{
+    boost::lock_guard<boost::recursive_mutex> guard(*mp_writer->getMutex());
+    for(auto it = m_loanedChanges.begin(); it != m_loanedChanges.end(); ++it)
+    {
+        if((*it)->serializedPayload.data == sample)
+        {
+            CacheChange_t* ch = *it;
+            m_loanedChanges.erase(it);
+            return ch;
+        }
+    }
+    return nullptr;
+}
+
+bool PublisherImpl::set_fragment_size(CacheChange_t* ch)
+{
+    if(high_mark_for_frag_ == 0)
+    {
+        high_mark_for_frag_ = mp_rtpsParticipant->getMaxMessageSize() > m_att.throughputController.bytesPerPeriod ? m_att.throughputController.bytesPerPeriod :
+            mp_rtpsParticipant->getMaxMessageSize();
+        if(high_mark_for_frag_ > mp_rtpsParticipant->getRTPSParticipantAttributes().throughputController.bytesPerPeriod)
+            high_mark_for_frag_ = mp_rtpsParticipant->getRTPSParticipantAttributes().throughputController.bytesPerPeriod;
+        if(high_mark_for_frag_ > RTPSMESSAGE_COMMON_RTPS_PAYLOAD_SIZE)
+            high_mark_for_frag_ -= RTPSMESSAGE_COMMON_RTPS_PAYLOAD_SIZE;
+    }
+
+    // If it is big data, fragment it.
+    if(ch->serializedPayload.length > high_mark_for_frag_)
+    {
+        // Check ASYNCHRONOUS_PUBLISH_MODE is being used, but it is an error case.
+        if( m_att.qos.m_publishMode.kind != ASYNCHRONOUS_PUBLISH_MODE)
+        {
+            logError(PUBLISHER, "Data cannot be sent. It's serialized size is " <<
+                    ch->serializedPayload.length << "' which exceeds the maximum payload size of '" <<
+                    high_mark_for_frag_ << "' and therefore ASYNCHRONOUS_PUBLISH_MODE must be used.");
+            return false;
+        }
+
+        /// Fragment the data.
+        // Set the fragment size to the cachechange.
+        // Note: high_mark will always be a value that can be casted to uint16_t)
+        ch->setFragmentSize((uint16_t)high_mark_for_frag_);
+    }
+
+    return true;
+}
+
 bool PublisherImpl::removeMinSeqChange()
 {
     return m_history.removeMinChange();
@@ -275,3 +423,13 @@ bool PublisherImpl::wait_for_all_acked(const Time_t& max_wait)
     return mp_writer->wait_for_all_acked(max_wait);
 }
 
+size_t PublisherImpl::flush()
+{
+    return mp_writer->flush();
+}
+
+BatchingStatistics PublisherImpl::getBatchingStatistics()
+{
+    return mp_writer->getBatchingStatistics();
+}
+
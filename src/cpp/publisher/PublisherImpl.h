@@ -24,6 +24,7 @@
 
 #include <fastrtps/rtps/common/Locator.h>
 #include <fastrtps/rtps/common/Guid.h>
+#include <fastrtps/rtps/common/BatchingStatistics.h>
 
 #include <fastrtps/attributes/PublisherAttributes.h>
 
@@ -83,6 +84,34 @@ class PublisherImpl
      */
     bool create_new_change_with_params(ChangeKind_t kind, void* Data, WriteParams &wparams);
 
+    /**
+     * Create, serialize and add a change for each data, locking the history once.
+     * @param kind
+     * @param data Pointers to the data.
+     * @return True if all the changes were added.
+     */
+    bool create_new_changes(ChangeKind_t kind, const std::vector<void*>& data);
+
+    /**
+     * Reserve a change and lend its payload to be filled with a sample of a plain type.
+     * @return Pointer to the payload, nullptr if the type is not plain or no change could be reserved.
+     */
+    void* loan_sample();
+
+    /**
+     * Add to the history the change whose payload was lent.
+     * @param sample Pointer returned by loan_sample.
+     * @return True if the change was added. In any case the loan is finished.
+     */
+    bool write_loaned(void* sample);
+
+    /**
+     * Release without writing it the change whose payload was lent.
+     * @param sample Pointer returned by loan_sample.
+     * @return True if the sample was lent by this publisher.
+     */
+    bool discard_loan(void* sample);
+
     /**
      * Removes the cache change with the minimum sequence number
      * @return True if correct.
@@ -130,7 +159,33 @@ class PublisherImpl
 
     bool wait_for_all_acked(const Time_t& max_wait);
 
+    /**
+     * Send the samples waiting to complete a batch.
+     * @return Number of samples sent.
+     */
+    size_t flush();
+
+    /**
+     * Get the statistics of the batches sent by the writer.
+     * @return Statistics of the batches.
+     */
+    BatchingStatistics getBatchingStatistics();
+
     private:
+    /**
+     * Set the fragment size of a change too big for a message.
+     * @param ch Change already serialized.
+     * @return False if the change is too big and the publisher is synchronous.
+     */
+    bool set_fragment_size(CacheChange_t* ch);
+
+    /**
+     * Remove from the lent changes the one owning a payload.
+     * @param sample Pointer returned by loan_sample.
+     * @return The change, nullptr if the payload was not lent by this publisher.
+     */
+    CacheChange_t* take_loaned_change(void* sample);
+
     ParticipantImpl* mp_participant;
     //! Pointer to the associated Data Writer.
     RTPSWriter* mp_writer;
@@ -157,6 +212,9 @@ class PublisherImpl
     RTPSParticipant* mp_rtpsParticipant;
 
     uint32_t high_mark_for_frag_;
+
+    //! Changes whose payload is lent to the user, protected by the mutex of the writer.
+    std::vector<CacheChange_t*> m_loanedChanges;
 };
 
 
@@ -24,7 +24,7 @@
 namespace eprosima {
 namespace fastrtps {
 
-#define IF_VALID_ADD {if(valid){plist->m_parameters.push_back((Parameter_t*)p);plist->m_hasChanged = true;paramlist_byte_size += plength;}else{delete(p);return -1;}break;}
+#define IF_VALID_ADD {if(valid){plist->m_parameters.push_back((Parameter_t*)p);plist->m_hasChanged = true;paramlist_byte_size += plength;}else{return -1;}break;}
 
 
 bool ParameterList::updateCDRMsg(ParameterList_t* plist,Endianness_t endian)
@@ -76,7 +76,7 @@ int32_t ParameterList::readParameterListfromCDRMsg(CDRMessage_t*msg,ParameterLis
 			case PID_METATRAFFIC_UNICAST_LOCATOR:
 			case PID_METATRAFFIC_MULTICAST_LOCATOR:
 			{
-				ParameterLocator_t* p = new ParameterLocator_t(pid,plength);
+				ParameterLocator_t* p = plist->m_arena.create<ParameterLocator_t>(pid,plength);
 				valid &= CDRMessage::readLocator(msg,&p->locator);
 				if(plength == PARAMETER_LOCATOR_LENGTH && valid)
 				{
@@ -86,7 +86,6 @@ int32_t ParameterList::readParameterListfromCDRMsg(CDRMessage_t*msg,ParameterLis
 				}
 				else
 				{
-					delete(p);
 					return -1;
 				}
 				break;
@@ -95,7 +94,7 @@ int32_t ParameterList::readParameterListfromCDRMsg(CDRMessage_t*msg,ParameterLis
 			case PID_METATRAFFIC_UNICAST_PORT:
 			case PID_METATRAFFIC_MULTICAST_PORT:
 			{
-				ParameterPort_t* p = new ParameterPort_t(pid,plength);
+				ParameterPort_t* p = plist->m_arena.create<ParameterPort_t>(pid,plength);
 				valid &= CDRMessage::readUInt32(msg,&p->port);
 				if(plength == PARAMETER_LOCATOR_LENGTH && valid)
 				{
@@ -105,14 +104,13 @@ int32_t ParameterList::readParameterListfromCDRMsg(CDRMessage_t*msg,ParameterLis
 				}
 				else
 				{
-					delete(p);
 					return -1;
 				}
 				break;
 			}
 			case PID_PROTOCOL_VERSION:
 			{
-				ParameterProtocolVersion_t* p = new ParameterProtocolVersion_t(pid,plength);
+				ParameterProtocolVersion_t* p = plist->m_arena.create<ParameterProtocolVersion_t>(pid,plength);
 				valid &= CDRMessage::readOctet(msg,&p->protocolVersion.m_major);
 				valid &= CDRMessage::readOctet(msg,&p->protocolVersion.m_minor);
 				msg->pos+=2;
@@ -124,20 +122,19 @@ int32_t ParameterList::readParameterListfromCDRMsg(CDRMessage_t*msg,ParameterLis
 				}
 				else
 				{
-					delete(p);
 					return -1;
 				}
 				break;
 			}
 			case PID_EXPECTS_INLINE_QOS:
 			{
-				ParameterBool_t * p = new ParameterBool_t(PID_EXPECTS_INLINE_QOS,plength);
+				ParameterBool_t* p = plist->m_arena.create<ParameterBool_t>(PID_EXPECTS_INLINE_QOS,plength);
 				valid &= CDRMessage::readOctet(msg,(octet*)&p->value);msg->pos+=3;
 				IF_VALID_ADD
 			}
 			case PID_VENDORID:
 			{
-				ParameterVendorId_t* p = new ParameterVendorId_t(pid,plength);
+				ParameterVendorId_t* p = plist->m_arena.create<ParameterVendorId_t>(pid,plength);
 				valid &= CDRMessage::readOctet(msg,&p->vendorId[0]);
 				valid &= CDRMessage::readOctet(msg,&p->vendorId[1]);
 				msg->pos+=2;
@@ -149,7 +146,6 @@ int32_t ParameterList::readParameterListfromCDRMsg(CDRMessage_t*msg,ParameterLis
 				}
 				else
 				{
-					delete(p);
 					return -1;
 				}
 				break;
@@ -159,7 +155,7 @@ int32_t ParameterList::readParameterListfromCDRMsg(CDRMessage_t*msg,ParameterLis
 			case PID_METATRAFFIC_UNICAST_IPADDRESS:
 			case PID_METATRAFFIC_MULTICAST_IPADDRESS:
 			{
-				ParameterIP4Address_t* p = new ParameterIP4Address_t(pid,plength);
+				ParameterIP4Address_t* p = plist->m_arena.create<ParameterIP4Address_t>(pid,plength);
 				if(plength == PARAMETER_IP4_LENGTH)
 				{
 					p->address[0] = msg->buffer[msg->pos];
@@ -173,7 +169,6 @@ int32_t ParameterList::readParameterListfromCDRMsg(CDRMessage_t*msg,ParameterLis
 				}
 				else
 				{
-					delete(p);
 					return -1;
 				}
 				break;
@@ -182,7 +177,7 @@ int32_t ParameterList::readParameterListfromCDRMsg(CDRMessage_t*msg,ParameterLis
 			case PID_GROUP_GUID:
 			case PID_ENDPOINT_GUID:
 			{
-				ParameterGuid_t* p = new ParameterGuid_t(pid,plength);
+				ParameterGuid_t* p = plist->m_arena.create<ParameterGuid_t>(pid,plength);
 				valid &= CDRMessage::readData(msg,p->guid.guidPrefix.value,12);
 				valid &= CDRMessage::readData(msg,p->guid.entityId.value,4);
 				if(plength == PARAMETER_GUID_LENGTH && valid)
@@ -193,7 +188,6 @@ int32_t ParameterList::readParameterListfromCDRMsg(CDRMessage_t*msg,ParameterLis
 				}
 				else
 				{
-					delete(p);
 					return -1;
 				}
 				break;
@@ -203,7 +197,7 @@ int32_t ParameterList::readParameterListfromCDRMsg(CDRMessage_t*msg,ParameterLis
 			case PID_ENTITY_NAME:
 			{
 //				cout << msg->pos << endl;
-				ParameterString_t* p = new ParameterString_t(pid,plength);
+				ParameterString_t* p = plist->m_arena.create<ParameterString_t>(pid,plength);
 				std::string aux;
 				valid &= CDRMessage::readString(msg,&aux);
 				p->setName(aux.c_str());
@@ -213,7 +207,7 @@ int32_t ParameterList::readParameterListfromCDRMsg(CDRMessage_t*msg,ParameterLis
 			}
 			case PID_PROPERTY_LIST:
 			{
-				ParameterPropertyList_t* p = new ParameterPropertyList_t(pid,plength);
+				ParameterPropertyList_t* p = plist->m_arena.create<ParameterPropertyList_t>(pid,plength);
 				uint32_t num_properties;
 				valid&=CDRMessage::readUInt32(msg,&num_properties);
 				//uint16_t msg_pos_first = msg->pos;
@@ -241,7 +235,6 @@ int32_t ParameterList::readParameterListfromCDRMsg(CDRMessage_t*msg,ParameterLis
 				}
 				else
 				{
-					delete(p);
 					return -1;
 				}
 				break;
@@ -261,7 +254,7 @@ int32_t ParameterList::readParameterListfromCDRMsg(CDRMessage_t*msg,ParameterLis
 			}
 			case PID_KEY_HASH:
 			{
-      			ParameterKey_t* p = new ParameterKey_t();
+      			ParameterKey_t* p = plist->m_arena.create<ParameterKey_t>();
 				p->Pid = PID_KEY_HASH;
 				p->length = 16;
 				valid&=CDRMessage::readData(msg,p->key.value,16);
@@ -276,28 +269,28 @@ int32_t ParameterList::readParameterListfromCDRMsg(CDRMessage_t*msg,ParameterLis
 			}
 			case PID_DURABILITY:
 			{
-				DurabilityQosPolicy* p = new DurabilityQosPolicy();
+				DurabilityQosPolicy* p = plist->m_arena.create<DurabilityQosPolicy>();
 				valid&=CDRMessage::readOctet(msg,(octet*)&p->kind);
 				msg->pos+=3;
 				IF_VALID_ADD
 			}
 			case PID_DEADLINE:
 			{
-				DeadlineQosPolicy* p= new DeadlineQosPolicy();
+				DeadlineQosPolicy* p = plist->m_arena.create<DeadlineQosPolicy>();
 				valid &= CDRMessage::readInt32(msg,&p->period.seconds);
 				valid &= CDRMessage::readUInt32(msg,&p->period.fraction);
 				IF_VALID_ADD
 			}
 			case PID_LATENCY_BUDGET:
 			{
-				LatencyBudgetQosPolicy* p = new LatencyBudgetQosPolicy();
+				LatencyBudgetQosPolicy* p = plist->m_arena.create<LatencyBudgetQosPolicy>();
 				valid &= CDRMessage::readInt32(msg,&p->duration.seconds);
 				valid &= CDRMessage::readUInt32(msg,&p->duration.fraction);
 				IF_VALID_ADD
 			}
 			case PID_LIVELINESS:
 			{
-				LivelinessQosPolicy* p = new LivelinessQosPolicy();
+				LivelinessQosPolicy* p = plist->m_arena.create<LivelinessQosPolicy>();
 				valid&=CDRMessage::readOctet(msg,(octet*)&p->kind);
 				msg->pos+=3;
 				valid &= CDRMessage::readInt32(msg,&p->lease_duration.seconds);
@@ -306,14 +299,14 @@ int32_t ParameterList::readParameterListfromCDRMsg(CDRMessage_t*msg,ParameterLis
 			}
 			case PID_OWNERSHIP:
 			{
-				OwnershipQosPolicy* p = new OwnershipQosPolicy();
+				OwnershipQosPolicy* p = plist->m_arena.create<OwnershipQosPolicy>();
 				valid&=CDRMessage::readOctet(msg,(octet*)&p->kind);
 				msg->pos+=3;
 				IF_VALID_ADD
 			}
 			case PID_RELIABILITY:
 			{
-				ReliabilityQosPolicy* p = new ReliabilityQosPolicy();
+				ReliabilityQosPolicy* p = plist->m_arena.create<ReliabilityQosPolicy>();
 				valid&=CDRMessage::readOctet(msg,(octet*)&p->kind);
 				msg->pos+=3;
 				valid &= CDRMessage::readInt32(msg,&p->max_blocking_time.seconds);
@@ -322,50 +315,48 @@ int32_t ParameterList::readParameterListfromCDRMsg(CDRMessage_t*msg,ParameterLis
 			}
 			case PID_DESTINATION_ORDER:
 			{
-				DestinationOrderQosPolicy* p = new DestinationOrderQosPolicy();
+				DestinationOrderQosPolicy* p = plist->m_arena.create<DestinationOrderQosPolicy>();
 				valid&=CDRMessage::readOctet(msg,(octet*)&p->kind);
 				msg->pos+=3;
 				IF_VALID_ADD
 			}
 			case PID_USER_DATA:
 			{
-				UserDataQosPolicy* p = new UserDataQosPolicy();
+				UserDataQosPolicy* p = plist->m_arena.create<UserDataQosPolicy>();
 				p->length = plength;
 				//cout << "Parameter length " << plength << endl;
 				uint32_t vec_size = 0;
 				valid&=CDRMessage::readUInt32(msg,&vec_size);
 				//cout << "User Data of size " << vec_size << endl;
-				p->dataVec.resize(vec_size);
-				octet* oc=new octet[vec_size];
-				valid &= CDRMessage::readData(msg,p->dataVec.data(),vec_size);
-				for(uint32_t i =0;i<vec_size;i++)
-					p->dataVec.at(i) = oc[i];
+				valid &= plength >= 4 && vec_size <= plength - 4u;
+				if(valid)
+				{
+					p->dataVec.resize(vec_size);
+					valid &= CDRMessage::readData(msg,p->dataVec.data(),vec_size);
+				}
 				msg->pos += (plength - 4 - vec_size);
 				if(valid)
 				{
 					plist->m_parameters.push_back((Parameter_t*)p);
 					plist->m_hasChanged = true;
 					paramlist_byte_size += plength;
-					delete[] oc;
 				}
 				else
 				{
-					delete(p);
-					delete[] oc;
 					return -1;
 				}
 				break;
 			}
 			case PID_TIME_BASED_FILTER:
 			{
-				TimeBasedFilterQosPolicy* p = new TimeBasedFilterQosPolicy();
+				TimeBasedFilterQosPolicy* p = plist->m_arena.create<TimeBasedFilterQosPolicy>();
 				valid &= CDRMessage::readInt32(msg,&p->minimum_separation.seconds);
 				valid &= CDRMessage::readUInt32(msg,&p->minimum_separation.fraction);
 				IF_VALID_ADD
 			}
 			case PID_PRESENTATION:
 			{
-				PresentationQosPolicy* p = new PresentationQosPolicy();
+				PresentationQosPolicy* p = plist->m_arena.create<PresentationQosPolicy>();
 				valid&=CDRMessage::readOctet(msg,(octet*)&p->access_scope);
 				valid&=CDRMessage::readOctet(msg,(octet*)&p->coherent_access);
 				valid&=CDRMessage::readOctet(msg,(octet*)&p->ordered_access);
@@ -374,7 +365,7 @@ int32_t ParameterList::readParameterListfromCDRMsg(CDRMessage_t*msg,ParameterLis
 			}
 			case PID_PARTITION:
 			{
-				PartitionQosPolicy * p = new PartitionQosPolicy();
+				PartitionQosPolicy* p = plist->m_arena.create<PartitionQosPolicy>();
 				p->length = plength;
 				uint32_t namessize;
 				valid &= CDRMessage::readUInt32(msg,&namessize);
@@ -388,28 +379,28 @@ int32_t ParameterList::readParameterListfromCDRMsg(CDRMessage_t*msg,ParameterLis
 			}
 			case PID_TOPIC_DATA:
 			{
-				TopicDataQosPolicy * p = new TopicDataQosPolicy();
+				TopicDataQosPolicy* p = plist->m_arena.create<TopicDataQosPolicy>();
 				p->length = plength;
 				valid &= CDRMessage::readOctetVector(msg,&p->value);
 				IF_VALID_ADD
 			}
 			case PID_GROUP_DATA:
 			{
-				GroupDataQosPolicy * p = new GroupDataQosPolicy();
+				GroupDataQosPolicy* p = plist->m_arena.create<GroupDataQosPolicy>();
 				p->length = plength;
 				valid &= CDRMessage::readOctetVector(msg,&p->value);
 				IF_VALID_ADD
 			}
 			case PID_HISTORY:
 			{
-				HistoryQosPolicy* p = new HistoryQosPolicy();
+				HistoryQosPolicy* p = plist->m_arena.create<HistoryQosPolicy>();
 				valid&=CDRMessage::readOctet(msg,(octet*)&p->kind);msg->pos+=3;
 				valid &= CDRMessage::readInt32(msg,&p->depth);
 				IF_VALID_ADD
 			}
 			case PID_DURABILITY_SERVICE:
 			{
-				DurabilityServiceQosPolicy * p = new DurabilityServiceQosPolicy();
+				DurabilityServiceQosPolicy* p = plist->m_arena.create<DurabilityServiceQosPolicy>();
 				valid &= CDRMessage::readInt32(msg,&p->service_cleanup_delay.seconds);
 				valid &= CDRMessage::readUInt32(msg,&p->service_cleanup_delay.fraction);
 				valid&=CDRMessage::readOctet(msg,(octet*)&p->history_kind);msg->pos+=3;
@@ -421,20 +412,20 @@ int32_t ParameterList::readParameterListfromCDRMsg(CDRMessage_t*msg,ParameterLis
 			}
 			case PID_LIFESPAN:
 			{
-				LifespanQosPolicy * p = new LifespanQosPolicy();
+				LifespanQosPolicy* p = plist->m_arena.create<LifespanQosPolicy>();
 				valid &= CDRMessage::readInt32(msg,&p->duration.seconds);
 				valid &= CDRMessage::readUInt32(msg,&p->duration.fraction);
 				IF_VALID_ADD
 			}
 			case PID_OWNERSHIP_STRENGTH:
 			{
-				OwnershipStrengthQosPolicy * p = new OwnershipStrengthQosPolicy();
+				OwnershipStrengthQosPolicy* p = plist->m_arena.create<OwnershipStrengthQosPolicy>();
 				valid &= CDRMessage::readUInt32(msg,&p->value);
 				IF_VALID_ADD
 			}
 			case PID_RESOURCE_LIMITS:
 			{
-				ResourceLimitsQosPolicy* p = new ResourceLimitsQosPolicy();
+				ResourceLimitsQosPolicy* p = plist->m_arena.create<ResourceLimitsQosPolicy>();
 				valid &= CDRMessage::readInt32(msg,&p->max_samples);
 				valid &= CDRMessage::readInt32(msg,&p->max_instances);
 				valid &= CDRMessage::readInt32(msg,&p->max_samples_per_instance);
@@ -442,7 +433,7 @@ int32_t ParameterList::readParameterListfromCDRMsg(CDRMessage_t*msg,ParameterLis
 			}
 			case PID_TRANSPORT_PRIORITY:
 			{
-				TransportPriorityQosPolicy * p = new TransportPriorityQosPolicy();
+				TransportPriorityQosPolicy* p = plist->m_arena.create<TransportPriorityQosPolicy>();
 				valid &= CDRMessage::readUInt32(msg,&p->value);
 				IF_VALID_ADD
 			}
@@ -455,20 +446,20 @@ int32_t ParameterList::readParameterListfromCDRMsg(CDRMessage_t*msg,ParameterLis
 			}
 			case PID_PARTICIPANT_MANUAL_LIVELINESS_COUNT:
 			{
-				ParameterCount_t*p = new ParameterCount_t(PID_PARTICIPANT_MANUAL_LIVELINESS_COUNT,plength);
+				ParameterCount_t* p = plist->m_arena.create<ParameterCount_t>(PID_PARTICIPANT_MANUAL_LIVELINESS_COUNT,plength);
 				valid&=CDRMessage::readUInt32(msg,&p->count);
 				IF_VALID_ADD
 			}
 			case PID_PARTICIPANT_BUILTIN_ENDPOINTS:
 			case PID_BUILTIN_ENDPOINT_SET:
 			{
-				ParameterBuiltinEndpointSet_t * p = new ParameterBuiltinEndpointSet_t(pid,plength);
+				ParameterBuiltinEndpointSet_t* p = plist->m_arena.create<ParameterBuiltinEndpointSet_t>(pid,plength);
 				valid &= CDRMessage::readUInt32(msg,&p->endpointSet);
 				IF_VALID_ADD
 			}
 			case PID_PARTICIPANT_LEASE_DURATION:
 			{
-				ParameterTime_t* p = new ParameterTime_t(PID_PARTICIPANT_LEASE_DURATION,plength);
+				ParameterTime_t* p = plist->m_arena.create<ParameterTime_t>(PID_PARTICIPANT_LEASE_DURATION,plength);
 				valid &= CDRMessage::readInt32(msg,&p->time.seconds);
 				valid &= CDRMessage::readUInt32(msg,&p->time.fraction);
 				IF_VALID_ADD
@@ -483,19 +474,19 @@ int32_t ParameterList::readParameterListfromCDRMsg(CDRMessage_t*msg,ParameterLis
 			case PID_PARTICIPANT_ENTITYID:
 			case PID_GROUP_ENTITYID:
 			{
-				ParameterEntityId_t * p = new ParameterEntityId_t(pid,plength);
+				ParameterEntityId_t* p = plist->m_arena.create<ParameterEntityId_t>(pid,plength);
 				valid &= CDRMessage::readEntityId(msg,&p->entityId);
 				IF_VALID_ADD
 			}
 			case PID_TYPE_MAX_SIZE_SERIALIZED:
 			{
-				ParameterCount_t * p = new ParameterCount_t(pid,plength);
+				ParameterCount_t* p = plist->m_arena.create<ParameterCount_t>(pid,plength);
 				valid &= CDRMessage::readUInt32(msg,&p->count);
 				IF_VALID_ADD
 			}
             case PID_RELATED_SAMPLE_IDENTITY:
             {
-                ParameterSampleIdentity_t *p = new ParameterSampleIdentity_t(pid, plength);
+                ParameterSampleIdentity_t* p = plist->m_arena.create<ParameterSampleIdentity_t>(pid, plength);
 				valid &= CDRMessage::readData(msg, p->sample_id.writer_guid().guidPrefix.value, GuidPrefix_t::size);
 				valid &= CDRMessage::readData(msg, p->sample_id.writer_guid().entityId.value, EntityId_t::size);
 				valid &= CDRMessage::readInt32(msg, &p->sample_id.sequence_number().high);
@@ -514,6 +505,65 @@ int32_t ParameterList::readParameterListfromCDRMsg(CDRMessage_t*msg,ParameterLis
 	return paramlist_byte_size;
 }
 
+int32_t ParameterList::readInlineQosFromCDRMsg(CDRMessage_t* msg, CacheChange_t* change)
+{
+	uint32_t paramlist_byte_size = 0;
+	ParameterId_t pid;
+	uint16_t plength;
+	for(;;)
+	{
+		if(!CDRMessage::readUInt16(msg,(uint16_t*)&pid) || !CDRMessage::readUInt16(msg,&plength))
+			return -1;
+		paramlist_byte_size += 4;
+		if(pid == PID_SENTINEL)
+			break;
+		if(msg->pos + plength > msg->length)
+			return -1;
+
+		uint32_t param_end = msg->pos + plength;
+		switch(pid)
+		{
+		case PID_KEY_HASH:
+		{
+			if(plength < 16)
+				return -1;
+			CDRMessage::readData(msg,change->instanceHandle.value,16);
+			break;
+		}
+		case PID_STATUS_INFO:
+		{
+			if(plength < 4)
+				return -1;
+			octet status = msg->buffer[msg->pos+3];
+			if(status == 1)
+				change->kind = NOT_ALIVE_DISPOSED;
+			else if (status == 2)
+				change->kind = NOT_ALIVE_UNREGISTERED;
+			else if (status == 3)
+				change->kind = NOT_ALIVE_DISPOSED_UNREGISTERED;
+			break;
+		}
+		case PID_RELATED_SAMPLE_IDENTITY:
+		{
+			if(plength < 24)
+				return -1;
+			SampleIdentity sample_id;
+			CDRMessage::readData(msg, sample_id.writer_guid().guidPrefix.value, GuidPrefix_t::size);
+			CDRMessage::readData(msg, sample_id.writer_guid().entityId.value, EntityId_t::size);
+			CDRMessage::readInt32(msg, &sample_id.sequence_number().high);
+			CDRMessage::readUInt32(msg, &sample_id.sequence_number().low);
+			change->write_params.sample_identity(sample_id);
+			break;
+		}
+		default:
+			break;
+		}
+		msg->pos = param_end;
+		paramlist_byte_size += plength;
+	}
+	return paramlist_byte_size;
+}
+
 } /* namespace pubsub */
 } /* namespace eprosima */
 
@@ -21,6 +21,7 @@
 #include <fastrtps/rtps/common/Locator.h>
 
 #include <fastrtps/rtps/builtin/discovery/participant/PDPSimple.h>
+#include <fastrtps/rtps/builtin/discovery/participant/PDPServer.h>
 #include <fastrtps/rtps/builtin/discovery/endpoint/EDP.h>
 
 #include <fastrtps/rtps/builtin/liveliness/WLP.h>
@@ -84,7 +85,11 @@ bool BuiltinProtocols::initBuiltinProtocols(RTPSParticipantImpl* p_part, Builtin
     m_mandatoryMulticastLocator.set_IP4_address(239,255,0,1);
     if(m_att.metatrafficMulticastLocatorList.empty())
     {
-        m_metatrafficMulticastLocatorList.push_back(m_mandatoryMulticastLocator);
+        // Discovery clients and servers only use unicast.
+        if(m_att.isDiscoveryServer || !m_att.discoveryServerLocatorList.empty())
+            m_useMandatory = false;
+        else
+            m_metatrafficMulticastLocatorList.push_back(m_mandatoryMulticastLocator);
     }
     else
     {
@@ -130,7 +135,10 @@ bool BuiltinProtocols::initBuiltinProtocols(RTPSParticipantImpl* p_part, Builtin
 
     if(m_att.use_SIMPLE_RTPSParticipantDiscoveryProtocol)
     {
-        mp_PDP = new PDPSimple(this);
+        if(m_att.isDiscoveryServer)
+            mp_PDP = new PDPServer(this);
+        else
+            mp_PDP = new PDPSimple(this);
         mp_PDP->initPDP(mp_participantImpl);
         if(m_att.use_WriterLivelinessProtocol)
         {
@@ -219,6 +227,7 @@ bool BuiltinProtocols::removeLocalWriter(RTPSWriter* W)
     }
     if(mp_PDP!=nullptr && mp_PDP->getEDP() != nullptr)
     {
+        mp_PDP->getEDP()->unindexLocalWriter(W);
         ok|= mp_PDP->getEDP()->removeLocalWriter(W);
     }
     return ok;
@@ -229,6 +238,7 @@ bool BuiltinProtocols::removeLocalReader(RTPSReader* R)
     bool ok = false;
     if(mp_PDP!=nullptr && mp_PDP->getEDP() != nullptr)
     {
+        mp_PDP->getEDP()->unindexLocalReader(R);
         ok|= mp_PDP->getEDP()->removeLocalReader(R);
     }
     return ok;
@@ -23,7 +23,6 @@
 
 #include <fastrtps/rtps/builtin/discovery/participant/PDPSimple.h>
 
-#include <fastrtps/rtps/builtin/discovery/participant/timedevent/RemoteParticipantLeaseDuration.h>
 #include <fastrtps/rtps/builtin/BuiltinProtocols.h>
 
 #include "../../participant/RTPSParticipantImpl.h"
@@ -49,7 +48,6 @@ ParticipantProxyData::ParticipantProxyData():
 m_manualLivelinessCount(0),
 		isAlive(false),
 		m_hasChanged(true),
-		mp_leaseDurationTimer(nullptr),
 		mp_mutex(new boost::recursive_mutex())
 {
 
@@ -70,8 +68,6 @@ ParticipantProxyData::~ParticipantProxyData()
 	}
 	m_QosList.inlineQos.deleteParams();
 	m_QosList.allQos.deleteParams();
-	if(this->mp_leaseDurationTimer != nullptr)
-		delete(mp_leaseDurationTimer);
 
 	delete(mp_mutex);
 }
@@ -383,12 +379,6 @@ bool ParticipantProxyData::updateData(ParticipantProxyData& pdata)
 	m_leaseDuration = pdata.m_leaseDuration;
 	m_userData = pdata.m_userData;
 	isAlive = true;
-	if(this->mp_leaseDurationTimer != nullptr)
-	{
-		mp_leaseDurationTimer->cancel_timer();
-		mp_leaseDurationTimer->update_interval(m_leaseDuration);
-		mp_leaseDurationTimer->restart_timer();
-	}
 	return true;
 }
 
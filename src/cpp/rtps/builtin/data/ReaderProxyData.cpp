@@ -32,7 +32,9 @@ ReaderProxyData::ReaderProxyData():
 													m_expectsInlineQos(false),
 													m_userDefinedId(0),
 													m_isAlive(true),
-													m_topicKind(NO_KEY)
+													m_topicKind(NO_KEY),
+													m_serializedIdentityLength(0),
+													m_serializedQosValid(false)
 {
 
 }
@@ -45,150 +47,119 @@ ReaderProxyData::~ReaderProxyData()
 
 bool ReaderProxyData::toParameterList()
 {
-	m_parameterList.deleteParams();
+	CDRMessage_t* msg = &m_parameterList.m_cdrmsg;
+
+	if(m_serializedIdentityLength == 0)
+	{
+		CDRMessage::initCDRMsg(msg);
+		if(!addIdentityToCDRMessage(msg))
+			return false;
+		m_serializedIdentityLength = msg->length;
+		m_serializedQosValid = false;
+	}
+
+	if(!m_serializedQosValid)
+	{
+		// The QoS parameters go after the cached ones.
+		msg->pos = msg->length = m_serializedIdentityLength;
+		if(!addQosToCDRMessage(msg) || !CDRMessage::addParameterSentinel(msg))
+			return false;
+		m_serializedQosValid = true;
+	}
+
+	logInfo(RTPS_PROXY_DATA,"DiscoveredReaderData serialized in " << msg->length << " bytes");
+	return true;
+}
+
+void ReaderProxyData::invalidateSerializedQos()
+{
+	m_serializedQosValid = false;
+}
+
+bool ReaderProxyData::addIdentityToCDRMessage(CDRMessage_t* msg)
+{
+	bool valid = true;
 	for(LocatorListIterator lit = m_unicastLocatorList.begin();
 			lit!=m_unicastLocatorList.end();++lit)
 	{
-		ParameterLocator_t* p = new ParameterLocator_t(PID_UNICAST_LOCATOR,PARAMETER_LOCATOR_LENGTH,*lit);
-		m_parameterList.m_parameters.push_back((Parameter_t*)p);
+		ParameterLocator_t p(PID_UNICAST_LOCATOR,PARAMETER_LOCATOR_LENGTH,*lit);
+		valid &= p.addToCDRMessage(msg);
 	}
 	for(LocatorListIterator lit = m_multicastLocatorList.begin();
 			lit!=m_multicastLocatorList.end();++lit)
 	{
-		ParameterLocator_t* p = new ParameterLocator_t(PID_MULTICAST_LOCATOR,PARAMETER_LOCATOR_LENGTH,*lit);
-		m_parameterList.m_parameters.push_back((Parameter_t*)p);
+		ParameterLocator_t p(PID_MULTICAST_LOCATOR,PARAMETER_LOCATOR_LENGTH,*lit);
+		valid &= p.addToCDRMessage(msg);
 	}
 	{
-		ParameterBool_t * p = new ParameterBool_t(PID_EXPECTS_INLINE_QOS,PARAMETER_BOOL_LENGTH,m_expectsInlineQos);
-		m_parameterList.m_parameters.push_back((Parameter_t*)p);
+		ParameterGuid_t p(PID_PARTICIPANT_GUID,PARAMETER_GUID_LENGTH,m_RTPSParticipantKey);
+		valid &= p.addToCDRMessage(msg);
 	}
 	{
-		ParameterGuid_t* p = new ParameterGuid_t(PID_PARTICIPANT_GUID,PARAMETER_GUID_LENGTH,m_RTPSParticipantKey);
-		m_parameterList.m_parameters.push_back((Parameter_t*)p);
+		ParameterString_t p(PID_TOPIC_NAME,0,m_topicName);
+		valid &= p.addToCDRMessage(msg);
 	}
 	{
-		ParameterString_t * p = new ParameterString_t(PID_TOPIC_NAME,0,m_topicName);
-		m_parameterList.m_parameters.push_back((Parameter_t*)p);
+		ParameterString_t p(PID_TYPE_NAME,0,m_typeName);
+		valid &= p.addToCDRMessage(msg);
 	}
 	{
-		ParameterString_t * p = new ParameterString_t(PID_TYPE_NAME,0,m_typeName);
-		m_parameterList.m_parameters.push_back((Parameter_t*)p);
+		ParameterKey_t p(PID_KEY_HASH,16,m_key);
+		valid &= p.addToCDRMessage(msg);
 	}
 	{
-		ParameterKey_t * p = new ParameterKey_t(PID_KEY_HASH,16,m_key);
-		m_parameterList.m_parameters.push_back((Parameter_t*)p);
+		ParameterGuid_t p(PID_ENDPOINT_GUID,16,m_guid);
+		valid &= p.addToCDRMessage(msg);
 	}
 	{
-		ParameterGuid_t * p = new ParameterGuid_t(PID_ENDPOINT_GUID,16,m_guid);
-		m_parameterList.m_parameters.push_back((Parameter_t*)p);
+		ParameterProtocolVersion_t p(PID_PROTOCOL_VERSION,4);
+		valid &= p.addToCDRMessage(msg);
 	}
 	{
-		ParameterProtocolVersion_t* p = new ParameterProtocolVersion_t(PID_PROTOCOL_VERSION,4);
-		m_parameterList.m_parameters.push_back((Parameter_t*)p);
+		ParameterVendorId_t p(PID_VENDORID,4);
+		valid &= p.addToCDRMessage(msg);
 	}
+	return valid;
+}
+
+bool ReaderProxyData::addQosToCDRMessage(CDRMessage_t* msg)
+{
+	bool valid = true;
 	{
-		ParameterVendorId_t*p = new ParameterVendorId_t(PID_VENDORID,4);
-		m_parameterList.m_parameters.push_back((Parameter_t*)p);
+		ParameterBool_t p(PID_EXPECTS_INLINE_QOS,PARAMETER_BOOL_LENGTH,m_expectsInlineQos);
+		valid &= p.addToCDRMessage(msg);
 	}
 	if(m_qos.m_durability.sendAlways() || m_qos.m_durability.hasChanged)
-	{
-		DurabilityQosPolicy*p = new DurabilityQosPolicy();
-		*p = m_qos.m_durability;
-		m_parameterList.m_parameters.push_back((Parameter_t*)p);
-	}
+		valid &= m_qos.m_durability.addToCDRMessage(msg);
 	if(m_qos.m_durabilityService.sendAlways() || m_qos.m_durabilityService.hasChanged)
-	{
-		DurabilityServiceQosPolicy*p = new DurabilityServiceQosPolicy();
-		*p = m_qos.m_durabilityService;
-		m_parameterList.m_parameters.push_back((Parameter_t*)p);
-	}
+		valid &= m_qos.m_durabilityService.addToCDRMessage(msg);
 	if(m_qos.m_deadline.sendAlways() || m_qos.m_deadline.hasChanged)
-	{
-		DeadlineQosPolicy*p = new DeadlineQosPolicy();
-		*p = m_qos.m_deadline;
-		m_parameterList.m_parameters.push_back((Parameter_t*)p);
-	}
+		valid &= m_qos.m_deadline.addToCDRMessage(msg);
 	if(m_qos.m_latencyBudget.sendAlways() || m_qos.m_latencyBudget.hasChanged)
-	{
-		LatencyBudgetQosPolicy*p = new LatencyBudgetQosPolicy();
-		*p = m_qos.m_latencyBudget;
-		m_parameterList.m_parameters.push_back((Parameter_t*)p);
-	}
+		valid &= m_qos.m_latencyBudget.addToCDRMessage(msg);
 	if(m_qos.m_liveliness.sendAlways() || m_qos.m_liveliness.hasChanged)
-	{
-		LivelinessQosPolicy*p = new LivelinessQosPolicy();
-		*p = m_qos.m_liveliness;
-		m_parameterList.m_parameters.push_back((Parameter_t*)p);
-	}
+		valid &= m_qos.m_liveliness.addToCDRMessage(msg);
 	if(m_qos.m_reliability.sendAlways() || m_qos.m_reliability.hasChanged)
-	{
-		ReliabilityQosPolicy*p = new ReliabilityQosPolicy();
-		*p = m_qos.m_reliability;
-		m_parameterList.m_parameters.push_back((Parameter_t*)p);
-	}
+		valid &= m_qos.m_reliability.addToCDRMessage(msg);
 	if(m_qos.m_lifespan.sendAlways() || m_qos.m_lifespan.hasChanged)
-	{
-		LifespanQosPolicy*p = new LifespanQosPolicy();
-		*p = m_qos.m_lifespan;
-		m_parameterList.m_parameters.push_back((Parameter_t*)p);
-	}
+		valid &= m_qos.m_lifespan.addToCDRMessage(msg);
 	if(m_qos.m_userData.sendAlways() || m_qos.m_userData.hasChanged)
-	{
-		UserDataQosPolicy*p = new UserDataQosPolicy();
-		*p = m_qos.m_userData;
-		m_parameterList.m_parameters.push_back((Parameter_t*)p);
-	}
+		valid &= m_qos.m_userData.addToCDRMessage(msg);
 	if(m_qos.m_timeBasedFilter.sendAlways() || m_qos.m_timeBasedFilter.hasChanged)
-	{
-		TimeBasedFilterQosPolicy*p = new TimeBasedFilterQosPolicy();
-		*p = m_qos.m_timeBasedFilter;
-		m_parameterList.m_parameters.push_back((Parameter_t*)p);
-	}
+		valid &= m_qos.m_timeBasedFilter.addToCDRMessage(msg);
 	if(m_qos.m_ownership.sendAlways() || m_qos.m_ownership.hasChanged)
-	{
-		OwnershipQosPolicy*p = new OwnershipQosPolicy();
-		*p = m_qos.m_ownership;
-		m_parameterList.m_parameters.push_back((Parameter_t*)p);
-	}
+		valid &= m_qos.m_ownership.addToCDRMessage(msg);
 	if(m_qos.m_destinationOrder.sendAlways() || m_qos.m_destinationOrder.hasChanged)
-	{
-		DestinationOrderQosPolicy*p = new DestinationOrderQosPolicy();
-		*p = m_qos.m_destinationOrder;
-		m_parameterList.m_parameters.push_back((Parameter_t*)p);
-	}
+		valid &= m_qos.m_destinationOrder.addToCDRMessage(msg);
 	if(m_qos.m_presentation.sendAlways() || m_qos.m_presentation.hasChanged)
-	{
-		PresentationQosPolicy*p = new PresentationQosPolicy();
-		*p = m_qos.m_presentation;
-		m_parameterList.m_parameters.push_back((Parameter_t*)p);
-	}
+		valid &= m_qos.m_presentation.addToCDRMessage(msg);
 	if(m_qos.m_partition.sendAlways() || m_qos.m_partition.hasChanged)
-	{
-		PartitionQosPolicy*p = new PartitionQosPolicy();
-		*p = m_qos.m_partition;
-		m_parameterList.m_parameters.push_back((Parameter_t*)p);
-	}
+		valid &= m_qos.m_partition.addToCDRMessage(msg);
 	if(m_qos.m_topicData.sendAlways() || m_qos.m_topicData.hasChanged)
-	{
-		TopicDataQosPolicy*p = new TopicDataQosPolicy();
-		*p = m_qos.m_topicData;
-		m_parameterList.m_parameters.push_back((Parameter_t*)p);
-	}
+		valid &= m_qos.m_topicData.addToCDRMessage(msg);
 	if(m_qos.m_groupData.sendAlways() || m_qos.m_groupData.hasChanged)
-	{
-		GroupDataQosPolicy*p = new GroupDataQosPolicy();
-		*p = m_qos.m_groupData;
-		m_parameterList.m_parameters.push_back((Parameter_t*)p);
-	}
-	if(m_qos.m_timeBasedFilter.sendAlways() || m_qos.m_timeBasedFilter.hasChanged)
-	{
-		TimeBasedFilterQosPolicy*p = new TimeBasedFilterQosPolicy();
-		*p = m_qos.m_timeBasedFilter;
-		m_parameterList.m_parameters.push_back((Parameter_t*)p);
-	}
-
-	logInfo(RTPS_PROXY_DATA,"DiscoveredReaderData converted to ParameterList with " << m_parameterList.m_parameters.size()<< " parameters");
-	return true;
+		valid &= m_qos.m_groupData.addToCDRMessage(msg);
+	return valid;
 }
 
 bool ReaderProxyData::readFromCDRMessage(CDRMessage_t* msg)
@@ -389,6 +360,7 @@ void ReaderProxyData::clear()
 
 
 	m_parameterList.deleteParams();
+	m_serializedIdentityLength = 0;
 }
 
 void ReaderProxyData::update(ReaderProxyData* rdata)
@@ -397,6 +369,7 @@ void ReaderProxyData::update(ReaderProxyData* rdata)
 	m_multicastLocatorList = rdata->m_multicastLocatorList;
 	m_qos.setQos(rdata->m_qos,false);
 	m_isAlive = rdata->m_isAlive;
+	m_serializedIdentityLength = 0;
 }
 
 void ReaderProxyData::copy(ReaderProxyData* rdata)
@@ -414,6 +387,7 @@ void ReaderProxyData::copy(ReaderProxyData* rdata)
 	m_expectsInlineQos = rdata->m_expectsInlineQos;
 	m_isAlive = rdata->m_isAlive;
 	m_topicKind = rdata->m_topicKind;
+	m_serializedIdentityLength = 0;
 }
 
 RemoteReaderAttributes& ReaderProxyData::toRemoteReaderAttributes()
@@ -26,6 +26,8 @@
 
 #include <fastrtps/rtps/writer/RTPSWriter.h>
 #include <fastrtps/rtps/reader/RTPSReader.h>
+#include <fastrtps/rtps/reader/StatefulReader.h>
+#include <fastrtps/rtps/reader/WriterProxy.h>
 #include <fastrtps/rtps/writer/WriterListener.h>
 #include <fastrtps/rtps/reader/ReaderListener.h>
 
@@ -36,9 +38,11 @@
 #include <fastrtps/attributes/TopicAttributes.h>
 #include <fastrtps/rtps/common/MatchingInfo.h>
 
-#include <fastrtps/utils/StringMatching.h>
+#include <fastrtps/utils/PartitionMatcher.h>
 #include <fastrtps/log/Log.h>
 
+#include <algorithm>
+
 #include <boost/thread/recursive_mutex.hpp>
 #include <boost/thread/lock_guard.hpp>
 
@@ -85,9 +89,13 @@ bool EDP::newLocalReaderProxyData(RTPSReader* reader,TopicAttributes& att, Reade
 		delete(rpd);
 		return false;
 	}
+	{
+		boost::lock_guard<boost::recursive_mutex> pguard(*mp_PDP->getMutex());
+		findTopic(rpd->m_topicName, rpd->m_typeName, true)->localReaders.push_back(std::make_pair(reader, rpd));
+	}
 	//PAIRING
     pairingReaderProxy(pdata, rpd);
-	pairingReader(reader);
+	pairingReader(reader, pdata, rpd);
 	//DO SOME PROCESSING DEPENDING ON THE IMPLEMENTATION (SIMPLE OR STATIC)
 	processLocalReaderProxyData(rpd);
 	return true;
@@ -116,9 +124,13 @@ bool EDP::newLocalWriterProxyData(RTPSWriter* writer,TopicAttributes& att, Write
 		delete(wpd);
 		return false;
 	}
+	{
+		boost::lock_guard<boost::recursive_mutex> pguard(*mp_PDP->getMutex());
+		findTopic(wpd->topicName(), wpd->typeName(), true)->localWriters.push_back(std::make_pair(writer, wpd));
+	}
 	//PAIRING
     pairingWriterProxy(pdata, wpd);
-	pairingWriter(writer);
+	pairingWriter(writer, pdata, wpd);
 	//DO SOME PROCESSING DEPENDING ON THE IMPLEMENTATION (SIMPLE OR STATIC)
 	processLocalWriterProxyData(wpd);
 	return true;
@@ -132,10 +144,11 @@ bool EDP::updatedLocalReader(RTPSReader* R,ReaderQos& rqos)
 	{
 		rdata->m_qos.setQos(rqos,false);
 		rdata->m_expectsInlineQos = R->expectsInlineQos();
+		rdata->invalidateSerializedQos();
 		processLocalReaderProxyData(rdata);
 		//this->updatedReaderProxy(rdata);
 		pairingReaderProxy(pdata, rdata);
-		pairingReader(R);
+		pairingReader(R, pdata, rdata);
 		return true;
 	}
 	return false;
@@ -148,10 +161,11 @@ bool EDP::updatedLocalWriter(RTPSWriter* W,WriterQos& wqos)
 	if(this->mp_PDP->lookupWriterProxyData(W->getGuid(),&wdata, &pdata))
 	{
 		wdata->m_qos.setQos(wqos,false);
+		wdata->invalidateSerializedQos();
 		processLocalWriterProxyData(wdata);
 		//this->updatedWriterProxy(wdata);
 		pairingWriterProxy(pdata, wdata);
-		pairingWriter(W);
+		pairingWriter(W, pdata, wdata);
 		return true;
 	}
 	return false;
@@ -196,21 +210,30 @@ bool EDP::unpairWriterProxy(ParticipantProxyData *pdata, WriterProxyData* wdata)
 {
 	logInfo(RTPS_EDP, wdata->guid() << " in topic: " << wdata->topicName());
 	boost::lock_guard<boost::recursive_mutex> guard(*mp_RTPSParticipant->getParticipantMutex());
-	for(std::vector<RTPSReader*>::iterator rit = mp_RTPSParticipant->userReadersListBegin();
-			rit!=mp_RTPSParticipant->userReadersListEnd();++rit)
+	// Only readers of the same topic can be matched with it.
+	std::vector<std::pair<RTPSReader*, ReaderProxyData*>> local_readers;
+	{
+		boost::lock_guard<boost::recursive_mutex> pguard(*mp_PDP->getMutex());
+		TopicEndpoints* topic = findTopic(wdata->topicName(), wdata->typeName(), false);
+		if(topic == nullptr)
+			return true;
+		local_readers = topic->localReaders;
+	}
+	for(auto rit = local_readers.begin(); rit != local_readers.end(); ++rit)
 	{
+		RTPSReader* R = rit->first;
 		RemoteWriterAttributes watt;
         boost::unique_lock<boost::recursive_mutex> plock(*pdata->mp_mutex);
 		watt.guid = wdata->guid();
-		if((*rit)->matched_writer_remove(watt))
+		if(R->matched_writer_remove(watt))
 		{
 			//MATCHED AND ADDED CORRECTLY:
-			if((*rit)->getListener()!=nullptr)
+			if(R->getListener()!=nullptr)
 			{
 				MatchingInfo info;
 				info.status = REMOVED_MATCHING;
 				info.remoteEndpointGuid = wdata->guid();
-				(*rit)->getListener()->onReaderMatched((*rit),info);
+				R->getListener()->onReaderMatched(R,info);
 			}
 		}
 	}
@@ -221,21 +244,30 @@ bool EDP::unpairReaderProxy(ParticipantProxyData *pdata, ReaderProxyData* rdata)
 {
 	logInfo(RTPS_EDP,rdata->m_guid << " in topic: "<< rdata->m_topicName);
 	boost::lock_guard<boost::recursive_mutex> guard(*mp_RTPSParticipant->getParticipantMutex());
-	for(std::vector<RTPSWriter*>::iterator wit = mp_RTPSParticipant->userWritersListBegin();
-			wit!=mp_RTPSParticipant->userWritersListEnd();++wit)
+	// Only writers of the same topic can be matched with it.
+	std::vector<std::pair<RTPSWriter*, WriterProxyData*>> local_writers;
 	{
+		boost::lock_guard<boost::recursive_mutex> pguard(*mp_PDP->getMutex());
+		TopicEndpoints* topic = findTopic(rdata->m_topicName, rdata->m_typeName, false);
+		if(topic == nullptr)
+			return true;
+		local_writers = topic->localWriters;
+	}
+	for(auto wit = local_writers.begin(); wit != local_writers.end(); ++wit)
+	{
+		RTPSWriter* W = wit->first;
 		RemoteReaderAttributes ratt;
         boost::unique_lock<boost::recursive_mutex> plock(*pdata->mp_mutex);
 		ratt.guid = rdata->m_guid;
-		if((*wit)->matched_reader_remove(ratt))
+		if(W->matched_reader_remove(ratt))
 		{
 			//MATCHED AND ADDED CORRECTLY:
-			if((*wit)->getListener()!=nullptr)
+			if(W->getListener()!=nullptr)
 			{
 				MatchingInfo info;
 				info.status = REMOVED_MATCHING;
 				info.remoteEndpointGuid = rdata->m_guid;
-				(*wit)->getListener()->onWriterMatched((*wit),info);
+				W->getListener()->onWriterMatched(W,info);
 			}
 		}
 	}
@@ -283,53 +315,7 @@ bool EDP::validMatching(WriterProxyData* wdata,ReaderProxyData* rdata)
 		return false;
 	}
 	//Partition check:
-	bool matched = false;
-	if(wdata->m_qos.m_partition.names.empty() && rdata->m_qos.m_partition.names.empty())
-	{
-		matched = true;
-	}
-	else if(wdata->m_qos.m_partition.names.empty() && rdata->m_qos.m_partition.names.size()>0)
-	{
-		for(std::vector<std::string>::const_iterator rnameit = rdata->m_qos.m_partition.names.begin();
-				rnameit!=rdata->m_qos.m_partition.names.end();++rnameit)
-		{
-			if(rnameit->size()==0)
-			{
-				matched = true;
-				break;
-			}
-		}
-	}
-	else if(wdata->m_qos.m_partition.names.size()>0 && rdata->m_qos.m_partition.names.empty() )
-	{
-		for(std::vector<std::string>::const_iterator wnameit = wdata->m_qos.m_partition.names.begin();
-				wnameit !=  wdata->m_qos.m_partition.names.end();++wnameit)
-		{
-			if(wnameit->size()==0)
-			{
-				matched = true;
-				break;
-			}
-		}
-	}
-	else
-	{
-		for(std::vector<std::string>::const_iterator wnameit = wdata->m_qos.m_partition.names.begin();
-				wnameit !=  wdata->m_qos.m_partition.names.end();++wnameit)
-		{
-			for(std::vector<std::string>::const_iterator rnameit = rdata->m_qos.m_partition.names.begin();
-					rnameit!=rdata->m_qos.m_partition.names.end();++rnameit)
-			{
-				if(StringMatching::matchString(wnameit->c_str(),rnameit->c_str()))
-				{
-					matched = true;
-					break;
-				}
-			}
-			if(matched)
-				break;
-		}
-	}
+	bool matched = matchPartitions(rdata, wdata);
 	if(!matched) //Different partitions
 		logWarning(RTPS_EDP,"INCOMPATIBLE QOS (topic: "<< rdata->m_topicName<<"): Different Partitions");
 	return matched;
@@ -370,227 +356,338 @@ bool EDP::validMatching(ReaderProxyData* rdata,WriterProxyData* wdata)
 		return false;
 	}
 	//Partition check:
-	bool matched = false;
-	if(rdata->m_qos.m_partition.names.empty() && wdata->m_qos.m_partition.names.empty())
+	bool matched = matchPartitions(rdata, wdata);
+	if(!matched) //Different partitions
+		logWarning(RTPS_EDP, "INCOMPATIBLE QOS (topic: " <<  wdata->topicName() << "): Different Partitions");
+
+	return matched;
+
+}
+
+bool EDP::matchPartitions(ReaderProxyData* rdata, WriterProxyData* wdata)
+{
+	// Compiling is a no-op while the partition names do not change.
+	rdata->m_partitionMatcher.compile(rdata->m_qos.m_partition.names);
+	wdata->m_partitionMatcher.compile(wdata->m_qos.m_partition.names);
+	return wdata->m_partitionMatcher.matches(rdata->m_partitionMatcher);
+}
+
+EDP::TopicEndpoints* EDP::findTopic(const std::string& topicName, const std::string& typeName, bool create)
+{
+	t_m_TopicEndpoints::iterator tit = m_topics.find(std::make_pair(topicName, typeName));
+	if(tit != m_topics.end())
+		return &tit->second;
+
+	if(!create)
+		return nullptr;
+
+	return &m_topics[std::make_pair(topicName, typeName)];
+}
+
+void EDP::releaseTopic(const std::string& topicName, const std::string& typeName)
+{
+	t_m_TopicEndpoints::iterator tit = m_topics.find(std::make_pair(topicName, typeName));
+	if(tit != m_topics.end() && tit->second.empty())
+		m_topics.erase(tit);
+}
+
+void EDP::indexReaderProxy(ParticipantProxyData* pdata, ReaderProxyData* rdata)
+{
+	findTopic(rdata->m_topicName, rdata->m_typeName, true)->readers.push_back(std::make_pair(pdata, rdata));
+}
+
+void EDP::indexWriterProxy(ParticipantProxyData* pdata, WriterProxyData* wdata)
+{
+	findTopic(wdata->topicName(), wdata->typeName(), true)->writers.push_back(std::make_pair(pdata, wdata));
+}
+
+void EDP::unindexReaderProxy(ReaderProxyData* rdata)
+{
+	TopicEndpoints* topic = findTopic(rdata->m_topicName, rdata->m_typeName, false);
+	if(topic == nullptr)
+		return;
+
+	for(auto rit = topic->readers.begin(); rit != topic->readers.end(); ++rit)
 	{
-		matched = true;
+		if(rit->second == rdata)
+		{
+			topic->readers.erase(rit);
+			break;
+		}
 	}
-	else if(rdata->m_qos.m_partition.names.empty() && wdata->m_qos.m_partition.names.size()>0)
+	for(auto rit = topic->localReaders.begin(); rit != topic->localReaders.end(); ++rit)
 	{
-		for(std::vector<std::string>::const_iterator rnameit = wdata->m_qos.m_partition.names.begin();
-				rnameit!=wdata->m_qos.m_partition.names.end();++rnameit)
+		if(rit->second == rdata)
 		{
-			if(rnameit->size()==0)
+			topic->localReaders.erase(rit);
+			break;
+		}
+	}
+	releaseTopic(rdata->m_topicName, rdata->m_typeName);
+}
+
+void EDP::unindexWriterProxy(WriterProxyData* wdata)
+{
+	TopicEndpoints* topic = findTopic(wdata->topicName(), wdata->typeName(), false);
+	if(topic == nullptr)
+		return;
+
+	for(auto wit = topic->writers.begin(); wit != topic->writers.end(); ++wit)
+	{
+		if(wit->second == wdata)
+		{
+			topic->writers.erase(wit);
+			break;
+		}
+	}
+	for(auto wit = topic->localWriters.begin(); wit != topic->localWriters.end(); ++wit)
+	{
+		if(wit->second == wdata)
+		{
+			topic->localWriters.erase(wit);
+			break;
+		}
+	}
+	releaseTopic(wdata->topicName(), wdata->typeName());
+}
+
+void EDP::unindexLocalReader(RTPSReader* R)
+{
+	boost::lock_guard<boost::recursive_mutex> pguard(*mp_PDP->getMutex());
+	for(auto tit = m_topics.begin(); tit != m_topics.end(); ++tit)
+	{
+		std::vector<std::pair<RTPSReader*, ReaderProxyData*>>& local_readers = tit->second.localReaders;
+		for(auto rit = local_readers.begin(); rit != local_readers.end(); ++rit)
+		{
+			if(rit->first == R)
 			{
-				matched = true;
-				break;
+				local_readers.erase(rit);
+				if(tit->second.empty())
+					m_topics.erase(tit);
+				return;
 			}
 		}
 	}
-	else if(rdata->m_qos.m_partition.names.size()>0 && wdata->m_qos.m_partition.names.empty() )
+}
+
+void EDP::unindexLocalWriter(RTPSWriter* W)
+{
+	boost::lock_guard<boost::recursive_mutex> pguard(*mp_PDP->getMutex());
+	for(auto tit = m_topics.begin(); tit != m_topics.end(); ++tit)
 	{
-		for(std::vector<std::string>::const_iterator wnameit = rdata->m_qos.m_partition.names.begin();
-				wnameit !=  rdata->m_qos.m_partition.names.end();++wnameit)
+		std::vector<std::pair<RTPSWriter*, WriterProxyData*>>& local_writers = tit->second.localWriters;
+		for(auto wit = local_writers.begin(); wit != local_writers.end(); ++wit)
 		{
-			if(wnameit->size()==0)
+			if(wit->first == W)
 			{
-				matched = true;
-				break;
+				local_writers.erase(wit);
+				if(tit->second.empty())
+					m_topics.erase(tit);
+				return;
 			}
 		}
 	}
+}
+
+void EDP::topicParticipants(const std::string& topicName, const std::string& typeName, EndpointKind_t kind,
+		std::vector<ParticipantProxyData*>& participants)
+{
+	TopicEndpoints* topic = findTopic(topicName, typeName, false);
+	if(topic == nullptr)
+		return;
+
+	if(kind == WRITER)
+	{
+		for(auto wit = topic->writers.begin(); wit != topic->writers.end(); ++wit)
+		{
+			if(std::find(participants.begin(), participants.end(), wit->first) == participants.end())
+				participants.push_back(wit->first);
+		}
+	}
 	else
 	{
-		for(std::vector<std::string>::const_iterator wnameit = rdata->m_qos.m_partition.names.begin();
-				wnameit !=  rdata->m_qos.m_partition.names.end();++wnameit)
+		for(auto rit = topic->readers.begin(); rit != topic->readers.end(); ++rit)
 		{
-			for(std::vector<std::string>::const_iterator rnameit = wdata->m_qos.m_partition.names.begin();
-					rnameit!=wdata->m_qos.m_partition.names.end();++rnameit)
-			{
-				if(StringMatching::matchString(wnameit->c_str(),rnameit->c_str()))
-				{
-					matched = true;
-					break;
-				}
-			}
-			if(matched)
-				break;
+			if(std::find(participants.begin(), participants.end(), rit->first) == participants.end())
+				participants.push_back(rit->first);
 		}
 	}
-	if(!matched) //Different partitions
-		logWarning(RTPS_EDP, "INCOMPATIBLE QOS (topic: " <<  wdata->topicName() << "): Different Partitions");
+}
 
-	return matched;
+void EDP::assertRemoteWriterLiveliness(WriterProxyData* wdata)
+{
+	TopicEndpoints* topic = findTopic(wdata->topicName(), wdata->typeName(), false);
+	if(topic == nullptr)
+		return;
 
+	for(auto rit = topic->localReaders.begin(); rit != topic->localReaders.end(); ++rit)
+	{
+		if(rit->first->getAttributes()->reliabilityKind == RELIABLE)
+		{
+			WriterProxy* WP;
+			if(static_cast<StatefulReader*>(rit->first)->matched_writer_lookup(wdata->guid(), &WP))
+				WP->assertLiveliness();
+		}
+	}
 }
 
 //TODO Estas cuatro funciones comparten codigo comun (2 a 2) y se podrían seguramente combinar.
 
-bool EDP::pairingReader(RTPSReader* R)
+bool EDP::pairingReader(RTPSReader* R, ParticipantProxyData* pdata, ReaderProxyData* rdata)
 {
-    ParticipantProxyData* pdata = nullptr;
-	ReaderProxyData* rdata = nullptr;
-	if(this->mp_PDP->lookupReaderProxyData(R->getGuid(),&rdata, &pdata))
+	logInfo(RTPS_EDP,R->getGuid()<<" in topic: \"" << rdata->m_topicName<<"\"");
+	boost::lock_guard<boost::recursive_mutex> pguard(*mp_PDP->getMutex());
+	TopicEndpoints* topic = findTopic(rdata->m_topicName, rdata->m_typeName, false);
+	if(topic == nullptr)
+		return true;
+	// Listeners can create or remove endpoints, so the candidates are copied.
+	std::vector<std::pair<ParticipantProxyData*, WriterProxyData*>> writers(topic->writers);
+	for(auto wdatait = writers.begin(); wdatait != writers.end(); ++wdatait)
 	{
-		logInfo(RTPS_EDP,R->getGuid()<<" in topic: \"" << rdata->m_topicName<<"\"");
-		boost::lock_guard<boost::recursive_mutex> pguard(*mp_PDP->getMutex());
-		for(std::vector<ParticipantProxyData*>::const_iterator pit = mp_PDP->ParticipantProxiesBegin();
-				pit!=mp_PDP->ParticipantProxiesEnd();++pit)
+		boost::lock_guard<boost::recursive_mutex> guard(*wdatait->first->mp_mutex);
+		WriterProxyData* wdata = wdatait->second;
+
+		pdata->mp_mutex->lock();
+		bool valid = validMatching(rdata, wdata);
+		pdata->mp_mutex->unlock();
+
+		if(valid)
 		{
-			boost::lock_guard<boost::recursive_mutex> guard(*(*pit)->mp_mutex);
-			for(std::vector<WriterProxyData*>::iterator wdatait = (*pit)->m_writers.begin();
-					wdatait!=(*pit)->m_writers.end();++wdatait)
+			logInfo(RTPS_EDP, "Valid Matching to writerProxy: " << wdata->guid());
+			if(R->matched_writer_add(wdata->toRemoteWriterAttributes()))
 			{
-                pdata->mp_mutex->lock();
-                bool valid = validMatching(rdata, *wdatait);
-                pdata->mp_mutex->unlock();
-
-				if(valid)
+				//MATCHED AND ADDED CORRECTLY:
+				if(R->getListener()!=nullptr)
 				{
-					logInfo(RTPS_EDP, "Valid Matching to writerProxy: " << (*wdatait)->guid());
-					if(R->matched_writer_add((*wdatait)->toRemoteWriterAttributes()))
-					{
-						//MATCHED AND ADDED CORRECTLY:
-						if(R->getListener()!=nullptr)
-						{
-							MatchingInfo info;
-							info.status = MATCHED_MATCHING;
-							info.remoteEndpointGuid = (*wdatait)->guid();
-							R->getListener()->onReaderMatched(R,info);
-						}
-					}
+					MatchingInfo info;
+					info.status = MATCHED_MATCHING;
+					info.remoteEndpointGuid = wdata->guid();
+					R->getListener()->onReaderMatched(R,info);
 				}
-				else
+			}
+		}
+		else
+		{
+			if(R->matched_writer_is_matched(wdata->toRemoteWriterAttributes())
+					&& R->matched_writer_remove(wdata->toRemoteWriterAttributes()))
+			{
+				//MATCHED AND ADDED CORRECTLY:
+				if(R->getListener()!=nullptr)
 				{
-					//logInfo(RTPS_EDP,RTPS_CYAN<<"Valid Matching to writerProxy: "<<(*wdatait)->m_guid<<RTPS_DEF<<endl);
-					if(R->matched_writer_is_matched((*wdatait)->toRemoteWriterAttributes())
-							&& R->matched_writer_remove((*wdatait)->toRemoteWriterAttributes()))
-					{
-						//MATCHED AND ADDED CORRECTLY:
-						if(R->getListener()!=nullptr)
-						{
-							MatchingInfo info;
-							info.status = REMOVED_MATCHING;
-							info.remoteEndpointGuid = (*wdatait)->guid();
-							R->getListener()->onReaderMatched(R,info);
-						}
-					}
+					MatchingInfo info;
+					info.status = REMOVED_MATCHING;
+					info.remoteEndpointGuid = wdata->guid();
+					R->getListener()->onReaderMatched(R,info);
 				}
 			}
 		}
-		return true;
 	}
-	return false;
+	return true;
 }
 
-//TODO Añadir WriterProxyData como argumento con nullptr como valor por defecto.
-bool EDP::pairingWriter(RTPSWriter* W)
+bool EDP::pairingWriter(RTPSWriter* W, ParticipantProxyData* pdata, WriterProxyData* wdata)
 {
-    ParticipantProxyData* pdata = nullptr;
-	WriterProxyData* wdata = nullptr;
-	if(this->mp_PDP->lookupWriterProxyData(W->getGuid(),&wdata, &pdata))
+	logInfo(RTPS_EDP, W->getGuid() << " in topic: \"" << wdata->topicName() <<"\"");
+	boost::lock_guard<boost::recursive_mutex> pguard(*mp_PDP->getMutex());
+	TopicEndpoints* topic = findTopic(wdata->topicName(), wdata->typeName(), false);
+	if(topic == nullptr)
+		return true;
+	// Listeners can create or remove endpoints, so the candidates are copied.
+	std::vector<std::pair<ParticipantProxyData*, ReaderProxyData*>> readers(topic->readers);
+	for(auto rdatait = readers.begin(); rdatait != readers.end(); ++rdatait)
 	{
-		logInfo(RTPS_EDP, W->getGuid() << " in topic: \"" << wdata->topicName() <<"\"");
-		boost::lock_guard<boost::recursive_mutex> pguard(*mp_PDP->getMutex());
-		for(std::vector<ParticipantProxyData*>::const_iterator pit = mp_PDP->ParticipantProxiesBegin();
-				pit!=mp_PDP->ParticipantProxiesEnd();++pit)
+		boost::lock_guard<boost::recursive_mutex> guard(*rdatait->first->mp_mutex);
+		ReaderProxyData* rdata = rdatait->second;
+
+		pdata->mp_mutex->lock();
+		bool valid = validMatching(wdata, rdata);
+		pdata->mp_mutex->unlock();
+
+		if(valid)
 		{
-			boost::lock_guard<boost::recursive_mutex> guard(*(*pit)->mp_mutex);
-			for(std::vector<ReaderProxyData*>::iterator rdatait = (*pit)->m_readers.begin();
-					rdatait!=(*pit)->m_readers.end(); ++rdatait)
+			logInfo(RTPS_EDP,"Valid Matching to readerProxy: "<<rdata->m_guid);
+			if(W->matched_reader_add(rdata->toRemoteReaderAttributes()))
 			{
-                pdata->mp_mutex->lock();
-                bool valid = validMatching(wdata, *rdatait);
-                pdata->mp_mutex->unlock();
-
-				if(valid)
+				//MATCHED AND ADDED CORRECTLY:
+				if(W->getListener()!=nullptr)
 				{
-					//std::cout << "VALID MATCHING to " <<(*rdatait)->m_guid<< std::endl;
-					logInfo(RTPS_EDP,"Valid Matching to readerProxy: "<<(*rdatait)->m_guid);
-					if(W->matched_reader_add((*rdatait)->toRemoteReaderAttributes()))
-					{
-						//MATCHED AND ADDED CORRECTLY:
-						if(W->getListener()!=nullptr)
-						{
-							MatchingInfo info;
-							info.status = MATCHED_MATCHING;
-							info.remoteEndpointGuid = (*rdatait)->m_guid;
-							W->getListener()->onWriterMatched(W,info);
-						}
-					}
+					MatchingInfo info;
+					info.status = MATCHED_MATCHING;
+					info.remoteEndpointGuid = rdata->m_guid;
+					W->getListener()->onWriterMatched(W,info);
 				}
-				else
+			}
+		}
+		else
+		{
+			if(W->matched_reader_is_matched(rdata->toRemoteReaderAttributes()) &&
+					W->matched_reader_remove(rdata->toRemoteReaderAttributes()))
+			{
+				//MATCHED AND ADDED CORRECTLY:
+				if(W->getListener()!=nullptr)
 				{
-					//logInfo(RTPS_EDP,RTPS_CYAN<<"Valid Matching to writerProxy: "<<(*wdatait)->m_guid<<RTPS_DEF<<endl);
-					if(W->matched_reader_is_matched((*rdatait)->toRemoteReaderAttributes()) &&
-							W->matched_reader_remove((*rdatait)->toRemoteReaderAttributes()))
-					{
-						//MATCHED AND ADDED CORRECTLY:
-						if(W->getListener()!=nullptr)
-						{
-							MatchingInfo info;
-							info.status = REMOVED_MATCHING;
-							info.remoteEndpointGuid = (*rdatait)->m_guid;
-							W->getListener()->onWriterMatched(W,info);
-						}
-					}
+					MatchingInfo info;
+					info.status = REMOVED_MATCHING;
+					info.remoteEndpointGuid = rdata->m_guid;
+					W->getListener()->onWriterMatched(W,info);
 				}
 			}
 		}
-		return true;
 	}
-	return false;
+	return true;
 }
 
 bool EDP::pairingReaderProxy(ParticipantProxyData* pdata, ReaderProxyData* rdata)
 {
 	logInfo(RTPS_EDP,rdata->m_guid<<" in topic: \"" << rdata->m_topicName <<"\"");
 	boost::lock_guard<boost::recursive_mutex> guard(*mp_RTPSParticipant->getParticipantMutex());
-	for(std::vector<RTPSWriter*>::iterator wit = mp_RTPSParticipant->userWritersListBegin();
-			wit!=mp_RTPSParticipant->userWritersListEnd();++wit)
-	{
-        GUID_t writerGUID;
-		boost::unique_lock<boost::recursive_mutex> lock(*(*wit)->getMutex());
-        writerGUID = (*wit)->getGuid();
-        lock.unlock();
-        ParticipantProxyData* wpdata = nullptr;
-		WriterProxyData* wdata = nullptr;
-		if(mp_PDP->lookupWriterProxyData(writerGUID,&wdata, &wpdata))
-		{
-            boost::unique_lock<boost::recursive_mutex> plock(*pdata->mp_mutex);
+	std::vector<std::pair<RTPSWriter*, WriterProxyData*>> local_writers;
+	{
+		boost::lock_guard<boost::recursive_mutex> pguard(*mp_PDP->getMutex());
+		TopicEndpoints* topic = findTopic(rdata->m_topicName, rdata->m_typeName, false);
+		if(topic == nullptr)
+			return true;
+		local_writers = topic->localWriters;
+	}
+	ParticipantProxyData* wpdata = mp_PDP->getLocalParticipantProxyData();
+	for(auto wit = local_writers.begin(); wit != local_writers.end(); ++wit)
+	{
+		RTPSWriter* W = wit->first;
+		WriterProxyData* wdata = wit->second;
+
+		boost::unique_lock<boost::recursive_mutex> plock(*pdata->mp_mutex);
 
-            wpdata->mp_mutex->lock();
-            bool valid = validMatching(wdata, rdata);
-            wpdata->mp_mutex->unlock();
+		wpdata->mp_mutex->lock();
+		bool valid = validMatching(wdata, rdata);
+		wpdata->mp_mutex->unlock();
 
-			if(valid)
+		if(valid)
+		{
+			logInfo(RTPS_EDP, "Valid Matching to local writer: " << W->getGuid().entityId);
+			if(W->matched_reader_add(rdata->toRemoteReaderAttributes()))
 			{
-                logInfo(RTPS_EDP, "Valid Matching to local writer: " << writerGUID.entityId);
-				if((*wit)->matched_reader_add(rdata->toRemoteReaderAttributes()))
+				//MATCHED AND ADDED CORRECTLY:
+				if(W->getListener()!=nullptr)
 				{
-					//MATCHED AND ADDED CORRECTLY:
-					if((*wit)->getListener()!=nullptr)
-					{
-						MatchingInfo info;
-						info.status = MATCHED_MATCHING;
-						info.remoteEndpointGuid = rdata->m_guid;
-						(*wit)->getListener()->onWriterMatched((*wit),info);
-					}
+					MatchingInfo info;
+					info.status = MATCHED_MATCHING;
+					info.remoteEndpointGuid = rdata->m_guid;
+					W->getListener()->onWriterMatched(W,info);
 				}
 			}
-			else
+		}
+		else
+		{
+			if(W->matched_reader_is_matched(rdata->toRemoteReaderAttributes())
+					&& W->matched_reader_remove(rdata->toRemoteReaderAttributes()))
 			{
-				if((*wit)->matched_reader_is_matched(rdata->toRemoteReaderAttributes())
-						&& (*wit)->matched_reader_remove(rdata->toRemoteReaderAttributes()))
+				//MATCHED AND ADDED CORRECTLY:
+				if(W->getListener()!=nullptr)
 				{
-					//MATCHED AND ADDED CORRECTLY:
-					if((*wit)->getListener()!=nullptr)
-					{
-						MatchingInfo info;
-						info.status = REMOVED_MATCHING;
-						info.remoteEndpointGuid = rdata->m_guid;
-						(*wit)->getListener()->onWriterMatched((*wit),info);
-					}
+					MatchingInfo info;
+					info.status = REMOVED_MATCHING;
+					info.remoteEndpointGuid = rdata->m_guid;
+					W->getListener()->onWriterMatched(W,info);
 				}
 			}
 		}
@@ -602,51 +699,53 @@ bool EDP::pairingWriterProxy(ParticipantProxyData *pdata, WriterProxyData* wdata
 {
 	logInfo(RTPS_EDP, wdata->guid() <<" in topic: \"" << wdata->topicName() <<"\"");
 	boost::lock_guard<boost::recursive_mutex> guard(*mp_RTPSParticipant->getParticipantMutex());
-	for(std::vector<RTPSReader*>::iterator rit = mp_RTPSParticipant->userReadersListBegin();
-			rit!=mp_RTPSParticipant->userReadersListEnd();++rit)
-	{
-        GUID_t readerGUID;
-		boost::unique_lock<boost::recursive_mutex> lock(*(*rit)->getMutex());
-        readerGUID = (*rit)->getGuid();
-        lock.unlock();
-        ParticipantProxyData* rpdata = nullptr;
-		ReaderProxyData* rdata = nullptr;
-        if(mp_PDP->lookupReaderProxyData(readerGUID, &rdata, &rpdata))
-		{
-            boost::unique_lock<boost::recursive_mutex> plock(*pdata->mp_mutex);
+	std::vector<std::pair<RTPSReader*, ReaderProxyData*>> local_readers;
+	{
+		boost::lock_guard<boost::recursive_mutex> pguard(*mp_PDP->getMutex());
+		TopicEndpoints* topic = findTopic(wdata->topicName(), wdata->typeName(), false);
+		if(topic == nullptr)
+			return true;
+		local_readers = topic->localReaders;
+	}
+	ParticipantProxyData* rpdata = mp_PDP->getLocalParticipantProxyData();
+	for(auto rit = local_readers.begin(); rit != local_readers.end(); ++rit)
+	{
+		RTPSReader* R = rit->first;
+		ReaderProxyData* rdata = rit->second;
 
-            rpdata->mp_mutex->lock();
-            bool valid = validMatching(rdata, wdata);
-            rpdata->mp_mutex->unlock();
+		boost::unique_lock<boost::recursive_mutex> plock(*pdata->mp_mutex);
 
-			if(valid)
+		rpdata->mp_mutex->lock();
+		bool valid = validMatching(rdata, wdata);
+		rpdata->mp_mutex->unlock();
+
+		if(valid)
+		{
+			logInfo(RTPS_EDP, "Valid Matching to local reader: " << R->getGuid().entityId);
+			if(R->matched_writer_add(wdata->toRemoteWriterAttributes()))
 			{
-                logInfo(RTPS_EDP, "Valid Matching to local reader: " << readerGUID.entityId);
-				if((*rit)->matched_writer_add(wdata->toRemoteWriterAttributes()))
+				//MATCHED AND ADDED CORRECTLY:
+				if(R->getListener()!=nullptr)
 				{
-					//MATCHED AND ADDED CORRECTLY:
-					if((*rit)->getListener()!=nullptr)
-					{
-						MatchingInfo info;
-						info.status = MATCHED_MATCHING;
-						info.remoteEndpointGuid = wdata->guid();
-						(*rit)->getListener()->onReaderMatched((*rit),info);
-					}
+					MatchingInfo info;
+					info.status = MATCHED_MATCHING;
+					info.remoteEndpointGuid = wdata->guid();
+					R->getListener()->onReaderMatched(R,info);
 				}
 			}
-			else
+		}
+		else
+		{
+			if(R->matched_writer_is_matched(wdata->toRemoteWriterAttributes())
+					&& R->matched_writer_remove(wdata->toRemoteWriterAttributes()))
 			{
-				if((*rit)->matched_writer_is_matched(wdata->toRemoteWriterAttributes())
-						&& (*rit)->matched_writer_remove(wdata->toRemoteWriterAttributes()))
+				//MATCHED AND ADDED CORRECTLY:
+				if(R->getListener()!=nullptr)
 				{
-					//MATCHED AND ADDED CORRECTLY:
-					if((*rit)->getListener()!=nullptr)
-					{
-						MatchingInfo info;
-						info.status = REMOVED_MATCHING;
-						info.remoteEndpointGuid = wdata->guid();
-						(*rit)->getListener()->onReaderMatched((*rit),info);
-					}
+					MatchingInfo info;
+					info.status = REMOVED_MATCHING;
+					info.remoteEndpointGuid = wdata->guid();
+					R->getListener()->onReaderMatched(R,info);
 				}
 			}
 		}
@@ -61,7 +61,7 @@ bool EDPStatic::initEDP(BuiltinAttributes& attributes)
 	m_attributes = attributes;
 	mp_edpXML = new EDPStaticXML();
 	std::string filename = std::string(m_attributes.getStaticEndpointXMLFilename());
-	return this->mp_edpXML->loadXMLFile(filename);
+	return this->mp_edpXML->loadXMLFile(filename, std::string(m_attributes.getStaticEndpointBinaryFilename()));
 }
 
 std::pair<std::string,std::string> EDPStaticProperty::toProperty(std::string type,std::string status,uint16_t id,const EntityId_t& ent)
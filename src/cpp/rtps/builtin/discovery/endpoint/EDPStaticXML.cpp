@@ -25,15 +25,277 @@
 #include <fastrtps/rtps/builtin/data/ReaderProxyData.h>
 
 #include "boost/lexical_cast.hpp"
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/thread/lock_guard.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+#if defined(_WIN32)
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
 
 namespace eprosima {
 namespace fastrtps{
 namespace rtps {
 
+namespace {
+
+/*
+ * Layout of the compiled files, in the byte order of the host that writes them:
+ * a BinaryHeader, the index of the readers and the index of the writers, both sorted by user Id,
+ * and the records of the endpoints pointed by the index entries.
+ */
+const uint32_t c_binaryMagic = 0x53504445; // "EDPS"
+const uint32_t c_binaryVersion = 1;
+
+struct BinaryHeader
+{
+	uint32_t magic;
+	uint32_t version;
+	uint64_t xmlHash;
+	uint32_t readerCount;
+	uint32_t writerCount;
+};
+
+struct BinaryIndexEntry
+{
+	uint16_t userId;
+	uint16_t reserved;
+	uint32_t offset;
+	uint32_t length;
+};
+
+bool operator<(const BinaryIndexEntry& a, const BinaryIndexEntry& b)
+{
+	return a.userId < b.userId;
+}
+
+bool isSameUserId(const BinaryIndexEntry& a, const BinaryIndexEntry& b)
+{
+	return a.userId == b.userId;
+}
+
+//!FNV-1a hash of the XML file, to know if a compiled file is up to date.
+uint64_t hashContents(const std::string& contents)
+{
+	uint64_t hash = 14695981039346656037ULL;
+	const uint8_t* data = (const uint8_t*)contents.data();
+	for(size_t i = 0; i < contents.size(); ++i)
+	{
+		hash ^= data[i];
+		hash *= 1099511628211ULL;
+	}
+	return hash;
+}
+
+//!Name of a temporary file next to filename that no other process or EDPStaticXML writes at the same time.
+std::string uniqueTemporaryFilename(const std::string& filename)
+{
+	static std::atomic<uint32_t> counter(0);
+	int pid;
+#if defined(_WIN32)
+	pid = (int)_getpid();
+#else
+	pid = (int)getpid();
+#endif
+	std::ostringstream name;
+	name << filename << "." << pid << "." << counter++ << ".tmp";
+	return name.str();
+}
+
+class BinaryRecordWriter
+{
+public:
+	BinaryRecordWriter(std::vector<octet>& out):m_out(out){}
+
+	void add(const void* data, size_t size)
+	{
+		const octet* begin = (const octet*)data;
+		m_out.insert(m_out.end(), begin, begin + size);
+	}
+
+	void addOctet(octet value){ m_out.push_back(value); }
+
+	void addUInt32(uint32_t value){ add(&value, sizeof(value)); }
+
+	void addString(const std::string& value)
+	{
+		addUInt32((uint32_t)value.size());
+		add(value.data(), value.size());
+	}
+
+	void addLocators(LocatorList_t& locators)
+	{
+		addUInt32((uint32_t)locators.size());
+		for(LocatorListIterator lit = locators.begin(); lit != locators.end(); ++lit)
+		{
+			add(&lit->kind, sizeof(lit->kind));
+			addUInt32(lit->port);
+			add(lit->address, sizeof(lit->address));
+		}
+	}
+
+	template<class Qos>
+	void addQos(Qos& qos)
+	{
+		addOctet((octet)qos.m_reliability.kind);
+		addOctet((octet)qos.m_durability.kind);
+		addOctet((octet)qos.m_ownership.kind);
+		addOctet((octet)qos.m_liveliness.kind);
+		add(&qos.m_liveliness.lease_duration.seconds, sizeof(int32_t));
+		addUInt32(qos.m_liveliness.lease_duration.fraction);
+		std::vector<std::string> names = qos.m_partition.getNames();
+		addUInt32((uint32_t)names.size());
+		for(std::vector<std::string>::iterator nit = names.begin(); nit != names.end(); ++nit)
+			addString(*nit);
+	}
+
+private:
+	std::vector<octet>& m_out;
+};
+
+//!Reads a record of a mapped file. Every read is checked against the end of the record.
+class BinaryRecordReader
+{
+public:
+	BinaryRecordReader(const octet* data, uint32_t length):m_pos(data), m_end(data + length){}
+
+	bool read(void* data, size_t size)
+	{
+		if((size_t)(m_end - m_pos) < size)
+			return false;
+		memcpy(data, m_pos, size);
+		m_pos += size;
+		return true;
+	}
+
+	bool readOctet(octet& value){ return read(&value, 1); }
+
+	bool readUInt32(uint32_t& value){ return read(&value, sizeof(value)); }
+
+	bool readString(std::string& value)
+	{
+		uint32_t size = 0;
+		if(!readUInt32(size) || (size_t)(m_end - m_pos) < size)
+			return false;
+		value.assign((const char*)m_pos, size);
+		m_pos += size;
+		return true;
+	}
+
+	bool readLocators(LocatorList_t& locators)
+	{
+		uint32_t count = 0;
+		if(!readUInt32(count))
+			return false;
+		for(uint32_t i = 0; i < count; ++i)
+		{
+			Locator_t loc;
+			if(!read(&loc.kind, sizeof(loc.kind)) || !readUInt32(loc.port) || !read(loc.address, sizeof(loc.address)))
+				return false;
+			locators.push_back(loc);
+		}
+		return true;
+	}
+
+	template<class Qos>
+	bool readQos(Qos& qos)
+	{
+		octet reliability, durability, ownership, liveliness;
+		uint32_t count = 0;
+		if(!readOctet(reliability) || !readOctet(durability) || !readOctet(ownership) || !readOctet(liveliness) ||
+				!read(&qos.m_liveliness.lease_duration.seconds, sizeof(int32_t)) ||
+				!readUInt32(qos.m_liveliness.lease_duration.fraction) || !readUInt32(count))
+			return false;
+		qos.m_reliability.kind = (ReliabilityQosPolicyKind)reliability;
+		qos.m_durability.kind = (DurabilityQosPolicyKind)durability;
+		qos.m_ownership.kind = (OwnershipQosPolicyKind)ownership;
+		qos.m_liveliness.kind = (LivelinessQosPolicyKind)liveliness;
+		for(uint32_t i = 0; i < count; ++i)
+		{
+			std::string name;
+			if(!readString(name))
+				return false;
+			qos.m_partition.push_back(name.c_str());
+		}
+		return true;
+	}
+
+private:
+	const octet* m_pos;
+	const octet* m_end;
+};
+
+void addReaderRecord(std::vector<octet>& out, ReaderProxyData* rdata)
+{
+	BinaryRecordWriter writer(out);
+	writer.add(rdata->m_guid.entityId.value, 4);
+	writer.addOctet((octet)rdata->m_topicKind);
+	writer.addOctet(rdata->m_expectsInlineQos ? 1 : 0);
+	writer.addString(rdata->m_topicName);
+	writer.addString(rdata->m_typeName);
+	writer.addQos(rdata->m_qos);
+	writer.addLocators(rdata->m_unicastLocatorList);
+	writer.addLocators(rdata->m_multicastLocatorList);
+}
+
+bool readReaderRecord(const octet* data, uint32_t length, ReaderProxyData* rdata)
+{
+	BinaryRecordReader reader(data, length);
+	octet topicKind, expectsInlineQos;
+	if(!reader.read(rdata->m_guid.entityId.value, 4) || !reader.readOctet(topicKind) ||
+			!reader.readOctet(expectsInlineQos) || !reader.readString(rdata->m_topicName) ||
+			!reader.readString(rdata->m_typeName) || !reader.readQos(rdata->m_qos) ||
+			!reader.readLocators(rdata->m_unicastLocatorList) || !reader.readLocators(rdata->m_multicastLocatorList))
+		return false;
+	rdata->m_topicKind = (TopicKind_t)topicKind;
+	rdata->m_expectsInlineQos = expectsInlineQos != 0;
+	return true;
+}
+
+void addWriterRecord(std::vector<octet>& out, WriterProxyData* wdata)
+{
+	BinaryRecordWriter writer(out);
+	writer.add(wdata->guid().entityId.value, 4);
+	writer.addOctet((octet)wdata->topicKind());
+	writer.addUInt32(wdata->m_qos.m_ownershipStrength.value);
+	writer.addString(wdata->topicName());
+	writer.addString(wdata->typeName());
+	writer.addQos(wdata->m_qos);
+	writer.addLocators(wdata->unicastLocatorList());
+	writer.addLocators(wdata->multicastLocatorList());
+}
+
+bool readWriterRecord(const octet* data, uint32_t length, WriterProxyData* wdata)
+{
+	BinaryRecordReader reader(data, length);
+	octet topicKind;
+	std::string topicName, typeName;
+	if(!reader.read(wdata->guid().entityId.value, 4) || !reader.readOctet(topicKind) ||
+			!reader.readUInt32(wdata->m_qos.m_ownershipStrength.value) || !reader.readString(topicName) ||
+			!reader.readString(typeName) || !reader.readQos(wdata->m_qos) ||
+			!reader.readLocators(wdata->unicastLocatorList()) || !reader.readLocators(wdata->multicastLocatorList()))
+		return false;
+	wdata->topicKind((TopicKind_t)topicKind);
+	wdata->topicName(topicName);
+	wdata->typeName(typeName);
+	return true;
+}
 
-EDPStaticXML::EDPStaticXML() {
-	// TODO Auto-generated constructor stub
+}
 
+EDPStaticXML::EDPStaticXML():
+	mp_binaryFile(nullptr),
+	mp_binaryRegion(nullptr)
+{
 }
 
 EDPStaticXML::~EDPStaticXML()
@@ -53,17 +315,38 @@ EDPStaticXML::~EDPStaticXML()
 			delete(*wit);
 		}
 	}
+	for(std::map<uint16_t, ReaderProxyData*>::iterator rit = m_binaryReaders.begin(); rit != m_binaryReaders.end(); ++rit)
+		delete(rit->second);
+	for(std::map<uint16_t, WriterProxyData*>::iterator wit = m_binaryWriters.begin(); wit != m_binaryWriters.end(); ++wit)
+		delete(wit->second);
+	delete(mp_binaryRegion);
+	delete(mp_binaryFile);
 }
 
-bool EDPStaticXML::loadXMLFile(std::string& filename)
+bool EDPStaticXML::loadXMLFile(std::string& filename, const std::string& binaryFilename)
 {
 	logInfo(RTPS_EDP,"File: "<<filename);
+	std::ifstream file(filename.c_str(), std::ios::binary);
+	if(!file.is_open())
+	{
+		logError(RTPS_EDP,"Error reading xml file ("<<filename<< "). Error: cannot open file");
+		return false;
+	}
+	std::ostringstream buffer;
+	buffer << file.rdbuf();
+	std::string contents = buffer.str();
+	uint64_t xmlHash = hashContents(contents);
+	if(!binaryFilename.empty() && loadBinaryFile(binaryFilename, xmlHash))
+	{
+		logInfo(RTPS_EDP,"Using the compiled file " << binaryFilename);
+		return true;
+	}
 	// Create an empty property tree object
 	ptree pt;
-	// Load the XML file into the property tree. If reading fails
-	// (cannot open file, parse error), an exception is thrown.
+	// Load the XML file into the property tree. If parsing fails, an exception is thrown.
 	try{
-		read_xml(filename, pt);
+		std::istringstream stream(contents);
+		read_xml(stream, pt);
 	}
 	catch (std::exception &e)
 	{
@@ -80,9 +363,160 @@ bool EDPStaticXML::loadXMLFile(std::string& filename)
 		}
 	}
 	logInfo(RTPS_EDP, "Finished parsing, "<< m_RTPSParticipants.size()<< " participants found.");
+	// The next participants that load this file will not need to parse it.
+	if(!binaryFilename.empty() && !saveBinaryFile(binaryFilename, xmlHash))
+	{
+		logWarning(RTPS_EDP,"Cannot write the compiled file " << binaryFilename);
+	}
 	return true;
 }
 
+bool EDPStaticXML::saveBinaryFile(const std::string& filename, uint64_t xmlHash)
+{
+	std::vector<BinaryIndexEntry> readerIndex, writerIndex;
+	std::vector<octet> records;
+	for(std::vector<StaticRTPSParticipantInfo*>::iterator pit = m_RTPSParticipants.begin();
+			pit!=m_RTPSParticipants.end();++pit)
+	{
+		for(std::vector<ReaderProxyData*>::iterator rit = (*pit)->m_readers.begin();
+				rit!=(*pit)->m_readers.end();++rit)
+		{
+			BinaryIndexEntry entry = {(*rit)->m_userDefinedId, 0, (uint32_t)records.size(), 0};
+			addReaderRecord(records, *rit);
+			entry.length = (uint32_t)records.size() - entry.offset;
+			readerIndex.push_back(entry);
+		}
+		for(std::vector<WriterProxyData*>::iterator wit = (*pit)->m_writers.begin();
+				wit!=(*pit)->m_writers.end();++wit)
+		{
+			BinaryIndexEntry entry = {(*wit)->userDefinedId(), 0, (uint32_t)records.size(), 0};
+			addWriterRecord(records, *wit);
+			entry.length = (uint32_t)records.size() - entry.offset;
+			writerIndex.push_back(entry);
+		}
+	}
+	std::stable_sort(readerIndex.begin(), readerIndex.end());
+	std::stable_sort(writerIndex.begin(), writerIndex.end());
+	if(std::adjacent_find(readerIndex.begin(), readerIndex.end(), isSameUserId) != readerIndex.end() ||
+			std::adjacent_find(writerIndex.begin(), writerIndex.end(), isSameUserId) != writerIndex.end())
+	{
+		logError(RTPS_EDP,"Repeated user ID, the compiled file " << filename << " is not written");
+		return false;
+	}
+
+	BinaryHeader header = {c_binaryMagic, c_binaryVersion, xmlHash, (uint32_t)readerIndex.size(),
+		(uint32_t)writerIndex.size()};
+	uint32_t recordsOffset = (uint32_t)(sizeof(header) + (readerIndex.size() + writerIndex.size()) * sizeof(BinaryIndexEntry));
+	for(std::vector<BinaryIndexEntry>::iterator it = readerIndex.begin(); it != readerIndex.end(); ++it)
+		it->offset += recordsOffset;
+	for(std::vector<BinaryIndexEntry>::iterator it = writerIndex.begin(); it != writerIndex.end(); ++it)
+		it->offset += recordsOffset;
+
+	// Written aside and renamed, so other processes never map a file at half.
+	std::string tmpFilename = uniqueTemporaryFilename(filename);
+	{
+		std::ofstream file(tmpFilename.c_str(), std::ios::binary | std::ios::trunc);
+		file.write((const char*)&header, sizeof(header));
+		if(!readerIndex.empty())
+			file.write((const char*)&readerIndex[0], readerIndex.size() * sizeof(BinaryIndexEntry));
+		if(!writerIndex.empty())
+			file.write((const char*)&writerIndex[0], writerIndex.size() * sizeof(BinaryIndexEntry));
+		if(!records.empty())
+			file.write((const char*)&records[0], records.size());
+		if(!file.good())
+		{
+			file.close();
+			std::remove(tmpFilename.c_str());
+			return false;
+		}
+	}
+	std::remove(filename.c_str());
+	if(std::rename(tmpFilename.c_str(), filename.c_str()) != 0)
+	{
+		std::remove(tmpFilename.c_str());
+		return false;
+	}
+	return true;
+}
+
+bool EDPStaticXML::loadBinaryFile(const std::string& filename, uint64_t xmlHash)
+{
+	boost::interprocess::file_mapping* binaryFile = nullptr;
+	boost::interprocess::mapped_region* binaryRegion = nullptr;
+	try
+	{
+		binaryFile = new boost::interprocess::file_mapping(filename.c_str(), boost::interprocess::read_only);
+		binaryRegion = new boost::interprocess::mapped_region(*binaryFile, boost::interprocess::read_only);
+	}
+	catch(std::exception&)
+	{
+		delete(binaryFile);
+		return false;
+	}
+
+	const octet* data = (const octet*)binaryRegion->get_address();
+	size_t size = binaryRegion->get_size();
+	BinaryHeader header;
+	bool valid = size >= sizeof(header);
+	if(valid)
+	{
+		memcpy(&header, data, sizeof(header));
+		valid = header.magic == c_binaryMagic && header.version == c_binaryVersion && header.xmlHash == xmlHash &&
+			(size - sizeof(header)) / sizeof(BinaryIndexEntry) >= (uint64_t)header.readerCount + header.writerCount;
+	}
+	BinaryIndexEntry previous = {0, 0, 0, 0};
+	for(uint32_t i = 0; valid && i < header.readerCount + header.writerCount; ++i)
+	{
+		BinaryIndexEntry entry;
+		memcpy(&entry, data + sizeof(header) + i * sizeof(entry), sizeof(entry));
+		valid = entry.offset <= size && entry.length <= size - entry.offset;
+		// Each index must be sorted by user Id for the binary search.
+		if(valid && i != 0 && i != header.readerCount)
+			valid = !(entry < previous);
+		previous = entry;
+	}
+	if(!valid)
+	{
+		logWarning(RTPS_EDP,"Compiled file " << filename << " is not valid or not up to date, ignoring it");
+		delete(binaryRegion);
+		delete(binaryFile);
+		return false;
+	}
+
+	mp_binaryFile = binaryFile;
+	mp_binaryRegion = binaryRegion;
+	return true;
+}
+
+const octet* EDPStaticXML::findBinaryEndpoint(bool isReader, uint16_t id, uint32_t* length)
+{
+	const octet* data = (const octet*)mp_binaryRegion->get_address();
+	BinaryHeader header;
+	memcpy(&header, data, sizeof(header));
+	const octet* index = data + sizeof(header) + (isReader ? 0 : header.readerCount * sizeof(BinaryIndexEntry));
+	uint32_t low = 0, high = isReader ? header.readerCount : header.writerCount;
+	uint32_t count = high;
+	// Lower bound, to get the first of the entries with the same Id as the XML file would.
+	while(low < high)
+	{
+		uint32_t middle = low + (high - low) / 2;
+		BinaryIndexEntry entry;
+		memcpy(&entry, index + middle * sizeof(entry), sizeof(entry));
+		if(entry.userId < id)
+			low = middle + 1;
+		else
+			high = middle;
+	}
+	if(low == count)
+		return nullptr;
+	BinaryIndexEntry entry;
+	memcpy(&entry, index + low * sizeof(entry), sizeof(entry));
+	if(entry.userId != id)
+		return nullptr;
+	*length = entry.length;
+	return data + entry.offset;
+}
+
 void EDPStaticXML::loadXMLParticipantEndpoint(ptree::value_type& xml_endpoint, StaticRTPSParticipantInfo* pdata)
 {
     BOOST_FOREACH(ptree::value_type& xml_RTPSParticipant_child, xml_endpoint.second)
@@ -528,6 +962,29 @@ bool EDPStaticXML::loadXMLWriterEndpoint(ptree::value_type& xml_endpoint,StaticR
 bool EDPStaticXML::lookforReader(std::string partname, uint16_t id,
 		ReaderProxyData** rdataptr)
 {
+	if(mp_binaryRegion != nullptr)
+	{
+		boost::lock_guard<boost::mutex> guard(m_binaryMutex);
+		std::map<uint16_t, ReaderProxyData*>::iterator it = m_binaryReaders.find(id);
+		if(it == m_binaryReaders.end())
+		{
+			uint32_t length = 0;
+			const octet* record = findBinaryEndpoint(true, id, &length);
+			if(record == nullptr)
+				return false;
+			ReaderProxyData* rdata = new ReaderProxyData();
+			if(!readReaderRecord(record, length, rdata))
+			{
+				logError(RTPS_EDP,"Bad record for the reader with ID " << id << " in the compiled file");
+				delete(rdata);
+				return false;
+			}
+			rdata->m_userDefinedId = id;
+			it = m_binaryReaders.insert(std::make_pair(id, rdata)).first;
+		}
+		*rdataptr = it->second;
+		return true;
+	}
 	for(std::vector<StaticRTPSParticipantInfo*>::iterator pit = m_RTPSParticipants.begin();
 			pit!=m_RTPSParticipants.end();++pit)
 	{
@@ -550,6 +1007,29 @@ bool EDPStaticXML::lookforReader(std::string partname, uint16_t id,
 bool EDPStaticXML::lookforWriter(std::string partname, uint16_t id,
 		WriterProxyData** wdataptr)
 {
+	if(mp_binaryRegion != nullptr)
+	{
+		boost::lock_guard<boost::mutex> guard(m_binaryMutex);
+		std::map<uint16_t, WriterProxyData*>::iterator it = m_binaryWriters.find(id);
+		if(it == m_binaryWriters.end())
+		{
+			uint32_t length = 0;
+			const octet* record = findBinaryEndpoint(false, id, &length);
+			if(record == nullptr)
+				return false;
+			WriterProxyData* wdata = new WriterProxyData();
+			if(!readWriterRecord(record, length, wdata))
+			{
+				logError(RTPS_EDP,"Bad record for the writer with ID " << id << " in the compiled file");
+				delete(wdata);
+				return false;
+			}
+			wdata->userDefinedId(id);
+			it = m_binaryWriters.insert(std::make_pair(id, wdata)).first;
+		}
+		*wdataptr = it->second;
+		return true;
+	}
 	for(std::vector<StaticRTPSParticipantInfo*>::iterator pit = m_RTPSParticipants.begin();
 			pit!=m_RTPSParticipants.end();++pit)
 	{
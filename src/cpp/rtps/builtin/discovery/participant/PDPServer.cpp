@@ -0,0 +1,165 @@
+// Copyright 2016 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file PDPServer.cpp
+ *
+ */
+
+#include <fastrtps/rtps/builtin/discovery/participant/PDPServer.h>
+
+#include <fastrtps/rtps/builtin/discovery/endpoint/EDP.h>
+
+#include <fastrtps/rtps/builtin/data/ParticipantProxyData.h>
+#include <fastrtps/rtps/builtin/data/ReaderProxyData.h>
+#include <fastrtps/rtps/builtin/data/WriterProxyData.h>
+
+#include "../../../participant/RTPSParticipantImpl.h"
+
+#include <fastrtps/rtps/writer/StatelessWriter.h>
+#include <fastrtps/rtps/messages/RTPSMessageCreator.h>
+#include <fastrtps/rtps/messages/CDRMessagePool.h>
+
+#include <fastrtps/log/Log.h>
+
+#include <algorithm>
+
+#include <boost/thread/recursive_mutex.hpp>
+#include <boost/thread/lock_guard.hpp>
+
+namespace eprosima {
+namespace fastrtps{
+namespace rtps {
+
+PDPServer::PDPServer(BuiltinProtocols* built):
+    PDPSimple(built)
+{
+}
+
+PDPServer::~PDPServer()
+{
+}
+
+void PDPServer::periodicAnnouncement()
+{
+    PDPSimple::periodicAnnouncement();
+
+    boost::lock_guard<boost::recursive_mutex> guardPDP(*this->mp_mutex);
+    for(auto dit = m_relays.begin(); dit != m_relays.end(); ++dit)
+    {
+        ParticipantProxyData* destination = findParticipantProxyData(dit->first);
+        if(destination == nullptr)
+            continue;
+
+        for(auto sit = dit->second.begin(); sit != dit->second.end(); ++sit)
+        {
+            ParticipantProxyData* source = findParticipantProxyData(*sit);
+            if(source != nullptr)
+                relay(source, destination);
+        }
+    }
+}
+
+bool PDPServer::removeRemoteParticipant(GUID_t& partGUID)
+{
+    {
+        boost::lock_guard<boost::recursive_mutex> guardPDP(*this->mp_mutex);
+        m_relays.erase(partGUID.guidPrefix);
+        for(auto dit = m_relays.begin(); dit != m_relays.end(); ++dit)
+        {
+            auto sit = std::find(dit->second.begin(), dit->second.end(), partGUID.guidPrefix);
+            if(sit != dit->second.end())
+                dit->second.erase(sit);
+        }
+    }
+
+    return PDPSimple::removeRemoteParticipant(partGUID);
+}
+
+void PDPServer::remoteReaderProxyDataAdded(ParticipantProxyData* pdata, ReaderProxyData* rdata)
+{
+    relayTopic(pdata, rdata->m_topicName, rdata->m_typeName, WRITER);
+}
+
+void PDPServer::remoteWriterProxyDataAdded(ParticipantProxyData* pdata, WriterProxyData* wdata)
+{
+    relayTopic(pdata, wdata->topicName(), wdata->typeName(), READER);
+}
+
+void PDPServer::relayTopic(ParticipantProxyData* pdata, const std::string& topicName, const std::string& typeName,
+        EndpointKind_t kind)
+{
+    if(mp_EDP == nullptr)
+        return;
+
+    std::vector<ParticipantProxyData*> participants;
+    mp_EDP->topicParticipants(topicName, typeName, kind, participants);
+
+    for(auto pit = participants.begin(); pit != participants.end(); ++pit)
+    {
+        if(*pit == pdata || *pit == getLocalParticipantProxyData())
+            continue;
+
+        // Both clients have to know each other to exchange their endpoints.
+        addRelay(pdata, *pit);
+        addRelay(*pit, pdata);
+    }
+}
+
+void PDPServer::addRelay(ParticipantProxyData* source, ParticipantProxyData* destination)
+{
+    std::vector<GuidPrefix_t>& sources = m_relays[destination->m_guid.guidPrefix];
+    if(std::find(sources.begin(), sources.end(), source->m_guid.guidPrefix) != sources.end())
+        return;
+
+    logInfo(RTPS_PDP, "Relaying " << source->m_guid.guidPrefix << " to " << destination->m_guid.guidPrefix);
+    sources.push_back(source->m_guid.guidPrefix);
+    relay(source, destination);
+}
+
+void PDPServer::relay(ParticipantProxyData* source, ParticipantProxyData* destination)
+{
+    boost::lock_guard<boost::recursive_mutex> guard(*source->mp_mutex);
+    if(source->m_lastAnnouncement.length == 0)
+        return;
+
+    // The announcement is sent as if it came from the client, so the destination processes it as a direct one.
+    CacheChange_t change;
+    change.kind = ALIVE;
+    change.writerGUID.guidPrefix = source->m_guid.guidPrefix;
+    change.writerGUID.entityId = c_EntityId_SPDPWriter;
+    change.instanceHandle = source->m_key;
+    change.sequenceNumber = source->m_lastAnnouncementSeqNum;
+    change.serializedPayload.encapsulation = source->m_lastAnnouncement.encapsulation;
+    change.serializedPayload.length = source->m_lastAnnouncement.length;
+    change.serializedPayload.data = source->m_lastAnnouncement.data;
+
+    CDRMessage_t& msg = mp_RTPSParticipant->getMessagePool().reserve_CDRMsg();
+    CDRMessage::initCDRMsg(&msg);
+    if(RTPSMessageCreator::addMessageData(&msg, change.writerGUID.guidPrefix, &change, WITH_KEY,
+                c_EntityId_SPDPReader, false, nullptr))
+    {
+        for(auto lit = destination->m_metatrafficUnicastLocatorList.begin();
+                lit != destination->m_metatrafficUnicastLocatorList.end(); ++lit)
+            mp_RTPSParticipant->sendSync(&msg, mp_SPDPWriter, *lit);
+    }
+    mp_RTPSParticipant->getMessagePool().release_CDRMsg(msg);
+
+    // The payload is owned by the RTPSParticipantProxyData.
+    change.serializedPayload.data = nullptr;
+}
+
+}
+} /* namespace rtps */
+} /* namespace eprosima */
@@ -34,14 +34,13 @@
 #include <fastrtps/rtps/resources/AsyncWriterThread.h>
 
 #include <fastrtps/rtps/builtin/discovery/participant/timedevent/ResendParticipantProxyDataPeriod.h>
+#include <fastrtps/rtps/builtin/discovery/participant/timedevent/RemoteParticipantLeaseDuration.h>
 
 
 #include "../../../participant/RTPSParticipantImpl.h"
 
 #include <fastrtps/rtps/writer/StatelessWriter.h>
 #include <fastrtps/rtps/reader/StatelessReader.h>
-#include <fastrtps/rtps/reader/StatefulReader.h>
-#include <fastrtps/rtps/reader/WriterProxy.h>
 
 #include <fastrtps/rtps/history/WriterHistory.h>
 #include <fastrtps/rtps/history/ReaderHistory.h>
@@ -69,6 +68,7 @@ PDPSimple::PDPSimple(BuiltinProtocols* built):
     mp_EDP(nullptr),
     m_hasChangedLocalPDP(true),
     mp_resendParticipantTimer(nullptr),
+    mp_leaseDurationTimer(nullptr),
     mp_listener(nullptr),
     mp_SPDPWriterHistory(nullptr),
     mp_SPDPReaderHistory(nullptr),
@@ -79,6 +79,10 @@ PDPSimple::PDPSimple(BuiltinProtocols* built):
 
 PDPSimple::~PDPSimple()
 {
+    // First, so no remote participant is removed by its lease while destroying.
+    if(mp_leaseDurationTimer != nullptr)
+        delete(mp_leaseDurationTimer);
+
     if(mp_resendParticipantTimer != nullptr)
         delete(mp_resendParticipantTimer);
 
@@ -113,8 +117,9 @@ bool PDPSimple::initPDP(RTPSParticipantImpl* part)
     mp_builtin->updateMetatrafficLocators(this->mp_SPDPReader->getAttributes()->unicastLocatorList);
     //boost::lock_guard<boost::recursive_mutex> guardR(*this->mp_SPDPReader->getMutex());
     //boost::lock_guard<boost::recursive_mutex> guardW(*this->mp_SPDPWriter->getMutex());
-    m_participantProxies.push_back(new ParticipantProxyData());
-    m_participantProxies.front()->initializeData(mp_RTPSParticipant,this);
+    ParticipantProxyData* localData = new ParticipantProxyData();
+    localData->initializeData(mp_RTPSParticipant,this);
+    addParticipantProxyData(localData);
 
     //INIT EDP
     if(m_discovery.use_STATIC_EndpointDiscoveryProtocol)
@@ -137,6 +142,7 @@ bool PDPSimple::initPDP(RTPSParticipantImpl* part)
         return false;
 
     mp_resendParticipantTimer = new ResendParticipantProxyDataPeriod(this,TimeConv::Time_t2MilliSecondsDouble(m_discovery.leaseDuration_announcementperiod));
+    mp_leaseDurationTimer = new RemoteParticipantLeaseDuration(this);
 
     return true;
 }
@@ -206,23 +212,20 @@ void PDPSimple::announceParticipantState(bool new_change, bool dispose)
 
 }
 
+void PDPSimple::periodicAnnouncement()
+{
+    announceParticipantState(false);
+}
+
 bool PDPSimple::lookupReaderProxyData(const GUID_t& reader, ReaderProxyData** rdata, ParticipantProxyData** pdata)
 {
     boost::lock_guard<boost::recursive_mutex> guardPDP(*this->mp_mutex);
-    for (auto pit = m_participantProxies.begin();
-            pit != m_participantProxies.end();++pit)
+    auto rit = m_readerProxies.find(reader);
+    if(rit != m_readerProxies.end())
     {
-        boost::lock_guard<boost::recursive_mutex> guard(*(*pit)->mp_mutex);
-        for (auto rit = (*pit)->m_readers.begin();
-                rit != (*pit)->m_readers.end();++rit)
-        {
-            if((*rit)->m_guid == reader)
-            {
-                *rdata = *rit;
-                *pdata = *pit;
-                return true;
-            }
-        }
+        *rdata = rit->second.second;
+        *pdata = rit->second.first;
+        return true;
     }
     return false;
 }
@@ -230,20 +233,12 @@ bool PDPSimple::lookupReaderProxyData(const GUID_t& reader, ReaderProxyData** rd
 bool PDPSimple::lookupWriterProxyData(const GUID_t& writer, WriterProxyData** wdata, ParticipantProxyData** pdata)
 {
     boost::lock_guard<boost::recursive_mutex> guardPDP(*this->mp_mutex);
-    for (auto pit = m_participantProxies.begin();
-            pit != m_participantProxies.end(); ++pit)
+    auto wit = m_writerProxies.find(writer);
+    if(wit != m_writerProxies.end())
     {
-        boost::lock_guard<boost::recursive_mutex> guard(*(*pit)->mp_mutex);
-        for (auto wit = (*pit)->m_writers.begin();
-                wit != (*pit)->m_writers.end(); ++wit)
-        {
-            if((*wit)->guid() == writer)
-            {
-                *wdata = *wit;
-                *pdata = *pit;
-                return true;
-            }
-        }
+        *wdata = wit->second.second;
+        *pdata = wit->second.first;
+        return true;
     }
     return false;
 }
@@ -259,6 +254,9 @@ bool PDPSimple::removeReaderProxyData(ParticipantProxyData* pdata, ReaderProxyDa
         if((*rit)->m_guid == rdata->m_guid)
         {
             pdata->m_readers.erase(rit);
+            m_readerProxies.erase(rdata->m_guid);
+            if(mp_EDP != nullptr)
+                mp_EDP->unindexReaderProxy(rdata);
             delete(rdata);
             return true;
         }
@@ -277,6 +275,9 @@ bool PDPSimple::removeWriterProxyData(ParticipantProxyData* pdata, WriterProxyDa
         if((*wit)->guid() == wdata->guid())
         {
             pdata->m_writers.erase(wit);
+            m_writerProxies.erase(wdata->guid());
+            if(mp_EDP != nullptr)
+                mp_EDP->unindexWriterProxy(wdata);
             delete(wdata);
             return true;
         }
@@ -289,18 +290,29 @@ bool PDPSimple::lookupParticipantProxyData(const GUID_t& pguid,ParticipantProxyD
 {
     logInfo(RTPS_PDP,pguid);
     boost::lock_guard<boost::recursive_mutex> guardPDP(*this->mp_mutex);
-    for(std::vector<ParticipantProxyData*>::iterator pit = m_participantProxies.begin();
-            pit!=m_participantProxies.end();++pit)
+    ParticipantProxyData* found = findParticipantProxyData(pguid.guidPrefix);
+    if(found != nullptr && found->m_guid == pguid)
     {
-        if((*pit)->m_guid == pguid)
-        {
-            *pdata = *pit;
-            return true;
-        }
+        *pdata = found;
+        return true;
     }
     return false;
 }
 
+void PDPSimple::addParticipantProxyData(ParticipantProxyData* pdata)
+{
+    m_participantProxies.push_back(pdata);
+    m_participantsByPrefix[pdata->m_guid.guidPrefix] = pdata;
+}
+
+ParticipantProxyData* PDPSimple::findParticipantProxyData(const GuidPrefix_t& guidP)
+{
+    auto pit = m_participantsByPrefix.find(guidP);
+    if(pit != m_participantsByPrefix.end())
+        return pit->second;
+    return nullptr;
+}
+
 bool PDPSimple::createSPDPEndpoints()
 {
     logInfo(RTPS_PDP,"Beginning");
@@ -323,6 +335,10 @@ bool PDPSimple::createSPDPEndpoints()
     {
         mp_SPDPWriter = dynamic_cast<StatelessWriter*>(wout);
         RemoteReaderAttributes ratt;
+        // Discovery clients only announce themselves to the servers.
+        for(LocatorListIterator lit = m_discovery.discoveryServerLocatorList.begin();
+                lit!=m_discovery.discoveryServerLocatorList.end();++lit)
+            mp_SPDPWriter->add_locator(ratt,*lit);
         for(LocatorListIterator lit = mp_builtin->m_metatrafficMulticastLocatorList.begin();
                 lit!=mp_builtin->m_metatrafficMulticastLocatorList.end();++lit)
             mp_SPDPWriter->add_locator(ratt,*lit);
@@ -371,44 +387,37 @@ bool PDPSimple::addReaderProxyData(ReaderProxyData* rdata,bool copydata,
 {
     logInfo(RTPS_PDP,rdata->m_guid);
     boost::lock_guard<boost::recursive_mutex> guardPDP(*this->mp_mutex);
-    for(std::vector<ParticipantProxyData*>::iterator pit = m_participantProxies.begin();
-            pit!=m_participantProxies.end();++pit)
+    ParticipantProxyData* pit = findParticipantProxyData(rdata->m_guid.guidPrefix);
+    if(pit == nullptr)
+        return false;
+
+    boost::lock_guard<boost::recursive_mutex> guard(*pit->mp_mutex);
+    //CHECK THAT IT IS NOT ALREADY THERE:
+    auto rit = m_readerProxies.find(rdata->m_guid);
+    if(rit != m_readerProxies.end())
     {
-        boost::lock_guard<boost::recursive_mutex> guard(*(*pit)->mp_mutex);
-        if((*pit)->m_guid.guidPrefix == rdata->m_guid.guidPrefix)
-        {
-            //CHECK THAT IT IS NOT ALREADY THERE:
-            for(std::vector<ReaderProxyData*>::iterator rit = (*pit)->m_readers.begin();
-                    rit!=(*pit)->m_readers.end();++rit)
-            {
-                if((*rit)->m_guid.entityId == rdata->m_guid.entityId)
-                {
-                    if(copydata)
-                        *returnReaderProxyData = *rit;
-                    if(pdata != nullptr)
-                        *pdata = *pit;
-                    return false;
-                }
-            }
-            if(copydata)
-            {
-                ReaderProxyData* newRPD = new ReaderProxyData();
-                newRPD->copy(rdata);
-                (*pit)->m_readers.push_back(newRPD);
-                *returnReaderProxyData = newRPD;
-                if(pdata != nullptr)
-                    *pdata = *pit;
-            }
-            else
-            {
-                (*pit)->m_readers.push_back(rdata);
-                if(pdata != nullptr)
-                    *pdata = *pit;
-            }
-            return true;
-        }
+        if(copydata)
+            *returnReaderProxyData = rit->second.second;
+        if(pdata != nullptr)
+            *pdata = pit;
+        return false;
     }
-    return false;
+    ReaderProxyData* stored = rdata;
+    if(copydata)
+    {
+        stored = new ReaderProxyData();
+        stored->copy(rdata);
+        *returnReaderProxyData = stored;
+    }
+    pit->m_readers.push_back(stored);
+    m_readerProxies[stored->m_guid] = std::make_pair(pit, stored);
+    if(mp_EDP != nullptr)
+        mp_EDP->indexReaderProxy(pit, stored);
+    if(pit != getLocalParticipantProxyData())
+        remoteReaderProxyDataAdded(pit, stored);
+    if(pdata != nullptr)
+        *pdata = pit;
+    return true;
 }
 
 bool PDPSimple::addWriterProxyData(WriterProxyData* wdata,bool copydata,
@@ -416,44 +425,37 @@ bool PDPSimple::addWriterProxyData(WriterProxyData* wdata,bool copydata,
 {
     logInfo(RTPS_PDP,wdata->guid());
     boost::lock_guard<boost::recursive_mutex> guardPDP(*this->mp_mutex);
-    for(std::vector<ParticipantProxyData*>::iterator pit = m_participantProxies.begin();
-            pit!=m_participantProxies.end();++pit)
+    ParticipantProxyData* pit = findParticipantProxyData(wdata->guid().guidPrefix);
+    if(pit == nullptr)
+        return false;
+
+    boost::lock_guard<boost::recursive_mutex> guard(*pit->mp_mutex);
+    //CHECK THAT IT IS NOT ALREADY THERE:
+    auto wit = m_writerProxies.find(wdata->guid());
+    if(wit != m_writerProxies.end())
     {
-        boost::lock_guard<boost::recursive_mutex> guard(*(*pit)->mp_mutex);
-        if((*pit)->m_guid.guidPrefix == wdata->guid().guidPrefix)
-        {
-            //CHECK THAT IT IS NOT ALREADY THERE:
-            for(std::vector<WriterProxyData*>::iterator wit = (*pit)->m_writers.begin();
-                    wit!=(*pit)->m_writers.end();++wit)
-            {
-                if((*wit)->guid().entityId == wdata->guid().entityId)
-                {
-                    if(copydata)
-                        *returnWriterProxyData = *wit;
-                    if(pdata != nullptr)
-                        *pdata = *pit;
-                    return false;
-                }
-            }
-            if(copydata)
-            {
-                WriterProxyData* newWPD = new WriterProxyData();
-                newWPD->copy(wdata);
-                (*pit)->m_writers.push_back(newWPD);
-                *returnWriterProxyData = newWPD;
-                if(pdata != nullptr)
-                    *pdata = *pit;
-            }
-            else
-            {
-                (*pit)->m_writers.push_back(wdata);
-                if(pdata != nullptr)
-                    *pdata = *pit;
-            }
-            return true;
-        }
+        if(copydata)
+            *returnWriterProxyData = wit->second.second;
+        if(pdata != nullptr)
+            *pdata = pit;
+        return false;
     }
-    return false;
+    WriterProxyData* stored = wdata;
+    if(copydata)
+    {
+        stored = new WriterProxyData();
+        stored->copy(wdata);
+        *returnWriterProxyData = stored;
+    }
+    pit->m_writers.push_back(stored);
+    m_writerProxies[stored->guid()] = std::make_pair(pit, stored);
+    if(mp_EDP != nullptr)
+        mp_EDP->indexWriterProxy(pit, stored);
+    if(pit != getLocalParticipantProxyData())
+        remoteWriterProxyDataAdded(pit, stored);
+    if(pdata != nullptr)
+        *pdata = pit;
+    return true;
 }
 
 void PDPSimple::assignRemoteEndpoints(ParticipantProxyData* pdata)
@@ -526,15 +528,23 @@ bool PDPSimple::removeRemoteParticipant(GUID_t& partGUID)
     ParticipantProxyData* pdata = nullptr;
     //Remove it from our vector or RTPSParticipantProxies:
     boost::unique_lock<boost::recursive_mutex> guardPDP(*this->mp_mutex);
-    for(std::vector<ParticipantProxyData*>::iterator pit = m_participantProxies.begin();
-            pit!=m_participantProxies.end();++pit)
+    auto pmit = m_participantsByPrefix.find(partGUID.guidPrefix);
+    if(pmit != m_participantsByPrefix.end() && pmit->second->m_guid == partGUID &&
+            pmit->second != getLocalParticipantProxyData())
     {
-        boost::lock_guard<boost::recursive_mutex> guard(*(*pit)->mp_mutex);
-        if((*pit)->m_guid == partGUID)
+        pdata = pmit->second;
+        m_participantsByPrefix.erase(pmit);
+        mp_leaseDurationTimer->removeLease(partGUID.guidPrefix);
+        // Order of the remote participants is not relevant, only the local one must stay first.
+        for(std::vector<ParticipantProxyData*>::iterator pit = m_participantProxies.begin() + 1;
+                pit!=m_participantProxies.end();++pit)
         {
-            pdata = *pit;
-            m_participantProxies.erase(pit);
-            break;
+            if(*pit == pdata)
+            {
+                *pit = m_participantProxies.back();
+                m_participantProxies.pop_back();
+                break;
+            }
         }
     }
 
@@ -547,13 +557,21 @@ bool PDPSimple::removeRemoteParticipant(GUID_t& partGUID)
                     rit!= pdata->m_readers.end();++rit)
             {
                 mp_EDP->unpairReaderProxy(pdata, *rit);
+                mp_EDP->unindexReaderProxy(*rit);
             }
             for(std::vector<WriterProxyData*>::iterator wit = pdata->m_writers.begin();
                     wit!=pdata->m_writers.end();++wit)
             {
                 mp_EDP->unpairWriterProxy(pdata, *wit);
+                mp_EDP->unindexWriterProxy(*wit);
             }
         }
+        for(std::vector<ReaderProxyData*>::iterator rit = pdata->m_readers.begin();
+                rit!= pdata->m_readers.end();++rit)
+            m_readerProxies.erase((*rit)->m_guid);
+        for(std::vector<WriterProxyData*>::iterator wit = pdata->m_writers.begin();
+                wit!=pdata->m_writers.end();++wit)
+            m_writerProxies.erase((*wit)->guid());
         if(mp_builtin->mp_WLP != nullptr)
             this->mp_builtin->mp_WLP->removeRemoteEndpoints(pdata);
         this->mp_EDP->removeRemoteEndpoints(pdata);
@@ -584,22 +602,15 @@ bool PDPSimple::removeRemoteParticipant(GUID_t& partGUID)
 void PDPSimple::assertRemoteParticipantLiveliness(const GuidPrefix_t& guidP)
 {
     boost::lock_guard<boost::recursive_mutex> guardPDP(*this->mp_mutex);
-    for(std::vector<ParticipantProxyData*>::iterator it = this->m_participantProxies.begin();
-            it!=this->m_participantProxies.end();++it)
+    ParticipantProxyData* pdata = findParticipantProxyData(guidP);
+    if(pdata != nullptr)
     {
-        boost::lock_guard<boost::recursive_mutex> guard(*(*it)->mp_mutex);
-        if((*it)->m_guid.guidPrefix == guidP)
-        {
-            logInfo(RTPS_LIVELINESS,"RTPSParticipant "<< (*it)->m_guid << " is Alive");
-            // TODO Ricardo: Study if isAlive attribute is necessary.
-            (*it)->isAlive = true;
-            if((*it)->mp_leaseDurationTimer != nullptr)
-            {
-                (*it)->mp_leaseDurationTimer->cancel_timer();
-                (*it)->mp_leaseDurationTimer->restart_timer();
-            }
-            break;
-        }
+        boost::lock_guard<boost::recursive_mutex> guard(*pdata->mp_mutex);
+        logInfo(RTPS_LIVELINESS,"RTPSParticipant "<< pdata->m_guid << " is Alive");
+        // TODO Ricardo: Study if isAlive attribute is necessary.
+        pdata->isAlive = true;
+        if(pdata != getLocalParticipantProxyData())
+            mp_leaseDurationTimer->assertLease(pdata->m_guid, pdata->m_leaseDuration);
     }
 }
 
@@ -625,36 +636,21 @@ void PDPSimple::assertRemoteWritersLiveliness(GuidPrefix_t& guidP,LivelinessQosP
     boost::lock_guard<boost::recursive_mutex> pguard(*this->mp_mutex);
     logInfo(RTPS_LIVELINESS,"of type " << (kind==AUTOMATIC_LIVELINESS_QOS?"AUTOMATIC":"")
             <<(kind==MANUAL_BY_PARTICIPANT_LIVELINESS_QOS?"MANUAL_BY_PARTICIPANT":""));
-    for(std::vector<ParticipantProxyData*>::iterator pit=this->m_participantProxies.begin();
-            pit!=this->m_participantProxies.end();++pit)
+    ParticipantProxyData* pdata = findParticipantProxyData(guidP);
+    if(pdata == nullptr)
+        return;
+
+    boost::lock_guard<boost::recursive_mutex> guard(*pdata->mp_mutex);
+    boost::lock_guard<boost::recursive_mutex> guardP(*mp_RTPSParticipant->getParticipantMutex());
+    for(std::vector<WriterProxyData*>::iterator wit = pdata->m_writers.begin();
+            wit != pdata->m_writers.end();++wit)
     {
-        boost::lock_guard<boost::recursive_mutex> guard(*(*pit)->mp_mutex);
-        if((*pit)->m_guid.guidPrefix == guidP)
+        if((*wit)->m_qos.m_liveliness.kind == kind)
         {
-            for(std::vector<WriterProxyData*>::iterator wit = (*pit)->m_writers.begin();
-                    wit != (*pit)->m_writers.end();++wit)
-            {
-                if((*wit)->m_qos.m_liveliness.kind == kind)
-                {
-                    (*wit)->isAlive(true);
-                    boost::lock_guard<boost::recursive_mutex> guardP(*mp_RTPSParticipant->getParticipantMutex());
-                    for(std::vector<RTPSReader*>::iterator rit = mp_RTPSParticipant->userReadersListBegin();
-                            rit!=mp_RTPSParticipant->userReadersListEnd();++rit)
-                    {
-                        if((*rit)->getAttributes()->reliabilityKind == RELIABLE)
-                        {
-                            StatefulReader* sfr = (StatefulReader*)(*rit);
-                            WriterProxy* WP;
-                            if(sfr->matched_writer_lookup((*wit)->guid(), &WP))
-                            {
-                                WP->assertLiveliness();
-                                continue;
-                            }
-                        }
-                    }
-                }
-            }
-            break;
+            (*wit)->isAlive(true);
+            // Only the local readers of the same topic can be matched with the writer.
+            if(mp_EDP != nullptr)
+                mp_EDP->assertRemoteWriterLiveliness(*wit);
         }
     }
 }
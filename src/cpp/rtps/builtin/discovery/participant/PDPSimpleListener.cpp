@@ -62,12 +62,21 @@ void PDPSimpleListener::onNewCacheChangeAdded(RTPSReader* reader, const CacheCha
     }
     if(change->kind == ALIVE)
     {
+        // Periodic announcements usually repeat the data already known. Then only the lease is refreshed.
+        if(isKnownAnnouncement(change))
+        {
+            this->mp_SPDP->mp_SPDPReaderHistory->remove_change(change);
+            return;
+        }
         //LOAD INFORMATION IN TEMPORAL RTPSParticipant PROXY DATA
         m_ParticipantProxyData.clear();
-        CDRMessage_t msg;
+        // Read the payload in place instead of copying it.
+        CDRMessage_t msg(0);
+        msg.wraps = true;
+        msg.buffer = change->serializedPayload.data;
         msg.msg_endian = change->serializedPayload.encapsulation == PL_CDR_BE ? BIGEND:LITTLEEND;
         msg.length = change->serializedPayload.length;
-        memcpy(msg.buffer,change->serializedPayload.data,msg.length);
+        msg.max_size = change->serializedPayload.max_size;
         if(m_ParticipantProxyData.readFromCDRMessage(&msg))
         {
             //AFTER CORRECTLY READING IT
@@ -80,19 +89,9 @@ void PDPSimpleListener::onNewCacheChangeAdded(RTPSReader* reader, const CacheCha
                 return;
             }
             //LOOK IF IS AN UPDATED INFORMATION
-            ParticipantProxyData* pdata_ptr = nullptr;
-            bool found = false;
             boost::lock_guard<boost::recursive_mutex> guard(*mp_SPDP->getMutex());
-            for (auto it = mp_SPDP->m_participantProxies.begin();
-                    it != mp_SPDP->m_participantProxies.end();++it)
-            {
-                if(m_ParticipantProxyData.m_key == (*it)->m_key)
-                {
-                    found = true;
-                    pdata_ptr = (*it);
-                    break;
-                }
-            }
+            ParticipantProxyData* pdata_ptr = mp_SPDP->findParticipantProxyData(m_ParticipantProxyData.m_guid.guidPrefix);
+            bool found = pdata_ptr != nullptr;
             RTPSParticipantDiscoveryInfo info;
             info.m_guid = m_ParticipantProxyData.m_guid;
             info.m_RTPSParticipantName = m_ParticipantProxyData.m_participantName;
@@ -107,11 +106,10 @@ void PDPSimpleListener::onNewCacheChangeAdded(RTPSReader* reader, const CacheCha
                 pdata->copy(m_ParticipantProxyData);
                 pdata_ptr = pdata;
                 pdata_ptr->isAlive = true;
-                pdata_ptr->mp_leaseDurationTimer = new RemoteParticipantLeaseDuration(mp_SPDP,
-                        pdata_ptr,
-                        TimeConv::Time_t2MilliSecondsDouble(pdata_ptr->m_leaseDuration));
-                pdata_ptr->mp_leaseDurationTimer->restart_timer();
-                this->mp_SPDP->m_participantProxies.push_back(pdata_ptr);
+                mp_SPDP->mp_leaseDurationTimer->assertLease(pdata_ptr->m_guid, pdata_ptr->m_leaseDuration);
+                pdata_ptr->m_lastAnnouncement.copy(&change->serializedPayload, false);
+                pdata_ptr->m_lastAnnouncementSeqNum = change->sequenceNumber;
+                this->mp_SPDP->addParticipantProxyData(pdata_ptr);
                 mp_SPDP->announceParticipantState(false);
                 mp_SPDP->assignRemoteEndpoints(pdata_ptr);
             }
@@ -120,6 +118,9 @@ void PDPSimpleListener::onNewCacheChangeAdded(RTPSReader* reader, const CacheCha
                 info.m_status = CHANGED_QOS_RTPSPARTICIPANT;
                 boost::lock_guard<boost::recursive_mutex> pguard(*pdata_ptr->mp_mutex);
                 pdata_ptr->updateData(m_ParticipantProxyData);
+                mp_SPDP->mp_leaseDurationTimer->assertLease(pdata_ptr->m_guid, pdata_ptr->m_leaseDuration);
+                pdata_ptr->m_lastAnnouncement.copy(&change->serializedPayload, false);
+                pdata_ptr->m_lastAnnouncementSeqNum = change->sequenceNumber;
                 if(mp_SPDP->m_discovery.use_STATIC_EndpointDiscoveryProtocol)
                     mp_SPDP->mp_EDP->assignRemoteEndpoints(&m_ParticipantProxyData);
             }
@@ -150,6 +151,28 @@ void PDPSimpleListener::onNewCacheChangeAdded(RTPSReader* reader, const CacheCha
 	return;
 }
 
+bool PDPSimpleListener::isKnownAnnouncement(CacheChange_t* change)
+{
+    GUID_t guid;
+    iHandle2GUID(guid,change->instanceHandle);
+    boost::lock_guard<boost::recursive_mutex> guard(*mp_SPDP->getMutex());
+    ParticipantProxyData* pdata = mp_SPDP->findParticipantProxyData(guid.guidPrefix);
+    if(pdata == nullptr || pdata == mp_SPDP->getLocalParticipantProxyData())
+        return false;
+
+    boost::lock_guard<boost::recursive_mutex> pguard(*pdata->mp_mutex);
+    if(pdata->m_lastAnnouncement.length != change->serializedPayload.length ||
+            pdata->m_lastAnnouncement.encapsulation != change->serializedPayload.encapsulation ||
+            memcmp(pdata->m_lastAnnouncement.data, change->serializedPayload.data,
+                change->serializedPayload.length) != 0)
+        return false;
+
+    logInfo(RTPS_PDP,"Announcement of " << pdata->m_guid << " did not change");
+    pdata->isAlive = true;
+    mp_SPDP->mp_leaseDurationTimer->assertLease(pdata->m_guid, pdata->m_leaseDuration);
+    return true;
+}
+
 bool PDPSimpleListener::getKey(CacheChange_t* change)
 {
 	SerializedPayload_t* pl = &change->serializedPayload;
@@ -21,28 +21,27 @@
 #include <fastrtps/rtps/resources/ResourceEvent.h>
 
 #include <fastrtps/rtps/builtin/discovery/participant/PDPSimple.h>
-#include <fastrtps/rtps/builtin/data/ParticipantProxyData.h>
 
 #include "../../../../participant/RTPSParticipantImpl.h"
 
+#include <fastrtps/utils/TimeConversion.h>
 #include <fastrtps/log/Log.h>
 
-#include <boost/thread/recursive_mutex.hpp>
+#include <boost/thread/lock_guard.hpp>
 
+#include <vector>
 
+using namespace boost::posix_time;
 
 namespace eprosima {
 namespace fastrtps{
 namespace rtps {
 
 
-RemoteParticipantLeaseDuration::RemoteParticipantLeaseDuration(PDPSimple* p_SPDP,
-		ParticipantProxyData* pdata,
-		double interval):
+RemoteParticipantLeaseDuration::RemoteParticipantLeaseDuration(PDPSimple* p_SPDP):
 				TimedEvent(p_SPDP->getRTPSParticipant()->getEventResource().getIOService(),
-                p_SPDP->getRTPSParticipant()->getEventResource().getThread(), interval, TimedEvent::ON_SUCCESS),
-				mp_PDP(p_SPDP),
-				mp_participantProxyData(pdata)
+                p_SPDP->getRTPSParticipant()->getEventResource().getThread(), 0),
+				mp_PDP(p_SPDP)
 {
 
 }
@@ -52,6 +51,54 @@ RemoteParticipantLeaseDuration::~RemoteParticipantLeaseDuration()
     destroy();
 }
 
+void RemoteParticipantLeaseDuration::assertLease(const GUID_t& guid, const Duration_t& leaseDuration)
+{
+    boost::lock_guard<boost::mutex> guard(m_mutex);
+    auto lit = m_leases.find(guid.guidPrefix);
+    if(lit != m_leases.end())
+    {
+        m_expirations.erase(lit->second);
+        m_leases.erase(lit);
+    }
+
+    // An infinite lease never expires.
+    if(leaseDuration == c_TimeInfinite)
+        return;
+
+    ptime expiration = microsec_clock::universal_time() + microseconds(TimeConv::Time_t2MicroSecondsInt64(leaseDuration));
+    m_leases[guid.guidPrefix] = m_expirations.insert(std::make_pair(expiration, guid));
+    schedule();
+}
+
+void RemoteParticipantLeaseDuration::removeLease(const GuidPrefix_t& guidP)
+{
+    // The timer is left as it is. If it was waiting for this lease, it will find nothing to remove.
+    boost::lock_guard<boost::mutex> guard(m_mutex);
+    auto lit = m_leases.find(guidP);
+    if(lit != m_leases.end())
+    {
+        m_expirations.erase(lit->second);
+        m_leases.erase(lit);
+    }
+}
+
+void RemoteParticipantLeaseDuration::schedule()
+{
+    if(m_expirations.empty())
+        return;
+
+    ptime first = m_expirations.begin()->first;
+    if(!m_scheduled.is_not_a_date_time() && m_scheduled <= first)
+        return;
+
+    // Renewals only move the leases forward, so this is only reached when a lease is added or shortened.
+    cancel_timer();
+    time_duration remaining = first - microsec_clock::universal_time();
+    update_interval_millisec(remaining.is_negative() ? 0 : remaining.total_microseconds() / 1000.0);
+    restart_timer();
+    m_scheduled = first;
+}
+
 void RemoteParticipantLeaseDuration::event(EventCode code, const char* msg)
 {
 
@@ -60,18 +107,31 @@ void RemoteParticipantLeaseDuration::event(EventCode code, const char* msg)
 
 	if(code == EVENT_SUCCESS)
     {
-        logInfo(RTPS_LIVELINESS,"RTPSParticipant no longer ALIVE, trying to remove: "
-                << mp_participantProxyData->m_guid);
-        // Set pointer to null because this call will be delete itself.
-        mp_participantProxyData->mp_mutex->lock();
-        mp_participantProxyData->mp_leaseDurationTimer = nullptr;
-        mp_participantProxyData->mp_mutex->unlock();
-        mp_PDP->removeRemoteParticipant(mp_participantProxyData->m_guid);
+        std::vector<GUID_t> expired;
+        {
+            boost::lock_guard<boost::mutex> guard(m_mutex);
+            m_scheduled = ptime(not_a_date_time);
+            ptime now = microsec_clock::universal_time();
+            while(!m_expirations.empty() && m_expirations.begin()->first <= now)
+            {
+                expired.push_back(m_expirations.begin()->second);
+                m_leases.erase(m_expirations.begin()->second.guidPrefix);
+                m_expirations.erase(m_expirations.begin());
+            }
+        }
+
+        for(std::vector<GUID_t>::iterator it = expired.begin(); it != expired.end(); ++it)
+        {
+            logInfo(RTPS_LIVELINESS,"RTPSParticipant no longer ALIVE, trying to remove: " << *it);
+            mp_PDP->removeRemoteParticipant(*it);
+        }
+
+        boost::lock_guard<boost::mutex> guard(m_mutex);
+        schedule();
 	}
 	else if(code == EVENT_ABORT)
 	{
-		logInfo(RTPS_LIVELINESS," Stopped for "<<mp_participantProxyData->m_participantName
-				<< " with ID: "<< mp_participantProxyData->m_guid.guidPrefix);
+		logInfo(RTPS_LIVELINESS,"Rescheduled");
 	}
 	else
 	{
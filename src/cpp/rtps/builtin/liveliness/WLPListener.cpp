@@ -64,19 +64,9 @@ void WLPListener::onNewCacheChangeAdded(RTPSReader* reader,const CacheChange_t*
 	if(!computeKey(change))
 	{
 		logWarning(RTPS_LIVELINESS,"Problem obtaining the Key");
+		this->mp_WLP->mp_builtinReaderHistory->remove_change(change);
 		return;
 	}
-	//Check the serializedPayload:
-	for(auto ch = this->mp_WLP->mp_builtinReaderHistory->changesBegin();
-			ch!=mp_WLP->mp_builtinReaderHistory->changesEnd();++ch)
-	{
-		if((*ch)->instanceHandle == change->instanceHandle &&
-				(*ch)->sequenceNumber < change->sequenceNumber)
-		{
-			mp_WLP->mp_builtinReaderHistory->remove_change(*ch);
-			break;
-		}
-	}
 	if(change->serializedPayload.length>0)
 	{
 		for(uint8_t i =0;i<12;++i)
@@ -102,6 +92,9 @@ void WLPListener::onNewCacheChangeAdded(RTPSReader* reader,const CacheChange_t*
 	}
 	this->mp_WLP->getBuiltinProtocols()->mp_PDP->assertRemoteWritersLiveliness(guidP,livelinessKind);
 
+	// The assertion is already processed. Keeping it in the history would only make it grow with the RTPSParticipants.
+	this->mp_WLP->mp_builtinReaderHistory->remove_change(change);
+
 	return;
 }
 
@@ -61,15 +61,15 @@ void ThroughputController::operator()(vector<CacheChangeForGroup_t>& changes)
         if (change.isFragmented())
         {
             unsigned int fittingFragments = min((mBytesPerPeriod - mAccumulatedPayloadSize) / change.getChange()->getFragmentSize(),
-                    static_cast<uint32_t>(change.getFragmentsClearedForSending().set.size()));
+                    static_cast<uint32_t>(change.getFragmentsClearedForSending().get_size()));
 
             if (fittingFragments)
             {
                 mAccumulatedPayloadSize += fittingFragments * change.getChange()->getFragmentSize();
 
                 auto limitedFragments = change.getFragmentsClearedForSending();
-                while (limitedFragments.set.size() > fittingFragments)
-                    limitedFragments.set.erase(std::prev(limitedFragments.set.end())); // remove biggest fragment
+                while (limitedFragments.get_size() > fittingFragments)
+                    limitedFragments.remove(limitedFragments.get_maxFragNum()); // remove biggest fragment
 
                 change.setFragmentsClearedForSending(limitedFragments);
                 clearedChanges++;
@@ -94,7 +94,44 @@ bool CacheChangePool::reserve_Cache(CacheChange_t** chan, const std::function<ui
 bool CacheChangePool::reserve_Cache(CacheChange_t** chan, uint32_t dataSize)
 {
     boost::lock_guard<boost::mutex> guard(*this->mp_mutex);
+    return reserve_Cache_nts(chan, dataSize);
+}
+
+bool CacheChangePool::reserve_Caches(std::vector<CacheChange_t*>& changes, size_t count,
+        const std::function<uint32_t(size_t)>& calculateSizeFunc)
+{
+    std::vector<uint32_t> dataSizes;
 
+    if(memoryMode != PREALLOCATED_MEMORY_MODE)
+    {
+        dataSizes.reserve(count);
+        for(size_t i = 0; i < count; ++i)
+            dataSizes.push_back(calculateSizeFunc(i));
+    }
+
+    size_t first = changes.size();
+    changes.reserve(first + count);
+
+    boost::lock_guard<boost::mutex> guard(*this->mp_mutex);
+
+    for(size_t i = 0; i < count; ++i)
+    {
+        CacheChange_t* ch = nullptr;
+        if(!reserve_Cache_nts(&ch, dataSizes.empty() ? 0 : dataSizes[i]))
+        {
+            for(size_t j = first; j < changes.size(); ++j)
+                release_Cache_nts(changes[j]);
+            changes.resize(first);
+            return false;
+        }
+        changes.push_back(ch);
+    }
+
+    return true;
+}
+
+bool CacheChangePool::reserve_Cache_nts(CacheChange_t** chan, uint32_t dataSize)
+{
     switch(memoryMode)
     {
         case PREALLOCATED_MEMORY_MODE:
@@ -147,7 +184,11 @@ bool CacheChangePool::reserve_Cache(CacheChange_t** chan, uint32_t dataSize)
 void CacheChangePool::release_Cache(CacheChange_t* ch)
 {
     boost::lock_guard<boost::mutex> guard(*this->mp_mutex);
+    release_Cache_nts(ch);
+}
 
+void CacheChangePool::release_Cache_nts(CacheChange_t* ch)
+{
     switch(memoryMode)
     {
         case PREALLOCATED_MEMORY_MODE:
@@ -27,6 +27,8 @@
 #include <boost/thread/lock_guard.hpp>
 #include <boost/interprocess/sync/interprocess_semaphore.hpp>
 
+#include <algorithm>
+
 namespace eprosima {
 namespace fastrtps{
 namespace rtps {
@@ -111,8 +113,12 @@ bool ReaderHistory::add_change(CacheChange_t* a_change)
 
 	if(*m_cachedRecordLocation->begin() < a_change->sequenceNumber && m_cachedRecordLocation->insert(a_change->sequenceNumber).second)
 	{
-		m_changes.push_back(a_change);
-        sortCacheChanges();
+		// Changes are kept ordered. They usually arrive in order, so the insertion is at the back.
+		if(m_changes.empty() || !(a_change->sequenceNumber < m_changes.back()->sequenceNumber))
+			m_changes.push_back(a_change);
+		else
+			m_changes.insert(std::upper_bound(m_changes.begin(), m_changes.end(), a_change,
+						sort_ReaderHistoryCache), a_change);
 		updateMaxMinSeqNum();
 		logInfo(RTPS_HISTORY, "Change " << a_change->sequenceNumber << " added with " << a_change->serializedPayload.length << " bytes");
 
@@ -135,22 +141,31 @@ bool ReaderHistory::remove_change(CacheChange_t* a_change)
 	}
 
 	boost::lock_guard<boost::recursive_mutex> guard(*mp_mutex);
+	if(detach_change(a_change))
+	{
+		m_changePool.release_Cache(a_change);
+		return true;
+	}
+	return false;
+}
+
+bool ReaderHistory::detach_change(CacheChange_t* a_change)
+{
 	if(a_change == nullptr)
 	{
 		logError(RTPS_HISTORY,"Pointer is not valid")
 		return false;
 	}
-	for(std::vector<CacheChange_t*>::iterator chit = m_changes.begin();
-			chit!=m_changes.end();++chit)
+	// Changes are ordered by sequence number, so only those with the same number are compared.
+	for(std::vector<CacheChange_t*>::iterator chit = std::lower_bound(m_changes.begin(), m_changes.end(),
+				a_change, sort_ReaderHistoryCache);
+			chit!=m_changes.end() && (*chit)->sequenceNumber == a_change->sequenceNumber;++chit)
 	{
-		if((*chit)->sequenceNumber == a_change->sequenceNumber &&
-				(*chit)->writerGUID == a_change->writerGUID)
+		if((*chit)->writerGUID == a_change->writerGUID)
 		{
 			logInfo(RTPS_HISTORY,"Removing change "<< a_change->sequenceNumber);
 			mp_reader->change_removed_by_history(a_change);
-			m_changePool.release_Cache(a_change);
 			m_changes.erase(chit);
-			sortCacheChanges();
 			updateMaxMinSeqNum();
 			return true;
 		}
@@ -159,6 +174,44 @@ bool ReaderHistory::remove_change(CacheChange_t* a_change)
 	return false;
 }
 
+size_t ReaderHistory::detach_changes(std::vector<CacheChange_t*>& changes)
+{
+	if(changes.empty())
+		return 0;
+
+	// The changes are a subsequence of the history, so the history is compacted once, from the first of them.
+	// A change that is not found is skipped when the history goes past its position.
+	size_t found = 0;
+	size_t next = 0;
+	std::vector<CacheChange_t*>::iterator keep = std::lower_bound(m_changes.begin(), m_changes.end(),
+			changes.front(), sort_ReaderHistoryCache);
+	std::vector<CacheChange_t*>::iterator chit = keep;
+	for(; chit != m_changes.end() && next < changes.size(); ++chit)
+	{
+		while(next < changes.size() && *chit != changes[next] && sort_ReaderHistoryCache(changes[next], *chit))
+			changes[next++] = nullptr;
+		if(next < changes.size() && *chit == changes[next])
+		{
+			logInfo(RTPS_HISTORY,"Removing change "<< (*chit)->sequenceNumber);
+			mp_reader->change_removed_by_history(*chit);
+			++next;
+			++found;
+		}
+		else
+			*keep++ = *chit;
+	}
+	for(; next < changes.size(); ++next)
+		changes[next] = nullptr;
+	keep = std::move(chit, m_changes.end(), keep);
+	m_changes.erase(keep, m_changes.end());
+
+	if(found < changes.size())
+		logWarning(RTPS_HISTORY,"Only " << found << " of " << changes.size() << " changes found");
+	if(found > 0)
+		updateMaxMinSeqNum();
+	return found;
+}
+
 bool ReaderHistory::remove_changes_with_guid(GUID_t* a_guid)
 {
 	std::vector<CacheChange_t*> changes_to_remove;
@@ -24,6 +24,8 @@
 #include <boost/thread/recursive_mutex.hpp>
 #include <boost/thread/lock_guard.hpp>
 
+#include <algorithm>
+
 namespace eprosima {
 namespace fastrtps{
 namespace rtps {
@@ -35,7 +37,8 @@ typedef std::vector<t_pairKeyChanges> t_vectorPairKeyChanges;
 
 WriterHistory::WriterHistory(const HistoryAttributes& att):
 				History(att),
-				mp_writer(nullptr)
+				mp_writer(nullptr),
+				mp_changeGroup(nullptr)
 {
 
 }
@@ -54,29 +57,89 @@ bool WriterHistory::add_change(CacheChange_t* a_change)
 		return false;
 	}
 
-	boost::lock_guard<boost::recursive_mutex> guard(*mp_mutex);
-	if(a_change->writerGUID != mp_writer->getGuid())
+	bool grouped = false;
 	{
-		logError(RTPS_HISTORY,"Change writerGUID "<< a_change->writerGUID << " different than Writer GUID "<< mp_writer->getGuid());
-		return false;
+		boost::lock_guard<boost::recursive_mutex> guard(*mp_mutex);
+		if(a_change->writerGUID != mp_writer->getGuid())
+		{
+			logError(RTPS_HISTORY,"Change writerGUID "<< a_change->writerGUID << " different than Writer GUID "<< mp_writer->getGuid());
+			return false;
+		}
+		if((m_att.memoryPolicy==PREALLOCATED_MEMORY_MODE) && a_change->serializedPayload.length > m_att.payloadMaxSize)
+		{
+			logError(RTPS_HISTORY,
+				"Change payload size of '" << a_change->serializedPayload.length <<
+				"' bytes is larger than the history payload size of '" << m_att.payloadMaxSize <<
+				"' bytes and cannot be resized.");
+			return false;
+		}
+		++m_lastCacheChangeSeqNum;
+		a_change->sequenceNumber = m_lastCacheChangeSeqNum;
+		m_changes.push_back(a_change);
+		logInfo(RTPS_HISTORY,"Change "<< a_change->sequenceNumber << " added with "<<a_change->serializedPayload.length<< " bytes");
+		updateMaxMinSeqNum();
+
+		grouped = mp_changeGroup != nullptr;
+		if(grouped)
+			mp_changeGroup->push_back(a_change);
+		else
+			mp_writer->unsent_change_added_to_history(a_change);
 	}
-	if((m_att.memoryPolicy==PREALLOCATED_MEMORY_MODE) && a_change->serializedPayload.length > m_att.payloadMaxSize)
+
+	// The changes of a group are sent by the one who ends it.
+	if(!grouped)
+		send_pending_changes();
+
+	return true;
+}
+
+size_t WriterHistory::add_changes(const std::vector<CacheChange_t*>& changes)
+{
+	if(mp_writer == nullptr || mp_mutex == nullptr)
 	{
-		logError(RTPS_HISTORY,
-			"Change payload size of '" << a_change->serializedPayload.length <<
-			"' bytes is larger than the history payload size of '" << m_att.payloadMaxSize <<
-			"' bytes and cannot be resized.");
-		return false;
+		logError(RTPS_HISTORY,"You need to create a Writer with this History before adding any changes");
+		return 0;
 	}
-	++m_lastCacheChangeSeqNum;
-	a_change->sequenceNumber = m_lastCacheChangeSeqNum;
-	m_changes.push_back(a_change);
-	logInfo(RTPS_HISTORY,"Change "<< a_change->sequenceNumber << " added with "<<a_change->serializedPayload.length<< " bytes");
-	updateMaxMinSeqNum();
 
-    mp_writer->unsent_change_added_to_history(a_change);
+	size_t added = 0;
+	{
+		boost::lock_guard<boost::recursive_mutex> guard(*mp_mutex);
+		std::vector<CacheChange_t*> group;
+		begin_change_group(&group);
 
-	return true;
+		while(added < changes.size() && add_change(changes[added]))
+			++added;
+
+		end_change_group();
+	}
+
+	send_pending_changes();
+	return added;
+}
+
+void WriterHistory::send_pending_changes()
+{
+	mp_writer->send_pending_changes();
+}
+
+void WriterHistory::begin_change_group(std::vector<CacheChange_t*>* group)
+{
+	mp_changeGroup = group;
+}
+
+void WriterHistory::flush_change_group()
+{
+	if(mp_changeGroup != nullptr && !mp_changeGroup->empty())
+	{
+		mp_writer->unsent_changes_added_to_history(*mp_changeGroup);
+		mp_changeGroup->clear();
+	}
+}
+
+void WriterHistory::end_change_group()
+{
+	flush_change_group();
+	mp_changeGroup = nullptr;
 }
 
 bool WriterHistory::remove_change(CacheChange_t* a_change)
@@ -108,7 +171,14 @@ bool WriterHistory::remove_change(CacheChange_t* a_change)
 	{
 		if((*chit)->sequenceNumber == a_change->sequenceNumber)
 		{
-			mp_writer->change_removed_by_history(a_change);
+			// A change of the group being added was never handed to the writer.
+			std::vector<CacheChange_t*>::iterator git;
+			if(mp_changeGroup != nullptr &&
+					(git = std::find(mp_changeGroup->begin(), mp_changeGroup->end(), a_change)) != mp_changeGroup->end())
+				mp_changeGroup->erase(git);
+			else
+				mp_writer->change_removed_by_history(a_change);
+			mp_writer->wait_until_sent(a_change);
 			m_changePool.release_Cache(a_change);
 			m_changes.erase(chit);
 			updateMaxMinSeqNum();
@@ -20,17 +20,122 @@
 #include <fastrtps/rtps/messages/CDRMessagePool.h>
 
 #include <boost/thread/mutex.hpp>
+#include <boost/thread/lock_guard.hpp>
+
+#include <map>
 
 namespace eprosima {
 namespace fastrtps{
 namespace rtps {
 
+namespace
+{
+    //! Number of pools each thread caches messages for.
+    const size_t c_ThreadCachePools = 4;
+    //! Number of messages each thread caches per pool.
+    const size_t c_ThreadCacheMessages = 4;
+
+    boost::mutex& pool_registry_mutex()
+    {
+        static boost::mutex mutex;
+        return mutex;
+    }
+
+    //! Alive pools. Thread caches only give messages back to pools found here.
+    std::map<uint64_t, CDRMessagePool*>& pool_registry()
+    {
+        static std::map<uint64_t, CDRMessagePool*> registry;
+        return registry;
+    }
+
+    uint64_t g_next_pool_id = 1;
+}
 
-CDRMessagePool::CDRMessagePool(uint32_t defaultGroupsize):
-m_group_size((uint16_t)defaultGroupsize), mutex_(nullptr)
+/**
+ * Messages released by a thread, kept to be reserved again by the same thread without locking.
+ */
+struct CDRMessageThreadCache
+{
+    struct Slot
+    {
+        uint64_t pool_id;
+        size_t count;
+        CDRMessage_t* messages[c_ThreadCacheMessages];
+    };
+
+    CDRMessageThreadCache() : next_eviction(0)
+    {
+        for(size_t i = 0; i < c_ThreadCachePools; ++i)
+        {
+            slots[i].pool_id = 0;
+            slots[i].count = 0;
+        }
+    }
+
+    ~CDRMessageThreadCache()
+    {
+        for(size_t i = 0; i < c_ThreadCachePools; ++i)
+            flush(slots[i]);
+    }
+
+    Slot* find(uint64_t pool_id)
+    {
+        for(size_t i = 0; i < c_ThreadCachePools; ++i)
+        {
+            if(slots[i].pool_id == pool_id)
+                return &slots[i];
+        }
+
+        return nullptr;
+    }
+
+    Slot& acquire(uint64_t pool_id)
+    {
+        Slot* slot = find(pool_id);
+
+        if(slot == nullptr)
+            slot = find(0);
+
+        if(slot == nullptr)
+        {
+            slot = &slots[next_eviction];
+            next_eviction = (next_eviction + 1) % c_ThreadCachePools;
+            flush(*slot);
+        }
+
+        slot->pool_id = pool_id;
+        return *slot;
+    }
+
+    static void flush(Slot& slot)
+    {
+        if(slot.count > 0)
+        {
+            boost::lock_guard<boost::mutex> guard(pool_registry_mutex());
+            auto it = pool_registry().find(slot.pool_id);
+            if(it != pool_registry().end())
+                it->second->release_to_pool(slot.messages, slot.count);
+        }
+
+        slot.pool_id = 0;
+        slot.count = 0;
+    }
+
+    Slot slots[c_ThreadCachePools];
+    size_t next_eviction;
+};
+
+static thread_local CDRMessageThreadCache t_message_cache;
+
+CDRMessagePool::CDRMessagePool(uint32_t defaultGroupsize, uint32_t messageSize):
+m_group_size((uint16_t)defaultGroupsize), m_message_size(messageSize), m_id(0), mutex_(nullptr)
 {
 	allocateGroup();
     mutex_ = new boost::mutex();
+
+    boost::lock_guard<boost::mutex> guard(pool_registry_mutex());
+    m_id = g_next_pool_id++;
+    pool_registry()[m_id] = this;
 }
 
 
@@ -39,7 +144,7 @@ void CDRMessagePool::allocateGroup()
 {
 	for(uint16_t i=0;i<m_group_size;++i)
 	{
-		CDRMessage_t* newObject = new CDRMessage_t();
+		CDRMessage_t* newObject = new CDRMessage_t(m_message_size);
 		m_free_objects.push_back(newObject);
 		m_all_objects.push_back(newObject);
 	}
@@ -57,6 +162,19 @@ void CDRMessagePool::allocateGroup(uint16_t payload)
 
 CDRMessagePool::~CDRMessagePool()
 {
+    {
+        boost::lock_guard<boost::mutex> guard(pool_registry_mutex());
+        pool_registry().erase(m_id);
+    }
+
+    // Messages cached by this thread are deleted below.
+    CDRMessageThreadCache::Slot* slot = t_message_cache.find(m_id);
+    if(slot != nullptr)
+    {
+        slot->pool_id = 0;
+        slot->count = 0;
+    }
+
 	for(std::vector<CDRMessage_t*>::iterator it=m_all_objects.begin();
 			it!=m_all_objects.end();++it)
 	{
@@ -70,6 +188,10 @@ CDRMessagePool::~CDRMessagePool()
 
 CDRMessage_t& CDRMessagePool::reserve_CDRMsg()
 {
+    CDRMessageThreadCache::Slot* slot = t_message_cache.find(m_id);
+    if(slot != nullptr && slot->count > 0)
+        return *slot->messages[--slot->count];
+
     boost::unique_lock<boost::mutex> lock(*mutex_);
 	if(m_free_objects.empty())
 		allocateGroup();
@@ -80,6 +202,11 @@ CDRMessage_t& CDRMessagePool::reserve_CDRMsg()
 
 CDRMessage_t& CDRMessagePool::reserve_CDRMsg(uint16_t payload)
 {
+    CDRMessageThreadCache::Slot* slot = t_message_cache.find(m_id);
+    if(slot != nullptr && slot->count > 0 &&
+            slot->messages[slot->count - 1]->max_size >= (uint32_t)payload + RTPSMESSAGE_COMMON_RTPS_PAYLOAD_SIZE)
+        return *slot->messages[--slot->count];
+
     boost::unique_lock<boost::mutex> lock(*mutex_);
 	if(m_free_objects.empty())
 		allocateGroup(payload);
@@ -99,9 +226,30 @@ CDRMessage_t& CDRMessagePool::reserve_CDRMsg(uint16_t payload)
 
 void CDRMessagePool::release_CDRMsg(CDRMessage_t& obj)
 {
+    CDRMessageThreadCache::Slot& slot = t_message_cache.acquire(m_id);
+    if(slot.count < c_ThreadCacheMessages)
+    {
+        slot.messages[slot.count++] = &obj;
+        return;
+    }
+
     boost::unique_lock<boost::mutex> lock(*mutex_);
 	m_free_objects.push_back(&obj);
 }
+
+void CDRMessagePool::flushThreadCache()
+{
+    CDRMessageThreadCache::Slot* slot = t_message_cache.find(m_id);
+    if(slot != nullptr)
+        CDRMessageThreadCache::flush(*slot);
+}
+
+void CDRMessagePool::release_to_pool(CDRMessage_t** objs, size_t count)
+{
+    boost::unique_lock<boost::mutex> lock(*mutex_);
+    m_free_objects.insert(m_free_objects.end(), objs, objs + count);
+}
+
 }
 } /* namespace rtps */
 } /* namespace eprosima */
@@ -54,9 +54,7 @@ namespace fastrtps{
 namespace rtps {
 
 
-MessageReceiver::MessageReceiver(){}
-MessageReceiver::MessageReceiver(uint32_t rec_buffer_size):
-												m_rec_msg(rec_buffer_size),
+MessageReceiver::MessageReceiver():
 												mp_change(nullptr)
 {
 }
@@ -73,14 +71,13 @@ void MessageReceiver::init(uint32_t rec_buffer_size){
 	defUniLoc.kind = LOCATOR_KIND_UDPv4;
 	LOCATOR_ADDRESS_INVALID(defUniLoc.address);
 	defUniLoc.port = LOCATOR_PORT_INVALID;
-	logInfo(RTPS_MSG_IN,"Created with CDRMessage of size: "<<m_rec_msg.max_size);
+	logInfo(RTPS_MSG_IN,"Created with buffer size: "<<rec_buffer_size);
 	uint16_t max_payload = ((uint32_t)std::numeric_limits<uint16_t>::max() < rec_buffer_size) ? std::numeric_limits<uint16_t>::max() : (uint16_t)rec_buffer_size;
 	mp_change = new CacheChange_t(max_payload, true);
 }
 
 MessageReceiver::~MessageReceiver()
 {
-	this->m_ParamList.deleteParams();
 	delete(mp_change);
 	logInfo(RTPS_MSG_IN,"");
 }
@@ -417,9 +414,6 @@ bool MessageReceiver::proc_Submsg_Data(CDRMessage_t* msg,SubmessageHeader_t* smh
 {
     boost::lock_guard<boost::mutex> guard(mtx);
 
-    // Reset param list
-    m_ParamList.deleteParams();
-
 	//READ and PROCESS
 	if(smh->submessageLength < RTPSMESSAGE_DATA_MIN_LENGTH)
 	{
@@ -499,7 +493,7 @@ bool MessageReceiver::proc_Submsg_Data(CDRMessage_t* msg,SubmessageHeader_t* smh
 
 	if(inlineQosFlag)
 	{
-		inlineQosSize = ParameterList::readParameterListfromCDRMsg(msg, &m_ParamList, ch);
+		inlineQosSize = ParameterList::readInlineQosFromCDRMsg(msg, ch);
 
 		if(inlineQosSize <= 0)
 		{
@@ -552,7 +546,7 @@ bool MessageReceiver::proc_Submsg_Data(CDRMessage_t* msg,SubmessageHeader_t* smh
 				return false;
 			}
 			//uint32_t param_size;
-			if(ParameterList::readParameterListfromCDRMsg(msg, &m_ParamList, ch) <= 0)
+			if(ParameterList::readInlineQosFromCDRMsg(msg, ch) <= 0)
 			{
 				logInfo(RTPS_MSG_IN,IDSTRING"SubMessage Data ERROR, keyFlag ParameterList");
 				return false;
@@ -569,7 +563,6 @@ bool MessageReceiver::proc_Submsg_Data(CDRMessage_t* msg,SubmessageHeader_t* smh
         ch->sourceTimestamp = this->timestamp;
 
 
-	//FIXME: DO SOMETHING WITH PARAMETERLIST CREATED.
 	logInfo(RTPS_MSG_IN,IDSTRING"from Writer " << ch->writerGUID << "; possible RTPSReaders: "<<AssociatedReaders.size());
 	//Look for the correct reader to add the change
 	for(std::vector<RTPSReader*>::iterator it = AssociatedReaders.begin();
@@ -589,9 +582,6 @@ bool MessageReceiver::proc_Submsg_DataFrag(CDRMessage_t* msg, SubmessageHeader_t
 {
    boost::lock_guard<boost::mutex> guard(mtx);
 
-	// Reset param list
-	m_ParamList.deleteParams();
-
 	//READ and PROCESS
 	if (smh->submessageLength < RTPSMESSAGE_DATA_MIN_LENGTH)
 	{
@@ -683,7 +673,7 @@ bool MessageReceiver::proc_Submsg_DataFrag(CDRMessage_t* msg, SubmessageHeader_t
 
 	if (inlineQosFlag)
 	{
-		inlineQosSize = ParameterList::readParameterListfromCDRMsg(msg, &m_ParamList, ch);
+		inlineQosSize = ParameterList::readInlineQosFromCDRMsg(msg, ch);
 
 		if (inlineQosSize <= 0)
 		{
@@ -751,7 +741,7 @@ bool MessageReceiver::proc_Submsg_DataFrag(CDRMessage_t* msg, SubmessageHeader_t
 			return false;
 		}
 		//uint32_t param_size;
-		if (ParameterList::readParameterListfromCDRMsg(msg, &m_ParamList, ch) <= 0)
+		if (ParameterList::readInlineQosFromCDRMsg(msg, ch) <= 0)
 		{
 			logInfo(RTPS_MSG_IN, IDSTRING"SubMessage Data ERROR, keyFlag ParameterList");
 			return false;
@@ -768,7 +758,6 @@ bool MessageReceiver::proc_Submsg_DataFrag(CDRMessage_t* msg, SubmessageHeader_t
 	if (haveTimestamp)
 		ch->sourceTimestamp = this->timestamp;
 
-	//FIXME: DO SOMETHING WITH PARAMETERLIST CREATED.
 	logInfo(RTPS_MSG_IN, IDSTRING"from Writer " << ch->writerGUID << "; possible RTPSReaders: " << AssociatedReaders.size());
 	//Look for the correct reader to add the change
 	for (std::vector<RTPSReader*>::iterator it = AssociatedReaders.begin();
@@ -19,6 +19,7 @@
 
 #include <fastrtps/rtps/messages/RTPSMessageGroup.h>
 #include <fastrtps/rtps/messages/RTPSMessageCreator.h>
+#include <fastrtps/utils/eClock.h>
 #include <fastrtps/rtps/flowcontrol/FlowController.h>
 #include <fastrtps/rtps/writer/RTPSWriter.h>
 #include "../participant/RTPSParticipantImpl.h"
@@ -29,6 +30,19 @@ namespace eprosima {
 namespace fastrtps {
 namespace rtps {
 
+// Clock used to timestamp the messages, defined with the message creator.
+extern eClock g_clock;
+
+Time_t& RTPSMessageGroup_t::timestamp()
+{
+    if(!has_timestamp_)
+    {
+        g_clock.setTimeNow(&timestamp_);
+        has_timestamp_ = true;
+    }
+    return timestamp_;
+}
+
 bool sort_changes_group (CacheChange_t* c1,CacheChange_t* c2)
 {
     return(c1->sequenceNumber < c2->sequenceNumber);
@@ -189,26 +203,6 @@ void RTPSMessageGroup::prepareDataFragSubM(RTPSWriter* W, CDRMessage_t* submsg,
     }
 }
 
-static uint32_t calculate_message_length_from_change(const CacheChangeForGroup_t& change)
-{
-    if (change.isFragmented())
-    {
-        auto fragsCleared = change.getFragmentsClearedForSending();
-        if (fragsCleared.isSetEmpty())
-            return 0;
-
-        FragmentNumber_t fragmentToSend = (*fragsCleared.set.begin());
-
-        bool one_fragment_left = fragmentToSend + 1 == change.getChange()->getFragmentCount();
-        if (one_fragment_left)
-            return change.getChange()->serializedPayload.length - (change.getChange()->getFragmentCount() - 1) * change.getChange()->getFragmentSize();
-        else
-            return change.getChange()->getFragmentSize();
-    }
-    else
-        return change.getChange()->serializedPayload.length;
-}
-
 uint32_t RTPSMessageGroup::send_Changes_AsData(RTPSMessageGroup_t* msg_group,
         RTPSWriter* W, std::vector<CacheChangeForGroup_t>& changes,
         const GuidPrefix_t& remoteGuidPrefix, const EntityId_t& ReaderId,
@@ -220,9 +214,6 @@ uint32_t RTPSMessageGroup::send_Changes_AsData(RTPSMessageGroup_t* msg_group,
     CDRMessage_t* cdrmsg_header = &msg_group->m_rtpsmsg_header;
     CDRMessage_t* cdrmsg_fullmsg = &msg_group->m_rtpsmsg_fullmsg;
 
-    auto cit = changes.begin();
-    uint32_t data_msg_length = calculate_message_length_from_change(*cit);
-
     // Set header
     CDRMessage::initCDRMsg(cdrmsg_fullmsg);
     CDRMessage::appendMsg(cdrmsg_fullmsg,cdrmsg_header);
@@ -233,46 +224,51 @@ uint32_t RTPSMessageGroup::send_Changes_AsData(RTPSMessageGroup_t* msg_group,
         RTPSMessageCreator::addSubmessageInfoDST(cdrmsg_fullmsg, remoteGuidPrefix);
     }
 
-    // Insert INFO_TS submessage.
-    RTPSMessageCreator::addSubmessageInfoTS_Now(cdrmsg_fullmsg, false); //Change here to add a INFO_TS for DATA.
+    // Insert INFO_TS submessage, with the timestamp shared by all the messages of the group.
+    RTPSMessageCreator::addSubmessageInfoTS(cdrmsg_fullmsg, msg_group->timestamp(), false);
 
+    DataSubmessageTemplate_t dataTemplate;
+    bool hasTemplate = false;
     bool dataInserted = false;
 
-    while(cdrmsg_fullmsg->length + data_msg_length < cdrmsg_fullmsg->max_size)
+    auto cit = changes.begin();
+    while(cit != changes.end())
     {
-        dataInserted = true;
-
         if(!cit->isFragmented())
         {
-            RTPSMessageGroup::prepareDataSubM(W, cdrmsg_submessage, expectsInlineQos, cit->getChange(), ReaderId);
+            // DATA submessages are written directly in the message, from the template of the reader.
+            if(!hasTemplate)
+            {
+                dataTemplate = W->getDataTemplate(ReaderId, expectsInlineQos);
+                hasTemplate = true;
+            }
+
+            if(!RTPSMessageCreator::addSubmessageData(cdrmsg_fullmsg, cit->getChange(), dataTemplate))
+                break;
+
             cit = changes.erase(cit);
         }
         else
         {
-            static uint32_t fragmentIndex = 0;
-            auto fragmentsBegin = cit->getFragmentsClearedForSending().set.begin();
-            auto fragmentsEnd= cit->getFragmentsClearedForSending().set.end();
-            if (std::next(fragmentsBegin, fragmentIndex) != fragmentsEnd)
+            const FragmentNumberSet_t& fragments = cit->getFragmentsClearedForSending();
+            if(fragments.isSetEmpty())
             {
-                RTPSMessageGroup::prepareDataFragSubM(W, cdrmsg_submessage, expectsInlineQos, cit->getChange(), ReaderId, *(std::next(fragmentsBegin, fragmentIndex)));
-                fragmentIndex++;
-            }
-            else
-            {
-                fragmentIndex = 0;
                 cit = changes.erase(cit);
+                continue;
             }
-        }
 
-        CDRMessage::appendMsg(cdrmsg_fullmsg,cdrmsg_submessage);
+            FragmentNumber_t fragment = *fragments.get_begin();
+            RTPSMessageGroup::prepareDataFragSubM(W, cdrmsg_submessage, expectsInlineQos, cit->getChange(), ReaderId, fragment);
+            if(cdrmsg_fullmsg->length + cdrmsg_submessage->length > cdrmsg_fullmsg->max_size)
+                break;
 
-        if(cit != changes.end())
-        {
-            data_msg_length = calculate_message_length_from_change(*cit);
+            CDRMessage::appendMsg(cdrmsg_fullmsg,cdrmsg_submessage);
+            cit->fragmentSent(fragment);
+            if(cit->getFragmentsClearedForSending().isSetEmpty())
+                cit = changes.erase(cit);
         }
-        else
-            break;
 
+        dataInserted = true;
     }
 
     if(dataInserted)
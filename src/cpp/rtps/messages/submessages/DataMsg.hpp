@@ -79,7 +79,8 @@ bool RTPSMessageCreator::addSubmessageData(CDRMessage_t* msg, const CacheChange_
         keyFlag = false;
     inlineQosFlag = false;
     // cout << "expects inline qos: " << expectsInlineQos << " topic KIND: " << (topicKind == WITH_KEY) << endl;
-    if(inlineQos != NULL || expectsInlineQos || change->kind != ALIVE) //expects inline qos
+    // Keyed changes always carry the key hash, so readers do not need to deserialize the payload to get it.
+    if(inlineQos != NULL || expectsInlineQos || change->kind != ALIVE || topicKind == WITH_KEY) //expects inline qos
     {
         if(topicKind == WITH_KEY)
         {
@@ -208,6 +209,111 @@ bool RTPSMessageCreator::addSubmessageData(CDRMessage_t* msg, const CacheChange_
     return added_no_error;
 }
 
+bool RTPSMessageCreator::addSubmessageData(CDRMessage_t* msg, const CacheChange_t* change,
+        const DataSubmessageTemplate_t& dataTemplate)
+{
+    TopicKind_t topicKind = dataTemplate.topicKind();
+
+    // Same flags as the generic version, without a writer inline QoS list.
+    bool dataFlag = change->kind == ALIVE && change->serializedPayload.length > 0 && change->serializedPayload.data != NULL;
+    bool keyFlag = !dataFlag && topicKind == WITH_KEY;
+    bool inlineQosFlag = false;
+    bool hasSampleIdentity = change->write_params.related_sample_identity() != SampleIdentity::unknown();
+    if(dataTemplate.expectsInlineQos() || change->kind != ALIVE || topicKind == WITH_KEY)
+    {
+        if(topicKind == WITH_KEY)
+        {
+            inlineQosFlag = true;
+            keyFlag = false;
+        }
+    }
+    else if(hasSampleIdentity)
+        inlineQosFlag = true;
+
+    octet status = 0;
+    if(change->kind == NOT_ALIVE_DISPOSED || change->kind == NOT_ALIVE_DISPOSED_UNREGISTERED)
+        status = status | BIT(0);
+    if(change->kind == NOT_ALIVE_UNREGISTERED || change->kind == NOT_ALIVE_DISPOSED_UNREGISTERED)
+        status = status | BIT(1);
+
+    // Compute the whole size first, so nothing is written if the submessage does not fit.
+    uint32_t size = DataSubmessageTemplate_t::size;
+    if(inlineQosFlag)
+    {
+        if(hasSampleIdentity)
+            size += 28;
+        if(topicKind == WITH_KEY)
+            size += 20;
+        if(change->kind != ALIVE)
+            size += 8;
+        size += 4;
+    }
+    if(dataFlag)
+        size += 4 + change->serializedPayload.length;
+    if(keyFlag)
+        size += 4 + 20 + 8 + 4;
+    uint32_t align = (4 - size % 4) & 3;
+    size += align;
+
+    if(msg->pos + size >= msg->max_size || size - 4 > 0xFFFF)
+        return false;
+
+    octet flags = dataTemplate.header()[DataSubmessageTemplate_t::flags_offset];
+    if(inlineQosFlag)
+        flags = flags | BIT(1);
+    if(dataFlag)
+        flags = flags | BIT(2);
+    if(keyFlag)
+        flags = flags | BIT(3);
+
+    // The template and the message share the byte order of the host.
+    octet* header = &msg->buffer[msg->pos];
+    uint16_t submessageLength = (uint16_t)(size - 4);
+    memcpy(header, dataTemplate.header(), DataSubmessageTemplate_t::size);
+    header[DataSubmessageTemplate_t::flags_offset] = flags;
+    memcpy(header + DataSubmessageTemplate_t::length_offset, &submessageLength, 2);
+    memcpy(header + DataSubmessageTemplate_t::sequence_number_offset, &change->sequenceNumber.high, 4);
+    memcpy(header + DataSubmessageTemplate_t::sequence_number_offset + 4, &change->sequenceNumber.low, 4);
+    msg->pos += DataSubmessageTemplate_t::size;
+    msg->length = msg->pos;
+#if EPROSIMA_BIG_ENDIAN
+    msg->msg_endian = BIGEND;
+#else
+    msg->msg_endian = LITTLEEND;
+#endif
+
+    if(inlineQosFlag)
+    {
+        if(hasSampleIdentity)
+            CDRMessage::addParameterSampleIdentity(msg, change->write_params.related_sample_identity());
+        if(topicKind == WITH_KEY)
+            CDRMessage::addParameterKey(msg, &change->instanceHandle);
+        if(change->kind != ALIVE)
+            CDRMessage::addParameterStatus(msg, status);
+        CDRMessage::addParameterSentinel(msg);
+    }
+
+    if(dataFlag)
+    {
+        octet encapsulation[4] = {0, (octet)change->serializedPayload.encapsulation, 0, 0};
+        CDRMessage::addData(msg, encapsulation, 4);
+        CDRMessage::addData(msg, change->serializedPayload.data, change->serializedPayload.length);
+    }
+    if(keyFlag)
+    {
+        octet encapsulation[4] = {0, msg->msg_endian == BIGEND ? (octet)PL_CDR_BE : (octet)PL_CDR_LE, 0, 0};
+        CDRMessage::addData(msg, encapsulation, 4);
+        CDRMessage::addParameterKey(msg, &change->instanceHandle);
+        CDRMessage::addParameterStatus(msg, status);
+        CDRMessage::addParameterSentinel(msg);
+    }
+
+    octet padding[3] = {0, 0, 0};
+    CDRMessage::addData(msg, padding, align);
+
+    return true;
+}
+
 
 bool RTPSMessageCreator::addMessageDataFrag(CDRMessage_t* msg, GuidPrefix_t& guidprefix,
         const CacheChange_t* change, uint32_t fragment_number, TopicKind_t topicKind, const EntityId_t& readerId,
@@ -272,7 +378,7 @@ bool RTPSMessageCreator::addSubmessageDataFrag(CDRMessage_t* msg, const CacheCha
         keyFlag = false;
 
     // cout << "expects inline qos: " << expectsInlineQos << " topic KIND: " << (topicKind == WITH_KEY) << endl;
-    if (inlineQos != NULL || expectsInlineQos || change->kind != ALIVE) //expects inline qos
+    if (inlineQos != NULL || expectsInlineQos || change->kind != ALIVE || topicKind == WITH_KEY) //expects inline qos
     {
         if (topicKind == WITH_KEY)
         {
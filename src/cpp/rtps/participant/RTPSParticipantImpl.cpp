@@ -25,6 +25,7 @@
 #include <fastrtps/rtps/resources/ListenResource.h>
 
 #include <fastrtps/rtps/messages/MessageReceiver.h>
+#include <fastrtps/rtps/messages/CDRMessagePool.h>
 
 #include <fastrtps/rtps/writer/StatelessWriter.h>
 #include <fastrtps/rtps/writer/StatefulWriter.h>
@@ -57,6 +58,10 @@ namespace eprosima {
 namespace fastrtps{
 namespace rtps {
 
+//!Event thread of the RTPSParticipants created with useSharedEventThread, alive while any of them is.
+static std::weak_ptr<ResourceEvent> g_sharedEvent;
+static boost::mutex g_sharedEventMutex;
+
 
 
 static EntityId_t TrustedWriter(const EntityId_t& reader)
@@ -90,6 +95,7 @@ RTPSParticipantImpl::RTPSParticipantImpl(const RTPSParticipantAttributes& PParam
         RTPSParticipantListener* plisten):	m_att(PParam), m_guid(guidP,c_EntityId_RTPSParticipant),
     mp_event_thr(nullptr),
     mp_builtinProtocols(nullptr),
+    mp_message_pool(nullptr),
     mp_ResourceSemaphore(new boost::interprocess::interprocess_semaphore(0)),
     IdCounter(0),
     mp_participantListener(plisten),
@@ -110,12 +116,32 @@ RTPSParticipantImpl::RTPSParticipantImpl(const RTPSParticipantAttributes& PParam
     for (const auto& transportDescriptor : PParam.userTransports)
         m_network_Factory.RegisterTransport(transportDescriptor.get());
 
+    // Messages are used both to send and to receive, so they must fit the biggest of both.
+    uint32_t message_size = getMaxMessageSize();
+    if(message_size < m_att.listenSocketBufferSize)
+        message_size = m_att.listenSocketBufferSize;
+    mp_message_pool = new CDRMessagePool(MessagePoolGroupSize, message_size);
+
     boost::lock_guard<boost::recursive_mutex> guard(*mp_mutex);
     mp_userParticipant->mp_impl = this;
     Locator_t loc;
     loc.port = PParam.defaultSendPort;
-    mp_event_thr = new ResourceEvent();
-    mp_event_thr->init_thread(this);
+    if(PParam.useSharedEventThread)
+    {
+        boost::lock_guard<boost::mutex> event_guard(g_sharedEventMutex);
+        mp_event_thr = g_sharedEvent.lock();
+        if(!mp_event_thr)
+        {
+            mp_event_thr = std::make_shared<ResourceEvent>();
+            mp_event_thr->init_thread(this);
+            g_sharedEvent = mp_event_thr;
+        }
+    }
+    else
+    {
+        mp_event_thr = std::make_shared<ResourceEvent>();
+        mp_event_thr->init_thread(this);
+    }
 
 
     // Throughput controller, if the descriptor has valid values
@@ -173,13 +199,14 @@ RTPSParticipantImpl::RTPSParticipantImpl(const RTPSParticipantAttributes& PParam
         We create the resources for these Locators now. Furthermore, in case these resources are taken, 
         we create them on another Locator and then update de defaultList.
         */
-    createReceiverResources(m_att.defaultUnicastLocatorList, true);
+    // Their listen threads are not needed until there is a user endpoint.
+    createReceiverResources(m_att.defaultUnicastLocatorList, true, false);
 
     if(!hasLocatorsDefined){
         logInfo(RTPS_PARTICIPANT,m_att.getName()<<" Created with NO default Unicast Locator List, adding Locators: "<<m_att.defaultUnicastLocatorList);
     }
     //Multicast
-    createReceiverResources(m_att.defaultMulticastLocatorList, true);
+    createReceiverResources(m_att.defaultMulticastLocatorList, true, false);
 
     //Check if defaultOutLocatorsExist, create some if they don't
     hasLocatorsDefined = true;
@@ -252,8 +279,11 @@ RTPSParticipantImpl::~RTPSParticipantImpl()
     {
         block.resourceAlive = false;
         block.Receiver.Abort();
-        block.m_thread->join();
-        delete block.m_thread;
+        if(block.m_thread != nullptr)
+        {
+            block.m_thread->join();
+            delete block.m_thread;
+        }
     }
 
     while(m_userReaderList.size()>0)
@@ -272,7 +302,9 @@ RTPSParticipantImpl::~RTPSParticipantImpl()
     delete(this->mp_userParticipant);
     m_senderResource.clear();
 
-    delete(this->mp_event_thr);
+    mp_event_thr.reset();
+
+    delete(this->mp_message_pool);
 
     delete(this->mp_mutex);
 }
@@ -374,7 +406,10 @@ bool RTPSParticipantImpl::createWriter(RTPSWriter** WriterOut,
     boost::lock_guard<boost::recursive_mutex> guard(*mp_mutex);
     m_allWriterList.push_back(SWriter);
     if(!isBuiltin)
+    {
         m_userWriterList.push_back(SWriter);
+        startListenThreads();
+    }
     *WriterOut = SWriter;
 
     // If the terminal throughput controller has proper user defined values, instantiate it
@@ -475,7 +510,10 @@ bool RTPSParticipantImpl::createReader(RTPSReader** ReaderOut,
     boost::lock_guard<boost::recursive_mutex> guard(*mp_mutex);
     m_allReaderList.push_back(SReader);
     if(!isBuiltin)
+    {
         m_userReaderList.push_back(SReader);
+        startListenThreads();
+    }
     *ReaderOut = SReader;
     return true;
 }
@@ -594,16 +632,21 @@ bool RTPSParticipantImpl::createAndAssociateReceiverswithEndpoint(Endpoint * pen
 
 void RTPSParticipantImpl::performListenOperation(ReceiverControlBlock *receiver, Locator_t input_locator)
 {
+    // The receive buffer is kept by this thread while it runs.
+    CDRMessage_t& msg = mp_message_pool->reserve_CDRMsg();
+
     while(receiver->resourceAlive)
     {	
         // Blocking receive.
-        auto& msg = receiver->mp_receiver->m_rec_msg;
         if(!receiver->Receiver.Receive(msg.buffer, msg.max_size, msg.length, input_locator))
             continue;
 
         // Processes the data through the CDR Message interface.
-        receiver->mp_receiver->processCDRMsg(getGuid().guidPrefix, &input_locator, &receiver->mp_receiver->m_rec_msg);
+        receiver->mp_receiver->processCDRMsg(getGuid().guidPrefix, &input_locator, &msg);
     }	
+
+    mp_message_pool->release_CDRMsg(msg);
+    mp_message_pool->flushThreadCache();
 }
 
 
@@ -664,7 +707,7 @@ bool RTPSParticipantImpl::createSendResources(Endpoint *pend){
     return true;
 }
 
-void RTPSParticipantImpl::createReceiverResources(LocatorList_t& Locator_list, bool ApplyMutation){
+void RTPSParticipantImpl::createReceiverResources(LocatorList_t& Locator_list, bool ApplyMutation, bool StartThreads){
     std::vector<ReceiverResource> newItemsBuffer;
 
     for(auto it_loc = Locator_list.begin(); it_loc != Locator_list.end(); ++it_loc){
@@ -681,17 +724,26 @@ void RTPSParticipantImpl::createReceiverResources(LocatorList_t& Locator_list, b
             //Push the new items into the ReceiverResource buffer
             m_receiverResourcelist.push_back(ReceiverControlBlock(std::move(*it_buffer)));
             //Create and init the MessageReceiver
-            //TODO(Ricardo) listenSocketBufferSize is too much size. Review
-            m_receiverResourcelist.back().mp_receiver = new MessageReceiver(m_att.listenSocketBufferSize);
+            m_receiverResourcelist.back().mp_receiver = new MessageReceiver();
             m_receiverResourcelist.back().mp_receiver->init(m_att.listenSocketBufferSize);
 
             //Init the thread
-            m_receiverResourcelist.back().m_thread = new boost::thread(&RTPSParticipantImpl::performListenOperation,this, &(m_receiverResourcelist.back()),(*it_loc));
+            if(StartThreads)
+                m_receiverResourcelist.back().m_thread = new boost::thread(&RTPSParticipantImpl::performListenOperation,this, &(m_receiverResourcelist.back()),(*it_loc));
         }
         newItemsBuffer.clear();
     }	
 }
 
+void RTPSParticipantImpl::startListenThreads()
+{
+    for(auto& block : m_receiverResourcelist)
+    {
+        if(block.m_thread == nullptr)
+            block.m_thread = new boost::thread(&RTPSParticipantImpl::performListenOperation, this, &block, Locator_t());
+    }
+}
+
 
 
 bool RTPSParticipantImpl::deleteUserEndpoint(Endpoint* p_endpoint)
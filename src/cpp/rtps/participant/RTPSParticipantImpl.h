@@ -22,6 +22,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <list>
+#include <memory>
 #include <sys/types.h>
 
 #if defined(_WIN32)
@@ -65,6 +66,7 @@ class ResourceSend;
 class ResourceEvent;
 class AsyncWriterThread;
 class BuiltinProtocols;
+class CDRMessagePool;
 struct CDRMessage_t;
 class Endpoint;
 class RTPSWriter;
@@ -204,6 +206,12 @@ class RTPSParticipantImpl
 
         uint32_t getMaxMessageSize() const;
 
+        /**
+         * Get the pool of message buffers shared by all the endpoints and threads of this RTPSParticipant.
+         * @return Reference to the pool.
+         */
+        CDRMessagePool& getMessagePool() { return *mp_message_pool; }
+
     private:
         //!Attributes of the RTPSParticipant
         RTPSParticipantAttributes m_att;
@@ -211,10 +219,14 @@ class RTPSParticipantImpl
         const GUID_t m_guid;
         //! Sending resources. - DEPRECATED -Stays commented for reference purposes
         // ResourceSend* mp_send_thr;
-        //! Event Resource
-        ResourceEvent* mp_event_thr;
+        //! Event Resource, shared with other RTPSParticipants if useSharedEventThread is set.
+        std::shared_ptr<ResourceEvent> mp_event_thr;
         //! BuiltinProtocols of this RTPSParticipant
         BuiltinProtocols* mp_builtinProtocols;
+        //! Pool of message buffers used to send and receive.
+        CDRMessagePool* mp_message_pool;
+        //! Number of messages allocated each time the message pool runs out.
+        static const uint32_t MessagePoolGroupSize = 4;
         //!Semaphore to wait for the listen thread creation.
         boost::interprocess::interprocess_semaphore* mp_ResourceSemaphore;
         //!Id counter to correctly assign the ids to writers and readers.
@@ -407,9 +419,15 @@ class RTPSParticipantImpl
           some and updating the list. DOES NOT associate endpoints with it.
           @param Locator_list - Locator list to be used to create the ReceiverResources
           @param ApplyMutation - True if we want to create a Resource with a "similar" locator if the one we provide is unavailable
+          @param StartThreads - False to open the resources without listening on them until startListenThreads is called
           */
         static const int MutationTries = 5;
-        void createReceiverResources(LocatorList_t& Locator_list, bool ApplyMutation);
+        void createReceiverResources(LocatorList_t& Locator_list, bool ApplyMutation, bool StartThreads = true);
+
+        /** Launch the listen thread of the ReceiverResources opened without it. The default locators are only
+          listened once the first user endpoint is created.
+          */
+        void startListenThreads();
 
         bool networkFactoryHasRegisteredTransports() const;
 };
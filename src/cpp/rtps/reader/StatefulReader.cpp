@@ -382,7 +382,7 @@ bool StatefulReader::processGapMsg(GUID_t &writerGUID, SequenceNumber_t &gapStar
                 fragmentedChangePitStop_->try_to_remove(auxSN, pWP->m_att.guid);
         }
 
-        for(std::vector<SequenceNumber_t>::iterator it=gapList.get_begin();it!=gapList.get_end();++it)
+        for(SequenceNumberSet_t::const_iterator it=gapList.get_begin();it!=gapList.get_end();++it)
         {
             if(pWP->irrelevant_change_set((*it)))
                 fragmentedChangePitStop_->try_to_remove((*it), pWP->m_att.guid);
@@ -562,6 +562,47 @@ bool StatefulReader::nextUntakenCache(CacheChange_t** change,WriterProxy** wpout
     return takeok;
 }
 
+size_t StatefulReader::nextUntakenCaches(std::vector<CacheChange_t*>& changes, std::vector<WriterProxy*>& wps, size_t max)
+{
+    boost::lock_guard<boost::recursive_mutex> guard(*mp_mutex);
+    std::vector<CacheChange_t*> toremove;
+    // The writer of each change is looked up once per call, not once per change.
+    std::vector<std::pair<WriterProxy*, SequenceNumber_t>> writers;
+    size_t count = 0;
+    for(std::vector<CacheChange_t*>::iterator it = mp_history->changesBegin();
+            it!=mp_history->changesEnd() && count < max;++it)
+    {
+        size_t w = 0;
+        while(w < writers.size() && writers[w].first->m_att.guid != (*it)->writerGUID)
+            ++w;
+        if(w == writers.size())
+        {
+            WriterProxy* wp;
+            if(!this->matched_writer_lookup((*it)->writerGUID, &wp))
+            {
+                toremove.push_back((*it));
+                continue;
+            }
+            writers.push_back(std::make_pair(wp, wp->available_changes_max()));
+        }
+
+        if(writers[w].second >= (*it)->sequenceNumber)
+        {
+            changes.push_back(*it);
+            wps.push_back(writers[w].first);
+            ++count;
+        }
+    }
+
+    for(std::vector<CacheChange_t*>::iterator it = toremove.begin();
+            it!=toremove.end();++it)
+    {
+        logWarning(RTPS_READER,"Removing change "<<(*it)->sequenceNumber << " from " << (*it)->writerGUID << " because is no longer paired");
+        mp_history->remove_change(*it);
+    }
+    return count;
+}
+
 // TODO Porque elimina aqui y no cuando hay unpairing
 bool StatefulReader::nextUnreadCache(CacheChange_t** change,WriterProxy** wpout)
 {
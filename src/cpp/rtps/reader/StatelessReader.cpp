@@ -122,6 +122,19 @@ bool StatelessReader::nextUntakenCache(CacheChange_t** change,WriterProxy** /*wp
 }
 
 
+size_t StatelessReader::nextUntakenCaches(std::vector<CacheChange_t*>& changes, std::vector<WriterProxy*>& wps, size_t max)
+{
+	boost::lock_guard<boost::recursive_mutex> guard(*mp_mutex);
+	size_t count = 0;
+	for(std::vector<CacheChange_t*>::iterator it = mp_history->changesBegin();
+			it != mp_history->changesEnd() && count < max; ++it, ++count)
+	{
+		changes.push_back(*it);
+		wps.push_back(nullptr);
+	}
+	return count;
+}
+
 bool StatelessReader::nextUnreadCache(CacheChange_t** change,WriterProxy** /*wpout*/)
 {
 	boost::lock_guard<boost::recursive_mutex> guard(*mp_mutex);
@@ -18,6 +18,7 @@
  */
 
 #include <fastrtps/rtps/reader/timedevent/HeartbeatResponseDelay.h>
+#include <fastrtps/rtps/messages/CDRMessagePool.h>
 #include <fastrtps/rtps/resources/ResourceEvent.h>
 #include <fastrtps/rtps/reader/WriterProxy.h>
 
@@ -98,8 +99,9 @@ void HeartbeatResponseDelay::event(EventCode code, const char* msg)
 			bool final = false;
 			if(sns.isSetEmpty())
 				final = true;
-			CDRMessage::initCDRMsg(&m_heartbeat_response_msg);
-			RTPSMessageCreator::addMessageAcknack(&m_heartbeat_response_msg,
+			CDRMessage_t& response_msg = mp_WP->mp_SFR->getRTPSParticipant()->getMessagePool().reserve_CDRMsg();
+			CDRMessage::initCDRMsg(&response_msg);
+			RTPSMessageCreator::addMessageAcknack(&response_msg,
 												mp_WP->mp_SFR->getGuid().guidPrefix,
                                                 mp_WP->m_att.guid.guidPrefix,
 												mp_WP->mp_SFR->getGuid().entityId,
@@ -110,11 +112,13 @@ void HeartbeatResponseDelay::event(EventCode code, const char* msg)
 
 			for(auto lit = mp_WP->m_att.endpoint.unicastLocatorList.begin();
 					lit!=mp_WP->m_att.endpoint.unicastLocatorList.end();++lit)
-				mp_WP->mp_SFR->getRTPSParticipant()->sendSync(&m_heartbeat_response_msg,static_cast<Endpoint *>(mp_WP->mp_SFR),(*lit));
+				mp_WP->mp_SFR->getRTPSParticipant()->sendSync(&response_msg,static_cast<Endpoint *>(mp_WP->mp_SFR),(*lit));
 
 			for(auto lit = mp_WP->m_att.endpoint.multicastLocatorList.begin();
 					lit!=mp_WP->m_att.endpoint.multicastLocatorList.end();++lit)
-				mp_WP->mp_SFR->getRTPSParticipant()->sendSync(&m_heartbeat_response_msg,static_cast<Endpoint *>(mp_WP->mp_SFR),(*lit));
+				mp_WP->mp_SFR->getRTPSParticipant()->sendSync(&response_msg,static_cast<Endpoint *>(mp_WP->mp_SFR),(*lit));
+
+			mp_WP->mp_SFR->getRTPSParticipant()->getMessagePool().release_CDRMsg(response_msg);
 		}
 
         // Now generage NACK_FRAGS
@@ -152,18 +156,21 @@ void HeartbeatResponseDelay::event(EventCode code, const char* msg)
 
                 ++mp_WP->m_nackfragCount;
                 logInfo(RTPS_READER,"Sending NACKFRAG for sample" << cit->sequenceNumber << ": "<< frag_sns;);
-                CDRMessage::initCDRMsg(&m_heartbeat_response_msg);
-                RTPSMessageCreator::addMessageNackFrag(&m_heartbeat_response_msg, mp_WP->mp_SFR->getGuid().guidPrefix,
+                CDRMessage_t& response_msg = mp_WP->mp_SFR->getRTPSParticipant()->getMessagePool().reserve_CDRMsg();
+                CDRMessage::initCDRMsg(&response_msg);
+                RTPSMessageCreator::addMessageNackFrag(&response_msg, mp_WP->mp_SFR->getGuid().guidPrefix,
                         mp_WP->m_att.guid.guidPrefix, mp_WP->mp_SFR->getGuid().entityId, mp_WP->m_att.guid.entityId,
                         cit->sequenceNumber, frag_sns, mp_WP->m_nackfragCount);
 
                 for(auto lit = mp_WP->m_att.endpoint.unicastLocatorList.begin();
                         lit!=mp_WP->m_att.endpoint.unicastLocatorList.end();++lit)
-                    mp_WP->mp_SFR->getRTPSParticipant()->sendSync(&m_heartbeat_response_msg,static_cast<Endpoint *>(mp_WP->mp_SFR),(*lit));
+                    mp_WP->mp_SFR->getRTPSParticipant()->sendSync(&response_msg,static_cast<Endpoint *>(mp_WP->mp_SFR),(*lit));
 
                 for(auto lit = mp_WP->m_att.endpoint.multicastLocatorList.begin();
                         lit!=mp_WP->m_att.endpoint.multicastLocatorList.end();++lit)
-                    mp_WP->mp_SFR->getRTPSParticipant()->sendSync(&m_heartbeat_response_msg,static_cast<Endpoint *>(mp_WP->mp_SFR),(*lit));
+                    mp_WP->mp_SFR->getRTPSParticipant()->sendSync(&response_msg,static_cast<Endpoint *>(mp_WP->mp_SFR),(*lit));
+
+                mp_WP->mp_SFR->getRTPSParticipant()->getMessagePool().release_CDRMsg(response_msg);
             }
         }
 	}
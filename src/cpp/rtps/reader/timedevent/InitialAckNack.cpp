@@ -18,6 +18,7 @@
  */
 
 #include <fastrtps/rtps/reader/timedevent/InitialAckNack.h>
+#include <fastrtps/rtps/messages/CDRMessagePool.h>
 #include <fastrtps/rtps/resources/ResourceEvent.h>
 
 #include <fastrtps/rtps/reader/StatefulReader.h>
@@ -72,8 +73,9 @@ void InitialAckNack::event(EventCode code, const char* msg)
 
         logInfo(RTPS_READER,"Sending ACKNACK: "<< sns;);
 
-        CDRMessage::initCDRMsg(&initial_acknack_msg_);
-        RTPSMessageCreator::addMessageAcknack(&initial_acknack_msg_,
+        CDRMessage_t& acknack_msg = wp_->mp_SFR->getRTPSParticipant()->getMessagePool().reserve_CDRMsg();
+        CDRMessage::initCDRMsg(&acknack_msg);
+        RTPSMessageCreator::addMessageAcknack(&acknack_msg,
                 wp_->mp_SFR->getGuid().guidPrefix,
                 wp_->m_att.guid.guidPrefix,
                 wp_->mp_SFR->getGuid().entityId,
@@ -84,11 +86,13 @@ void InitialAckNack::event(EventCode code, const char* msg)
 
         for(auto lit = wp_->m_att.endpoint.unicastLocatorList.begin();
                 lit != wp_->m_att.endpoint.unicastLocatorList.end(); ++lit)
-            wp_->mp_SFR->getRTPSParticipant()->sendSync(&initial_acknack_msg_, static_cast<Endpoint *>(wp_->mp_SFR), (*lit));
+            wp_->mp_SFR->getRTPSParticipant()->sendSync(&acknack_msg, static_cast<Endpoint *>(wp_->mp_SFR), (*lit));
 
         for(auto lit = wp_->m_att.endpoint.multicastLocatorList.begin();
                 lit != wp_->m_att.endpoint.multicastLocatorList.end(); ++lit)
-            wp_->mp_SFR->getRTPSParticipant()->sendSync(&initial_acknack_msg_, static_cast<Endpoint *>(wp_->mp_SFR),(*lit));
+            wp_->mp_SFR->getRTPSParticipant()->sendSync(&acknack_msg, static_cast<Endpoint *>(wp_->mp_SFR),(*lit));
+
+        wp_->mp_SFR->getRTPSParticipant()->getMessagePool().release_CDRMsg(acknack_msg);
 	}
 	else if(code == EVENT_ABORT)
 	{
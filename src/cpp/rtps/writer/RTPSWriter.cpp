@@ -20,10 +20,16 @@
 #include <fastrtps/rtps/writer/RTPSWriter.h>
 #include <fastrtps/rtps/history/WriterHistory.h>
 #include <fastrtps/rtps/messages/RTPSMessageCreator.h>
+#include <fastrtps/rtps/writer/timedevent/BatchFlushDelay.h>
+#include <fastrtps/utils/TimeConversion.h>
 #include <fastrtps/log/Log.h>
 #include "../participant/RTPSParticipantImpl.h"
 
 #include <boost/thread/recursive_mutex.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+
+#include <algorithm>
 
 using namespace eprosima::fastrtps::rtps;
 
@@ -31,7 +37,8 @@ using namespace eprosima::fastrtps::rtps;
 RTPSWriter::RTPSWriter(RTPSParticipantImpl* impl, GUID_t& guid, WriterAttributes& att, WriterHistory* hist, WriterListener* listen):
     Endpoint(impl,guid,att.endpoint),
     m_pushMode(true),
-    m_cdrmessages(impl->getMaxMessageSize() > att.throughputController.bytesPerPeriod ?
+    m_cdrmessage_header(RTPSMESSAGE_HEADER_SIZE),
+    m_max_message_size(impl->getMaxMessageSize() > att.throughputController.bytesPerPeriod ?
             att.throughputController.bytesPerPeriod > impl->getRTPSParticipantAttributes().throughputController.bytesPerPeriod ?
             impl->getRTPSParticipantAttributes().throughputController.bytesPerPeriod :
             att.throughputController.bytesPerPeriod :
@@ -41,29 +48,82 @@ RTPSWriter::RTPSWriter(RTPSParticipantImpl* impl, GUID_t& guid, WriterAttributes
     m_livelinessAsserted(false),
     mp_history(hist),
     mp_listener(listen),
-    is_async_(att.mode == SYNCHRONOUS_WRITER ? false : true)
+    is_async_(att.mode == SYNCHRONOUS_WRITER ? false : true),
+    m_nextDataTemplate(0),
+    m_batching(att.batching),
+    m_batchBytes(0),
+    mp_batchFlushDelay(nullptr),
+    m_nextSendTurn(0),
+    m_sendTurn(0),
+    mp_sendMutex(new boost::mutex()),
+    mp_sendTurnCond(new boost::condition_variable())
 {
     mp_history->mp_writer = this;
     mp_history->mp_mutex = mp_mutex;
     this->init_header();
+
+    // Asynchronous writers already group their unsent changes.
+    if(is_async_)
+        m_batching.enabled = false;
+
+    if(m_batching.enabled)
+    {
+        // Room left by the RTPS header, INFO_DST and INFO_TS.
+        const uint32_t message_overhead = RTPSMESSAGE_HEADER_SIZE + 16 + 12;
+        uint32_t max_bytes = m_max_message_size > message_overhead ? m_max_message_size - message_overhead : 0;
+        if(m_batching.maxBytes == 0 || m_batching.maxBytes > max_bytes)
+            m_batching.maxBytes = max_bytes;
+        m_batchingStatistics.capacity = m_batching.maxBytes;
+        mp_batchFlushDelay = new BatchFlushDelay(this, TimeConv::Time_t2MilliSecondsDouble(m_batching.maxDelay));
+    }
     logInfo(RTPS_WRITER,"RTPSWriter created");
 }
 
 void RTPSWriter::init_header()
 {
-    CDRMessage::initCDRMsg(&m_cdrmessages.m_rtpsmsg_header);
-    RTPSMessageCreator::addHeader(&m_cdrmessages.m_rtpsmsg_header,m_guid.guidPrefix);
+    CDRMessage::initCDRMsg(&m_cdrmessage_header);
+    RTPSMessageCreator::addHeader(&m_cdrmessage_header,m_guid.guidPrefix);
 }
 
 
+DataSubmessageTemplate_t RTPSWriter::getDataTemplate(const EntityId_t& readerId, bool expectsInlineQos)
+{
+    // Writers usually send to a handful of reader entity ids, so a linear search is enough.
+    static const size_t max_templates = 16;
+
+    boost::lock_guard<boost::mutex> guard(*mp_sendMutex);
+
+    for(size_t i = 0; i < m_dataTemplates.size(); ++i)
+    {
+        if(m_dataTemplates[i].matches(readerId, expectsInlineQos))
+            return m_dataTemplates[i];
+    }
+
+    size_t index = m_dataTemplates.size();
+    if(index < max_templates)
+        m_dataTemplates.push_back(DataSubmessageTemplate_t());
+    else
+    {
+        index = m_nextDataTemplate;
+        m_nextDataTemplate = (m_nextDataTemplate + 1) % max_templates;
+    }
+
+    m_dataTemplates[index].init(m_guid.entityId, readerId, m_att.topicKind, expectsInlineQos);
+    return m_dataTemplates[index];
+}
+
 RTPSWriter::~RTPSWriter()
 {
     logInfo(RTPS_WRITER,"RTPSWriter destructor");
 
     // Deletion of the events has to be made in child destructor.
+    destroy_batch_flush_delay();
 
     mp_history->mp_writer = nullptr;
     mp_history->mp_mutex = nullptr;
+
+    delete mp_sendTurnCond;
+    delete mp_sendMutex;
 }
 
 CacheChange_t* RTPSWriter::new_change(const std::function<uint32_t()>& dataCdrSerializedSize,
@@ -88,6 +148,27 @@ CacheChange_t* RTPSWriter::new_change(const std::function<uint32_t()>& dataCdrSe
     return ch;
 }
 
+bool RTPSWriter::new_changes(std::vector<CacheChange_t*>& changes, size_t count,
+        const std::function<uint32_t(size_t)>& dataCdrSerializedSize, ChangeKind_t changeKind)
+{
+    logInfo(RTPS_WRITER,"Creating " << count << " new changes");
+    size_t first = changes.size();
+
+    if(!mp_history->reserve_Caches(changes, count, dataCdrSerializedSize))
+    {
+        logWarning(RTPS_WRITER,"Problem reserving Caches from the History");
+        return false;
+    }
+
+    for(size_t i = first; i < changes.size(); ++i)
+    {
+        changes[i]->kind = changeKind;
+        changes[i]->instanceHandle = c_InstanceHandle_Unknown;
+        changes[i]->writerGUID = m_guid;
+    }
+    return true;
+}
+
 SequenceNumber_t RTPSWriter::get_seq_num_min()
 {
     CacheChange_t* change;
@@ -130,3 +211,199 @@ bool RTPSWriter::remove_older_changes(unsigned int max)
 
     return at_least_one;
 }
+
+size_t RTPSWriter::flush()
+{
+    size_t samples = 0;
+    {
+        boost::lock_guard<boost::recursive_mutex> guard(*mp_mutex);
+        samples = flush_batch(BatchingStatistics::FLUSHED_EXPLICITLY);
+    }
+    send_pending_changes();
+    return samples;
+}
+
+BatchingStatistics RTPSWriter::getBatchingStatistics()
+{
+    boost::lock_guard<boost::recursive_mutex> guard(*mp_mutex);
+    return m_batchingStatistics;
+}
+
+bool RTPSWriter::add_to_batch(CacheChange_t* change)
+{
+    if(!m_batching.enabled || change->getFragmentSize() != 0)
+    {
+        // The change is sent right away, so the batched ones go first to keep the order.
+        flush_batch(BatchingStatistics::FLUSHED_EXPLICITLY);
+        return false;
+    }
+
+    // Size of the DATA submessage, as RTPSMessageCreator writes it without a writer inline QoS list.
+    uint32_t bytes = DataSubmessageTemplate_t::size + 4 + change->serializedPayload.length;
+    if(m_att.topicKind == WITH_KEY)
+        bytes += 24;
+    bytes = (bytes + 3) & ~3u;
+
+    if(!m_batch.empty() && m_batchBytes + bytes > m_batching.maxBytes)
+        flush_batch(BatchingStatistics::FLUSHED_BY_SIZE);
+
+    m_batch.push_back(CacheChangeForGroup_t(change));
+    m_batchBytes += bytes;
+
+    if(m_batchBytes >= m_batching.maxBytes ||
+            (m_batching.maxSamples != 0 && m_batch.size() >= m_batching.maxSamples))
+        flush_batch(BatchingStatistics::FLUSHED_BY_SIZE);
+    else if(m_batch.size() == 1)
+        mp_batchFlushDelay->restart_timer();
+
+    return true;
+}
+
+void RTPSWriter::remove_from_batch(const CacheChange_t* change)
+{
+    for(auto it = m_batch.begin(); it != m_batch.end(); ++it)
+    {
+        if(it->getChange() == change)
+        {
+            m_batch.erase(it);
+            break;
+        }
+    }
+
+    if(m_batch.empty())
+    {
+        m_batchBytes = 0;
+        if(mp_batchFlushDelay != nullptr)
+            mp_batchFlushDelay->cancel_timer();
+    }
+}
+
+size_t RTPSWriter::flush_batch(BatchingStatistics::FlushReason reason)
+{
+    if(m_batch.empty())
+        return 0;
+
+    // Does nothing when called from the event itself.
+    mp_batchFlushDelay->cancel_timer();
+
+    std::vector<CacheChangeForGroup_t> changes;
+    changes.swap(m_batch);
+    size_t samples = changes.size();
+
+    ++m_batchingStatistics.batches;
+    m_batchingStatistics.samples += samples;
+    m_batchingStatistics.bytes += m_batchBytes;
+    switch(reason)
+    {
+        case BatchingStatistics::FLUSHED_BY_SIZE: ++m_batchingStatistics.flushedBySize; break;
+        case BatchingStatistics::FLUSHED_BY_DELAY: ++m_batchingStatistics.flushedByDelay; break;
+        case BatchingStatistics::FLUSHED_EXPLICITLY: ++m_batchingStatistics.flushedExplicitly; break;
+    }
+    m_batchBytes = 0;
+
+    logInfo(RTPS_WRITER, "Flushing batch of " << samples << " changes");
+    m_pendingChanges.insert(m_pendingChanges.end(), changes.begin(), changes.end());
+
+    return samples;
+}
+
+void RTPSWriter::remove_from_pending(const CacheChange_t* change)
+{
+    for(auto it = m_pendingChanges.begin(); it != m_pendingChanges.end(); ++it)
+    {
+        if(it->getChange() == change)
+        {
+            m_pendingChanges.erase(it);
+            break;
+        }
+    }
+}
+
+void RTPSWriter::wait_until_sent(const CacheChange_t* change)
+{
+    // The same change can be listed again by a later turn when its buffer was reused.
+    bool in_flight = false;
+    uint64_t last_turn = 0;
+    for(auto it = m_changesInFlight.begin(); it != m_changesInFlight.end(); ++it)
+    {
+        if(it->first == change)
+        {
+            in_flight = true;
+            last_turn = it->second;
+        }
+    }
+
+    if(in_flight)
+    {
+        boost::unique_lock<boost::mutex> lock(*mp_sendMutex);
+        while(m_sendTurn <= last_turn)
+            mp_sendTurnCond->wait(lock);
+    }
+}
+
+size_t RTPSWriter::send_pending_changes()
+{
+    std::vector<CacheChangeForGroup_t> changes;
+    LocatorList_t unicast;
+    LocatorList_t multicast;
+    EntityId_t readerId = c_EntityId_Unknown;
+    bool expectsInlineQos = false;
+    uint64_t turn = 0;
+
+    {
+        boost::lock_guard<boost::recursive_mutex> guard(*mp_mutex);
+        if(m_pendingChanges.empty())
+            return 0;
+
+        changes.swap(m_pendingChanges);
+
+        // The readers were unmatched while the changes waited.
+        if(!prepare_pending_send(unicast, multicast, readerId, expectsInlineQos))
+            return 0;
+
+        turn = m_nextSendTurn++;
+        for(auto it = changes.begin(); it != changes.end(); ++it)
+            m_changesInFlight.push_back(std::make_pair(it->getChange(), turn));
+    }
+
+    // Turns are taken with the mutex locked, so the changes go out in the order of their sequence numbers.
+    {
+        boost::unique_lock<boost::mutex> lock(*mp_sendMutex);
+        while(m_sendTurn != turn)
+            mp_sendTurnCond->wait(lock);
+    }
+
+    size_t samples = changes.size();
+    RTPSMessageGroup_t msg_group(mp_RTPSParticipant->getMessagePool(), m_cdrmessage_header, m_max_message_size);
+    uint32_t bytesSent = 0;
+    do
+    {
+        bytesSent = RTPSMessageGroup::send_Changes_AsData(&msg_group, this, changes, c_GuidPrefix_Unknown,
+                readerId, unicast, multicast, expectsInlineQos);
+    } while(bytesSent > 0 && changes.size() > 0);
+
+    if(!changes.empty())
+        logError(RTPS_WRITER, "Error sending changes, " << changes.size() << " changes not sent");
+
+    {
+        boost::lock_guard<boost::mutex> lock(*mp_sendMutex);
+        ++m_sendTurn;
+    }
+    mp_sendTurnCond->notify_all();
+
+    boost::lock_guard<boost::recursive_mutex> guard(*mp_mutex);
+    m_changesInFlight.erase(std::remove_if(m_changesInFlight.begin(), m_changesInFlight.end(),
+                [turn](const std::pair<const CacheChange_t*, uint64_t>& in_flight){ return in_flight.second == turn; }),
+            m_changesInFlight.end());
+
+    return samples;
+}
+
+void RTPSWriter::destroy_batch_flush_delay()
+{
+    if(mp_batchFlushDelay != nullptr)
+    {
+        delete(mp_batchFlushDelay);
+        mp_batchFlushDelay = nullptr;
+    }
+}
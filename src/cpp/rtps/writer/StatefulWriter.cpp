@@ -75,6 +75,8 @@ StatefulWriter::~StatefulWriter()
 
     logInfo(RTPS_WRITER,"StatefulWriter destructor");
 
+    destroy_batch_flush_delay();
+
     delete all_acked_cond_;
     delete all_acked_mutex_;
 
@@ -95,6 +97,16 @@ StatefulWriter::~StatefulWriter()
  */
 
 void StatefulWriter::unsent_change_added_to_history(CacheChange_t* change)
+{
+    add_unsent_changes(&change, 1);
+}
+
+void StatefulWriter::unsent_changes_added_to_history(const std::vector<CacheChange_t*>& changes)
+{
+    add_unsent_changes(changes.data(), changes.size());
+}
+
+void StatefulWriter::add_unsent_changes(CacheChange_t* const* changes, size_t count)
 {
     boost::lock_guard<boost::recursive_mutex> guard(*mp_mutex);
 
@@ -105,56 +117,50 @@ void StatefulWriter::unsent_change_added_to_history(CacheChange_t* change)
     {
         if(!isAsync())
         {
-            LocatorList_t unilocList;
-            LocatorList_t multilocList;
-            bool expectsInlineQos = false;
-
             for(auto it = matched_readers.begin(); it != matched_readers.end(); ++it)
             {
-                ChangeForReader_t changeForReader(change);
+                (*it)->mp_mutex->lock();
+                for(size_t i = 0; i < count; ++i)
+                {
+                    ChangeForReader_t changeForReader(changes[i]);
 
-                if(m_pushMode)
-                    changeForReader.setStatus(UNDERWAY);
-                else
-                    changeForReader.setStatus(UNACKNOWLEDGED);
+                    if(m_pushMode)
+                        changeForReader.setStatus(UNDERWAY);
+                    else
+                        changeForReader.setStatus(UNACKNOWLEDGED);
 
-                (*it)->mp_mutex->lock();
-                changeForReader.setRelevance((*it)->rtps_is_relevant(change));
-                (*it)->addChange(changeForReader);
-                unilocList.push_back((*it)->m_att.endpoint.unicastLocatorList);
-                multilocList.push_back((*it)->m_att.endpoint.multicastLocatorList);
-                expectsInlineQos |= (*it)->m_att.expectsInlineQos;
+                    changeForReader.setRelevance((*it)->rtps_is_relevant(changes[i]));
+                    (*it)->addChange(changeForReader);
+                }
                 (*it)->mp_mutex->unlock();
 
                 (*it)->mp_nackSupression->restart_timer();
             }
 
-            std::vector<CacheChangeForGroup_t> changes_to_send;
-            changes_to_send.push_back(CacheChangeForGroup_t(change));
-
-            uint32_t bytesSent = RTPSMessageGroup::send_Changes_AsData(&m_cdrmessages, (RTPSWriter*)this,
-                    changes_to_send, c_GuidPrefix_Unknown, c_EntityId_Unknown, unilocList,
-                    multilocList, expectsInlineQos);
-
-            if(bytesSent == 0 || changes_to_send.size() > 0)
-                logError(RTPS_WRITER, "Error sending change " << change->sequenceNumber);
-
-            this->mp_periodicHB->restart_timer();
+            // The changes are sent by the history once the mutex is released.
+            for(size_t i = 0; i < count; ++i)
+            {
+                if(!add_to_batch(changes[i]))
+                    m_pendingChanges.push_back(CacheChangeForGroup_t(changes[i]));
+            }
         }
         else
         {
             for(auto it = matched_readers.begin(); it != matched_readers.end(); ++it)
             {
-                ChangeForReader_t changeForReader(change);
+                boost::lock_guard<boost::recursive_mutex> rguard(*(*it)->mp_mutex);
+                for(size_t i = 0; i < count; ++i)
+                {
+                    ChangeForReader_t changeForReader(changes[i]);
 
-                if(m_pushMode)
-                    changeForReader.setStatus(UNSENT);
-                else
-                    changeForReader.setStatus(UNACKNOWLEDGED);
+                    if(m_pushMode)
+                        changeForReader.setStatus(UNSENT);
+                    else
+                        changeForReader.setStatus(UNACKNOWLEDGED);
 
-                boost::lock_guard<boost::recursive_mutex> rguard(*(*it)->mp_mutex);
-                changeForReader.setRelevance((*it)->rtps_is_relevant(change));
-                (*it)->addChange(changeForReader);
+                    changeForReader.setRelevance((*it)->rtps_is_relevant(changes[i]));
+                    (*it)->addChange(changeForReader);
+                }
             }
         }
     }
@@ -177,6 +183,28 @@ bool StatefulWriter::change_removed_by_history(CacheChange_t* a_change)
         (*it)->setNotValid(a_change);
     }
 
+    remove_from_batch(a_change);
+    remove_from_pending(a_change);
+
+    return true;
+}
+
+bool StatefulWriter::prepare_pending_send(LocatorList_t& unicast, LocatorList_t& multicast,
+        EntityId_t& readerId, bool& expectsInlineQos)
+{
+    for(auto it = matched_readers.begin(); it != matched_readers.end(); ++it)
+    {
+        boost::lock_guard<boost::recursive_mutex> rguard(*(*it)->mp_mutex);
+        unicast.push_back((*it)->m_att.endpoint.unicastLocatorList);
+        multicast.push_back((*it)->m_att.endpoint.multicastLocatorList);
+        expectsInlineQos |= (*it)->m_att.expectsInlineQos;
+    }
+
+    if(unicast.empty() && multicast.empty())
+        return false;
+
+    readerId = c_EntityId_Unknown;
+    this->mp_periodicHB->restart_timer();
     return true;
 }
 
@@ -250,13 +278,15 @@ size_t StatefulWriter::send_any_unsent_changes()
 
         if(m_pushMode)
         {
+            RTPSMessageGroup_t msg_group(mp_RTPSParticipant->getMessagePool(), m_cdrmessage_header, m_max_message_size);
+
             if(!relevant_changes.empty())
             {
                 number_of_changes_sent += relevant_changes.size();
                 uint32_t bytesSent = 0;
                 do
                 {
-                    bytesSent =  RTPSMessageGroup::send_Changes_AsData(&m_cdrmessages, (RTPSWriter*)this,
+                    bytesSent =  RTPSMessageGroup::send_Changes_AsData(&msg_group, (RTPSWriter*)this,
                             relevant_changes,
                             (*m_reader_iterator)->m_att.guid.guidPrefix,
                             (*m_reader_iterator)->m_att.guid.entityId,
@@ -266,7 +296,7 @@ size_t StatefulWriter::send_any_unsent_changes()
                 } while(bytesSent > 0 && relevant_changes.size() > 0);
             }
             if(!not_relevant_changes.empty())
-                RTPSMessageGroup::send_Changes_AsGap(&m_cdrmessages,(RTPSWriter*)this,
+                RTPSMessageGroup::send_Changes_AsGap(&msg_group,(RTPSWriter*)this,
                         &not_relevant_changes,
                         (*m_reader_iterator)->m_att.guid.guidPrefix,
                         (*m_reader_iterator)->m_att.guid.entityId,
@@ -287,15 +317,17 @@ size_t StatefulWriter::send_any_unsent_changes()
             if(firstSeq != c_SequenceNumber_Unknown && lastSeq != c_SequenceNumber_Unknown && lastSeq >= firstSeq)
             {
                 this->incrementHBCount();
-                CDRMessage::initCDRMsg(&m_cdrmessages.m_rtpsmsg_fullmsg);
+                CDRMessage_t& hb_msg = mp_RTPSParticipant->getMessagePool().reserve_CDRMsg();
+                CDRMessage::initCDRMsg(&hb_msg);
 				// TODO(Ricardo) This is a StatefulWriter in Reliable. Hast the FinalFlag be true? Check.
-                RTPSMessageCreator::addMessageHeartbeat(&m_cdrmessages.m_rtpsmsg_fullmsg,m_guid.guidPrefix,
+                RTPSMessageCreator::addMessageHeartbeat(&hb_msg,m_guid.guidPrefix,
                         m_HBReaderEntityId, m_guid.entityId, firstSeq, lastSeq, m_heartbeatCount, true, false);
                 std::vector<Locator_t>::iterator lit;
                 for(lit = (*m_reader_iterator)->m_att.endpoint.unicastLocatorList.begin();lit!=(*m_reader_iterator)->m_att.endpoint.unicastLocatorList.end();++lit)
-                    getRTPSParticipant()->sendSync(&m_cdrmessages.m_rtpsmsg_fullmsg,(Endpoint *)this,(*lit));
+                    getRTPSParticipant()->sendSync(&hb_msg,(Endpoint *)this,(*lit));
                 for(lit = (*m_reader_iterator)->m_att.endpoint.multicastLocatorList.begin();lit!=(*m_reader_iterator)->m_att.endpoint.multicastLocatorList.end();++lit)
-                    getRTPSParticipant()->sendSync(&m_cdrmessages.m_rtpsmsg_fullmsg,(Endpoint *)this,(*lit));
+                    getRTPSParticipant()->sendSync(&hb_msg,(Endpoint *)this,(*lit));
+                mp_RTPSParticipant->getMessagePool().release_CDRMsg(hb_msg);
             }
         }
     }
@@ -619,14 +651,16 @@ void StatefulWriter::send_heartbeat_to(ReaderProxy& remoteReaderProxy)
     }
 
     this->incrementHBCount();
-    CDRMessage::initCDRMsg(&m_cdrmessages.m_rtpsmsg_fullmsg);
+    CDRMessage_t& hb_msg = mp_RTPSParticipant->getMessagePool().reserve_CDRMsg();
+    CDRMessage::initCDRMsg(&hb_msg);
     // FinalFlag is always false because this is a StatefulWriter in Reliable.
-    RTPSMessageCreator::addMessageHeartbeat(&m_cdrmessages.m_rtpsmsg_fullmsg, m_guid.guidPrefix, remoteReaderProxy.m_att.guid.guidPrefix,
+    RTPSMessageCreator::addMessageHeartbeat(&hb_msg, m_guid.guidPrefix, remoteReaderProxy.m_att.guid.guidPrefix,
             remoteReaderProxy.m_att.guid.entityId, m_guid.entityId,
             firstSeq, lastSeq, m_heartbeatCount, false, false);
     logInfo(RTPS_WRITER, m_guid.entityId << " Sending Heartbeat (" << firstSeq << " - " << lastSeq << ")");
     for (auto lit = remoteReaderProxy.m_att.endpoint.multicastLocatorList.begin(); lit != remoteReaderProxy.m_att.endpoint.multicastLocatorList.end(); ++lit)
-        mp_RTPSParticipant->sendSync(&m_cdrmessages.m_rtpsmsg_fullmsg, (Endpoint *)this, (*lit));
+        mp_RTPSParticipant->sendSync(&hb_msg, (Endpoint *)this, (*lit));
     for (auto lit = remoteReaderProxy.m_att.endpoint.unicastLocatorList.begin(); lit != remoteReaderProxy.m_att.endpoint.unicastLocatorList.end(); ++lit)
-        mp_RTPSParticipant->sendSync(&m_cdrmessages.m_rtpsmsg_fullmsg, (Endpoint *)this, (*lit));
+        mp_RTPSParticipant->sendSync(&hb_msg, (Endpoint *)this, (*lit));
+    mp_RTPSParticipant->getMessagePool().release_CDRMsg(hb_msg);
 }
@@ -41,6 +41,7 @@ StatelessWriter::~StatelessWriter()
 {
    AsyncWriterThread::removeWriter(*this);
 	logInfo(RTPS_WRITER,"StatelessWriter destructor";);
+   destroy_batch_flush_delay();
 }
 
 /*
@@ -48,26 +49,31 @@ StatelessWriter::~StatelessWriter()
  */
 
 void StatelessWriter::unsent_change_added_to_history(CacheChange_t* cptr)
+{
+    add_unsent_changes(&cptr, 1);
+}
+
+void StatelessWriter::unsent_changes_added_to_history(const std::vector<CacheChange_t*>& changes)
+{
+    add_unsent_changes(changes.data(), changes.size());
+}
+
+void StatelessWriter::add_unsent_changes(CacheChange_t* const* changes, size_t count)
 {
 	boost::lock_guard<boost::recursive_mutex> guard(*mp_mutex);
 
     if(!isAsync())
     {
-        std::vector<CacheChangeForGroup_t> changes_to_send;
-        changes_to_send.push_back(CacheChangeForGroup_t(cptr));
         this->setLivelinessAsserted(true);
 
         if(!reader_locator.empty()) //TODO change to m_reader_locator.
         {
-
-            uint32_t bytesSent = RTPSMessageGroup::send_Changes_AsData(&m_cdrmessages, (RTPSWriter*)this,
-                    changes_to_send, c_GuidPrefix_Unknown,
-                    this->m_guid.entityId == ENTITYID_SPDP_BUILTIN_RTPSParticipant_WRITER ? c_EntityId_SPDPReader : c_EntityId_Unknown,
-                    m_loc_list_1_for_sync_send, m_loc_list_2_for_sync_send, false);
-
-            // Check send
-            if(bytesSent == 0 || changes_to_send.size() > 0)
-                logError(RTPS_WRITER, "Error sending change " << cptr->sequenceNumber);
+            // The changes are sent by the history once the mutex is released.
+            for(size_t i = 0; i < count; ++i)
+            {
+                if(!add_to_batch(changes[i]))
+                    m_pendingChanges.push_back(CacheChangeForGroup_t(changes[i]));
+            }
         }
         else
         {
@@ -76,7 +82,8 @@ void StatelessWriter::unsent_change_added_to_history(CacheChange_t* cptr)
     }
     else
     {
-        m_unsent_changes.emplace_back(cptr);
+        for(size_t i = 0; i < count; ++i)
+            m_unsent_changes.emplace_back(changes[i]);
         AsyncWriterThread::wakeUp(this);
     }
 }
@@ -92,9 +99,25 @@ bool StatelessWriter::change_removed_by_history(CacheChange_t* change)
     bool removed = newEnd != m_unsent_changes.end();
     m_unsent_changes.erase(newEnd, m_unsent_changes.end());
 
+    remove_from_batch(change);
+    remove_from_pending(change);
+
     return removed;
 }
 
+bool StatelessWriter::prepare_pending_send(LocatorList_t& unicast, LocatorList_t& multicast,
+        EntityId_t& readerId, bool& expectsInlineQos)
+{
+    if(reader_locator.empty())
+        return false;
+
+    unicast = m_loc_list_1_for_sync_send;
+    multicast = m_loc_list_2_for_sync_send;
+    readerId = this->m_guid.entityId == ENTITYID_SPDP_BUILTIN_RTPSParticipant_WRITER ? c_EntityId_SPDPReader : c_EntityId_Unknown;
+    expectsInlineQos = false;
+    return true;
+}
+
 void StatelessWriter::update_unsent_changes(const std::vector<CacheChangeForGroup_t>& changes)
 {
    for (auto& change : changes)
@@ -145,11 +168,12 @@ size_t StatelessWriter::send_any_unsent_changes()
       number_of_changes_sent += changes_to_send.size();
       if(m_pushMode)
       {
+         RTPSMessageGroup_t msg_group(mp_RTPSParticipant->getMessagePool(), m_cdrmessage_header, m_max_message_size);
          uint32_t bytesSent = 0;
 
          do
          {
-             bytesSent = RTPSMessageGroup::send_Changes_AsData(&m_cdrmessages, (RTPSWriter*)this,
+             bytesSent = RTPSMessageGroup::send_Changes_AsData(&msg_group, (RTPSWriter*)this,
                          changes_to_send, c_GuidPrefix_Unknown,
                          this->m_guid.entityId == ENTITYID_SPDP_BUILTIN_RTPSParticipant_WRITER ? c_EntityId_SPDPReader : c_EntityId_Unknown,
                          m_loc_list_1_for_sync_send, m_loc_list_2_for_sync_send, false);
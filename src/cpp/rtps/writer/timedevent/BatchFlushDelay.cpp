@@ -0,0 +1,75 @@
+// Copyright 2016 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file BatchFlushDelay.cpp
+ *
+ */
+
+#include <fastrtps/rtps/writer/timedevent/BatchFlushDelay.h>
+#include <fastrtps/rtps/resources/ResourceEvent.h>
+#include <fastrtps/rtps/writer/RTPSWriter.h>
+
+#include "../../participant/RTPSParticipantImpl.h"
+
+#include <fastrtps/log/Log.h>
+
+#include <boost/thread/recursive_mutex.hpp>
+#include <boost/thread/lock_guard.hpp>
+
+namespace eprosima {
+namespace fastrtps{
+namespace rtps{
+
+
+BatchFlushDelay::~BatchFlushDelay()
+{
+	logInfo(RTPS_WRITER,"Destroying BatchFlushDelay");
+	destroy();
+}
+
+BatchFlushDelay::BatchFlushDelay(RTPSWriter* writer,double interval):
+TimedEvent(writer->getRTPSParticipant()->getEventResource().getIOService(),
+writer->getRTPSParticipant()->getEventResource().getThread(), interval), mp_writer(writer)
+{
+
+}
+
+void BatchFlushDelay::event(EventCode code, const char* msg)
+{
+
+	// Unused in release mode.
+	(void)msg;
+
+	if(code == EVENT_SUCCESS)
+	{
+		{
+			boost::lock_guard<boost::recursive_mutex> guard(*mp_writer->getMutex());
+			mp_writer->flush_batch(BatchingStatistics::FLUSHED_BY_DELAY);
+		}
+		mp_writer->send_pending_changes();
+	}
+	else if(code == EVENT_ABORT)
+	{
+		logInfo(RTPS_WRITER,"Batch flush aborted");
+	}
+	else
+	{
+		logInfo(RTPS_WRITER,"Batch flush message: " <<msg);
+	}
+}
+
+}
+}
+} /* namespace eprosima */
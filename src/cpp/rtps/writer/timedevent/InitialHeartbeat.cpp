@@ -18,6 +18,7 @@
  */
 
 #include <fastrtps/rtps/writer/timedevent/InitialHeartbeat.h>
+#include <fastrtps/rtps/messages/CDRMessagePool.h>
 #include <fastrtps/rtps/resources/ResourceEvent.h>
 
 #include <fastrtps/rtps/writer/StatefulWriter.h>
@@ -82,16 +83,18 @@ void InitialHeartbeat::event(EventCode code, const char* msg)
 			heartbeatCount = rp_->mp_SFW->getHeartbeatCount();
 		}
 
-        CDRMessage::initCDRMsg(&initial_hb_msg_);
+        CDRMessage_t& hb_msg = rp_->mp_SFW->getRTPSParticipant()->getMessagePool().reserve_CDRMsg();
+        CDRMessage::initCDRMsg(&hb_msg);
         // FinalFlag is always false because this is a StatefulWriter in Reliable.
-        RTPSMessageCreator::addMessageHeartbeat(&initial_hb_msg_, rp_->mp_SFW->getGuid().guidPrefix, rp_->m_att.guid.guidPrefix,
+        RTPSMessageCreator::addMessageHeartbeat(&hb_msg, rp_->mp_SFW->getGuid().guidPrefix, rp_->m_att.guid.guidPrefix,
                 rp_->m_att.guid.entityId, rp_->mp_SFW->getGuid().entityId,
                 firstSeq, lastSeq, heartbeatCount, false, false);
         logInfo(RTPS_WRITER, rp_->mp_SFW->getGuid().entityId << " Sending Heartbeat (" << firstSeq << " - " << lastSeq << ")");
         for (auto lit = rp_->m_att.endpoint.multicastLocatorList.begin(); lit != rp_->m_att.endpoint.multicastLocatorList.end(); ++lit)
-            rp_->mp_SFW->getRTPSParticipant()->sendSync(&initial_hb_msg_, (Endpoint *)rp_->mp_SFW, (*lit));
+            rp_->mp_SFW->getRTPSParticipant()->sendSync(&hb_msg, (Endpoint *)rp_->mp_SFW, (*lit));
         for (auto lit = rp_->m_att.endpoint.unicastLocatorList.begin(); lit != rp_->m_att.endpoint.unicastLocatorList.end(); ++lit)
-            rp_->mp_SFW->getRTPSParticipant()->sendSync(&initial_hb_msg_, (Endpoint *)rp_->mp_SFW, (*lit));
+            rp_->mp_SFW->getRTPSParticipant()->sendSync(&hb_msg, (Endpoint *)rp_->mp_SFW, (*lit));
+        rp_->mp_SFW->getRTPSParticipant()->getMessagePool().release_CDRMsg(hb_msg);
 	}
 	else if(code == EVENT_ABORT)
 	{
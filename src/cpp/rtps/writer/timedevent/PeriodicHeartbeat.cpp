@@ -18,6 +18,7 @@
  */
 
 #include <fastrtps/rtps/writer/timedevent/PeriodicHeartbeat.h>
+#include <fastrtps/rtps/messages/CDRMessagePool.h>
 #include <fastrtps/rtps/resources/ResourceEvent.h>
 
 #include <fastrtps/rtps/writer/StatefulWriter.h>
@@ -101,14 +102,16 @@ void PeriodicHeartbeat::event(EventCode code, const char* msg)
 
 		if (unacked_changes)
 		{
-			CDRMessage::initCDRMsg(&m_periodic_hb_msg);
+			CDRMessage_t& hb_msg = mp_SFW->getRTPSParticipant()->getMessagePool().reserve_CDRMsg();
+			CDRMessage::initCDRMsg(&hb_msg);
 			// FinalFlag is always false because this class is used only by StatefulWriter in Reliable.
-			RTPSMessageCreator::addMessageHeartbeat(&m_periodic_hb_msg, mp_SFW->getGuid().guidPrefix,
+			RTPSMessageCreator::addMessageHeartbeat(&hb_msg, mp_SFW->getGuid().guidPrefix,
 				mp_SFW->getHBReaderEntityId(), mp_SFW->getGuid().entityId,
 				firstSeq, lastSeq, heartbeatCount, false, false);
 			logInfo(RTPS_WRITER,mp_SFW->getGuid().entityId << " Sending Heartbeat ("<<firstSeq<< " - " << lastSeq<<")" );
 			for (std::vector<Locator_t>::iterator lit = locList.begin(); lit != locList.end(); ++lit)
-				mp_SFW->getRTPSParticipant()->sendSync(&m_periodic_hb_msg,(Endpoint *)mp_SFW , (*lit));
+				mp_SFW->getRTPSParticipant()->sendSync(&hb_msg,(Endpoint *)mp_SFW , (*lit));
+			mp_SFW->getRTPSParticipant()->getMessagePool().release_CDRMsg(hb_msg);
 		
 			//Reset TIMER
 			this->restart_timer();
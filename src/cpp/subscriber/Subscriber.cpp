@@ -44,6 +44,26 @@ bool Subscriber::takeNextData(void* data,SampleInfo_t* info)
 	return mp_impl->takeNextData(data,info);
 }
 
+size_t Subscriber::take_samples(const std::function<void*(size_t)>& data,
+		std::vector<SampleInfo_t>& infos, size_t max)
+{
+	infos.clear();
+	return mp_impl->take_samples(data, infos, max);
+}
+
+size_t Subscriber::take_loan(std::vector<const SerializedPayload_t*>& payloads,
+		std::vector<SampleInfo_t>& infos, size_t max)
+{
+	return mp_impl->take_loan(payloads, infos, max);
+}
+
+bool Subscriber::return_loan(std::vector<const SerializedPayload_t*>& payloads)
+{
+	bool returned = mp_impl->return_loan(payloads);
+	payloads.clear();
+	return returned;
+}
+
 bool Subscriber::updateAttributes(SubscriberAttributes& att)
 {
 	return mp_impl->updateAttributes(att);
@@ -29,15 +29,50 @@
 #include <boost/thread/recursive_mutex.hpp>
 #include <boost/thread/lock_guard.hpp>
 
+#include <algorithm>
+
 namespace eprosima {
 namespace fastrtps {
 
+/**
+ * Adds a change at the back of an index. A change arriving out of order is moved back
+ * behind the newer changes of the same writer.
+ */
+static void insert_ordered(RingBuffer<CacheChange_t*>& changes, CacheChange_t* a_change)
+{
+	changes.push_back(a_change);
+	for(size_t i = changes.size() - 1; i > 0 &&
+			changes[i - 1]->writerGUID == a_change->writerGUID &&
+			a_change->sequenceNumber < changes[i - 1]->sequenceNumber; --i)
+	{
+		changes[i] = changes[i - 1];
+		changes[i - 1] = a_change;
+	}
+}
 
-inline bool sort_ReaderHistoryCache(CacheChange_t*c1,CacheChange_t*c2)
+/**
+ * Checks whether the changes of a writer, ordered by sequence number, contain the given one.
+ */
+static bool contains_sequence(const RingBuffer<CacheChange_t*>& changes, const SequenceNumber_t& seq)
 {
-	return c1->sequenceNumber < c2->sequenceNumber;
+	// Usual case: newer than anything stored.
+	if(changes.empty() || changes.back()->sequenceNumber < seq)
+		return false;
+
+	size_t low = 0, high = changes.size();
+	while(low < high)
+	{
+		size_t middle = low + (high - low) / 2;
+		if(changes[middle]->sequenceNumber < seq)
+			low = middle + 1;
+		else
+			high = middle;
+	}
+
+	return low < changes.size() && changes[low]->sequenceNumber == seq;
 }
 
+
 SubscriberHistory::SubscriberHistory(SubscriberImpl* simpl,uint32_t payloadMaxSize,
 		HistoryQosPolicy& history,
 		ResourceLimitsQosPolicy& resource,MemoryManagementPolicy_t mempolicy):
@@ -46,6 +81,7 @@ SubscriberHistory::SubscriberHistory(SubscriberImpl* simpl,uint32_t payloadMaxSi
 								m_historyQos(history),
 								m_resourceLimitsQos(resource),
 								mp_subImpl(simpl),
+								m_instanceCapacity(history.kind == KEEP_LAST_HISTORY_QOS && history.depth > 0 ? history.depth : 1),
 								mp_getKeyObject(nullptr)
 {
 
@@ -86,37 +122,31 @@ bool SubscriberHistory::received_change(CacheChange_t* a_change, size_t unknown_
 			}
 			else
 			{
-                		// Try to substitude a older samples.
-                		auto older_sample = m_changes.rend();
-                		for(auto it = m_changes.rbegin(); it != m_changes.rend(); ++it)
-                		{
-
-                    			if((*it)->writerGUID == a_change->writerGUID)
-                    			{
-                        			if((*it)->sequenceNumber < a_change->sequenceNumber)
-                            			older_sample = it;
-                        			// Already received
-                        			else if((*it)->sequenceNumber == a_change->sequenceNumber)
-                            			return false;
-                    			}
-                		}
-
-                	if(older_sample != m_changes.rend())
-                	{
-                    		bool read = (*older_sample)->isRead;
-
-                    		if(this->remove_change_sub(*older_sample))
-                    		{
-                        		if(!read)
-                        		{
-                            			this->decreaseUnreadCount();
-                        		}
-                        		add = true;
-                    		}
-                	}
-                	// Not discard, but not store and set as received.
-                	else
-                    		return true;
+				// The oldest sample of the same writer is replaced.
+				t_Writer_Changes* writer_changes = get_Writer(a_change);
+
+				// Already received
+				if(writer_changes != nullptr && contains_sequence(*writer_changes, a_change->sequenceNumber))
+					return false;
+
+				if(writer_changes != nullptr && !writer_changes->empty() &&
+						writer_changes->front()->sequenceNumber < a_change->sequenceNumber)
+				{
+					CacheChange_t* older_sample = writer_changes->front();
+					bool read = older_sample->isRead;
+
+					if(this->remove_change_sub(older_sample))
+					{
+						if(!read)
+						{
+							this->decreaseUnreadCount();
+						}
+						add = true;
+					}
+				}
+				// Not discard, but not store and set as received.
+				else
+					return true;
 			}
 		}
 
@@ -132,11 +162,10 @@ bool SubscriberHistory::received_change(CacheChange_t* a_change, size_t unknown_
 			if(this->add_change(a_change))
 			{
 				increaseUnreadCount();
-				if(a_change->sequenceNumber < mp_maxSeqCacheChange->sequenceNumber)
-					sortCacheChanges();
-				updateMaxMinSeqNum();
 				if((int32_t)m_changes.size()==m_resourceLimitsQos.max_samples)
 					m_isHistoryFull = true;
+				if(m_historyQos.kind == KEEP_LAST_HISTORY_QOS)
+					insert_ordered(find_Writer(a_change), a_change);
 				logInfo(SUBSCRIBER,this->mp_subImpl->getGuid().entityId
 						<<": Change "<< a_change->sequenceNumber << " added from: "
 						<< a_change->writerGUID;);
@@ -151,10 +180,12 @@ bool SubscriberHistory::received_change(CacheChange_t* a_change, size_t unknown_
 		if(!a_change->instanceHandle.isDefined() && mp_subImpl->getType() !=nullptr)
 		{
 			logInfo(RTPS_HISTORY,"Getting Key of change with no Key transmitted")
-							mp_subImpl->getType()->deserialize(&a_change->serializedPayload,mp_getKeyObject);
-			if(!mp_subImpl->getType()->getKey(mp_getKeyObject,&a_change->instanceHandle))
-				return false;
-
+			if(!mp_subImpl->getType()->getKeyFromPayload(&a_change->serializedPayload,&a_change->instanceHandle))
+			{
+				mp_subImpl->getType()->deserialize(&a_change->serializedPayload,mp_getKeyObject);
+				if(!mp_subImpl->getType()->getKey(mp_getKeyObject,&a_change->instanceHandle))
+					return false;
+			}
 		}
 		else if(!a_change->instanceHandle.isDefined())
 		{
@@ -162,7 +193,7 @@ bool SubscriberHistory::received_change(CacheChange_t* a_change, size_t unknown_
 					<< " and no method to obtain it";);
 			return false;
 		}
-		t_v_Inst_Caches::iterator vit;
+		t_m_Inst_Caches::iterator vit;
 		if(find_Key(a_change,&vit))
 		{
 			//logInfo(RTPS_EDP,"Trying to add change with KEY: "<< vit->first << endl;);
@@ -187,37 +218,29 @@ bool SubscriberHistory::received_change(CacheChange_t* a_change, size_t unknown_
 				}
 				else
 				{
-                    // Try to substitude a older samples.
-                    auto older_sample = m_changes.rend();
-                    for(auto it = m_changes.rbegin(); it != m_changes.rend(); ++it)
-                    {
-
-                        if((*it)->writerGUID == a_change->writerGUID)
-                        {
-                            if((*it)->sequenceNumber < a_change->sequenceNumber)
-                                older_sample = it;
-                            // Already received
-                            else if((*it)->sequenceNumber == a_change->sequenceNumber)
-                                return false;
-                        }
-                    }
-
-                    if(older_sample != m_changes.rend())
-                    {
-                        bool read = (*older_sample)->isRead;
-
-                        if(this->remove_change_sub(*older_sample, &vit))
-                        {
-                            if(!read)
-                            {
-                                this->decreaseUnreadCount();
-                            }
-                            add = true;
-                        }
-                    }
-                    // Not discard, but not store and set as received.
-                    else
-                        return true;
+					// Already received
+					t_Writer_Changes* writer_changes = get_Writer(a_change);
+					if(writer_changes != nullptr && contains_sequence(*writer_changes, a_change->sequenceNumber))
+						return false;
+
+					// The oldest sample of the instance is replaced.
+					CacheChange_t* older_sample = vit->second.empty() ? nullptr : vit->second.front();
+
+					// Not discard, but not store and set as received.
+					if(older_sample == nullptr || (older_sample->writerGUID == a_change->writerGUID &&
+							a_change->sequenceNumber < older_sample->sequenceNumber))
+						return true;
+
+					bool read = older_sample->isRead;
+
+					if(this->remove_change_sub(older_sample, &vit))
+					{
+						if(!read)
+						{
+							this->decreaseUnreadCount();
+						}
+						add = true;
+					}
 				}
 			}
 
@@ -233,25 +256,12 @@ bool SubscriberHistory::received_change(CacheChange_t* a_change, size_t unknown_
 				if(this->add_change(a_change))
 				{
 					increaseUnreadCount();
-					if(a_change->sequenceNumber < mp_maxSeqCacheChange->sequenceNumber)
-						sortCacheChanges();
-					updateMaxMinSeqNum();
 					if((int32_t)m_changes.size()==m_resourceLimitsQos.max_samples)
 						m_isHistoryFull = true;
 					//ADD TO KEY VECTOR
-					if(vit->second.size() == 0)
-					{
-						vit->second.push_back(a_change);
-					}
-					else if(vit->second.back()->sequenceNumber < a_change->sequenceNumber)
-					{
-						vit->second.push_back(a_change);
-					}
-					else
-					{
-						vit->second.push_back(a_change);
-						std::sort(vit->second.begin(),vit->second.end(),sort_ReaderHistoryCache);
-					}
+					insert_ordered(vit->second, a_change);
+					if(m_historyQos.kind == KEEP_LAST_HISTORY_QOS)
+						insert_ordered(find_Writer(a_change), a_change);
 					logInfo(SUBSCRIBER,this->mp_reader->getGuid().entityId
 							<<": Change "<< a_change->sequenceNumber << " added from: "
 							<< a_change->writerGUID<< " with KEY: "<< a_change->instanceHandle;);
@@ -352,51 +362,222 @@ bool SubscriberHistory::takeNextData(void* data, SampleInfo_t* info)
 	return false;
 }
 
-bool SubscriberHistory::find_Key(CacheChange_t* a_change, t_v_Inst_Caches::iterator* vit_out)
+size_t SubscriberHistory::take_samples(const std::function<void*(size_t)>& data,
+		std::vector<SampleInfo_t>& infos, size_t max)
 {
-	t_v_Inst_Caches::iterator vit;
-	bool found = false;
-	for (vit = m_keyedChanges.begin(); vit != m_keyedChanges.end(); ++vit)
+	if(mp_reader == nullptr || mp_mutex == nullptr)
 	{
-		if (a_change->instanceHandle == vit->first)
-		{
-			*vit_out = vit;
-			return true;
-		}
+		logError(RTPS_HISTORY,"You need to create a Reader with this History before using it");
+		return 0;
 	}
-	if (!found)
+
+	boost::lock_guard<boost::recursive_mutex> guard(*mp_mutex);
+	this->mp_reader->nextUntakenCaches(m_takenChanges, m_takenProxies, max);
+	detach_taken_changes();
+	size_t taken = 0;
+	for(size_t i = 0; i < m_takenChanges.size(); ++i)
 	{
-		if ((int)m_keyedChanges.size() < m_resourceLimitsQos.max_instances)
+		CacheChange_t* change = m_takenChanges[i];
+		if(change == nullptr)
+			continue;
+		if(!change->isRead)
+			this->decreaseUnreadCount();
+		change->isRead = true;
+		logInfo(SUBSCRIBER,this->mp_reader->getGuid().entityId<<": taking seqNum"<< change->sequenceNumber <<
+				" from writer: "<< change->writerGUID);
+		void* sample = data(taken++);
+		if(change->kind == ALIVE)
 		{
-			t_p_I_Change newpair;
-			newpair.first = a_change->instanceHandle;
-			m_keyedChanges.push_back(newpair);
-			*vit_out = m_keyedChanges.end() - 1;
-			return true;
+			this->mp_subImpl->getType()->deserialize(&change->serializedPayload,sample);
+			if(this->mp_subImpl->getAttributes().topic.topicKind == WITH_KEY &&
+					change->instanceHandle == c_InstanceHandle_Unknown)
+			{
+				this->mp_subImpl->getType()->getKey(sample,&change->instanceHandle);
+			}
 		}
-		else
+		infos.push_back(SampleInfo_t());
+		fill_sample_info(change, m_takenProxies[i], &infos.back());
+		m_changePool.release_Cache(change);
+	}
+	m_takenChanges.clear();
+	m_takenProxies.clear();
+	return taken;
+}
+
+size_t SubscriberHistory::take_loan(std::vector<const SerializedPayload_t*>& payloads,
+		std::vector<SampleInfo_t>& infos, size_t max)
+{
+	if(mp_reader == nullptr || mp_mutex == nullptr)
+	{
+		logError(RTPS_HISTORY,"You need to create a Reader with this History before using it");
+		return 0;
+	}
+
+	boost::lock_guard<boost::recursive_mutex> guard(*mp_mutex);
+	this->mp_reader->nextUntakenCaches(m_takenChanges, m_takenProxies, max);
+	// The changes are kept out of the history until the user returns them.
+	size_t taken = detach_taken_changes();
+	for(size_t i = 0; i < m_takenChanges.size(); ++i)
+	{
+		CacheChange_t* change = m_takenChanges[i];
+		if(change == nullptr)
+			continue;
+		if(!change->isRead)
+			this->decreaseUnreadCount();
+		change->isRead = true;
+		logInfo(SUBSCRIBER,this->mp_reader->getGuid().entityId<<": loaning seqNum"<< change->sequenceNumber <<
+				" from writer: "<< change->writerGUID);
+		infos.push_back(SampleInfo_t());
+		fill_sample_info(change, m_takenProxies[i], &infos.back());
+		payloads.push_back(&change->serializedPayload);
+		m_loanedChanges.push_back(change);
+	}
+	m_takenChanges.clear();
+	m_takenProxies.clear();
+	return taken;
+}
+
+size_t SubscriberHistory::detach_taken_changes()
+{
+	size_t detached = detach_changes(m_takenChanges);
+	if(detached > 0)
+		m_isHistoryFull = false;
+
+	for(size_t i = 0; i < m_takenChanges.size(); ++i)
+	{
+		CacheChange_t* change = m_takenChanges[i];
+		if(change == nullptr)
+			continue;
+		if(mp_subImpl->getAttributes().topic.getTopicKind() == WITH_KEY)
 		{
-			for (vit = m_keyedChanges.begin(); vit != m_keyedChanges.end(); ++vit)
+			t_m_Inst_Caches::iterator vit = m_keyedChanges.find(change->instanceHandle);
+			if(vit != m_keyedChanges.end())
 			{
-				if (vit->second.size() == 0)
-				{
-					m_keyedChanges.erase(vit);
-					t_p_I_Change newpair;
-					newpair.first = a_change->instanceHandle;
-					m_keyedChanges.push_back(newpair);
-					*vit_out = m_keyedChanges.end() - 1;
-					return true;
-				}
+				size_t index = vit->second.find(change);
+				if(index < vit->second.size())
+					vit->second.erase(index);
 			}
-			logWarning(SUBSCRIBER, "History has reached the maximum number of instances" << endl;)
 		}
+		if(m_historyQos.kind == KEEP_LAST_HISTORY_QOS)
+			remove_from_Writer(change);
+	}
+	return detached;
+}
+
+bool SubscriberHistory::return_loan(const std::vector<const SerializedPayload_t*>& payloads)
+{
+	if(mp_reader == nullptr || mp_mutex == nullptr)
+	{
+		logError(RTPS_HISTORY,"You need to create a Reader with this History before using it");
+		return false;
+	}
+
+	boost::lock_guard<boost::recursive_mutex> guard(*mp_mutex);
+	bool all = true;
+	for(size_t i = 0; i < payloads.size(); ++i)
+	{
+		auto it = std::find_if(m_loanedChanges.begin(), m_loanedChanges.end(),
+				[&](CacheChange_t* ch) { return &ch->serializedPayload == payloads[i]; });
+		if(it == m_loanedChanges.end())
+		{
+			logError(SUBSCRIBER,"Payload not loaned by this subscriber");
+			all = false;
+			continue;
+		}
+		m_changePool.release_Cache(*it);
+		*it = m_loanedChanges.back();
+		m_loanedChanges.pop_back();
+	}
+	return all;
+}
+
+void SubscriberHistory::fill_sample_info(CacheChange_t* change, WriterProxy* wp, SampleInfo_t* info)
+{
+	info->sampleKind = change->kind;
+	info->sample_identity.writer_guid(change->writerGUID);
+	info->sample_identity.sequence_number(change->sequenceNumber);
+	info->sourceTimestamp = change->sourceTimestamp;
+	if(wp != nullptr && this->mp_subImpl->getAttributes().qos.m_ownership.kind == EXCLUSIVE_OWNERSHIP_QOS)
+		info->ownershipStrength = wp->m_att.ownershipStrength;
+	info->iHandle = change->instanceHandle;
+	info->related_sample_identity = change->write_params.sample_identity();
+}
+
+bool SubscriberHistory::find_Key(CacheChange_t* a_change, t_m_Inst_Caches::iterator* vit_out)
+{
+	t_m_Inst_Caches::iterator vit = m_keyedChanges.find(a_change->instanceHandle);
+	if (vit != m_keyedChanges.end())
+	{
+		*vit_out = vit;
+		return true;
+	}
 
+	if ((int)m_keyedChanges.size() < m_resourceLimitsQos.max_instances)
+	{
+		*vit_out = m_keyedChanges.insert(std::make_pair(a_change->instanceHandle, t_Inst_Changes(m_instanceCapacity))).first;
+		return true;
 	}
+
+	// Reuse an instance without changes, keeping its buffer.
+	for (vit = m_keyedChanges.begin(); vit != m_keyedChanges.end(); ++vit)
+	{
+		if (vit->second.empty())
+		{
+			t_Inst_Changes changes(std::move(vit->second));
+			m_keyedChanges.erase(vit);
+			*vit_out = m_keyedChanges.insert(std::make_pair(a_change->instanceHandle, std::move(changes))).first;
+			return true;
+		}
+	}
+
+	logWarning(SUBSCRIBER, "History has reached the maximum number of instances" << endl;)
 	return false;
 }
 
 
-bool SubscriberHistory::remove_change_sub(CacheChange_t* change,t_v_Inst_Caches::iterator* vit_in)
+SubscriberHistory::t_Writer_Changes& SubscriberHistory::find_Writer(CacheChange_t* a_change)
+{
+	t_m_Writer_Caches::iterator wit = m_writerChanges.find(a_change->writerGUID);
+	if(wit == m_writerChanges.end())
+	{
+		if(!m_spareWriterChanges.empty())
+		{
+			wit = m_writerChanges.insert(std::make_pair(a_change->writerGUID, std::move(m_spareWriterChanges.back()))).first;
+			m_spareWriterChanges.pop_back();
+		}
+		else
+			wit = m_writerChanges.insert(std::make_pair(a_change->writerGUID, t_Writer_Changes(m_instanceCapacity))).first;
+	}
+
+	return wit->second;
+}
+
+SubscriberHistory::t_Writer_Changes* SubscriberHistory::get_Writer(CacheChange_t* a_change)
+{
+	t_m_Writer_Caches::iterator wit = m_writerChanges.find(a_change->writerGUID);
+	return wit == m_writerChanges.end() ? nullptr : &wit->second;
+}
+
+void SubscriberHistory::remove_from_Writer(CacheChange_t* a_change)
+{
+	t_m_Writer_Caches::iterator wit = m_writerChanges.find(a_change->writerGUID);
+	if(wit != m_writerChanges.end())
+	{
+		size_t index = wit->second.find(a_change);
+		if(index < wit->second.size())
+			wit->second.erase(index);
+		// Writers that come and go must not leave their entries behind. The buffer of one is kept,
+		// so a writer whose only change is replaced does not allocate again.
+		if(wit->second.empty())
+		{
+			if(m_spareWriterChanges.empty())
+				m_spareWriterChanges.push_back(std::move(wit->second));
+			m_writerChanges.erase(wit);
+		}
+	}
+}
+
+bool SubscriberHistory::remove_change_sub(CacheChange_t* change,t_m_Inst_Caches::iterator* vit_in)
 {
 
 	if(mp_reader == nullptr || mp_mutex == nullptr)
@@ -406,45 +587,74 @@ bool SubscriberHistory::remove_change_sub(CacheChange_t* change,t_v_Inst_Caches:
 	}
 
 	boost::lock_guard<boost::recursive_mutex> guard(*mp_mutex);
+	return erase_change_sub(change, vit_in, true);
+}
+
+bool SubscriberHistory::erase_change_sub(CacheChange_t* change, t_m_Inst_Caches::iterator* vit_in, bool release)
+{
 	if(mp_subImpl->getAttributes().topic.getTopicKind() == NO_KEY)
 	{
-		if(this->remove_change(change))
-        {
-            m_isHistoryFull = false;
-            return true;
-        }
-        return false;
+		return remove_indexed_change(change, release);
 	}
 	else
 	{
-		t_v_Inst_Caches::iterator vit;
+		t_m_Inst_Caches::iterator vit;
 		if(vit_in!=nullptr)
 			vit = *vit_in;
-		else if(this->find_Key(change,&vit))
-		{
-
-		}
 		else
+			vit = m_keyedChanges.find(change->instanceHandle);
+
+		if(vit == m_keyedChanges.end())
 			return false;
-		for(auto chit = vit->second.begin();
-				chit!= vit->second.end();++chit)
+
+		size_t index = vit->second.find(change);
+		if(index < vit->second.size())
 		{
-			if((*chit)->sequenceNumber == change->sequenceNumber
-					&& (*chit)->writerGUID == change->writerGUID)
-			{
-				if(remove_change(change))
-				{
-					vit->second.erase(chit);
-                    m_isHistoryFull = false;
-					return true;
-				}
-			}
+			vit->second.erase(index);
+			return remove_indexed_change(change, release);
 		}
 		logError(SUBSCRIBER,"Change not found, something is wrong");
 	}
 	return false;
 }
 
+bool SubscriberHistory::remove_change(CacheChange_t* a_change)
+{
+	if(mp_reader == nullptr || mp_mutex == nullptr)
+	{
+		logError(RTPS_HISTORY,"You need to create a Reader with this History before using it");
+		return false;
+	}
+
+	boost::lock_guard<boost::recursive_mutex> guard(*mp_mutex);
+	// Also reached from ReaderHistory when the changes of a writer are dropped.
+	if(mp_subImpl->getAttributes().topic.getTopicKind() == WITH_KEY)
+	{
+		t_m_Inst_Caches::iterator vit = m_keyedChanges.find(a_change->instanceHandle);
+		if(vit != m_keyedChanges.end())
+		{
+			size_t index = vit->second.find(a_change);
+			if(index < vit->second.size())
+				vit->second.erase(index);
+		}
+	}
+
+	return remove_indexed_change(a_change);
+}
+
+bool SubscriberHistory::remove_indexed_change(CacheChange_t* a_change, bool release)
+{
+	if(m_historyQos.kind == KEEP_LAST_HISTORY_QOS)
+		remove_from_Writer(a_change);
+
+	if(release ? ReaderHistory::remove_change(a_change) : detach_change(a_change))
+	{
+		m_isHistoryFull = false;
+		return true;
+	}
+	return false;
+}
+
 
 } /* namespace fastrtps */
 } /* namespace eprosima */
@@ -84,6 +84,23 @@ bool SubscriberImpl::takeNextData(void* data,SampleInfo_t* info) {
 	return this->m_history.takeNextData(data,info);
 }
 
+size_t SubscriberImpl::take_samples(const std::function<void*(size_t)>& data,
+		std::vector<SampleInfo_t>& infos, size_t max)
+{
+	return this->m_history.take_samples(data, infos, max);
+}
+
+size_t SubscriberImpl::take_loan(std::vector<const SerializedPayload_t*>& payloads,
+		std::vector<SampleInfo_t>& infos, size_t max)
+{
+	return this->m_history.take_loan(payloads, infos, max);
+}
+
+bool SubscriberImpl::return_loan(const std::vector<const SerializedPayload_t*>& payloads)
+{
+	return this->m_history.return_loan(payloads);
+}
+
 
 
 const GUID_t& SubscriberImpl::getGuid(){
@@ -78,6 +78,31 @@ public:
 	bool takeNextData(void* data,SampleInfo_t* info);
 
 	///@}
+
+	/**
+	 * Take several samples at once.
+	 * @param data Function returning the object where the sample with the given index is deserialized.
+	 * @param[out] infos Vector where the information of each sample is appended.
+	 * @param max Maximum number of samples to take.
+	 * @return Number of samples taken.
+	 */
+	size_t take_samples(const std::function<void*(size_t)>& data, std::vector<SampleInfo_t>& infos, size_t max);
+
+	/**
+	 * Take several samples without deserializing them.
+	 * @param[out] payloads Vector where the payloads of the samples are appended.
+	 * @param[out] infos Vector where the information of each sample is appended.
+	 * @param max Maximum number of samples to take.
+	 * @return Number of samples taken.
+	 */
+	size_t take_loan(std::vector<const SerializedPayload_t*>& payloads, std::vector<SampleInfo_t>& infos, size_t max);
+
+	/**
+	 * Return the payloads obtained with take_loan.
+	 * @param payloads Payloads to return.
+	 * @return True if all the payloads were loaned by this subscriber.
+	 */
+	bool return_loan(const std::vector<const SerializedPayload_t*>& payloads);
 	
 	/**
 	 * Update the Attributes of the subscriber;
@@ -25,6 +25,8 @@ static const uint32_t maximumUDPSocketSize = 65536;
 static const uint32_t maximumMessageSize = 65000;
 vector<vector<octet> > test_UDPv4Transport::DropLog;
 uint32_t test_UDPv4Transport::DropLogLength = 0;
+atomic<uint64_t> test_UDPv4Transport::SentPackets(0);
+atomic<uint64_t> test_UDPv4Transport::SentBytes(0);
 
 test_UDPv4Transport::test_UDPv4Transport(const test_UDPv4TransportDescriptor& descriptor):
     mDropDataMessagesPercentage(descriptor.dropDataMessagesPercentage),
@@ -57,6 +59,9 @@ RTPS_DllAPI test_UDPv4TransportDescriptor::test_UDPv4TransportDescriptor():
 
 bool test_UDPv4Transport::Send(const octet* sendBuffer, uint32_t sendBufferSize, const Locator_t& localLocator, const Locator_t& remoteLocator)
 {
+    ++SentPackets;
+    SentBytes += sendBufferSize;
+
     if (PacketShouldDrop(sendBuffer, sendBufferSize))
     {
         LogDrop(sendBuffer, sendBufferSize);
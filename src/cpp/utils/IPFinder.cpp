@@ -36,11 +36,17 @@
 #include <string.h>
 #endif
 
-
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/lock_guard.hpp>
 
 namespace eprosima {
 namespace fastrtps{
 
+//!Interfaces of the host, with the loopback ones, enumerated on the first call to getIPs.
+static std::vector<IPFinder::info_IP> g_cachedIPs;
+static bool g_cachedIPsValid = false;
+static boost::mutex g_cachedIPsMutex;
+
 IPFinder::IPFinder() {
 
 
@@ -53,7 +59,7 @@ IPFinder::~IPFinder() {
 #if defined(_WIN32)
 
 
-bool IPFinder::getIPs(std::vector<info_IP>* vec_name, bool return_loopback)
+bool IPFinder::queryIPs(std::vector<info_IP>* vec_name, bool return_loopback)
 {
     DWORD rv, size;
     PIP_ADAPTER_ADDRESSES adapter_addresses, aa;
@@ -115,7 +121,7 @@ bool IPFinder::getIPs(std::vector<info_IP>* vec_name, bool return_loopback)
 
 #else
 
-bool IPFinder::getIPs(std::vector<info_IP>* vec_name, bool return_loopback)
+bool IPFinder::queryIPs(std::vector<info_IP>* vec_name, bool return_loopback)
 {
     struct ifaddrs *ifaddr, *ifa;
     int family, s;
@@ -179,6 +185,34 @@ bool IPFinder::getIPs(std::vector<info_IP>* vec_name, bool return_loopback)
 }
 #endif
 
+bool IPFinder::getIPs(std::vector<info_IP>* vec_name, bool return_loopback)
+{
+    boost::lock_guard<boost::mutex> guard(g_cachedIPsMutex);
+
+    // Enumerating the interfaces is slow, and every participant does it several times while it is created.
+    if(!g_cachedIPsValid)
+    {
+        g_cachedIPs.clear();
+        if(!queryIPs(&g_cachedIPs, true))
+            return false;
+        g_cachedIPsValid = true;
+    }
+
+    for(auto it = g_cachedIPs.begin(); it != g_cachedIPs.end(); ++it)
+    {
+        if(return_loopback || (it->type != IP4_LOCAL && it->type != IP6_LOCAL))
+            vec_name->push_back(*it);
+    }
+    return true;
+}
+
+void IPFinder::clearCache()
+{
+    boost::lock_guard<boost::mutex> guard(g_cachedIPsMutex);
+    g_cachedIPs.clear();
+    g_cachedIPsValid = false;
+}
+
 bool IPFinder::getIP4Address(LocatorList_t* locators)
 {
     std::vector<info_IP> ip_names;
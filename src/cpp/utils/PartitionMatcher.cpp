@@ -0,0 +1,289 @@
+// Copyright 2016 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file PartitionMatcher.cpp
+ *
+ */
+
+#include <fastrtps/utils/PartitionMatcher.h>
+#include <fastrtps/utils/StringMatching.h>
+
+#include <algorithm>
+
+namespace eprosima {
+namespace fastrtps{
+namespace rtps {
+
+PartitionMatcher::PartitionMatcher()
+{
+}
+
+PartitionMatcher::~PartitionMatcher()
+{
+}
+
+void PartitionMatcher::compile(const std::vector<std::string>& names)
+{
+	if(names == m_names)
+		return;
+
+	m_names = names;
+	m_exact.clear();
+	m_sortedExact.clear();
+	m_patterns.clear();
+
+	for(std::vector<std::string>::const_iterator nit = names.begin(); nit != names.end(); ++nit)
+	{
+		if(hasWildcards(*nit))
+		{
+			m_patterns.push_back(Pattern());
+			m_patterns.back().name = *nit;
+			compilePattern(m_patterns.back());
+		}
+		else if(m_exact.insert(*nit).second)
+		{
+			m_sortedExact.push_back(*nit);
+		}
+	}
+
+	std::sort(m_sortedExact.begin(), m_sortedExact.end());
+}
+
+bool PartitionMatcher::matches(const PartitionMatcher& other) const
+{
+	if(m_names.empty() && other.m_names.empty())
+		return true;
+	// An endpoint without partitions is in the default one.
+	if(m_names.empty())
+		return other.m_exact.count(std::string()) > 0;
+	if(other.m_names.empty())
+		return m_exact.count(std::string()) > 0;
+
+	const std::unordered_set<std::string>& smaller = m_exact.size() <= other.m_exact.size() ? m_exact : other.m_exact;
+	const std::unordered_set<std::string>& larger = m_exact.size() <= other.m_exact.size() ? other.m_exact : m_exact;
+	for(std::unordered_set<std::string>::const_iterator nit = smaller.begin(); nit != smaller.end(); ++nit)
+	{
+		if(larger.count(*nit) > 0)
+			return true;
+	}
+
+	for(std::vector<Pattern>::const_iterator pit = m_patterns.begin(); pit != m_patterns.end(); ++pit)
+	{
+		if(other.matchesAnyName(*pit))
+			return true;
+	}
+
+	for(std::vector<Pattern>::const_iterator pit = other.m_patterns.begin(); pit != other.m_patterns.end(); ++pit)
+	{
+		if(matchesAnyName(*pit))
+			return true;
+	}
+
+	return false;
+}
+
+bool PartitionMatcher::hasWildcards(const std::string& name)
+{
+	return name.find_first_of("*?[\\") != std::string::npos;
+}
+
+void PartitionMatcher::compilePattern(Pattern& pattern)
+{
+	const std::string& name = pattern.name;
+	size_t length = name.size();
+	bool literalPrefix = true;
+	size_t i = 0;
+
+	while(i < length)
+	{
+		Token token;
+		token.kind = Token::LITERAL;
+		token.literal = name[i];
+		token.negated = false;
+
+		if(name[i] == '*')
+		{
+			token.kind = Token::STAR;
+			while(i < length && name[i] == '*')
+				++i;
+		}
+		else if(name[i] == '?')
+		{
+			token.kind = Token::ANY;
+			++i;
+		}
+		else if(name[i] == '\\')
+		{
+			if(i + 1 == length || name[i + 1] == '/')
+			{
+				// Trailing escapes and escaped separators are left to fnmatch.
+				pattern.tokens.clear();
+				pattern.prefix.clear();
+				return;
+			}
+			token.literal = name[++i];
+			++i;
+		}
+		else if(name[i] == '[')
+		{
+			size_t j = i + 1;
+			if(j < length && (name[j] == '!' || name[j] == '^'))
+			{
+				token.negated = true;
+				++j;
+			}
+
+			bool first = true;
+			while(j < length && (first || name[j] != ']'))
+			{
+				if(name[j] == '/' || (name[j] == '\\' && j + 1 < length && name[j + 1] == '/') ||
+						(name[j] == '[' && j + 1 < length &&
+							(name[j + 1] == ':' || name[j + 1] == '=' || name[j + 1] == '.')))
+				{
+					// Character classes and separators inside brackets are left to fnmatch.
+					pattern.tokens.clear();
+					pattern.prefix.clear();
+					return;
+				}
+
+				unsigned char low = static_cast<unsigned char>(name[j]);
+				if(low == '\\' && j + 1 < length)
+					low = static_cast<unsigned char>(name[++j]);
+				++j;
+
+				unsigned char high = low;
+				if(j + 1 < length && name[j] == '-' && name[j + 1] != ']')
+				{
+					j += 1;
+					high = static_cast<unsigned char>(name[j]);
+					if(high == '\\' && j + 1 < length)
+						high = static_cast<unsigned char>(name[++j]);
+					++j;
+				}
+
+				for(unsigned int c = low; c <= high; ++c)
+					token.set.set(c);
+				first = false;
+			}
+
+			if(j >= length)
+			{
+				// Brackets without closing are left to fnmatch.
+				pattern.tokens.clear();
+				pattern.prefix.clear();
+				return;
+			}
+
+			token.kind = Token::SET;
+			i = j + 1;
+		}
+		else
+		{
+			++i;
+		}
+
+		if(token.kind == Token::LITERAL && literalPrefix)
+			pattern.prefix.push_back(token.literal);
+		else
+			literalPrefix = false;
+
+		pattern.tokens.push_back(token);
+	}
+}
+
+bool PartitionMatcher::matchPattern(const Pattern& pattern, const std::string& input)
+{
+	if(pattern.tokens.empty())
+		return StringMatching::matchString(pattern.name.c_str(), input.c_str());
+
+	const std::vector<Token>& tokens = pattern.tokens;
+	size_t t = 0, s = 0;
+	size_t starToken = std::string::npos, starInput = 0;
+
+	while(s < input.size())
+	{
+		if(t < tokens.size())
+		{
+			const Token& token = tokens[t];
+			char c = input[s];
+
+			if(token.kind == Token::STAR)
+			{
+				starToken = t++;
+				starInput = s;
+				continue;
+			}
+
+			bool matched = false;
+			switch(token.kind)
+			{
+				case Token::LITERAL:
+					matched = c == token.literal;
+					break;
+				case Token::ANY:
+					matched = c != '/';
+					break;
+				case Token::SET:
+					matched = c != '/' && token.set.test(static_cast<unsigned char>(c)) != token.negated;
+					break;
+				default:
+					break;
+			}
+
+			if(matched)
+			{
+				++t;
+				++s;
+				continue;
+			}
+		}
+
+		// Let the last star take one more character. It never takes a separator.
+		if(starToken == std::string::npos || input[starInput] == '/')
+			return false;
+
+		t = starToken + 1;
+		s = ++starInput;
+	}
+
+	while(t < tokens.size() && tokens[t].kind == Token::STAR)
+		++t;
+
+	return t == tokens.size();
+}
+
+bool PartitionMatcher::matchesAnyName(const Pattern& pattern) const
+{
+	const std::string& prefix = pattern.prefix;
+
+	for(std::vector<std::string>::const_iterator nit = std::lower_bound(m_sortedExact.begin(), m_sortedExact.end(), prefix);
+			nit != m_sortedExact.end() && nit->compare(0, prefix.size(), prefix) == 0; ++nit)
+	{
+		if(matchPattern(pattern, *nit))
+			return true;
+	}
+
+	for(std::vector<Pattern>::const_iterator pit = m_patterns.begin(); pit != m_patterns.end(); ++pit)
+	{
+		if(pit->name.compare(0, prefix.size(), prefix) == 0 && matchPattern(pattern, pit->name))
+			return true;
+	}
+
+	return false;
+}
+
+}
+} /* namespace rtps */
+} /* namespace eprosima */
@@ -15,6 +15,7 @@
 #include "types/HelloWorld.h"
 #include "types/Data64kbType.h"
 #include "types/Data1mbType.h"
+#include "types/KeyedPlainType.h"
 
 #include "RTPSAsSocketReader.hpp"
 #include "RTPSAsSocketWriter.hpp"
@@ -130,6 +131,27 @@ std::list<Data1mb> default_data300kb_data_generator(size_t max = 0)
     return returnedValue;
 }
 
+// Samples of several keys, interleaved: indexes first_index..first_index+samples_per_key-1 of each key.
+std::list<KeyedPlain> keyedplain_data_generator(size_t samples_per_key, uint32_t keys, uint32_t first_index = 1)
+{
+    std::list<KeyedPlain> returnedValue;
+
+    for(uint32_t index = first_index; index < first_index + samples_per_key; ++index)
+    {
+        for(uint32_t key = 0; key < keys; ++key)
+        {
+            KeyedPlain sample;
+            memset(&sample, 0, sizeof(sample));
+            sample.key = key;
+            sample.index = index;
+            snprintf(sample.message, sizeof(sample.message), "KeyedPlain %u %u", key, index);
+            returnedValue.push_back(sample);
+        }
+    }
+
+    return returnedValue;
+}
+
 /****** Auxiliary lambda functions  ******/
 const std::function<void(const HelloWorld&)>  default_helloworld_print = [](const HelloWorld& hello)
 {
@@ -563,6 +585,542 @@ BLACKBOXTEST(BlackBox, PubSubAsReliableHelloworld)
     ASSERT_EQ(data.size(), 0);
 }
 
+BLACKBOXTEST(BlackBox, PubSubAsReliableHelloworldBulkWrite)
+{
+    PubSubReader<HelloWorldType> reader(TEST_TOPIC_NAME);
+    PubSubWriter<HelloWorldType> writer(TEST_TOPIC_NAME);
+
+    reader.history_depth(100).
+        reliability(eprosima::fastrtps::RELIABLE_RELIABILITY_QOS).init();
+
+    ASSERT_TRUE(reader.isInitialized());
+
+    writer.history_depth(100).init();
+
+    ASSERT_TRUE(writer.isInitialized());
+
+    // Because its volatile the durability
+    // Wait for discovery.
+    writer.waitDiscovery();
+    reader.waitDiscovery();
+
+    auto data = default_helloword_data_generator();
+
+    reader.expected_data(data);
+    reader.startReception();
+
+    // Send all the data with one call.
+    writer.send_bulk(data);
+    // In this test all data should be sent.
+    ASSERT_TRUE(data.empty());
+    // Block reader until reception finished or timeout.
+    data = reader.block(std::chrono::seconds(2));
+
+    print_non_received_messages(data, default_helloworld_print);
+    ASSERT_EQ(data.size(), 0);
+}
+
+BLACKBOXTEST(BlackBox, PubSubAsReliableHelloworldTakeSeveral)
+{
+    PubSubReader<HelloWorldType> reader(TEST_TOPIC_NAME);
+    PubSubWriter<HelloWorldType> writer(TEST_TOPIC_NAME);
+
+    reader.history_depth(100).
+        reliability(eprosima::fastrtps::RELIABLE_RELIABILITY_QOS).init();
+
+    ASSERT_TRUE(reader.isInitialized());
+
+    writer.history_depth(100).init();
+
+    ASSERT_TRUE(writer.isInitialized());
+
+    // Because its volatile the durability
+    // Wait for discovery.
+    writer.waitDiscovery();
+    reader.waitDiscovery();
+
+    auto data = default_helloword_data_generator();
+    std::vector<HelloWorld> expected(data.begin(), data.end());
+
+    // The samples are not taken on reception, they stay in the history until all are acknowledged.
+    writer.send(data);
+    ASSERT_TRUE(data.empty());
+    ASSERT_TRUE(writer.waitForAllAcked(std::chrono::seconds(10)));
+
+    std::vector<HelloWorld> samples(4);
+    std::vector<SampleInfo_t> infos;
+    size_t taken = 0;
+
+    // max caps the count, and the elements of the vector beyond it are not modified.
+    ASSERT_EQ(reader.take(samples, infos, 3), 3u);
+    ASSERT_EQ(infos.size(), 3u);
+    ASSERT_EQ(samples.size(), 4u);
+    for(size_t i = 0; i < 3; ++i)
+    {
+        ASSERT_EQ(samples[i], expected[taken + i]);
+        ASSERT_EQ(infos[i].sampleKind, ALIVE);
+        ASSERT_EQ(infos[i].sample_identity.sequence_number(), SequenceNumber_t(0, (uint32_t)(taken + i + 1)));
+        ASSERT_EQ(infos[i].sample_identity.writer_guid(), infos[0].sample_identity.writer_guid());
+    }
+    ASSERT_EQ(samples[3], HelloWorld());
+    taken += 3;
+
+    // The vector grows when more samples are taken than it holds.
+    ASSERT_EQ(reader.take(samples, infos, 5), 5u);
+    ASSERT_EQ(infos.size(), 5u);
+    ASSERT_EQ(samples.size(), 5u);
+    for(size_t i = 0; i < 5; ++i)
+    {
+        ASSERT_EQ(samples[i], expected[taken + i]);
+        ASSERT_EQ(infos[i].sample_identity.sequence_number(), SequenceNumber_t(0, (uint32_t)(taken + i + 1)));
+    }
+    taken += 5;
+
+    // So an empty vector takes the rest.
+    samples.clear();
+    ASSERT_EQ(reader.take(samples, infos, 100), expected.size() - taken);
+    ASSERT_EQ(infos.size(), expected.size() - taken);
+    ASSERT_EQ(samples.size(), expected.size() - taken);
+    for(size_t i = 0; i < infos.size(); ++i)
+        ASSERT_EQ(samples[i], expected[taken + i]);
+
+    ASSERT_EQ(reader.take(samples, infos, 10), 0u);
+    ASSERT_TRUE(infos.empty());
+}
+
+BLACKBOXTEST(BlackBox, PubSubAsReliableKeepLastKeyedTakeSeveral)
+{
+    PubSubReader<KeyedPlainType> reader(TEST_TOPIC_NAME);
+    PubSubWriter<KeyedPlainType> writer(TEST_TOPIC_NAME);
+
+    reader.history_kind(eprosima::fastrtps::KEEP_LAST_HISTORY_QOS).history_depth(2).
+        reliability(eprosima::fastrtps::RELIABLE_RELIABILITY_QOS).init();
+
+    ASSERT_TRUE(reader.isInitialized());
+
+    writer.history_depth(100).init();
+
+    ASSERT_TRUE(writer.isInitialized());
+
+    // Because its volatile the durability
+    // Wait for discovery.
+    writer.waitDiscovery();
+    reader.waitDiscovery();
+
+    // Three samples of three keys. The reader keeps the last two of each key.
+    auto data = keyedplain_data_generator(3, 3);
+    writer.send(data);
+    ASSERT_TRUE(data.empty());
+    ASSERT_TRUE(writer.waitForAllAcked(std::chrono::seconds(10)));
+
+    std::vector<KeyedPlain> samples;
+    std::vector<SampleInfo_t> infos;
+    ASSERT_EQ(reader.take(samples, infos, 4), 4u);
+    // In the order they were received: index 2 of the three keys, and index 3 of key 0.
+    uint32_t expected_keys[] = {0, 1, 2, 0};
+    uint32_t expected_indexes[] = {2, 2, 2, 3};
+    for(size_t i = 0; i < 4; ++i)
+    {
+        ASSERT_EQ(samples[i].key, expected_keys[i]);
+        ASSERT_EQ(samples[i].index, expected_indexes[i]);
+        ASSERT_EQ(infos[i].iHandle.value[3], expected_keys[i]);
+    }
+
+    // Only the samples not taken are left in the instances. Key 0 has room for two new samples, while
+    // keys 1 and 2 replace their sample 3 with the last one.
+    data = keyedplain_data_generator(2, 3, 4);
+    writer.send(data);
+    ASSERT_TRUE(data.empty());
+    ASSERT_TRUE(writer.waitForAllAcked(std::chrono::seconds(10)));
+
+    ASSERT_EQ(reader.take(samples, infos, 10), 6u);
+    uint32_t next_keys[] = {0, 1, 2, 0, 1, 2};
+    uint32_t next_indexes[] = {4, 4, 4, 5, 5, 5};
+    for(size_t i = 0; i < 6; ++i)
+    {
+        ASSERT_EQ(samples[i].key, next_keys[i]);
+        ASSERT_EQ(samples[i].index, next_indexes[i]);
+    }
+
+    ASSERT_EQ(reader.take(samples, infos, 10), 0u);
+}
+
+BLACKBOXTEST(BlackBox, PubSubAsReliableKeepLastKeyedTakeLoan)
+{
+    PubSubReader<KeyedPlainType> reader(TEST_TOPIC_NAME);
+    PubSubWriter<KeyedPlainType> writer(TEST_TOPIC_NAME);
+
+    reader.history_kind(eprosima::fastrtps::KEEP_LAST_HISTORY_QOS).history_depth(2).
+        reliability(eprosima::fastrtps::RELIABLE_RELIABILITY_QOS).init();
+
+    ASSERT_TRUE(reader.isInitialized());
+
+    writer.history_depth(100).init();
+
+    ASSERT_TRUE(writer.isInitialized());
+
+    // Because its volatile the durability
+    // Wait for discovery.
+    writer.waitDiscovery();
+    reader.waitDiscovery();
+
+    auto data = keyedplain_data_generator(2, 2);
+    std::vector<KeyedPlain> expected(data.begin(), data.end());
+    writer.send(data);
+    ASSERT_TRUE(data.empty());
+    ASSERT_TRUE(writer.waitForAllAcked(std::chrono::seconds(10)));
+
+    // The payloads of a plain type are the samples.
+    std::vector<const SerializedPayload_t*> payloads;
+    std::vector<SampleInfo_t> infos;
+    ASSERT_EQ(reader.take_loan(payloads, infos, 3), 3u);
+    ASSERT_EQ(payloads.size(), 3u);
+    ASSERT_EQ(infos.size(), 3u);
+    for(size_t i = 0; i < 3; ++i)
+    {
+        ASSERT_EQ(payloads[i]->length, sizeof(KeyedPlain));
+        ASSERT_EQ(*reinterpret_cast<const KeyedPlain*>(payloads[i]->data), expected[i]);
+        ASSERT_EQ(infos[i].sampleKind, ALIVE);
+        ASSERT_EQ(infos[i].sample_identity.sequence_number(), SequenceNumber_t(0, (uint32_t)(i + 1)));
+        ASSERT_EQ(infos[i].iHandle.value[3], expected[i].key);
+    }
+
+    // While they are loaned, new samples are received and replace the ones left in the history.
+    // Key 1 keeps its sample 1 and 2 until sample 3 arrives; key 0 has room for samples 3 and 4.
+    data = keyedplain_data_generator(2, 2, 3);
+    writer.send(data);
+    ASSERT_TRUE(data.empty());
+    ASSERT_TRUE(writer.waitForAllAcked(std::chrono::seconds(10)));
+
+    std::vector<const SerializedPayload_t*> more_payloads;
+    ASSERT_EQ(reader.take_loan(more_payloads, infos, 10), 4u);
+    ASSERT_EQ(infos.size(), 7u);
+    uint32_t next_keys[] = {0, 1, 0, 1};
+    uint32_t next_indexes[] = {3, 3, 4, 4};
+    for(size_t i = 0; i < 4; ++i)
+    {
+        const KeyedPlain* sample = reinterpret_cast<const KeyedPlain*>(more_payloads[i]->data);
+        ASSERT_EQ(sample->key, next_keys[i]);
+        ASSERT_EQ(sample->index, next_indexes[i]);
+    }
+
+    // The first payloads loaned are not modified by the reception.
+    for(size_t i = 0; i < 3; ++i)
+        ASSERT_EQ(*reinterpret_cast<const KeyedPlain*>(payloads[i]->data), expected[i]);
+
+    // Returned payloads, and payloads not loaned by this subscriber, are rejected.
+    std::vector<const SerializedPayload_t*> returned(payloads);
+    ASSERT_TRUE(reader.return_loan(payloads));
+    ASSERT_TRUE(payloads.empty());
+    ASSERT_FALSE(reader.return_loan(returned));
+    ASSERT_TRUE(returned.empty());
+
+    SerializedPayload_t foreign(sizeof(KeyedPlain));
+    more_payloads.push_back(&foreign);
+    ASSERT_FALSE(reader.return_loan(more_payloads));
+    ASSERT_TRUE(more_payloads.empty());
+
+    ASSERT_EQ(reader.take_loan(payloads, infos, 10), 0u);
+}
+
+BLACKBOXTEST(BlackBox, PubSubLoanSampleNonPlainType)
+{
+    PubSubWriter<HelloWorldType> writer(TEST_TOPIC_NAME);
+
+    writer.init();
+
+    ASSERT_TRUE(writer.isInitialized());
+
+    // Only the samples of plain types are loaned.
+    ASSERT_EQ(writer.loan_sample(), nullptr);
+
+    HelloWorld hello;
+    ASSERT_FALSE(writer.write_loaned(&hello));
+    ASSERT_FALSE(writer.discard_loan(&hello));
+}
+
+BLACKBOXTEST(BlackBox, PubSubAsReliableKeyedWriteLoaned)
+{
+    PubSubReader<KeyedPlainType> reader(TEST_TOPIC_NAME);
+    PubSubWriter<KeyedPlainType> writer(TEST_TOPIC_NAME);
+
+    reader.history_kind(eprosima::fastrtps::KEEP_ALL_HISTORY_QOS).
+        reliability(eprosima::fastrtps::RELIABLE_RELIABILITY_QOS).init();
+
+    ASSERT_TRUE(reader.isInitialized());
+
+    // The pool of the writer has room for three samples, written or loaned.
+    writer.history_depth(3).resource_limits_max_samples(3).resource_limits_max_samples_per_instance(3).
+        allocated_samples(3).init();
+
+    ASSERT_TRUE(writer.isInitialized());
+
+    // Because its volatile the durability
+    // Wait for discovery.
+    writer.waitDiscovery();
+    reader.waitDiscovery();
+
+    auto data = keyedplain_data_generator(1, 3);
+    std::vector<KeyedPlain> expected(data.begin(), data.end());
+
+    KeyedPlain* sample = writer.loan_sample();
+    ASSERT_NE(sample, nullptr);
+    *sample = expected[0];
+    ASSERT_TRUE(writer.write_loaned(sample));
+    // Once written, the sample is not loaned anymore.
+    ASSERT_FALSE(writer.write_loaned(sample));
+    ASSERT_FALSE(writer.discard_loan(sample));
+
+    // Samples not loaned by the writer are rejected.
+    KeyedPlain foreign = expected[1];
+    ASSERT_FALSE(writer.write_loaned(&foreign));
+    ASSERT_FALSE(writer.discard_loan(&foreign));
+
+    KeyedPlain* discarded = writer.loan_sample();
+    ASSERT_NE(discarded, nullptr);
+    ASSERT_TRUE(writer.discard_loan(discarded));
+    ASSERT_FALSE(writer.discard_loan(discarded));
+
+    // With the first sample in the history, two more can be loaned.
+    KeyedPlain* second = writer.loan_sample();
+    KeyedPlain* third = writer.loan_sample();
+    ASSERT_NE(second, nullptr);
+    ASSERT_NE(third, nullptr);
+    ASSERT_EQ(writer.loan_sample(), nullptr);
+    ASSERT_TRUE(writer.discard_loan(third));
+    third = writer.loan_sample();
+    ASSERT_NE(third, nullptr);
+
+    *second = expected[1];
+    *third = expected[2];
+    ASSERT_TRUE(writer.write_loaned(second));
+    ASSERT_TRUE(writer.write_loaned(third));
+    ASSERT_TRUE(writer.waitForAllAcked(std::chrono::seconds(10)));
+
+    std::vector<KeyedPlain> samples(10);
+    std::vector<SampleInfo_t> infos;
+    ASSERT_EQ(reader.take(samples, infos, 10), 3u);
+    for(size_t i = 0; i < 3; ++i)
+    {
+        ASSERT_EQ(samples[i], expected[i]);
+        ASSERT_EQ(infos[i].sample_identity.sequence_number(), SequenceNumber_t(0, (uint32_t)(i + 1)));
+        ASSERT_EQ(infos[i].iHandle.value[3], expected[i].key);
+    }
+}
+
+BLACKBOXTEST(BlackBox, PubSubLoansReleasedOnPublisherRemoval)
+{
+    PubSubReader<KeyedPlainType> reader(TEST_TOPIC_NAME);
+    PubSubWriter<KeyedPlainType> writer(TEST_TOPIC_NAME);
+
+    reader.reliability(eprosima::fastrtps::RELIABLE_RELIABILITY_QOS).init();
+
+    ASSERT_TRUE(reader.isInitialized());
+
+    writer.history_depth(2).resource_limits_max_samples(2).resource_limits_max_samples_per_instance(2).
+        allocated_samples(2).init();
+
+    ASSERT_TRUE(writer.isInitialized());
+
+    writer.waitDiscovery();
+    reader.waitDiscovery();
+
+    // The publisher is removed with all its pool loaned, and the loans are released with it.
+    ASSERT_NE(writer.loan_sample(), nullptr);
+    ASSERT_NE(writer.loan_sample(), nullptr);
+    ASSERT_EQ(writer.loan_sample(), nullptr);
+
+    writer.destroy();
+
+    reader.waitRemoval();
+}
+
+BLACKBOXTEST(BlackBox, PubSubAsReliableTakeLoanExhaustsPool)
+{
+    PubSubReader<KeyedPlainType> reader(TEST_TOPIC_NAME);
+    PubSubWriter<KeyedPlainType> writer(TEST_TOPIC_NAME);
+
+    reader.history_kind(eprosima::fastrtps::KEEP_ALL_HISTORY_QOS).
+        resource_limits_max_samples(4).resource_limits_max_samples_per_instance(4).allocated_samples(4).
+        reliability(eprosima::fastrtps::RELIABLE_RELIABILITY_QOS).init();
+
+    ASSERT_TRUE(reader.isInitialized());
+
+    writer.history_depth(100).init();
+
+    ASSERT_TRUE(writer.isInitialized());
+
+    // Because its volatile the durability
+    // Wait for discovery.
+    writer.waitDiscovery();
+    reader.waitDiscovery();
+
+    auto data = keyedplain_data_generator(4, 1);
+    writer.send(data);
+    ASSERT_TRUE(data.empty());
+    ASSERT_TRUE(writer.waitForAllAcked(std::chrono::seconds(10)));
+
+    std::vector<const SerializedPayload_t*> payloads;
+    std::vector<SampleInfo_t> infos;
+    ASSERT_EQ(reader.take_loan(payloads, infos, 10), 4u);
+
+    // The loans hold the whole pool of the reader, so nothing else can be received.
+    data = keyedplain_data_generator(2, 1, 5);
+    writer.send(data);
+    ASSERT_TRUE(data.empty());
+    ASSERT_FALSE(writer.waitForAllAcked(std::chrono::seconds(1)));
+
+    std::vector<const SerializedPayload_t*> none;
+    ASSERT_EQ(reader.take_loan(none, infos, 10), 0u);
+    for(size_t i = 0; i < 4; ++i)
+        ASSERT_EQ(reinterpret_cast<const KeyedPlain*>(payloads[i]->data)->index, i + 1);
+
+    // Once returned, the samples not received are sent again.
+    ASSERT_TRUE(reader.return_loan(payloads));
+    ASSERT_TRUE(writer.waitForAllAcked(std::chrono::seconds(10)));
+
+    infos.clear();
+    ASSERT_EQ(reader.take_loan(payloads, infos, 10), 2u);
+    ASSERT_EQ(reinterpret_cast<const KeyedPlain*>(payloads[0]->data)->index, 5u);
+    ASSERT_EQ(reinterpret_cast<const KeyedPlain*>(payloads[1]->data)->index, 6u);
+    ASSERT_EQ(infos[0].sample_identity.sequence_number(), SequenceNumber_t(0, 5));
+    ASSERT_TRUE(reader.return_loan(payloads));
+}
+
+BLACKBOXTEST(BlackBox, PubSubAsReliableHelloworldBatched)
+{
+    PubSubReader<HelloWorldType> reader(TEST_TOPIC_NAME);
+    PubSubWriter<HelloWorldType> writer(TEST_TOPIC_NAME);
+
+    reader.history_depth(100).
+        reliability(eprosima::fastrtps::RELIABLE_RELIABILITY_QOS).init();
+
+    ASSERT_TRUE(reader.isInitialized());
+
+    writer.history_depth(100).batching(0, 4, 100).init();
+
+    ASSERT_TRUE(writer.isInitialized());
+
+    // Because its volatile the durability
+    // Wait for discovery.
+    writer.waitDiscovery();
+    reader.waitDiscovery();
+
+    auto data = default_helloword_data_generator();
+
+    reader.expected_data(data);
+    reader.startReception();
+
+    // Send data. The last two samples wait for the batch delay.
+    writer.send(data);
+    // In this test all data should be sent.
+    ASSERT_TRUE(data.empty());
+    // Block reader until reception finished or timeout.
+    data = reader.block(std::chrono::seconds(2));
+
+    print_non_received_messages(data, default_helloworld_print);
+    ASSERT_EQ(data.size(), 0);
+
+    BatchingStatistics statistics = writer.batching_statistics();
+    ASSERT_EQ(statistics.samples, 10u);
+    ASSERT_GE(statistics.batches, 3u);
+    ASSERT_EQ(statistics.flushedBySize + statistics.flushedByDelay + statistics.flushedExplicitly, statistics.batches);
+}
+
+BLACKBOXTEST(BlackBox, PubSubAsNonReliableHelloworldBatchedExplicitFlush)
+{
+    PubSubReader<HelloWorldType> reader(TEST_TOPIC_NAME);
+    PubSubWriter<HelloWorldType> writer(TEST_TOPIC_NAME);
+
+    reader.history_depth(100).init();
+
+    ASSERT_TRUE(reader.isInitialized());
+
+    // The batch delay is longer than the reception timeout, so only the flush sends the samples.
+    writer.history_depth(100).reliability(eprosima::fastrtps::BEST_EFFORT_RELIABILITY_QOS).
+        batching(0, 0, 10000).init();
+
+    ASSERT_TRUE(writer.isInitialized());
+
+    // Because its volatile the durability
+    // Wait for discovery.
+    writer.waitDiscovery();
+    reader.waitDiscovery();
+
+    auto data = default_helloword_data_generator();
+
+    reader.expected_data(data);
+    reader.startReception();
+
+    // Send data
+    writer.send(data);
+    // In this test all data should be sent.
+    ASSERT_TRUE(data.empty());
+    ASSERT_EQ(writer.flush(), 10u);
+    // Block reader until reception finished or timeout.
+    data = reader.block(std::chrono::seconds(2));
+
+    // The batch is a single datagram through the loopback, so every sample arrives.
+    print_non_received_messages(data, default_helloworld_print);
+    ASSERT_EQ(data.size(), 0);
+
+    BatchingStatistics statistics = writer.batching_statistics();
+    ASSERT_EQ(statistics.batches, 1u);
+    ASSERT_EQ(statistics.flushedExplicitly, 1u);
+    ASSERT_DOUBLE_EQ(statistics.averageSamples(), 10.0);
+}
+
+BLACKBOXTEST(BlackBox, PubSubAsReliableHelloworldThroughDiscoveryServer)
+{
+    uint32_t pid = (uint32_t)boost::interprocess::ipcdetail::get_current_process_id();
+
+    Locator_t server_locator;
+    server_locator.kind = LOCATOR_KIND_UDPv4;
+    server_locator.set_IP4_address(127, 0, 0, 1);
+    server_locator.port = 17000 + (pid % 1000);
+
+    eprosima::fastrtps::ParticipantAttributes server_attr;
+    server_attr.rtps.builtin.domainId = pid % 230;
+    server_attr.rtps.builtin.isDiscoveryServer = true;
+    server_attr.rtps.builtin.metatrafficUnicastLocatorList.push_back(server_locator);
+    eprosima::fastrtps::Participant* server = eprosima::fastrtps::Domain::createParticipant(server_attr);
+    ASSERT_NE(server, nullptr);
+
+    PubSubReader<HelloWorldType> reader(TEST_TOPIC_NAME);
+    PubSubWriter<HelloWorldType> writer(TEST_TOPIC_NAME);
+
+    reader.history_depth(100).
+        reliability(eprosima::fastrtps::RELIABLE_RELIABILITY_QOS).
+        discovery_server(server_locator).init();
+
+    ASSERT_TRUE(reader.isInitialized());
+
+    writer.history_depth(100).discovery_server(server_locator).init();
+
+    ASSERT_TRUE(writer.isInitialized());
+
+    // The clients only know each other through the server.
+    writer.waitDiscovery();
+    reader.waitDiscovery();
+
+    auto data = default_helloword_data_generator();
+
+    reader.expected_data(data);
+    reader.startReception();
+
+    // Send data
+    writer.send(data);
+    // In this test all data should be sent.
+    ASSERT_TRUE(data.empty());
+    // Block reader until reception finished or timeout.
+    data = reader.block(std::chrono::seconds(2));
+
+    print_non_received_messages(data, default_helloworld_print);
+    ASSERT_EQ(data.size(), 0);
+
+    eprosima::fastrtps::Domain::removeParticipant(server);
+}
+
 BLACKBOXTEST(BlackBox, AsyncPubSubAsReliableHelloworld)
 {
     PubSubReader<HelloWorldType> reader(TEST_TOPIC_NAME);
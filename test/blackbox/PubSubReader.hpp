@@ -31,6 +31,7 @@
 
 #include <string>
 #include <list>
+#include <vector>
 #include <condition_variable>
 #include <boost/asio.hpp>
 #include <boost/interprocess/detail/os_thread_functions.hpp>
@@ -89,6 +90,8 @@ class PubSubReader
             std::ostringstream t;
             t << topic_name_ << "_" << boost::asio::ip::host_name() << "_" << boost::interprocess::ipcdetail::get_current_process_id();
             subscriber_attr_.topic.topicName = t.str();
+            subscriber_attr_.topic.topicKind = type_.m_isGetKeyDefined ? eprosima::fastrtps::rtps::WITH_KEY :
+                eprosima::fastrtps::rtps::NO_KEY;
 
 #if defined(PREALLOCATED_WITH_REALLOC_MEMORY_MODE_TEST)
             subscriber_attr_.historyMemoryPolicy = PREALLOCATED_WITH_REALLOC_MEMORY_MODE;
@@ -111,9 +114,8 @@ class PubSubReader
 
         void init()
         {
-            eprosima::fastrtps::ParticipantAttributes pattr;
-            pattr.rtps.builtin.domainId = (uint32_t)boost::interprocess::ipcdetail::get_current_process_id() % 230;
-            participant_ = eprosima::fastrtps::Domain::createParticipant(pattr);
+            participant_attr_.rtps.builtin.domainId = (uint32_t)boost::interprocess::ipcdetail::get_current_process_id() % 230;
+            participant_ = eprosima::fastrtps::Domain::createParticipant(participant_attr_);
             ASSERT_NE(participant_, nullptr);
 
             // Register type
@@ -214,6 +216,22 @@ class PubSubReader
             return current_received_count_;
         }
 
+        size_t take(std::vector<type>& data, std::vector<SampleInfo_t>& infos, size_t max)
+        {
+            return subscriber_->take(data, infos, max);
+        }
+
+        size_t take_loan(std::vector<const SerializedPayload_t*>& payloads, std::vector<SampleInfo_t>& infos,
+                size_t max)
+        {
+            return subscriber_->take_loan(payloads, infos, max);
+        }
+
+        bool return_loan(std::vector<const SerializedPayload_t*>& payloads)
+        {
+            return subscriber_->return_loan(payloads);
+        }
+
         /*** Function to change QoS ***/
         PubSubReader& reliability(const eprosima::fastrtps::ReliabilityQosPolicyKind kind)
         {
@@ -239,6 +257,12 @@ class PubSubReader
             return *this;
         }
 
+        PubSubReader& resource_limits_max_samples_per_instance(const int32_t max)
+        {
+            subscriber_attr_.topic.resourceLimitsQos.max_samples_per_instance = max;
+            return *this;
+        }
+
         PubSubReader& allocated_samples(const int32_t max)
         {
             subscriber_attr_.topic.resourceLimitsQos.allocated_samples = max;
@@ -270,6 +294,12 @@ class PubSubReader
             return *this;
         }
 
+        PubSubReader& discovery_server(const Locator_t& server)
+        {
+            participant_attr_.rtps.builtin.discoveryServerLocatorList.push_back(server);
+            return *this;
+        }
+
         PubSubReader& durability_kind(const eprosima::fastrtps::DurabilityQosPolicyKind kind)
         {
             subscriber_attr_.qos.m_durability.kind = kind;
@@ -328,6 +358,7 @@ class PubSubReader
 
         eprosima::fastrtps::Participant *participant_;
         eprosima::fastrtps::SubscriberAttributes subscriber_attr_;
+        eprosima::fastrtps::ParticipantAttributes participant_attr_;
         eprosima::fastrtps::Subscriber *subscriber_;
         std::string topic_name_;
         bool initialized_;
@@ -75,6 +75,8 @@ class PubSubWriter
         std::ostringstream t;
         t << topic_name_ << "_" << boost::asio::ip::host_name() << "_" << boost::interprocess::ipcdetail::get_current_process_id();
         publisher_attr_.topic.topicName = t.str();
+        publisher_attr_.topic.topicKind = type_.m_isGetKeyDefined ? eprosima::fastrtps::rtps::WITH_KEY :
+            eprosima::fastrtps::rtps::NO_KEY;
 
 #if defined(PREALLOCATED_WITH_REALLOC_MEMORY_MODE_TEST)
             publisher_attr_.historyMemoryPolicy = PREALLOCATED_WITH_REALLOC_MEMORY_MODE;
@@ -152,6 +154,17 @@ class PubSubWriter
         }
     }
 
+    void send_bulk(std::list<type>& msgs)
+    {
+        std::vector<void*> data;
+
+        for(auto it = msgs.begin(); it != msgs.end(); ++it)
+            data.push_back((void*)&(*it));
+
+        if(publisher_->write(data))
+            msgs.clear();
+    }
+
     void waitDiscovery()
     {
         std::cout << "Writer waiting for discovery..." << std::endl;
@@ -182,6 +195,31 @@ class PubSubWriter
         return publisher_->wait_for_all_acked(Time_t((int32_t)max_wait.count(), 0));
     }
 
+    size_t flush()
+    {
+        return publisher_->flush();
+    }
+
+    type* loan_sample()
+    {
+        return static_cast<type*>(publisher_->loan_sample());
+    }
+
+    bool write_loaned(type* sample)
+    {
+        return publisher_->write_loaned(sample);
+    }
+
+    bool discard_loan(type* sample)
+    {
+        return publisher_->discard_loan(sample);
+    }
+
+    eprosima::fastrtps::rtps::BatchingStatistics batching_statistics()
+    {
+        return publisher_->getBatchingStatistics();
+    }
+
     /*** Function to change QoS ***/
     PubSubWriter& reliability(const eprosima::fastrtps::ReliabilityQosPolicyKind kind)
     {
@@ -203,6 +241,16 @@ class PubSubWriter
         return *this;
     }
 
+    PubSubWriter& batching(uint32_t maxBytes, uint32_t maxSamples, uint32_t maxDelayMs)
+    {
+        publisher_attr_.batching.enabled = true;
+        publisher_attr_.batching.maxBytes = maxBytes;
+        publisher_attr_.batching.maxSamples = maxSamples;
+        publisher_attr_.batching.maxDelay.seconds = maxDelayMs / 1000;
+        publisher_attr_.batching.maxDelay.fraction = (maxDelayMs % 1000) * 4294967;
+        return *this;
+    }
+
     PubSubWriter& history_kind(const eprosima::fastrtps::HistoryQosPolicyKind kind)
     {
         publisher_attr_.topic.historyQos.kind = kind;
@@ -239,6 +287,12 @@ class PubSubWriter
         return *this;
     }
 
+    PubSubWriter& resource_limits_max_samples_per_instance(const int32_t max)
+    {
+        publisher_attr_.topic.resourceLimitsQos.max_samples_per_instance = max;
+        return *this;
+    }
+
     PubSubWriter& heartbeat_period_seconds(int32_t sec)
     {
         publisher_attr_.times.heartbeatPeriod.seconds = sec;
@@ -269,6 +323,12 @@ class PubSubWriter
         return *this;
     }
 
+    PubSubWriter& discovery_server(const Locator_t& server)
+    {
+        participant_attr_.rtps.builtin.discoveryServerLocatorList.push_back(server);
+        return *this;
+    }
+
     PubSubWriter& allocated_samples(const uint32_t max)
     {
         publisher_attr_.topic.resourceLimitsQos.allocated_samples = max;
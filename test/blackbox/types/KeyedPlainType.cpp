@@ -0,0 +1,76 @@
+// Copyright 2016 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file KeyedPlainType.cpp
+ *
+ */
+
+#include "KeyedPlainType.h"
+
+KeyedPlainType::KeyedPlainType() {
+	setName("KeyedPlainType");
+	m_typeSize = (uint32_t)sizeof(KeyedPlain) + 4;
+	m_isGetKeyDefined = true;
+	m_plainSize = (uint32_t)sizeof(KeyedPlain);
+}
+
+KeyedPlainType::~KeyedPlainType() {
+}
+
+bool KeyedPlainType::serialize(void* data, SerializedPayload_t* payload)
+{
+#if EPROSIMA_BIG_ENDIAN
+	payload->encapsulation = CDR_BE;
+#else
+	payload->encapsulation = CDR_LE;
+#endif
+	memcpy(payload->data, data, sizeof(KeyedPlain));
+	payload->length = (uint32_t)sizeof(KeyedPlain);
+	return true;
+}
+
+bool KeyedPlainType::deserialize(SerializedPayload_t* payload, void* data)
+{
+	if(payload->length != sizeof(KeyedPlain))
+		return false;
+	memcpy(data, payload->data, sizeof(KeyedPlain));
+	return true;
+}
+
+std::function<uint32_t()> KeyedPlainType::getSerializedSizeProvider(void* /*data*/)
+{
+	return []() -> uint32_t { return (uint32_t)sizeof(KeyedPlain) + 4; };
+}
+
+void* KeyedPlainType::createData()
+{
+	return (void*)new KeyedPlain();
+}
+
+void KeyedPlainType::deleteData(void* data)
+{
+	delete((KeyedPlain*)data);
+}
+
+bool KeyedPlainType::getKey(void* data, InstanceHandle_t* handle)
+{
+	KeyedPlain* sample = (KeyedPlain*)data;
+	memset(handle->value, 0, 16);
+	handle->value[0] = (octet)(sample->key >> 24);
+	handle->value[1] = (octet)(sample->key >> 16);
+	handle->value[2] = (octet)(sample->key >> 8);
+	handle->value[3] = (octet)sample->key;
+	return true;
+}
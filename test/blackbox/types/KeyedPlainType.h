@@ -0,0 +1,63 @@
+// Copyright 2016 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file KeyedPlainType.h
+ *
+ */
+
+#ifndef KEYEDPLAINTYPE_H_
+#define KEYEDPLAINTYPE_H_
+
+#include "fastrtps/TopicDataType.h"
+
+#include <cstdint>
+#include <cstring>
+
+using namespace eprosima::fastrtps;
+
+/**
+ * Sample with a key and a fixed size, so its serialized payload is the sample itself.
+ */
+struct KeyedPlain
+{
+	uint32_t key;
+	uint32_t index;
+	char message[24];
+};
+
+inline bool operator==(const KeyedPlain& a, const KeyedPlain& b)
+{
+	return a.key == b.key && a.index == b.index && strncmp(a.message, b.message, sizeof(a.message)) == 0;
+}
+
+/**
+ * Plain type of KeyedPlain, that publishers can loan (TopicDataType::isPlain).
+ * The payloads are in the byte order of the host.
+ */
+class KeyedPlainType:public TopicDataType {
+public:
+	typedef KeyedPlain type;
+
+	KeyedPlainType();
+	virtual ~KeyedPlainType();
+	bool serialize(void*data,SerializedPayload_t* payload);
+	bool deserialize(SerializedPayload_t* payload,void * data);
+	std::function<uint32_t()> getSerializedSizeProvider(void *data);
+	bool getKey(void*data,InstanceHandle_t* ihandle);
+	void* createData();
+	void deleteData(void* data);
+};
+
+#endif /* KEYEDPLAINTYPE_H_ */
@@ -0,0 +1,192 @@
+// Copyright 2016 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file CDRMessageBenchmark.cpp
+ *
+ * Micro benchmarks of the CDR primitives used to build and parse the RTPS submessages.
+ */
+
+#include "MicroBenchmark.h"
+
+#include <fastrtps/rtps/messages/CDRMessage.h>
+#include <fastrtps/rtps/messages/RTPSMessageCreator.h>
+#include <fastrtps/rtps/messages/MessageReceiver.h>
+#include <fastrtps/rtps/common/CacheChange.h>
+#include <fastrtps/rtps/RTPSDomain.h>
+#include <fastrtps/rtps/participant/RTPSParticipant.h>
+#include <fastrtps/rtps/attributes/RTPSParticipantAttributes.h>
+#include <fastrtps/rtps/attributes/ReaderAttributes.h>
+#include <fastrtps/rtps/attributes/HistoryAttributes.h>
+#include <fastrtps/rtps/history/ReaderHistory.h>
+#include <fastrtps/rtps/reader/RTPSReader.h>
+
+using namespace eprosima::fastrtps;
+using namespace eprosima::fastrtps::rtps;
+
+/**
+ * Fields of a HEARTBEAT, an ACKNACK and the locators and timestamp of an INFO_TS/INFO_REPLY, written with
+ * the same primitives the submessages use.
+ */
+static void addFields(CDRMessage_t* msg, const SequenceNumberSet_t& set, Locator_t& loc)
+{
+    EntityId_t reader(ENTITYID_UNKNOWN), writer(ENTITYID_SPDP_BUILTIN_RTPSParticipant_WRITER);
+    SequenceNumber_t first(0, 1), last(0, 1000);
+    Time_t ts(12, 34);
+    CDRMessage::addUInt16(msg, 0x1234);
+    CDRMessage::addUInt16(msg, 28);
+    CDRMessage::addEntityId(msg, &reader);
+    CDRMessage::addEntityId(msg, &writer);
+    CDRMessage::addSequenceNumber(msg, &first);
+    CDRMessage::addSequenceNumber(msg, &last);
+    CDRMessage::addUInt32(msg, 7);
+    CDRMessage::addSequenceNumberSet(msg, const_cast<SequenceNumberSet_t*>(&set));
+    CDRMessage::addInt32(msg, 8);
+    CDRMessage::addLocator(msg, &loc);
+    CDRMessage::addInt32(msg, ts.seconds);
+    CDRMessage::addUInt32(msg, ts.fraction);
+    CDRMessage::addInt64(msg, 0x0102030405060708ll);
+}
+
+static uint32_t readFields(CDRMessage_t* msg, SequenceNumberSet_t& set, Locator_t& loc)
+{
+    EntityId_t reader, writer;
+    SequenceNumber_t first, last;
+    uint16_t id = 0, length = 0;
+    uint32_t count = 0;
+    int32_t acknackCount = 0;
+    Time_t ts;
+    CDRMessage::readUInt16(msg, &id);
+    CDRMessage::readUInt16(msg, &length);
+    CDRMessage::readEntityId(msg, &reader);
+    CDRMessage::readEntityId(msg, &writer);
+    CDRMessage::readSequenceNumber(msg, &first);
+    CDRMessage::readSequenceNumber(msg, &last);
+    CDRMessage::readUInt32(msg, &count);
+    CDRMessage::readSequenceNumberSet(msg, &set);
+    CDRMessage::readInt32(msg, &acknackCount);
+    CDRMessage::readLocator(msg, &loc);
+    CDRMessage::readTimestamp(msg, &ts);
+    return id + length + count + last.low + (uint32_t)acknackCount + (uint32_t)ts.seconds + loc.port;
+}
+
+int main(int argc, char** argv)
+{
+    MicroBenchmark bench(argc, argv);
+
+    SequenceNumberSet_t set;
+    set.base = SequenceNumber_t(0, 1000);
+    for(uint32_t i = 0; i < 256; i += 3)
+        set.add(set.base + i);
+    Locator_t loc(7400);
+    loc.set_IP4_address(192, 168, 1, 10);
+
+    const Endianness_t orders[] = {LITTLEEND, BIGEND};
+    const char* names[] = {"little", "big"};
+    for(int o = 0; o < 2; ++o)
+    {
+        CDRMessage_t msg(1024);
+        msg.msg_endian = orders[o];
+
+        bench.run(std::string("CDR_AddFields/") + names[o], [&](uint64_t iterations) {
+            for(uint64_t i = 0; i < iterations; ++i)
+            {
+                msg.pos = 0;
+                msg.length = 0;
+                addFields(&msg, set, loc);
+                doNotOptimize(msg.buffer[msg.length - 1]);
+            }
+        });
+
+        SequenceNumberSet_t readSet;
+        Locator_t readLoc;
+        bench.run(std::string("CDR_ReadFields/") + names[o], [&](uint64_t iterations) {
+            for(uint64_t i = 0; i < iterations; ++i)
+            {
+                msg.pos = 0;
+                doNotOptimize(readFields(&msg, readSet, readLoc));
+            }
+        });
+    }
+
+    // Whole RTPS messages: a DATA of a keyed topic with a small payload, a HEARTBEAT and an ACKNACK, as
+    // a reliable writer and reader exchange them. They are directed to a reliable reader that is not
+    // matched with the writer, so they are completely parsed and then discarded.
+    GuidPrefix_t prefix;
+    for(uint8_t i = 0; i < 12; ++i)
+        prefix.value[i] = i;
+    GuidPrefix_t remotePrefix;
+    EntityId_t readerId(ENTITYID_UNKNOWN);
+    EntityId_t writerId(ENTITYID_SPDP_BUILTIN_RTPSParticipant_WRITER);
+    CacheChange_t change(128);
+    change.writerGUID = GUID_t(prefix, writerId);
+    change.sequenceNumber = SequenceNumber_t(0, 1000);
+    change.serializedPayload.length = 128;
+    for(uint8_t i = 0; i < 16; ++i)
+        change.instanceHandle.value[i] = i;
+    memset(change.serializedPayload.data, 0xAB, 128);
+    SequenceNumber_t first(0, 1), last(0, 1000);
+
+    CDRMessage_t mix(RTPSMESSAGE_DEFAULT_SIZE);
+    auto buildMix = [&]() {
+        CDRMessage::initCDRMsg(&mix);
+        RTPSMessageCreator::addHeader(&mix, prefix);
+        RTPSMessageCreator::addSubmessageInfoTS_Now(&mix, false);
+        RTPSMessageCreator::addSubmessageData(&mix, &change, WITH_KEY, readerId, false, nullptr);
+        RTPSMessageCreator::addSubmessageHeartbeat(&mix, readerId, writerId, first, last, 3, false, false);
+        RTPSMessageCreator::addSubmessageAcknack(&mix, readerId, writerId, set, 3, false);
+        mix.length = mix.pos;
+    };
+
+    bench.run("RTPS_BuildMessage/DATA+HB+ACKNACK", [&](uint64_t iterations) {
+        for(uint64_t i = 0; i < iterations; ++i)
+        {
+            buildMix();
+            doNotOptimize(mix.length);
+        }
+    });
+
+    RTPSParticipantAttributes participantAttributes;
+    participantAttributes.builtin.use_SIMPLE_RTPSParticipantDiscoveryProtocol = false;
+    participantAttributes.builtin.use_WriterLivelinessProtocol = false;
+    RTPSParticipant* participant = RTPSDomain::createParticipant(participantAttributes);
+    HistoryAttributes historyAttributes;
+    ReaderHistory history(historyAttributes);
+    ReaderAttributes readerAttributes;
+    readerAttributes.endpoint.reliabilityKind = RELIABLE;
+    readerAttributes.endpoint.topicKind = WITH_KEY;
+    RTPSReader* reader = participant != nullptr ?
+        RTPSDomain::createRTPSReader(participant, readerAttributes, &history) : nullptr;
+    if(reader == nullptr)
+    {
+        printf("Error creating the reader\n");
+        return 1;
+    }
+
+    MessageReceiver receiver;
+    receiver.init(RTPSMESSAGE_DEFAULT_SIZE);
+    receiver.associateEndpoint(reader);
+    buildMix();
+    bench.run("RTPS_ParseMessage/DATA+HB+ACKNACK", [&](uint64_t iterations) {
+        for(uint64_t i = 0; i < iterations; ++i)
+        {
+            receiver.processCDRMsg(remotePrefix, &loc, &mix);
+            doNotOptimize(mix.pos);
+        }
+    });
+
+    RTPSDomain::stopAll();
+
+    return 0;
+}
@@ -0,0 +1,182 @@
+// Copyright 2016 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file ConcurrentWriteBenchmark.cpp
+ *
+ * Benchmark of several threads writing on the same synchronous publisher, matched with a subscriber
+ * of the same participant. Each iteration is one write per thread.
+ */
+
+#include "MicroBenchmark.h"
+
+#include <fastrtps/Domain.h>
+#include <fastrtps/participant/Participant.h>
+#include <fastrtps/attributes/ParticipantAttributes.h>
+#include <fastrtps/attributes/PublisherAttributes.h>
+#include <fastrtps/attributes/SubscriberAttributes.h>
+#include <fastrtps/publisher/Publisher.h>
+#include <fastrtps/publisher/PublisherListener.h>
+#include <fastrtps/subscriber/Subscriber.h>
+#include <fastrtps/TopicDataType.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace eprosima::fastrtps;
+using namespace eprosima::fastrtps::rtps;
+
+struct ConcurrentSample
+{
+    uint32_t index;
+    char data[60];
+};
+
+/**
+ * Type copying the sample as is, so the benchmark measures the write path and not the serialization.
+ */
+class ConcurrentSampleType : public TopicDataType
+{
+public:
+
+    ConcurrentSampleType()
+    {
+        setName("ConcurrentSample");
+        m_typeSize = sizeof(ConcurrentSample) + 4;
+        m_isGetKeyDefined = false;
+    }
+
+    bool serialize(void* data, SerializedPayload_t* payload)
+    {
+        payload->encapsulation = CDR_LE;
+        memcpy(payload->data, data, sizeof(ConcurrentSample));
+        payload->length = sizeof(ConcurrentSample);
+        return true;
+    }
+
+    bool deserialize(SerializedPayload_t* payload, void* data)
+    {
+        memcpy(data, payload->data, sizeof(ConcurrentSample));
+        return true;
+    }
+
+    std::function<uint32_t()> getSerializedSizeProvider(void*)
+    {
+        return []() -> uint32_t { return sizeof(ConcurrentSample) + 4; };
+    }
+
+    void* createData() { return new ConcurrentSample(); }
+
+    void deleteData(void* data) { delete static_cast<ConcurrentSample*>(data); }
+};
+
+class MatchListener : public PublisherListener
+{
+public:
+
+    MatchListener(): matched(0) {}
+
+    void onPublicationMatched(Publisher*, MatchingInfo& info)
+    {
+        if(info.status == MATCHED_MATCHING)
+            ++matched;
+    }
+
+    std::atomic<int> matched;
+};
+
+int main(int argc, char** argv)
+{
+    MicroBenchmark bench(argc, argv);
+
+    ParticipantAttributes pattr;
+    pattr.rtps.builtin.domainId = 80;
+    pattr.rtps.setName("ConcurrentWriteBenchmark");
+    Participant* participant = Domain::createParticipant(pattr);
+    if(participant == nullptr)
+    {
+        printf("Error creating the participant\n");
+        return 1;
+    }
+
+    ConcurrentSampleType type;
+    Domain::registerType(participant, &type);
+
+    const ReliabilityQosPolicyKind kinds[] = {BEST_EFFORT_RELIABILITY_QOS, RELIABLE_RELIABILITY_QOS};
+    const unsigned int threadCounts[] = {1, 2, 4, 8, 16};
+
+    for(size_t k = 0; k < sizeof(kinds) / sizeof(kinds[0]); ++k)
+    {
+        std::string topicName = kinds[k] == RELIABLE_RELIABILITY_QOS ? "ConcurrentWriteReliable" : "ConcurrentWriteBestEffort";
+
+        SubscriberAttributes sattr;
+        sattr.topic.topicDataType = type.getName();
+        sattr.topic.topicName = topicName;
+        sattr.topic.historyQos.kind = KEEP_LAST_HISTORY_QOS;
+        sattr.topic.historyQos.depth = 100;
+        sattr.qos.m_reliability.kind = kinds[k];
+        Subscriber* subscriber = Domain::createSubscriber(participant, sattr);
+
+        MatchListener listener;
+        PublisherAttributes wattr;
+        wattr.topic.topicDataType = type.getName();
+        wattr.topic.topicName = topicName;
+        wattr.topic.historyQos.kind = KEEP_LAST_HISTORY_QOS;
+        wattr.topic.historyQos.depth = 100;
+        // Room for the change written while the oldest one is still in the history.
+        wattr.topic.resourceLimitsQos.max_samples = 200;
+        wattr.topic.resourceLimitsQos.allocated_samples = 200;
+        wattr.qos.m_reliability.kind = kinds[k];
+        Publisher* publisher = Domain::createPublisher(participant, wattr, &listener);
+
+        if(subscriber == nullptr || publisher == nullptr)
+        {
+            printf("Error creating the endpoints of %s\n", topicName.c_str());
+            return 1;
+        }
+
+        for(int i = 0; i < 100 && listener.matched == 0; ++i)
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+        for(size_t t = 0; t < sizeof(threadCounts) / sizeof(threadCounts[0]); ++t)
+        {
+            unsigned int threads = threadCounts[t];
+
+            bench.run(topicName + "/" + std::to_string(threads) + "threads", [&](uint64_t iterations) {
+                std::vector<std::thread> writers;
+                for(unsigned int w = 0; w < threads; ++w)
+                {
+                    writers.emplace_back([&, w]() {
+                        ConcurrentSample sample;
+                        memset(sample.data, (int)w, sizeof(sample.data));
+                        for(uint64_t i = 0; i < iterations; ++i)
+                        {
+                            sample.index = (uint32_t)i;
+                            publisher->write(&sample);
+                        }
+                    });
+                }
+                for(auto& writer : writers)
+                    writer.join();
+            }, threads);
+        }
+
+        Domain::removePublisher(publisher);
+        Domain::removeSubscriber(subscriber);
+    }
+
+    Domain::removeParticipant(participant);
+    return 0;
+}
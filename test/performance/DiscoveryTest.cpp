@@ -0,0 +1,239 @@
+// Copyright 2016 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file DiscoveryTest.cpp
+ *
+ */
+
+#include "DiscoveryTest.h"
+
+#include <fastrtps/attributes/ParticipantAttributes.h>
+#include <fastrtps/attributes/PublisherAttributes.h>
+#include <fastrtps/attributes/SubscriberAttributes.h>
+#include <fastrtps/transport/test_UDPv4Transport.h>
+#include <fastrtps/rtps/common/MatchingInfo.h>
+
+#include <fastrtps/Domain.h>
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+using namespace eprosima::fastrtps::rtps;
+using namespace std;
+
+DiscoveryTest::DiscoveryTest():
+	match_count_(0),
+	n_total_participants(0),
+	n_local_participants(0),
+	n_endpoints(0),
+	n_loss(0),
+	n_timeout(0),
+	n_seed(0),
+	n_shared_event_thread(false),
+	n_export_csv(false),
+	m_publistener(this),
+	m_sublistener(this),
+	m_expectedMatches(0),
+	m_startMemory(0),
+	m_startCpu(0)
+{
+}
+
+DiscoveryTest::~DiscoveryTest()
+{
+	for(std::vector<Participant*>::iterator it = m_participants.begin(); it != m_participants.end(); ++it)
+		Domain::removeParticipant(*it);
+}
+
+bool DiscoveryTest::init(uint32_t total, uint32_t local, uint32_t endpoints, uint32_t loss, uint32_t timeout,
+		uint32_t seed, bool shared_event_thread, bool export_csv)
+{
+	n_total_participants = total;
+	n_local_participants = local;
+	n_endpoints = endpoints;
+	n_loss = loss;
+	n_timeout = timeout;
+	n_seed = seed;
+	n_shared_event_thread = shared_event_thread;
+	n_export_csv = export_csv;
+
+	// Each writer matches the reader of its topic in every participant, and the other way round.
+	m_expectedMatches = 2 * (uint64_t)n_local_participants * n_endpoints * n_total_participants;
+
+	m_startMemory = currentMemory();
+	m_startCpu = std::clock();
+	test_UDPv4Transport::SentPackets = 0;
+	test_UDPv4Transport::SentBytes = 0;
+	t_start_ = std::chrono::steady_clock::now();
+	t_startup_ = std::chrono::duration<double, std::milli>::zero();
+
+	for(uint32_t p = 0; p < n_local_participants; ++p)
+	{
+		std::chrono::steady_clock::time_point t_create = std::chrono::steady_clock::now();
+
+		// All the traffic goes through the test transport, to count it and to drop part of it.
+		auto transport = std::make_shared<test_UDPv4TransportDescriptor>();
+		transport->percentageOfMessagesToDrop = (uint8_t)n_loss;
+
+		ParticipantAttributes PParam;
+		PParam.rtps.builtin.domainId = n_seed % 230;
+		PParam.rtps.builtin.use_SIMPLE_EndpointDiscoveryProtocol = true;
+		PParam.rtps.builtin.use_SIMPLE_RTPSParticipantDiscoveryProtocol = true;
+		PParam.rtps.builtin.m_simpleEDP.use_PublicationReaderANDSubscriptionWriter = true;
+		PParam.rtps.builtin.m_simpleEDP.use_PublicationWriterANDSubscriptionReader = true;
+		PParam.rtps.useBuiltinTransports = false;
+		PParam.rtps.userTransports.push_back(transport);
+		PParam.rtps.useSharedEventThread = n_shared_event_thread;
+		PParam.rtps.setName("Participant_discovery");
+		Participant* participant = Domain::createParticipant(PParam);
+		if(participant == nullptr)
+			return false;
+		m_participants.push_back(participant);
+		Domain::registerType(participant, (TopicDataType*)&m_type);
+
+		for(uint32_t e = 0; e < n_endpoints; ++e)
+		{
+			std::ostringstream topic;
+			topic << "DiscoveryTest_" << n_seed << "_" << e;
+
+			PublisherAttributes Wparam;
+			Wparam.topic.topicDataType = m_type.getName();
+			Wparam.topic.topicKind = NO_KEY;
+			Wparam.topic.topicName = topic.str();
+			Publisher* publisher = Domain::createPublisher(participant, Wparam, &m_publistener);
+			if(publisher == nullptr)
+				return false;
+			m_publishers.push_back(publisher);
+
+			SubscriberAttributes Rparam;
+			Rparam.topic.topicDataType = m_type.getName();
+			Rparam.topic.topicKind = NO_KEY;
+			Rparam.topic.topicName = topic.str();
+			Subscriber* subscriber = Domain::createSubscriber(participant, Rparam, &m_sublistener);
+			if(subscriber == nullptr)
+				return false;
+			m_subscribers.push_back(subscriber);
+		}
+
+		t_startup_ += std::chrono::steady_clock::now() - t_create;
+	}
+
+	return true;
+}
+
+void DiscoveryTest::run()
+{
+	std::unique_lock<std::mutex> lock(mutex_);
+	bool matched = match_cond_.wait_for(lock, std::chrono::seconds(n_timeout),
+			[&]() { return match_count_ >= m_expectedMatches; });
+	lock.unlock();
+
+	if(!matched)
+		t_end_ = std::chrono::steady_clock::now();
+
+	m_results.total_participants = n_total_participants;
+	m_results.local_participants = n_local_participants;
+	m_results.endpoints = n_endpoints;
+	m_results.loss = n_loss;
+	m_results.matched = matched;
+	m_results.startup_time_ms = t_startup_.count();
+	m_results.match_time_ms = std::chrono::duration<double, std::milli>(t_end_ - t_start_).count();
+	m_results.bytes = test_UDPv4Transport::SentBytes;
+	m_results.packets = test_UDPv4Transport::SentPackets;
+	uint64_t peak = peakMemory();
+	m_results.peak_memory_kb = peak > m_startMemory ? peak - m_startMemory : 0;
+	m_results.cpu_ms = 1000.0 * (std::clock() - m_startCpu) / CLOCKS_PER_SEC;
+
+	if(!matched)
+		cout << "Full match not reached in " << n_timeout << " seconds: " << match_count_ << " of "
+			<< m_expectedMatches << " matches" << endl;
+
+	printStat(m_results);
+
+	if(n_export_csv)
+	{
+		const char* filename = "perf_DiscoveryTest.csv";
+		bool newFile = !std::ifstream(filename).good();
+		std::ofstream outFile(filename, std::ios::app);
+		if(newFile)
+			printResultTitle(outFile);
+		printResults(outFile, m_results);
+	}
+}
+
+void DiscoveryTest::printStat(const DiscoveryResults& res)
+{
+	printResultTitle(cout);
+	printResults(cout, res);
+}
+
+void DiscoveryTest::newMatch()
+{
+	std::unique_lock<std::mutex> lock(mutex_);
+	if(++match_count_ == m_expectedMatches)
+	{
+		t_end_ = std::chrono::steady_clock::now();
+		match_cond_.notify_one();
+	}
+}
+
+void DiscoveryTest::PubListener::onPublicationMatched(Publisher* /*pub*/, MatchingInfo& info)
+{
+	if(info.status == MATCHED_MATCHING)
+		mp_up->newMatch();
+}
+
+void DiscoveryTest::SubListener::onSubscriptionMatched(Subscriber* /*sub*/, MatchingInfo& info)
+{
+	if(info.status == MATCHED_MATCHING)
+		mp_up->newMatch();
+}
+
+#if defined(__linux__)
+static uint64_t readStatusField(const char* field)
+{
+	std::ifstream status("/proc/self/status");
+	std::string line;
+	size_t length = std::char_traits<char>::length(field);
+	while(std::getline(status, line))
+	{
+		if(line.compare(0, length, field) == 0)
+			return std::stoull(line.substr(length));
+	}
+	return 0;
+}
+
+uint64_t DiscoveryTest::peakMemory()
+{
+	return readStatusField("VmHWM:");
+}
+
+uint64_t DiscoveryTest::currentMemory()
+{
+	return readStatusField("VmRSS:");
+}
+#else
+uint64_t DiscoveryTest::peakMemory()
+{
+	return 0;
+}
+
+uint64_t DiscoveryTest::currentMemory()
+{
+	return 0;
+}
+#endif
@@ -0,0 +1,113 @@
+// Copyright 2016 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file DiscoveryTest.h
+ *
+ */
+
+#ifndef DISCOVERYTEST_H_
+#define DISCOVERYTEST_H_
+
+#include "DiscoveryTestTypes.h"
+
+#include <fastrtps/fastrtps_fwd.h>
+#include <fastrtps/publisher/PublisherListener.h>
+#include <fastrtps/subscriber/SubscriberListener.h>
+
+#include <condition_variable>
+#include <chrono>
+#include <ctime>
+#include <mutex>
+#include <vector>
+
+/**
+ * Creates some participants with some readers and writers each, and measures the time and resources
+ * needed until all of them are matched with the ones of every participant of the test.
+ * Every participant has a writer and a reader in each of the topics of the test.
+ * The participants of a test can be split between several processes that use the same seed.
+ */
+class DiscoveryTest {
+public:
+	DiscoveryTest();
+	virtual ~DiscoveryTest();
+
+	std::vector<Participant*> m_participants;
+	std::vector<Publisher*> m_publishers;
+	std::vector<Subscriber*> m_subscribers;
+	DiscoveryDataType m_type;
+	std::mutex mutex_;
+	uint64_t match_count_;
+	std::condition_variable match_cond_;
+	uint32_t n_total_participants;
+	uint32_t n_local_participants;
+	uint32_t n_endpoints;
+	uint32_t n_loss;
+	uint32_t n_timeout;
+	uint32_t n_seed;
+	bool n_shared_event_thread;
+	bool n_export_csv;
+	DiscoveryResults m_results;
+	/**
+	 * @param total Participants of the test, in all the processes.
+	 * @param local Participants created by this process.
+	 * @param endpoints Readers and writers of each participant.
+	 * @param loss Percentage of packets dropped by the transport.
+	 * @param timeout Seconds to wait for the full match.
+	 * @param seed Seed to calculate domain and topics, to isolate the test.
+	 * @param shared_event_thread Whether the participants share their event thread.
+	 * @param export_csv Whether to append the results to perf_DiscoveryTest.csv.
+	 */
+	bool init(uint32_t total, uint32_t local, uint32_t endpoints, uint32_t loss, uint32_t timeout, uint32_t seed,
+			bool shared_event_thread, bool export_csv);
+	void run();
+	void printStat(const DiscoveryResults& res);
+
+	class PubListener : public PublisherListener
+	{
+	public:
+		PubListener(DiscoveryTest* up):mp_up(up){}
+		~PubListener(){}
+		void onPublicationMatched(Publisher* pub,MatchingInfo& info);
+		DiscoveryTest* mp_up;
+	}m_publistener;
+	class SubListener : public SubscriberListener
+	{
+	public:
+		SubListener(DiscoveryTest* up):mp_up(up){}
+		~SubListener(){}
+		void onSubscriptionMatched(Subscriber* sub,MatchingInfo& info);
+		DiscoveryTest* mp_up;
+	}m_sublistener;
+
+private:
+
+	//!Count a new match and wake run() when all the expected ones are done.
+	void newMatch();
+
+	//!Peak resident memory of the process in KB, or 0 where it is not available.
+	static uint64_t peakMemory();
+
+	//!Current resident memory of the process in KB, or 0 where it is not available.
+	static uint64_t currentMemory();
+
+	uint64_t m_expectedMatches;
+	uint64_t m_startMemory;
+	std::clock_t m_startCpu;
+	std::chrono::steady_clock::time_point t_start_, t_end_;
+	//!Time spent creating the participants, with their endpoints.
+	std::chrono::duration<double, std::milli> t_startup_;
+};
+
+#endif /* DISCOVERYTEST_H_ */
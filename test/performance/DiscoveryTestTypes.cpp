@@ -0,0 +1,56 @@
+// Copyright 2016 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file DiscoveryTestTypes.cpp
+ *
+ */
+
+#include "DiscoveryTestTypes.h"
+
+bool DiscoveryDataType::serialize(void*data,SerializedPayload_t* payload)
+{
+	DiscoveryType* dt = (DiscoveryType*)data;
+	*(uint32_t*)payload->data = dt->index;
+	payload->length = 4;
+	return true;
+}
+
+bool DiscoveryDataType::deserialize(SerializedPayload_t* payload,void * data)
+{
+	if(payload->length >= 4)
+	{
+		DiscoveryType* dt = (DiscoveryType*)data;
+		dt->index = *(uint32_t*)payload->data;
+	}
+	return true;
+}
+
+std::function<uint32_t()> DiscoveryDataType::getSerializedSizeProvider(void* /*data*/)
+{
+    return []() -> uint32_t
+    {
+        return 4;
+    };
+}
+
+void* DiscoveryDataType::createData()
+{
+	return (void*)new DiscoveryType();
+}
+
+void DiscoveryDataType::deleteData(void* data)
+{
+	delete((DiscoveryType*)data);
+}
@@ -0,0 +1,85 @@
+// Copyright 2016 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file DiscoveryTestTypes.h
+ *
+ */
+
+#ifndef DISCOVERYTESTTYPES_H_
+#define DISCOVERYTESTTYPES_H_
+
+#include <fastrtps/TopicDataType.h>
+
+#include <cstdint>
+#include <ostream>
+
+using namespace eprosima;
+using namespace eprosima::fastrtps;
+
+struct DiscoveryResults
+{
+	uint32_t total_participants;
+	uint32_t local_participants;
+	uint32_t endpoints;
+	uint32_t loss;
+	bool matched;
+	double startup_time_ms;
+	double match_time_ms;
+	uint64_t bytes;
+	uint64_t packets;
+	uint64_t peak_memory_kb;
+	double cpu_ms;
+};
+
+inline void printResultTitle(std::ostream& output)
+{
+	output << "\"Participants\",\"Local participants\",\"Endpoints per participant\",\"Loss (%)\",\"Matched\","
+		<< "\"Startup time per participant (ms)\",\"Time to full match (ms)\",\"Discovery bytes\",\"Discovery packets\","
+		<< "\"Bytes per participant\","
+		<< "\"Peak memory (KB)\",\"Peak memory per participant (KB)\",\"CPU per participant (ms)\"" << std::endl;
+}
+
+inline void printResults(std::ostream& output, const DiscoveryResults& res)
+{
+	output << res.total_participants << "," << res.local_participants << "," << res.endpoints << "," << res.loss << ","
+		<< (res.matched ? "true" : "false") << "," << res.startup_time_ms / res.local_participants << ","
+		<< res.match_time_ms << "," << res.bytes << "," << res.packets << ","
+		<< res.bytes / res.local_participants << "," << res.peak_memory_kb << ","
+		<< res.peak_memory_kb / res.local_participants << "," << res.cpu_ms / res.local_participants << std::endl;
+}
+
+typedef struct DiscoveryType{
+	uint32_t index;
+	DiscoveryType():index(0){}
+}DiscoveryType;
+
+class DiscoveryDataType: public TopicDataType
+{
+public:
+	DiscoveryDataType()
+{
+		setName("DiscoveryType");
+		m_typeSize = 4;
+		m_isGetKeyDefined = false;
+};
+	~DiscoveryDataType(){};
+	bool serialize(void*data,SerializedPayload_t* payload);
+	bool deserialize(SerializedPayload_t* payload,void * data);
+	std::function<uint32_t()> getSerializedSizeProvider(void* data);
+	void* createData();
+	void deleteData(void* data);
+};
+
+#endif /* DISCOVERYTESTTYPES_H_ */
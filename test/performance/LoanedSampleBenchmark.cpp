@@ -0,0 +1,216 @@
+// Copyright 2016 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file LoanedSampleBenchmark.cpp
+ *
+ * Benchmark of the publication of a large plain sample, filled in a user buffer and written, or filled
+ * in a sample loaned by the publisher and written in place. Before it, a loaned sample is checked to
+ * arrive intact, reading it in place from a payload loaned by the subscriber.
+ */
+
+#include "MicroBenchmark.h"
+
+#include <fastrtps/Domain.h>
+#include <fastrtps/participant/Participant.h>
+#include <fastrtps/attributes/ParticipantAttributes.h>
+#include <fastrtps/attributes/PublisherAttributes.h>
+#include <fastrtps/attributes/SubscriberAttributes.h>
+#include <fastrtps/publisher/Publisher.h>
+#include <fastrtps/publisher/PublisherListener.h>
+#include <fastrtps/subscriber/Subscriber.h>
+#include <fastrtps/subscriber/SampleInfo.h>
+#include <fastrtps/TopicDataType.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace eprosima::fastrtps;
+using namespace eprosima::fastrtps::rtps;
+
+struct FrameSample
+{
+    uint32_t index;
+    uint8_t pixels[16380];
+};
+
+/**
+ * Plain type: its serialized payload is the sample as is.
+ */
+class FrameSampleType : public TopicDataType
+{
+public:
+
+    FrameSampleType()
+    {
+        setName("FrameSample");
+        m_typeSize = sizeof(FrameSample) + 4;
+        m_isGetKeyDefined = false;
+        m_plainSize = sizeof(FrameSample);
+    }
+
+    bool serialize(void* data, SerializedPayload_t* payload)
+    {
+        payload->encapsulation = CDR_LE;
+        memcpy(payload->data, data, sizeof(FrameSample));
+        payload->length = sizeof(FrameSample);
+        return true;
+    }
+
+    bool deserialize(SerializedPayload_t* payload, void* data)
+    {
+        memcpy(data, payload->data, sizeof(FrameSample));
+        return true;
+    }
+
+    std::function<uint32_t()> getSerializedSizeProvider(void*)
+    {
+        return []() -> uint32_t { return sizeof(FrameSample) + 4; };
+    }
+
+    void* createData() { return new FrameSample(); }
+
+    void deleteData(void* data) { delete static_cast<FrameSample*>(data); }
+};
+
+class MatchListener : public PublisherListener
+{
+public:
+
+    MatchListener(): matched(0) {}
+
+    void onPublicationMatched(Publisher*, MatchingInfo& info)
+    {
+        if(info.status == MATCHED_MATCHING)
+            ++matched;
+    }
+
+    std::atomic<int> matched;
+};
+
+//! Fill a frame as a producer would do.
+static void fillFrame(FrameSample& frame, uint32_t index)
+{
+    frame.index = index;
+    memset(frame.pixels, (int)(index & 0xFF), sizeof(frame.pixels));
+}
+
+int main(int argc, char** argv)
+{
+    MicroBenchmark bench(argc, argv);
+
+    ParticipantAttributes pattr;
+    pattr.rtps.builtin.domainId = 81;
+    pattr.rtps.setName("LoanedSampleBenchmark");
+    Participant* participant = Domain::createParticipant(pattr);
+    if(participant == nullptr)
+    {
+        printf("Error creating the participant\n");
+        return 1;
+    }
+
+    FrameSampleType type;
+    Domain::registerType(participant, &type);
+
+    SubscriberAttributes sattr;
+    sattr.topic.topicDataType = type.getName();
+    sattr.topic.topicName = "LoanedSampleBenchmark";
+    sattr.topic.historyQos.kind = KEEP_LAST_HISTORY_QOS;
+    sattr.topic.historyQos.depth = 10;
+    Subscriber* subscriber = Domain::createSubscriber(participant, sattr);
+
+    MatchListener listener;
+    PublisherAttributes wattr;
+    wattr.topic.topicDataType = type.getName();
+    wattr.topic.topicName = "LoanedSampleBenchmark";
+    wattr.topic.historyQos.kind = KEEP_LAST_HISTORY_QOS;
+    wattr.topic.historyQos.depth = 10;
+    // Room for the change loaned while the history is full.
+    wattr.topic.resourceLimitsQos.max_samples = 20;
+    wattr.topic.resourceLimitsQos.allocated_samples = 20;
+    wattr.qos.m_reliability.kind = BEST_EFFORT_RELIABILITY_QOS;
+    Publisher* publisher = Domain::createPublisher(participant, wattr, &listener);
+
+    if(subscriber == nullptr || publisher == nullptr)
+    {
+        printf("Error creating the endpoints\n");
+        return 1;
+    }
+
+    for(int i = 0; i < 100 && listener.matched == 0; ++i)
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    // A loaned sample must arrive as it was filled.
+    FrameSample* loaned = static_cast<FrameSample*>(publisher->loan_sample());
+    if(loaned == nullptr)
+    {
+        printf("Error loaning a sample\n");
+        return 1;
+    }
+    fillFrame(*loaned, 7);
+    publisher->write_loaned(loaned);
+
+    // It is read in place from the payload loaned by the subscriber.
+    std::vector<const SerializedPayload_t*> payloads;
+    std::vector<SampleInfo_t> infos;
+    for(int i = 0; i < 100 && payloads.empty(); ++i)
+    {
+        if(subscriber->take_loan(payloads, infos, 1) == 0)
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    const FrameSample* received = payloads.empty() ? nullptr :
+        reinterpret_cast<const FrameSample*>(payloads[0]->data);
+    if(received == nullptr || payloads[0]->length != sizeof(FrameSample) ||
+            received->index != 7 || received->pixels[sizeof(received->pixels) - 1] != 7)
+    {
+        printf("The loaned sample was not received as written\n");
+        return 1;
+    }
+    subscriber->return_loan(payloads);
+
+    FrameSample* frame = new FrameSample();
+    bench.run("Write/16KB", [&](uint64_t iterations) {
+        for(uint64_t i = 0; i < iterations; ++i)
+        {
+            fillFrame(*frame, (uint32_t)i);
+            publisher->write(frame);
+        }
+    });
+    delete frame;
+
+    bool loaned_all = true;
+    bench.run("WriteLoaned/16KB", [&](uint64_t iterations) {
+        for(uint64_t i = 0; i < iterations; ++i)
+        {
+            FrameSample* sample = static_cast<FrameSample*>(publisher->loan_sample());
+            if(sample == nullptr)
+            {
+                loaned_all = false;
+                break;
+            }
+            fillFrame(*sample, (uint32_t)i);
+            publisher->write_loaned(sample);
+        }
+    });
+
+    Domain::removeParticipant(participant);
+
+    if(!loaned_all)
+    {
+        printf("Error loaning a sample\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,109 @@
+// Copyright 2016 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file MicroBenchmark.h
+ *
+ */
+
+#ifndef MICROBENCHMARK_H_
+#define MICROBENCHMARK_H_
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+/**
+ * Prevents the compiler from optimizing away a value computed by a benchmark.
+ */
+template<class T>
+inline void doNotOptimize(const T& value)
+{
+#if defined(__GNUC__)
+	asm volatile("" : : "r,m"(value) : "memory");
+#else
+	static volatile const void* sink;
+	sink = &value;
+#endif
+}
+
+/**
+ * Minimal harness for the micro benchmarks, printing the same table as Google Benchmark.
+ * Each benchmark is a callable receiving the number of iterations to run. The number of iterations
+ * grows until a run lasts at least the minimum time, and that last run is the one reported.
+ * Usage: binary [filter] [min_time_seconds]. Only the benchmarks whose name contains filter are run.
+ */
+class MicroBenchmark
+{
+public:
+
+	MicroBenchmark(int argc, char** argv): m_minTime(0.5), m_headerPrinted(false)
+	{
+		if(argc > 1)
+			m_filter = argv[1];
+		if(argc > 2)
+			m_minTime = atof(argv[2]);
+	}
+
+	/**
+	 * Run a benchmark.
+	 * @param name Name printed in the results.
+	 * @param body Callable receiving the number of iterations to run.
+	 * @param itemsPerIteration Items processed in each iteration, to print the items per second.
+	 * @return Nanoseconds per iteration, or 0 if the benchmark was filtered out.
+	 */
+	template<class Body>
+	double run(const std::string& name, Body body, uint64_t itemsPerIteration = 1)
+	{
+		if(!m_filter.empty() && name.find(m_filter) == std::string::npos)
+			return 0;
+
+		uint64_t iterations = 1;
+		double elapsed = 0;
+		for(;;)
+		{
+			std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			body(iterations);
+			elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+			if(elapsed >= m_minTime || iterations >= 1000000000ull)
+				break;
+			// Aim a bit over the minimum time, growing at most 10 times per step.
+			double factor = elapsed > 0 ? 1.4 * m_minTime / elapsed : 10;
+			iterations = (uint64_t)(iterations * (factor < 10 ? (factor > 1.1 ? factor : 1.1) : 10)) + 1;
+		}
+
+		if(!m_headerPrinted)
+		{
+			printf("%-40s %14s %12s %16s\n", "Benchmark", "Time", "Iterations", "Items/s");
+			printf("%s\n", std::string(85, '-').c_str());
+			m_headerPrinted = true;
+		}
+		double ns = elapsed * 1e9 / iterations;
+		printf("%-40s %11.1f ns %12llu %14.3fM/s\n", name.c_str(), ns, (unsigned long long)iterations,
+				itemsPerIteration * iterations / elapsed / 1e6);
+		fflush(stdout);
+		return ns;
+	}
+
+private:
+
+	std::string m_filter;
+	double m_minTime;
+	bool m_headerPrinted;
+};
+
+#endif /* MICROBENCHMARK_H_ */
@@ -0,0 +1,156 @@
+// Copyright 2016 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file SendPathBenchmark.cpp
+ *
+ * Micro benchmarks of the construction of the messages sent by a writer, without sending them.
+ */
+
+#include "MicroBenchmark.h"
+
+#include <fastrtps/rtps/messages/CDRMessage.h>
+#include <fastrtps/rtps/messages/RTPSMessageCreator.h>
+#include <fastrtps/rtps/messages/DataSubmessageTemplate.h>
+#include <fastrtps/rtps/common/CacheChange.h>
+
+#include <vector>
+
+using namespace eprosima::fastrtps;
+using namespace eprosima::fastrtps::rtps;
+
+struct SendPathCase
+{
+    const char* name;
+    uint32_t samples;
+    uint32_t payload;
+    TopicKind_t topicKind;
+};
+
+/**
+ * Message built as the writers did before the DATA templates: INFO_TS with the clock read for the
+ * message, and each DATA created in a submessage buffer and then appended.
+ */
+static void buildGeneric(CDRMessage_t& msg, CDRMessage_t& submsg, const CDRMessage_t& header,
+        const GuidPrefix_t& remotePrefix, const EntityId_t& readerId, TopicKind_t topicKind,
+        const std::vector<CacheChange_t*>& changes)
+{
+    CDRMessage::initCDRMsg(&msg);
+    CDRMessage::appendMsg(&msg, const_cast<CDRMessage_t*>(&header));
+    RTPSMessageCreator::addSubmessageInfoDST(&msg, remotePrefix);
+    RTPSMessageCreator::addSubmessageInfoTS_Now(&msg, false);
+    for(size_t i = 0; i < changes.size(); ++i)
+    {
+        CDRMessage::initCDRMsg(&submsg);
+        RTPSMessageCreator::addSubmessageData(&submsg, changes[i], topicKind, readerId, false, nullptr);
+        CDRMessage::appendMsg(&msg, &submsg);
+    }
+}
+
+/**
+ * Message built as the writers do now: INFO_TS with the timestamp of the group and each DATA written
+ * directly in the message from the template of the reader.
+ */
+static void buildTemplate(CDRMessage_t& msg, const CDRMessage_t& header, const GuidPrefix_t& remotePrefix,
+        Time_t& timestamp, const DataSubmessageTemplate_t& dataTemplate, const std::vector<CacheChange_t*>& changes)
+{
+    CDRMessage::initCDRMsg(&msg);
+    CDRMessage::appendMsg(&msg, const_cast<CDRMessage_t*>(&header));
+    RTPSMessageCreator::addSubmessageInfoDST(&msg, remotePrefix);
+    RTPSMessageCreator::addSubmessageInfoTS(&msg, timestamp, false);
+    for(size_t i = 0; i < changes.size(); ++i)
+        RTPSMessageCreator::addSubmessageData(&msg, changes[i], dataTemplate);
+}
+
+int main(int argc, char** argv)
+{
+    MicroBenchmark bench(argc, argv);
+
+    GuidPrefix_t prefix, remotePrefix;
+    for(uint8_t i = 0; i < 12; ++i)
+    {
+        prefix.value[i] = i;
+        remotePrefix.value[i] = (octet)(0x80 + i);
+    }
+    EntityId_t writerId, readerId;
+    writerId.value[2] = 1; writerId.value[3] = 0x03;
+    readerId.value[2] = 1; readerId.value[3] = 0x04;
+
+    CDRMessage_t header(RTPSMESSAGE_HEADER_SIZE);
+    RTPSMessageCreator::addHeader(&header, prefix);
+    CDRMessage_t msg(RTPSMESSAGE_DEFAULT_SIZE);
+    CDRMessage_t submsg(RTPSMESSAGE_DEFAULT_SIZE);
+
+    const SendPathCase cases[] = {
+        {"10x64B/NO_KEY", 10, 64, NO_KEY},
+        {"10x64B/WITH_KEY", 10, 64, WITH_KEY},
+        {"1x1024B/NO_KEY", 1, 1024, NO_KEY},
+    };
+
+    for(size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); ++c)
+    {
+        const SendPathCase& sc = cases[c];
+
+        std::vector<CacheChange_t*> changes;
+        for(uint32_t i = 0; i < sc.samples; ++i)
+        {
+            CacheChange_t* change = new CacheChange_t(sc.payload);
+            change->kind = ALIVE;
+            change->writerGUID = GUID_t(prefix, writerId);
+            change->sequenceNumber = SequenceNumber_t(0, 100 + i);
+            change->serializedPayload.length = sc.payload;
+            memset(change->serializedPayload.data, (int)i, sc.payload);
+            for(uint8_t k = 0; k < 16; ++k)
+                change->instanceHandle.value[k] = (octet)(i + k);
+            changes.push_back(change);
+        }
+
+        DataSubmessageTemplate_t dataTemplate;
+        dataTemplate.init(writerId, readerId, sc.topicKind, false);
+
+        // Both ways must produce the same message, timestamp apart.
+        Time_t timestamp;
+        buildGeneric(msg, submsg, header, remotePrefix, readerId, sc.topicKind, changes);
+        std::vector<octet> generic(msg.buffer, msg.buffer + msg.length);
+        memcpy(&timestamp.seconds, &generic[RTPSMESSAGE_HEADER_SIZE + 16 + 4], 4);
+        memcpy(&timestamp.fraction, &generic[RTPSMESSAGE_HEADER_SIZE + 16 + 8], 4);
+        buildTemplate(msg, header, remotePrefix, timestamp, dataTemplate, changes);
+        if(msg.length != generic.size() || memcmp(msg.buffer, generic.data(), msg.length) != 0)
+        {
+            printf("Messages built from the template differ for %s\n", sc.name);
+            return 1;
+        }
+
+        bench.run(std::string("SendPath_Generic/") + sc.name, [&](uint64_t iterations) {
+            for(uint64_t i = 0; i < iterations; ++i)
+            {
+                buildGeneric(msg, submsg, header, remotePrefix, readerId, sc.topicKind, changes);
+                doNotOptimize(msg.length);
+            }
+        }, sc.samples);
+
+        bench.run(std::string("SendPath_Template/") + sc.name, [&](uint64_t iterations) {
+            for(uint64_t i = 0; i < iterations; ++i)
+            {
+                buildTemplate(msg, header, remotePrefix, timestamp, dataTemplate, changes);
+                doNotOptimize(msg.length);
+            }
+        }, sc.samples);
+
+        for(size_t i = 0; i < changes.size(); ++i)
+            delete changes[i];
+    }
+
+    return 0;
+}
@@ -40,9 +40,12 @@ using namespace eprosima::fastrtps::rtps;
 
 int writecalls= 0;
 
+//! Samples taken from the data subscriber at once.
+static const size_t SAMPLES_PER_TAKE = 32;
+
 
 ThroughputSubscriber::DataSubListener::DataSubListener(ThroughputSubscriber& up):
-    m_up(up),lastseqnum(0),saved_lastseqnum(0),lostsamples(0),saved_lostsamples(0),first(true),throughputin(nullptr)
+    m_up(up),lastseqnum(0),saved_lastseqnum(0),lostsamples(0),saved_lostsamples(0),first(true)
 {
 }
 
@@ -77,26 +80,26 @@ void ThroughputSubscriber::DataSubListener::onSubscriptionMatched(Subscriber* /*
 }
 void ThroughputSubscriber::DataSubListener::onNewDataMessage(Subscriber* subscriber)
 {
-    //	cout << "NEW DATA MSG: "<< throughputin->seqnum << endl;
-    while(subscriber->takeNextData((void*)throughputin, &info))
+    // Samples are taken in blocks, reusing the same objects.
+    size_t taken;
+    while((taken = subscriber->take(throughputin, infos, throughputin.size())) > 0)
     {
-        //myfile << throughputin.seqnum << ",";
-        if(info.sampleKind == ALIVE)
+        for(size_t i = 0; i < taken; ++i)
         {
-            //cout << "R:"<<throughputin->seqnum<<std::flush;
-            if((lastseqnum+1)<throughputin->seqnum)
+            if(infos[i].sampleKind == ALIVE)
             {
-                lostsamples+=throughputin->seqnum-lastseqnum-1;
-                //	myfile << "***** lostsamples: "<< lastseqnum << "|"<< lostsamples<< "*****";
+                if((lastseqnum+1)<throughputin[i].seqnum)
+                {
+                    lostsamples+=throughputin[i].seqnum-lastseqnum-1;
+                }
+                lastseqnum = throughputin[i].seqnum;
+            }
+            else
+            {
+                cout << "NOT ALIVE DATA RECEIVED"<<endl;
             }
-            lastseqnum = throughputin->seqnum;
-        }
-        else
-        {
-            cout << "NOT ALIVE DATA RECEIVED"<<endl;
         }
     }
-    //	cout << ";O|"<<std::flush;
 }
 
 void ThroughputSubscriber::DataSubListener::saveNumbers()
@@ -144,7 +147,7 @@ void ThroughputSubscriber::CommandSubListener::onNewDataMessage(Subscriber* subs
                                       m_up.m_datasize = m_commandin.m_size;
                                       m_up.m_demand = m_commandin.m_demand;
                                       //cout << "Ready to start data size: " << m_datasize << " and demand; "<<m_demand << endl;
-                                      m_up.m_DataSubListener.throughputin = new ThroughputType((uint16_t)m_up.m_datasize);
+                                      m_up.m_DataSubListener.throughputin.assign(SAMPLES_PER_TAKE, ThroughputType((uint16_t)m_up.m_datasize));
                                       ThroughputCommandType command(BEGIN);
                                       eClock::my_sleep(50);
                                       m_up.m_DataSubListener.reset();
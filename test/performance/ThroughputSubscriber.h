@@ -37,6 +37,7 @@ using namespace eprosima::fastrtps;
 
 #include <fstream>
 #include <iostream>
+#include <vector>
 
 using namespace std;
 
@@ -67,8 +68,9 @@ public:
 		uint32_t lastseqnum,saved_lastseqnum;
 		uint32_t lostsamples,saved_lostsamples;
 		bool first;
-		ThroughputType* throughputin;
-		SampleInfo_t info;
+		//!Objects where the samples are taken, one block each time.
+		std::vector<ThroughputType> throughputin;
+		std::vector<SampleInfo_t> infos;
 		void onSubscriptionMatched(Subscriber* sub,MatchingInfo& info);
 		void onNewDataMessage(Subscriber* sub);
 		void saveNumbers();
@@ -0,0 +1,49 @@
+# Copyright 2016 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import shlex, subprocess, time, os, socket, sys
+
+if len(sys.argv) < 2 or len(sys.argv) > 5:
+	print("ERROR: Provide the numbers of participants to test")
+	print("usage: python discovery_tests.py PARTICIPANTS[,PARTICIPANTS...] [ENDPOINTS] [PROCESSES] [LOSS]")
+	quit(-1)
+
+sweep = [int(n) for n in sys.argv[1].split(",")]
+endpoints = sys.argv[2] if len(sys.argv) > 2 else "1"
+processes = int(sys.argv[3]) if len(sys.argv) > 3 else 1
+loss = sys.argv[4] if len(sys.argv) > 4 else "0"
+
+command = os.environ.get("DISCOVERY_TEST_BIN")
+
+result = 0
+
+for total in sweep:
+	# Every run uses its own seed, so the runs do not discover each other.
+	seed = str(os.getpid() + total)
+	# Big tests need more time to discover everything.
+	timeout = str(max(60, total))
+	procs = []
+	for index in range(processes):
+		participants = total // processes + (1 if index < total % processes else 0)
+		if participants == 0:
+			continue
+		procs.append(subprocess.Popen([command, "--participants", str(participants), "--total", str(total),
+			"--endpoints", endpoints, "--loss", loss, "--timeout", timeout, "--seed", seed, "--export_csv"]))
+
+	for proc in procs:
+		proc.communicate()
+		if proc.returncode != 0:
+			result = proc.returncode
+
+quit(result)
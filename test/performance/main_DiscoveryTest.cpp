@@ -0,0 +1,114 @@
+// Copyright 2016 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "DiscoveryTest.h"
+
+#include <iostream>
+#include <string>
+
+#include <fastrtps/Domain.h>
+#include <fastrtps/utils/eClock.h>
+
+#if defined(_MSC_VER)
+#pragma warning (push)
+#pragma warning (disable:4512)
+#endif
+
+#include <boost/program_options.hpp>
+
+using namespace eprosima;
+using namespace std;
+
+int main(int argc, char** argv)
+{
+    const char* const DISCOVERY_TEST_USAGE = "Usage: DiscoveryTest [options]\n";
+
+    boost::program_options::options_description optionals("Allowed options");
+    optionals.add_options()
+        ("help,h", "produce help message")
+        ("participants,n", boost::program_options::value<uint32_t>()->default_value(10), "number of participants created by this process")
+        ("total,t", boost::program_options::value<uint32_t>()->default_value(0), "number of participants of the test in all the processes (0 to use --participants)")
+        ("endpoints,m", boost::program_options::value<uint32_t>()->default_value(1), "number of readers and writers of each participant")
+        ("loss,l", boost::program_options::value<uint32_t>()->default_value(0), "percentage of packets dropped by the transport")
+        ("timeout", boost::program_options::value<uint32_t>()->default_value(60), "seconds to wait for the full match")
+        ("seed", boost::program_options::value<uint32_t>()->default_value(80), "seed to calculate domain and topics, to isolate test")
+        ("shared_event_thread", "run the timed events of all the participants in one thread")
+        ("export_csv", "append the results to perf_DiscoveryTest.csv")
+        ;
+
+    boost::program_options::variables_map vm;
+    try
+    {
+        boost::program_options::store(boost::program_options::parse_command_line(argc, argv, optionals), vm);
+        boost::program_options::notify(vm);
+    }
+    catch (std::exception& ex)
+    {
+        cout << "Error: " << ex.what() << std::endl;
+        cout << DISCOVERY_TEST_USAGE << optionals << endl;
+        return -1;
+    }
+
+    if (vm.count("help"))
+    {
+        cout << DISCOVERY_TEST_USAGE << optionals << endl;
+        return 0;
+    }
+
+    uint32_t participants = vm["participants"].as<uint32_t>();
+    uint32_t total = vm["total"].as<uint32_t>();
+    uint32_t endpoints = vm["endpoints"].as<uint32_t>();
+    uint32_t loss = vm["loss"].as<uint32_t>();
+
+    if (total == 0)
+        total = participants;
+
+    if (participants == 0 || endpoints == 0 || participants > total || loss > 100)
+    {
+        cout << "Bad arguments: at least one participant and one endpoint, no more participants than --total "
+            "and a loss percentage up to 100 are needed." << endl;
+        cout << DISCOVERY_TEST_USAGE << optionals << endl;
+        return -1;
+    }
+
+    cout << "Performing test with " << participants << " of " << total << " participants and " << endpoints <<
+        " readers and writers each" << endl;
+
+    int result = 0;
+    {
+        DiscoveryTest discoveryTest;
+        if (discoveryTest.init(total, participants, endpoints, loss, vm["timeout"].as<uint32_t>(),
+                    vm["seed"].as<uint32_t>(), vm.count("shared_event_thread") > 0, vm.count("export_csv") > 0))
+        {
+            discoveryTest.run();
+            if (!discoveryTest.m_results.matched)
+                result = 1;
+        }
+        else
+        {
+            cout << "Error creating the participants" << endl;
+            result = -1;
+        }
+    }
+
+    Domain::stopAll();
+
+    cout << "EVERYTHING STOPPED FINE" << endl;
+
+    return result;
+}
+
+#if defined(_MSC_VER)
+#pragma warning (pop)
+#endif
@@ -167,6 +167,12 @@ class PubSubReader
             return total_msgs_;
         }
 
+        size_t getReceivedCount()
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            return current_received_count_;
+        }
+
         void waitDiscovery()
         {
             std::cout << "Reader waiting for discovery..." << std::endl;
@@ -194,6 +200,12 @@ class PubSubReader
             return *this;
         }
 
+        PubSubReader& topic_kind(const eprosima::fastrtps::rtps::TopicKind_t kind)
+        {
+            subscriber_attr_.topic.topicKind = kind;
+            return *this;
+        }
+
         PubSubReader& history_kind(const eprosima::fastrtps::HistoryQosPolicyKind kind)
         {
             subscriber_attr_.topic.historyQos.kind = kind;
@@ -212,6 +224,18 @@ class PubSubReader
             return *this;
         }
 
+        PubSubReader& resource_limits_max_instances(const int32_t max)
+        {
+            subscriber_attr_.topic.resourceLimitsQos.max_instances = max;
+            return *this;
+        }
+
+        PubSubReader& resource_limits_max_samples_per_instance(const int32_t max)
+        {
+            subscriber_attr_.topic.resourceLimitsQos.max_samples_per_instance = max;
+            return *this;
+        }
+
     private:
 
         void receive_one(eprosima::fastrtps::Subscriber* subscriber, bool& returnedValue)
@@ -221,7 +245,8 @@ class PubSubReader
 
             if(receiving_)
             {
-                type data;
+                // The sample is reused between calls so reception does not allocate on its own.
+                type& data = data_;
                 eprosima::fastrtps::SampleInfo_t info;
 
                 if(subscriber->takeNextData((void*)&data, &info))
@@ -234,10 +259,14 @@ class PubSubReader
 
                     if(info.sampleKind == ALIVE)
                     {
-                        auto it = std::find(total_msgs_.begin(), total_msgs_.end(), data) ;
-                        if (it == total_msgs_.end())
-                           return;
-                        total_msgs_.erase(it);
+                        // Without expected data, samples are only counted.
+                        if(!total_msgs_.empty())
+                        {
+                            auto it = std::find(total_msgs_.begin(), total_msgs_.end(), data) ;
+                            if (it == total_msgs_.end())
+                                return;
+                            total_msgs_.erase(it);
+                        }
                         ++current_received_count_;
 
                         if(current_received_count_ == number_samples_expected_)
@@ -276,6 +305,7 @@ class PubSubReader
         unsigned int matched_;
         bool receiving_;
         type_support type_;
+        type data_;
         SequenceNumber_t last_seq;
         size_t current_received_count_;
         size_t number_samples_expected_;
@@ -85,9 +85,8 @@ class PubSubWriter
     void init()
     {
         //Create participant
-        eprosima::fastrtps::ParticipantAttributes pattr;
-        pattr.rtps.builtin.domainId = (uint32_t)boost::interprocess::ipcdetail::get_current_process_id() % 230;
-        participant_ = eprosima::fastrtps::Domain::createParticipant(pattr);
+        participant_attr_.rtps.builtin.domainId = (uint32_t)boost::interprocess::ipcdetail::get_current_process_id() % 230;
+        participant_ = eprosima::fastrtps::Domain::createParticipant(participant_attr_);
 
         if(participant_ != nullptr)
         {
@@ -164,12 +163,26 @@ class PubSubWriter
         return *this;
     }
 
+    PubSubWriter& add_throughput_controller_descriptor_to_pparams(uint32_t bytesPerPeriod, uint32_t periodInMs)
+    {
+        ThroughputControllerDescriptor descriptor {bytesPerPeriod, periodInMs};
+        participant_attr_.rtps.throughputController = descriptor;
+
+        return *this;
+    }
+
     PubSubWriter& asynchronously(const eprosima::fastrtps::PublishModeQosPolicyKind kind)
     {
         publisher_attr_.qos.m_publishMode.kind = kind;
         return *this;
     }
 
+    PubSubWriter& topic_kind(const eprosima::fastrtps::rtps::TopicKind_t kind)
+    {
+        publisher_attr_.topic.topicKind = kind;
+        return *this;
+    }
+
     PubSubWriter& history_kind(const eprosima::fastrtps::HistoryQosPolicyKind kind)
     {
         publisher_attr_.topic.historyQos.kind = kind;
@@ -194,6 +207,18 @@ class PubSubWriter
         return *this;
     }
 
+    PubSubWriter& resource_limits_max_instances(const int32_t max)
+    {
+        publisher_attr_.topic.resourceLimitsQos.max_instances = max;
+        return *this;
+    }
+
+    PubSubWriter& resource_limits_max_samples_per_instance(const int32_t max)
+    {
+        publisher_attr_.topic.resourceLimitsQos.max_samples_per_instance = max;
+        return *this;
+    }
+
     PubSubWriter& heartbeat_period_seconds(int32_t sec)
     {
         publisher_attr_.times.heartbeatPeriod.seconds = sec;
@@ -225,6 +250,7 @@ class PubSubWriter
     PubSubWriter& operator=(const PubSubWriter&)NON_COPYABLE_CXX11;
 
     eprosima::fastrtps::Participant *participant_;
+    eprosima::fastrtps::ParticipantAttributes participant_attr_;
     eprosima::fastrtps::PublisherAttributes publisher_attr_;
     eprosima::fastrtps::Publisher *publisher_;
     std::string topic_name_;
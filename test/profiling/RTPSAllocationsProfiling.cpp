@@ -0,0 +1,336 @@
+// Copyright 2016 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file RTPSAllocationsProfiling.cpp
+ *
+ * Counts heap allocations per sample on a steady-state publish/subscribe loop
+ * and fails when a scenario does not deliver its samples or exceeds its declared budget.
+ */
+
+#include "PubSubReader.hpp"
+#include "PubSubWriter.hpp"
+#include <fastrtps/rtps/RTPSDomain.h>
+#include <fastrtps/log/Log.h>
+#include "types/HelloWorldType.h"
+#include "types/KeyedHelloWorldType.h"
+#include "types/Data1mbType.h"
+
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <sstream>
+#include <iomanip>
+#include <fstream>
+
+/***** Allocation counters *****/
+
+namespace
+{
+    std::atomic<bool> g_counting(false);
+    std::atomic<size_t> g_allocations(0);
+    std::atomic<size_t> g_allocated_bytes(0);
+
+    inline void count_allocation(size_t size)
+    {
+        if(g_counting.load(std::memory_order_relaxed))
+        {
+            g_allocations.fetch_add(1, std::memory_order_relaxed);
+            g_allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+        }
+    }
+}
+
+#if defined(__GLIBC__)
+// Interpose the C allocator so allocations made by the library through malloc are also counted.
+extern "C"
+{
+    void* __libc_malloc(size_t size);
+    void* __libc_calloc(size_t nmemb, size_t size);
+    void* __libc_realloc(void* ptr, size_t size);
+
+    void* malloc(size_t size)
+    {
+        count_allocation(size);
+        return __libc_malloc(size);
+    }
+
+    void* calloc(size_t nmemb, size_t size)
+    {
+        count_allocation(nmemb * size);
+        return __libc_calloc(nmemb, size);
+    }
+
+    void* realloc(void* ptr, size_t size)
+    {
+        count_allocation(size);
+        return __libc_realloc(ptr, size);
+    }
+}
+#define PROFILING_RAW_MALLOC __libc_malloc
+#else
+#define PROFILING_RAW_MALLOC std::malloc
+#endif
+
+void* operator new(size_t size)
+{
+    count_allocation(size);
+    void* ptr = PROFILING_RAW_MALLOC(size != 0 ? size : 1);
+    if(ptr == nullptr)
+        throw std::bad_alloc();
+    return ptr;
+}
+
+void* operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+    count_allocation(size);
+    return PROFILING_RAW_MALLOC(size != 0 ? size : 1);
+}
+
+void* operator new[](size_t size, const std::nothrow_t& tag) noexcept
+{
+    return operator new(size, tag);
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept
+{
+    std::free(ptr);
+}
+
+/***** Data generators *****/
+
+std::list<HelloWorld> helloworld_data_generator(size_t maximum)
+{
+    uint16_t index = 1;
+    std::list<HelloWorld> returnedValue(maximum);
+
+    std::generate(returnedValue.begin(), returnedValue.end(), [&index] {
+            HelloWorld hello;
+            hello.index(index);
+            std::stringstream ss;
+            // Short enough to stay in the string's inline storage on reception.
+            ss << "Hello " << index;
+            hello.message(ss.str());
+            ++index;
+            return hello;
+            });
+
+    return returnedValue;
+}
+
+//! Keys used by the keyed scenarios. The endpoints allow this many instances.
+const int32_t keyed_instances = 16;
+
+std::list<KeyedHelloWorld> keyedhelloworld_data_generator(size_t maximum)
+{
+    uint16_t index = 1;
+    std::list<KeyedHelloWorld> returnedValue(maximum);
+
+    std::generate(returnedValue.begin(), returnedValue.end(), [&index] {
+            KeyedHelloWorld hello;
+            hello.key(index % keyed_instances);
+            hello.index(index);
+            std::stringstream ss;
+            ss << "Hello " << index;
+            hello.message(ss.str());
+            ++index;
+            return hello;
+            });
+
+    return returnedValue;
+}
+
+const size_t data300kb_length = 307201;
+std::list<Data1mb> data300kb_data_generator(size_t maximum)
+{
+    unsigned char index = 1;
+    std::list<Data1mb> returnedValue(maximum);
+
+    std::generate(returnedValue.begin(), returnedValue.end(), [&index] {
+            Data1mb data;
+            data.data().resize(data300kb_length);
+            data.data()[0] = index;
+            for(size_t i = 1; i < data300kb_length; ++i)
+            data.data()[i] = static_cast<unsigned char>(i + data.data()[0]);
+            ++index;
+            return data;
+            });
+
+    return returnedValue;
+}
+
+/***** Scenarios *****/
+
+struct AllocationScenario
+{
+    //! Name printed in the report.
+    const char* name;
+    //! Reliability used by both endpoints.
+    eprosima::fastrtps::ReliabilityQosPolicyKind reliability;
+    //! Samples sent before counting starts, so pools and histories reach their steady size.
+    size_t warmup_samples;
+    //! Samples sent while counting.
+    size_t measured_samples;
+    //! Maximum number of allocations per measured sample.
+    double budget;
+    //! Minimum ratio of the measured samples that must be received. Fewer allocations mean nothing otherwise.
+    double min_delivery;
+};
+
+struct AllocationResult
+{
+    size_t samples;
+    size_t received;
+    size_t allocations;
+    size_t allocated_bytes;
+};
+
+template<class TypeSupport>
+bool run_scenario(const AllocationScenario& scenario, eprosima::fastrtps::rtps::TopicKind_t topic_kind,
+        bool fragmented, std::list<typename TypeSupport::type> (*generator)(size_t),
+        std::ofstream& csv)
+{
+    PubSubReader<TypeSupport> reader(scenario.name);
+    PubSubWriter<TypeSupport> writer(scenario.name);
+
+    reader.reliability(scenario.reliability).topic_kind(topic_kind).
+        history_depth(10).resource_limits_max_instances(keyed_instances).init();
+
+    writer.reliability(scenario.reliability).topic_kind(topic_kind).
+        history_depth(10).resource_limits_max_instances(keyed_instances);
+
+    if(fragmented)
+    {
+        // Fragmentation needs the asynchronous writer and some flow control not to overrun the receive buffer.
+        // Its history keeps every sample written at once, so none is replaced before being sent.
+        writer.asynchronously(eprosima::fastrtps::ASYNCHRONOUS_PUBLISH_MODE).
+            add_throughput_controller_descriptor_to_pparams(65536, 10).
+            history_depth(static_cast<int32_t>(scenario.measured_samples));
+    }
+
+    writer.init();
+
+    if(!reader.isInitialized() || !writer.isInitialized())
+    {
+        std::cout << scenario.name << ": endpoints could not be created" << std::endl;
+        return false;
+    }
+
+    // Wait for discovery.
+    writer.waitDiscovery();
+    reader.waitDiscovery();
+
+    // Warm up.
+    auto data = generator(scenario.warmup_samples);
+    reader.startReception(scenario.warmup_samples);
+    writer.send(data);
+    reader.block(std::chrono::seconds(10));
+    reader.stopReception();
+    if(scenario.reliability == eprosima::fastrtps::RELIABLE_RELIABILITY_QOS)
+        writer.waitForAllAcked(std::chrono::seconds(10));
+
+    // Measure. Data is generated before counting starts.
+    data = generator(scenario.measured_samples);
+    reader.startReception(scenario.measured_samples);
+
+    g_allocations = 0;
+    g_allocated_bytes = 0;
+    g_counting = true;
+
+    writer.send(data);
+    reader.block(std::chrono::seconds(10));
+    if(scenario.reliability == eprosima::fastrtps::RELIABLE_RELIABILITY_QOS)
+        writer.waitForAllAcked(std::chrono::seconds(10));
+
+    g_counting = false;
+    reader.stopReception();
+
+    AllocationResult result;
+    result.samples = scenario.measured_samples - data.size();
+    result.received = reader.getReceivedCount();
+    result.allocations = g_allocations;
+    result.allocated_bytes = g_allocated_bytes;
+
+    double per_sample = result.samples != 0 ? static_cast<double>(result.allocations) / result.samples : 0;
+    double bytes_per_sample = result.samples != 0 ? static_cast<double>(result.allocated_bytes) / result.samples : 0;
+    bool delivered = result.samples == scenario.measured_samples &&
+        result.received >= static_cast<size_t>(std::ceil(scenario.min_delivery * result.samples));
+    bool within_budget = per_sample <= scenario.budget;
+
+    std::cout << std::left << std::setw(32) << scenario.name <<
+        " sent " << std::setw(6) << result.samples <<
+        " received " << std::setw(6) << result.received <<
+        " allocs/sample " << std::setw(10) << std::fixed << std::setprecision(2) << per_sample <<
+        " bytes/sample " << std::setw(12) << bytes_per_sample <<
+        " budget " << scenario.budget <<
+        (!delivered ? "  NOT DELIVERED" : (within_budget ? "  OK" : "  EXCEEDED")) << std::endl;
+
+    csv << scenario.name << "," << result.samples << "," << result.received << "," <<
+        result.allocations << "," << result.allocated_bytes << "," << per_sample << "," <<
+        scenario.budget << std::endl;
+
+    return delivered && within_budget;
+}
+
+int main(void)
+{
+    using namespace eprosima::fastrtps;
+
+    // Budgets are ceilings on the steady state. Lower them when the hot path stops allocating.
+    // Reliable scenarios must deliver every sample; best effort ones may lose a few on a loaded host.
+    const AllocationScenario best_effort_small {"BestEffortSmall", BEST_EFFORT_RELIABILITY_QOS, 500, 2000, 32, 0.95};
+    const AllocationScenario reliable_small {"ReliableSmall", RELIABLE_RELIABILITY_QOS, 500, 2000, 48, 1.0};
+    const AllocationScenario best_effort_keyed {"BestEffortKeyedSmall", BEST_EFFORT_RELIABILITY_QOS, 500, 2000, 40, 0.95};
+    const AllocationScenario reliable_keyed {"ReliableKeyedSmall", RELIABLE_RELIABILITY_QOS, 500, 2000, 56, 1.0};
+    const AllocationScenario best_effort_frag {"BestEffortFragmented300kb", BEST_EFFORT_RELIABILITY_QOS, 5, 20, 256, 0.95};
+    const AllocationScenario reliable_frag {"ReliableFragmented300kb", RELIABLE_RELIABILITY_QOS, 5, 20, 384, 1.0};
+
+    std::ofstream csv("results_RTPSAllocationsProfiling.csv");
+    csv << "Scenario,Samples,Received,Allocations,AllocatedBytes,AllocationsPerSample,Budget" << std::endl;
+
+    bool passed = true;
+
+    passed &= run_scenario<HelloWorldType>(best_effort_small, rtps::NO_KEY, false, helloworld_data_generator, csv);
+    passed &= run_scenario<HelloWorldType>(reliable_small, rtps::NO_KEY, false, helloworld_data_generator, csv);
+    passed &= run_scenario<KeyedHelloWorldType>(best_effort_keyed, rtps::WITH_KEY, false, keyedhelloworld_data_generator, csv);
+    passed &= run_scenario<KeyedHelloWorldType>(reliable_keyed, rtps::WITH_KEY, false, keyedhelloworld_data_generator, csv);
+    passed &= run_scenario<Data1mbType>(best_effort_frag, rtps::NO_KEY, true, data300kb_data_generator, csv);
+    passed &= run_scenario<Data1mbType>(reliable_frag, rtps::NO_KEY, true, data300kb_data_generator, csv);
+
+    Log::Reset();
+
+    return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,145 @@
+// Copyright 2016 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file RTPSKeyedHistoryProfiling.cpp
+ *
+ * Measures the cost of writing and receiving keyed samples while the number of
+ * live instances grows.
+ */
+
+#include "PubSubReader.hpp"
+#include "PubSubWriter.hpp"
+#include <fastrtps/log/Log.h>
+#include "types/KeyedHelloWorldType.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <string>
+#include <sstream>
+#include <iomanip>
+#include <fstream>
+#include <vector>
+
+std::list<KeyedHelloWorld> keyedhelloworld_data_generator(size_t maximum, size_t instances)
+{
+    size_t index = 0;
+    std::list<KeyedHelloWorld> returnedValue(maximum);
+
+    std::generate(returnedValue.begin(), returnedValue.end(), [&index, instances] {
+            KeyedHelloWorld hello;
+            hello.key(static_cast<uint16_t>(index % instances));
+            hello.index(static_cast<uint16_t>(index));
+            hello.message("Hello");
+            ++index;
+            return hello;
+            });
+
+    return returnedValue;
+}
+
+bool run_instances(size_t instances, size_t samples, std::ofstream& csv)
+{
+    std::ostringstream topic;
+    topic << "KeyedHistory" << instances;
+
+    PubSubReader<KeyedHelloWorldType> reader(topic.str());
+    PubSubWriter<KeyedHelloWorldType> writer(topic.str());
+
+    // Depth 1 keeps the last value of every instance, as a "latest state" topic does.
+    // One extra sample lets a new change be reserved before the oldest one is replaced.
+    reader.reliability(eprosima::fastrtps::BEST_EFFORT_RELIABILITY_QOS).
+        topic_kind(eprosima::fastrtps::rtps::WITH_KEY).history_depth(1).
+        resource_limits_max_instances(static_cast<int32_t>(instances)).
+        resource_limits_max_samples_per_instance(1).
+        resource_limits_max_samples(static_cast<int32_t>(instances) + 1).init();
+
+    writer.reliability(eprosima::fastrtps::BEST_EFFORT_RELIABILITY_QOS).
+        topic_kind(eprosima::fastrtps::rtps::WITH_KEY).history_depth(1).
+        resource_limits_max_instances(static_cast<int32_t>(instances)).
+        resource_limits_max_samples_per_instance(1).
+        resource_limits_max_samples(static_cast<int32_t>(instances) + 1).init();
+
+    if(!reader.isInitialized() || !writer.isInitialized())
+    {
+        std::cout << instances << " instances: endpoints could not be created" << std::endl;
+        return false;
+    }
+
+    writer.waitDiscovery();
+    reader.waitDiscovery();
+
+    auto data = keyedhelloworld_data_generator(samples, instances);
+    reader.startReception(samples);
+
+    auto start = std::chrono::steady_clock::now();
+    writer.send(data);
+    auto written = std::chrono::steady_clock::now();
+    reader.block(std::chrono::seconds(10));
+    auto end = std::chrono::steady_clock::now();
+
+    reader.stopReception();
+
+    size_t sent = samples - data.size();
+    size_t received = reader.getReceivedCount();
+    double write_us = sent != 0 ?
+        std::chrono::duration<double, std::micro>(written - start).count() / sent : 0;
+    double total_us = received != 0 ?
+        std::chrono::duration<double, std::micro>(end - start).count() / received : 0;
+
+    std::cout << std::left << std::setw(10) << instances <<
+        " sent " << std::setw(8) << sent <<
+        " received " << std::setw(8) << received <<
+        " write us/sample " << std::setw(10) << std::fixed << std::setprecision(3) << write_us <<
+        " delivery us/sample " << total_us << std::endl;
+
+    csv << instances << "," << sent << "," << received << "," << write_us << "," << total_us << std::endl;
+
+    return sent == samples;
+}
+
+int main(int argc, char** argv)
+{
+    std::vector<size_t> instance_counts = {1, 10, 100, 1000, 10000, 50000};
+
+    // A custom sweep can be given as arguments.
+    if(argc > 1)
+    {
+        instance_counts.clear();
+        for(int arg = 1; arg < argc; ++arg)
+            instance_counts.push_back(std::strtoul(argv[arg], nullptr, 10));
+    }
+
+    std::ofstream csv("results_RTPSKeyedHistoryProfiling.csv");
+    csv << "Instances,Sent,Received,WriteMicrosecondsPerSample,DeliveryMicrosecondsPerSample" << std::endl;
+
+    bool passed = true;
+
+    for(size_t instances : instance_counts)
+    {
+        if(instances == 0 || instances > 65536)
+        {
+            std::cout << "Skipping " << instances << " instances: the key is an unsigned short" << std::endl;
+            continue;
+        }
+
+        // Every instance is updated several times, so the sweep exercises lookups of existing instances.
+        size_t samples = instances * 4 > 20000 ? instances * 4 : 20000;
+        passed &= run_instances(instances, samples, csv);
+    }
+
+    eprosima::fastrtps::Log::Reset();
+
+    return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
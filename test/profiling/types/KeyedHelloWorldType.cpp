@@ -0,0 +1,114 @@
+// Copyright 2016 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file KeyedHelloWorldType.cpp
+ *
+ */
+
+#include "fastcdr/FastBuffer.h"
+#include "fastcdr/Cdr.h"
+
+#include "KeyedHelloWorldType.h"
+
+KeyedHelloWorldType::KeyedHelloWorldType() {
+	setName("KeyedHelloWorldType");
+	m_typeSize = (uint32_t)KeyedHelloWorld::getMaxCdrSerializedSize();
+	m_isGetKeyDefined = KeyedHelloWorld::isKeyDefined();
+	m_keyBuffer = (unsigned char*)malloc(KeyedHelloWorld::getKeyMaxCdrSerializedSize()>16 ? KeyedHelloWorld::getKeyMaxCdrSerializedSize() : 16);
+}
+
+KeyedHelloWorldType::~KeyedHelloWorldType() {
+	if(m_keyBuffer!=nullptr)
+		free(m_keyBuffer);
+}
+
+bool KeyedHelloWorldType::serialize(void* data, SerializedPayload_t* payload)
+{
+	KeyedHelloWorld* hw = (KeyedHelloWorld*) data;
+	// Object that manages the raw buffer.
+	eprosima::fastcdr::FastBuffer fastbuffer((char*)payload->data, payload->max_size);
+	// Object that serializes the data.
+	eprosima::fastcdr::Cdr ser(fastbuffer);
+	payload->encapsulation = ser.endianness() == eprosima::fastcdr::Cdr::BIG_ENDIANNESS ? CDR_BE : CDR_LE;
+	//serialize the object:
+	hw->serialize(ser);
+	payload->length = (uint32_t)ser.getSerializedDataLength();
+	return true;
+}
+
+bool KeyedHelloWorldType::deserialize(SerializedPayload_t* payload, void* data)
+{
+	KeyedHelloWorld* hw = (KeyedHelloWorld*) data;
+	// Object that manages the raw buffer.
+	eprosima::fastcdr::FastBuffer fastbuffer((char*)payload->data, payload->length);
+	// Object that serializes the data.
+	eprosima::fastcdr::Cdr deser(fastbuffer, payload->encapsulation == CDR_BE ? eprosima::fastcdr::Cdr::BIG_ENDIANNESS : eprosima::fastcdr::Cdr::LITTLE_ENDIANNESS); 	// Object that deserializes the data.
+	//serialize the object:
+	hw->deserialize(deser);
+	return true;
+}
+
+std::function<uint32_t()> KeyedHelloWorldType::getSerializedSizeProvider(void *data)
+{
+    return [data]() -> uint32_t { return (uint32_t)type::getCdrSerializedSize(*static_cast<KeyedHelloWorld*>(data)); };
+}
+
+void* KeyedHelloWorldType::createData()
+{
+	return (void*)new KeyedHelloWorld();
+}
+void KeyedHelloWorldType::deleteData(void* data)
+{
+	delete((KeyedHelloWorld*)data);
+}
+
+bool KeyedHelloWorldType::getKey(void* data, InstanceHandle_t* handle)
+{
+	if(!m_isGetKeyDefined)
+		return false;
+	KeyedHelloWorld* p_type = (KeyedHelloWorld*) data;
+	memset(m_keyBuffer, 0, 16);	// Short keys are padded with zeros.
+	eprosima::fastcdr::FastBuffer fastbuffer((char*)m_keyBuffer,KeyedHelloWorld::getKeyMaxCdrSerializedSize()); 	// Object that manages the raw buffer.
+	eprosima::fastcdr::Cdr ser(fastbuffer, eprosima::fastcdr::Cdr::BIG_ENDIANNESS); 	// Object that serializes the data.
+	p_type->serializeKey(ser);
+	if(KeyedHelloWorld::getKeyMaxCdrSerializedSize()>16)	{
+		m_md5.init();
+		m_md5.update(m_keyBuffer,(unsigned int)ser.getSerializedDataLength());
+		m_md5.finalize();
+		for(uint8_t i = 0;i<16;++i)    	{
+        	handle->value[i] = m_md5.digest[i];
+    	}
+    }
+    else    {
+    	for(uint8_t i = 0;i<16;++i)    	{
+        	handle->value[i] = m_keyBuffer[i];
+    	}
+    }
+	return true;
+}
+
+bool KeyedHelloWorldType::getKeyFromPayload(SerializedPayload_t* payload, InstanceHandle_t* handle)
+{
+	if(!m_isGetKeyDefined)
+		return false;
+	KeyedHelloWorld key_object;
+	// Object that manages the raw buffer.
+	eprosima::fastcdr::FastBuffer fastbuffer((char*)payload->data, payload->length);
+	// Object that deserializes the data.
+	eprosima::fastcdr::Cdr deser(fastbuffer, payload->encapsulation == CDR_BE ? eprosima::fastcdr::Cdr::BIG_ENDIANNESS : eprosima::fastcdr::Cdr::LITTLE_ENDIANNESS);
+	// Only the members up to the last key member are read.
+	key_object.deserializeKey(deser);
+	return getKey(&key_object, handle);
+}
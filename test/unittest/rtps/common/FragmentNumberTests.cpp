@@ -0,0 +1,114 @@
+// Copyright 2016 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fastrtps/rtps/common/FragmentNumber.h>
+#include <fastrtps/rtps/messages/CDRMessage.h>
+
+#include <vector>
+#include <gtest/gtest.h>
+
+using namespace eprosima::fastrtps::rtps;
+
+static std::vector<FragmentNumber_t> to_vector(const FragmentNumberSet_t& set)
+{
+    return std::vector<FragmentNumber_t>(set.get_begin(), set.get_end());
+}
+
+/*!
+ * @fn TEST(FragmentNumberSet, AddRange)
+ * @brief This test checks the addition of ranges, also when they do not fit in the set.
+ */
+TEST(FragmentNumberSet, AddRange)
+{
+    FragmentNumberSet_t set;
+
+    ASSERT_TRUE(set.addRange(1, 40));
+    ASSERT_EQ(set.get_size(), 40u);
+    ASSERT_EQ(*set.get_begin(), 1u);
+    ASSERT_EQ(set.get_maxFragNum(), 40u);
+    ASSERT_FALSE(set.contains(0));
+
+    // Only the part up to base + 255 is added.
+    ASSERT_FALSE(set.addRange(200, 1000));
+    ASSERT_EQ(set.get_size(), 40u + 56u);
+    ASSERT_EQ(set.get_maxFragNum(), 255u);
+
+    set.base = 300;
+    set.get_bitmap().clear();
+    ASSERT_FALSE(set.addRange(290, 301));
+    std::vector<FragmentNumber_t> expected = {300, 301};
+    ASSERT_EQ(to_vector(set), expected);
+}
+
+/*!
+ * @fn TEST(FragmentNumberSet, UnionAndDifference)
+ * @brief This test checks the union and difference of sets with the same and with different bases.
+ */
+TEST(FragmentNumberSet, UnionAndDifference)
+{
+    FragmentNumberSet_t unsent;
+    unsent.addRange(1, 100);
+
+    FragmentNumberSet_t sent;
+    sent.addRange(1, 60);
+    unsent -= sent;
+    ASSERT_EQ(unsent.get_size(), 40u);
+    ASSERT_EQ(*unsent.get_begin(), 61u);
+
+    // A NACK_FRAG uses the first missing fragment as base.
+    FragmentNumberSet_t requested;
+    requested.base = 10;
+    requested.add(10);
+    requested.add(12);
+    unsent += requested;
+    ASSERT_EQ(unsent.get_size(), 42u);
+    ASSERT_TRUE(unsent.contains(12));
+    ASSERT_FALSE(unsent.contains(11));
+
+    FragmentNumberSet_t rest = unsent - requested;
+    ASSERT_EQ(rest.get_size(), 40u);
+    ASSERT_TRUE(rest + requested == unsent);
+}
+
+/*!
+ * @fn TEST(FragmentNumberSet, Serialization)
+ * @brief This test checks a set is written with the bitmap of the RTPS specification and read back.
+ */
+TEST(FragmentNumberSet, Serialization)
+{
+    FragmentNumberSet_t set;
+    set.base = 5;
+    set.addRange(5, 260);
+
+    CDRMessage_t msg;
+    ASSERT_TRUE(CDRMessage::addFragmentNumberSet(&msg, &set));
+    // Base, numBits and eight words.
+    ASSERT_EQ(msg.length, 4u + 4u + 32u);
+
+    msg.pos = 0;
+    FragmentNumberSet_t read;
+    ASSERT_TRUE(CDRMessage::readFragmentNumberSet(&msg, &read));
+    ASSERT_TRUE(read == set);
+    ASSERT_EQ(read.get_size(), 256u);
+
+    // A set with base 0 cannot be sent.
+    FragmentNumberSet_t invalid;
+    ASSERT_FALSE(CDRMessage::addFragmentNumberSet(&msg, &invalid));
+}
+
+int main(int argc, char **argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <fastrtps/rtps/common/SequenceNumber.h>
+#include <fastrtps/rtps/messages/CDRMessage.h>
 
 #include <climits>
 #include <gtest/gtest.h>
@@ -493,6 +494,114 @@ TEST(SequenceNumberSet, GetMaxSeqNumOperation)
     ASSERT_EQ(set.get_maxSeqNum(), expected_seq);
 }
 
+/*!
+ * @fn TEST(SequenceNumberSet, IterationOrder)
+ * @brief This test checks the set is iterated in increasing order, whatever the order of insertion.
+ */
+TEST(SequenceNumberSet, IterationOrder)
+{
+    SequenceNumberSet_t set;
+
+    set.base = SequenceNumber_t(3, UINT32_MAX - 40);
+
+    ASSERT_TRUE(set.isSetEmpty());
+    ASSERT_TRUE(set.get_begin() == set.get_end());
+
+    ASSERT_TRUE(set.add(set.base + 255));
+    ASSERT_TRUE(set.add(set.base + 64));
+    ASSERT_TRUE(set.add(set.base));
+    ASSERT_TRUE(set.add(set.base + 31));
+    ASSERT_TRUE(set.add(set.base + 64));
+    ASSERT_FALSE(set.add(set.base + 256));
+    ASSERT_FALSE(set.add(set.base - 1));
+
+    ASSERT_EQ(set.get_size(), 4u);
+    ASSERT_TRUE(set.contains(set.base + 31));
+    ASSERT_FALSE(set.contains(set.base + 32));
+
+    std::vector<SequenceNumber_t> expected = {set.base, set.base + 31, set.base + 64, set.base + 255};
+    ASSERT_EQ(set.get_set(), expected);
+    ASSERT_EQ(set.get_maxSeqNum(), set.base + 255);
+
+    set.remove(set.base + 255);
+    ASSERT_EQ(set.get_maxSeqNum(), set.base + 64);
+}
+
+/*!
+ * @fn TEST(SequenceNumberSet, UnionAndDifference)
+ * @brief This test checks the union and difference of sets with the same and with different bases.
+ */
+TEST(SequenceNumberSet, UnionAndDifference)
+{
+    SequenceNumberSet_t set1, set2, set3;
+
+    set1.base = SequenceNumber_t(0, 100);
+    set2.base = SequenceNumber_t(0, 100);
+    set3.base = SequenceNumber_t(0, 200);
+
+    set1.add(SequenceNumber_t(0, 100));
+    set1.add(SequenceNumber_t(0, 210));
+    set2.add(SequenceNumber_t(0, 150));
+    set2.add(SequenceNumber_t(0, 210));
+    set3.add(SequenceNumber_t(0, 300));
+    set3.add(SequenceNumber_t(0, 400));
+
+    set1 += set2;
+    std::vector<SequenceNumber_t> expected = {SequenceNumber_t(0, 100), SequenceNumber_t(0, 150),
+        SequenceNumber_t(0, 210)};
+    ASSERT_EQ(set1.get_set(), expected);
+
+    // 400 is out of the range of set1.
+    set1 += set3;
+    expected.push_back(SequenceNumber_t(0, 300));
+    ASSERT_EQ(set1.get_set(), expected);
+
+    set1 -= set2;
+    set1 -= set3;
+    expected = {SequenceNumber_t(0, 100)};
+    ASSERT_EQ(set1.get_set(), expected);
+}
+
+/*!
+ * @fn TEST(SequenceNumberSet, Serialization)
+ * @brief This test checks a set is written with the bitmap of the RTPS specification and read back.
+ */
+TEST(SequenceNumberSet, Serialization)
+{
+    SequenceNumberSet_t set;
+    set.base = SequenceNumber_t(1, 10);
+    set.add(SequenceNumber_t(1, 10));
+    set.add(SequenceNumber_t(1, 43));
+
+    CDRMessage_t msg;
+    ASSERT_TRUE(CDRMessage::addSequenceNumberSet(&msg, &set));
+    // Base, numBits and two words.
+    ASSERT_EQ(msg.length, 8u + 4u + 8u);
+
+    msg.pos = 8;
+    uint32_t numBits, word;
+    CDRMessage::readUInt32(&msg, &numBits);
+    ASSERT_EQ(numBits, 34u);
+    CDRMessage::readUInt32(&msg, &word);
+    ASSERT_EQ(word, 0x80000000u);
+    CDRMessage::readUInt32(&msg, &word);
+    ASSERT_EQ(word, 0x40000000u);
+
+    msg.pos = 0;
+    SequenceNumberSet_t read;
+    ASSERT_TRUE(CDRMessage::readSequenceNumberSet(&msg, &read));
+    ASSERT_TRUE(read == set);
+
+    // The bits after numBits are ignored.
+    msg.pos = 8;
+    msg.length = 8;
+    CDRMessage::addUInt32(&msg, 1);
+    CDRMessage::addUInt32(&msg, 0xFFFFFFFFu);
+    msg.pos = 0;
+    ASSERT_TRUE(CDRMessage::readSequenceNumberSet(&msg, &read));
+    ASSERT_EQ(read.get_size(), 1u);
+}
+
 int main(int argc, char **argv)
 {
     testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,350 @@
+// Copyright 2016 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fastrtps/rtps/builtin/discovery/endpoint/EDPStaticXML.h>
+#include <fastrtps/rtps/builtin/data/ReaderProxyData.h>
+#include <fastrtps/rtps/builtin/data/WriterProxyData.h>
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+using namespace eprosima::fastrtps::rtps;
+
+namespace
+{
+    const char* const c_xmlFilename = "EDPStaticXMLTests.xml";
+    const char* const c_binaryFilename = "EDPStaticXMLTests.xml.bin";
+
+    // Layout of the compiled file: a header of 24 bytes, followed by index entries of 12 bytes that start with the user Id.
+    const size_t c_headerSize = 24;
+    const size_t c_indexEntrySize = 12;
+
+    std::string endpointsXml(const std::string& readerTopic, const std::string& writerTopic)
+    {
+        return "<staticdiscovery><participant><name>participant</name>"
+            "<reader><userId>3</userId><entityId>4</entityId>"
+            "<topic name=\"" + readerTopic + "\" dataType=\"ReaderType\" kind=\"WITH_KEY\"/>"
+            "<expectsInlineQos>true</expectsInlineQos>"
+            "<reliabilityQos>RELIABLE_RELIABILITY_QOS</reliabilityQos>"
+            "<unicastLocator address=\"192.168.1.10\" port=\"7410\"/>"
+            "<partitionQos>first</partitionQos><partitionQos>second</partitionQos>"
+            "</reader>"
+            "<reader><userId>1</userId><entityId>2</entityId>"
+            "<topic name=\"OtherReaderTopic\" dataType=\"ReaderType\" kind=\"NO_KEY\"/>"
+            "</reader>"
+            "<writer><userId>5</userId><entityId>6</entityId>"
+            "<topic name=\"" + writerTopic + "\" dataType=\"WriterType\" kind=\"NO_KEY\"/>"
+            "<reliabilityQos>BEST_EFFORT_RELIABILITY_QOS</reliabilityQos>"
+            "<durabilityQos>TRANSIENT_LOCAL_DURABILITY_QOS</durabilityQos>"
+            "<multicastLocator address=\"239.255.0.1\" port=\"7400\"/>"
+            "</writer>"
+            "</participant></staticdiscovery>";
+    }
+
+    void writeFile(const std::string& filename, const std::string& contents)
+    {
+        std::ofstream file(filename.c_str(), std::ios::binary | std::ios::trunc);
+        file << contents;
+    }
+
+    std::string readFile(const std::string& filename)
+    {
+        std::ifstream file(filename.c_str(), std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+
+    bool fileExists(const std::string& filename)
+    {
+        std::ifstream file(filename.c_str());
+        return file.good();
+    }
+
+    uint64_t xmlHashOf(const std::string& binary)
+    {
+        uint64_t hash = 0;
+        memcpy(&hash, binary.data() + 8, sizeof(hash));
+        return hash;
+    }
+
+    void expectEqual(LocatorList_t& expected, LocatorList_t& actual)
+    {
+        ASSERT_EQ(expected.size(), actual.size());
+        for(LocatorListIterator eit = expected.begin(), ait = actual.begin(); eit != expected.end(); ++eit, ++ait)
+            EXPECT_TRUE(*eit == *ait);
+    }
+
+    void expectEqual(ReaderProxyData* expected, ReaderProxyData* actual)
+    {
+        EXPECT_EQ(expected->m_userDefinedId, actual->m_userDefinedId);
+        EXPECT_EQ(expected->m_guid.entityId, actual->m_guid.entityId);
+        EXPECT_EQ(expected->m_topicName, actual->m_topicName);
+        EXPECT_EQ(expected->m_typeName, actual->m_typeName);
+        EXPECT_EQ(expected->m_topicKind, actual->m_topicKind);
+        EXPECT_EQ(expected->m_expectsInlineQos, actual->m_expectsInlineQos);
+        EXPECT_EQ(expected->m_qos.m_reliability.kind, actual->m_qos.m_reliability.kind);
+        EXPECT_EQ(expected->m_qos.m_partition.getNames(), actual->m_qos.m_partition.getNames());
+        expectEqual(expected->m_unicastLocatorList, actual->m_unicastLocatorList);
+        expectEqual(expected->m_multicastLocatorList, actual->m_multicastLocatorList);
+    }
+
+    void expectEqual(WriterProxyData* expected, WriterProxyData* actual)
+    {
+        EXPECT_EQ(expected->userDefinedId(), actual->userDefinedId());
+        EXPECT_EQ(expected->guid().entityId, actual->guid().entityId);
+        EXPECT_EQ(expected->topicName(), actual->topicName());
+        EXPECT_EQ(expected->typeName(), actual->typeName());
+        EXPECT_EQ(expected->topicKind(), actual->topicKind());
+        EXPECT_EQ(expected->m_qos.m_reliability.kind, actual->m_qos.m_reliability.kind);
+        EXPECT_EQ(expected->m_qos.m_durability.kind, actual->m_qos.m_durability.kind);
+        expectEqual(expected->unicastLocatorList(), actual->unicastLocatorList());
+        expectEqual(expected->multicastLocatorList(), actual->multicastLocatorList());
+    }
+}
+
+class EDPStaticXMLTests : public ::testing::Test
+{
+    protected:
+
+    void SetUp()
+    {
+        xmlFilename = c_xmlFilename;
+        binaryFilename = c_binaryFilename;
+        writeFile(xmlFilename, endpointsXml("ReaderTopic", "WriterTopic"));
+        std::remove(binaryFilename.c_str());
+    }
+
+    void TearDown()
+    {
+        std::remove(xmlFilename.c_str());
+        std::remove(binaryFilename.c_str());
+    }
+
+    std::string xmlFilename;
+    std::string binaryFilename;
+};
+
+/*!
+ * @fn TEST_F(EDPStaticXMLTests, NoCompiledFileByDefault)
+ * @brief Without a compiled filename, the XML file is parsed and nothing is written next to it.
+ */
+TEST_F(EDPStaticXMLTests, NoCompiledFileByDefault)
+{
+    EDPStaticXML edp;
+    ASSERT_TRUE(edp.loadXMLFile(xmlFilename));
+    EXPECT_FALSE(fileExists(xmlFilename + ".bin"));
+
+    ReaderProxyData* rdata = nullptr;
+    ASSERT_TRUE(edp.lookforReader("participant", 3, &rdata));
+    EXPECT_EQ("ReaderTopic", rdata->m_topicName);
+}
+
+/*!
+ * @fn TEST_F(EDPStaticXMLTests, CompiledFileRoundTrip)
+ * @brief The endpoints read from the compiled file are the ones parsed from the XML file.
+ */
+TEST_F(EDPStaticXMLTests, CompiledFileRoundTrip)
+{
+    EDPStaticXML parsed;
+    ASSERT_TRUE(parsed.loadXMLFile(xmlFilename, binaryFilename));
+    ASSERT_TRUE(fileExists(binaryFilename));
+
+    std::string binary = readFile(binaryFilename);
+    EDPStaticXML compiled;
+    ASSERT_TRUE(compiled.loadBinaryFile(binaryFilename, xmlHashOf(binary)));
+
+    uint16_t readerIds[] = {1, 3};
+    for(uint16_t id : readerIds)
+    {
+        ReaderProxyData* expected = nullptr;
+        ReaderProxyData* actual = nullptr;
+        ASSERT_TRUE(parsed.lookforReader("participant", id, &expected));
+        ASSERT_TRUE(compiled.lookforReader("participant", id, &actual));
+        expectEqual(expected, actual);
+    }
+
+    WriterProxyData* expected = nullptr;
+    WriterProxyData* actual = nullptr;
+    ASSERT_TRUE(parsed.lookforWriter("participant", 5, &expected));
+    ASSERT_TRUE(compiled.lookforWriter("participant", 5, &actual));
+    expectEqual(expected, actual);
+
+    // Readers and writers are looked for in their own index.
+    ReaderProxyData* rdata = nullptr;
+    WriterProxyData* wdata = nullptr;
+    EXPECT_FALSE(compiled.lookforReader("participant", 5, &rdata));
+    EXPECT_FALSE(compiled.lookforWriter("participant", 3, &wdata));
+    EXPECT_FALSE(compiled.lookforReader("participant", 2, &rdata));
+}
+
+/*!
+ * @fn TEST_F(EDPStaticXMLTests, LoadUsesCompiledFile)
+ * @brief Loading the XML file again uses the compiled file written by the first load.
+ */
+TEST_F(EDPStaticXMLTests, LoadUsesCompiledFile)
+{
+    {
+        EDPStaticXML edp;
+        ASSERT_TRUE(edp.loadXMLFile(xmlFilename, binaryFilename));
+    }
+    std::string binary = readFile(binaryFilename);
+
+    EDPStaticXML edp;
+    ASSERT_TRUE(edp.loadXMLFile(xmlFilename, binaryFilename));
+    EXPECT_EQ(binary, readFile(binaryFilename));
+
+    WriterProxyData* wdata = nullptr;
+    ASSERT_TRUE(edp.lookforWriter("participant", 5, &wdata));
+    EXPECT_EQ("WriterTopic", wdata->topicName());
+}
+
+/*!
+ * @fn TEST_F(EDPStaticXMLTests, StaleCompiledFileFallsBackToXML)
+ * @brief A compiled file from a previous version of the XML file is ignored and written again.
+ */
+TEST_F(EDPStaticXMLTests, StaleCompiledFileFallsBackToXML)
+{
+    {
+        EDPStaticXML edp;
+        ASSERT_TRUE(edp.loadXMLFile(xmlFilename, binaryFilename));
+    }
+    std::string staleBinary = readFile(binaryFilename);
+
+    writeFile(xmlFilename, endpointsXml("NewReaderTopic", "NewWriterTopic"));
+    {
+        EDPStaticXML edp;
+        EXPECT_FALSE(edp.loadBinaryFile(binaryFilename, xmlHashOf(staleBinary) + 1));
+    }
+
+    EDPStaticXML edp;
+    ASSERT_TRUE(edp.loadXMLFile(xmlFilename, binaryFilename));
+    ReaderProxyData* rdata = nullptr;
+    ASSERT_TRUE(edp.lookforReader("participant", 3, &rdata));
+    EXPECT_EQ("NewReaderTopic", rdata->m_topicName);
+
+    std::string binary = readFile(binaryFilename);
+    EXPECT_NE(xmlHashOf(staleBinary), xmlHashOf(binary));
+
+    EDPStaticXML compiled;
+    ASSERT_TRUE(compiled.loadXMLFile(xmlFilename, binaryFilename));
+    WriterProxyData* wdata = nullptr;
+    ASSERT_TRUE(compiled.lookforWriter("participant", 5, &wdata));
+    EXPECT_EQ("NewWriterTopic", wdata->topicName());
+}
+
+/*!
+ * @fn TEST_F(EDPStaticXMLTests, CorruptCompiledFileIsRejected)
+ * @brief Truncated or corrupt compiled files are not mapped, and the XML file is parsed instead.
+ */
+TEST_F(EDPStaticXMLTests, CorruptCompiledFileIsRejected)
+{
+    {
+        EDPStaticXML edp;
+        ASSERT_TRUE(edp.loadXMLFile(xmlFilename, binaryFilename));
+    }
+    std::string binary = readFile(binaryFilename);
+    uint64_t hash = xmlHashOf(binary);
+    ASSERT_GT(binary.size(), c_headerSize + 5 * c_indexEntrySize);
+
+    std::vector<std::string> corrupt;
+    // Empty, header cut and index cut.
+    corrupt.push_back(std::string());
+    corrupt.push_back(binary.substr(0, c_headerSize / 2));
+    corrupt.push_back(binary.substr(0, c_headerSize + c_indexEntrySize));
+    // Records cut, so the last entries point out of the file.
+    corrupt.push_back(binary.substr(0, binary.size() - 1));
+    // Bad magic.
+    corrupt.push_back(binary);
+    corrupt.back()[0] ^= 0xFF;
+    // Bad version.
+    corrupt.push_back(binary);
+    corrupt.back()[4] ^= 0xFF;
+    // Huge reader count.
+    corrupt.push_back(binary);
+    corrupt.back()[19] = (char)0x7F;
+    // Index not sorted by user Id.
+    corrupt.push_back(binary);
+    std::swap_ranges(corrupt.back().begin() + c_headerSize, corrupt.back().begin() + c_headerSize + c_indexEntrySize,
+            corrupt.back().begin() + c_headerSize + c_indexEntrySize);
+
+    for(size_t i = 0; i < corrupt.size(); ++i)
+    {
+        writeFile(binaryFilename, corrupt[i]);
+        EDPStaticXML edp;
+        EXPECT_FALSE(edp.loadBinaryFile(binaryFilename, hash)) << "Corrupt file " << i;
+    }
+
+    EDPStaticXML edp;
+    ASSERT_TRUE(edp.loadXMLFile(xmlFilename, binaryFilename));
+    ReaderProxyData* rdata = nullptr;
+    ASSERT_TRUE(edp.lookforReader("participant", 3, &rdata));
+    EXPECT_EQ("ReaderTopic", rdata->m_topicName);
+    EXPECT_EQ(binary, readFile(binaryFilename));
+}
+
+/*!
+ * @fn TEST_F(EDPStaticXMLTests, DuplicateIdsReturnFirstEndpoint)
+ * @brief With repeated user Ids, the compiled file returns the same endpoint as the XML file: the first one.
+ */
+TEST_F(EDPStaticXMLTests, DuplicateIdsReturnFirstEndpoint)
+{
+    writeFile(xmlFilename, "<staticdiscovery><participant><name>participant</name>"
+            "<reader><userId>2</userId><entityId>2</entityId>"
+            "<topic name=\"FirstTopic\" dataType=\"Type\" kind=\"NO_KEY\"/></reader>"
+            "<reader><userId>2</userId><entityId>3</entityId>"
+            "<topic name=\"SecondTopic\" dataType=\"Type\" kind=\"NO_KEY\"/></reader>"
+            "<reader><userId>1</userId><entityId>4</entityId>"
+            "<topic name=\"ThirdTopic\" dataType=\"Type\" kind=\"NO_KEY\"/></reader>"
+            "</participant></staticdiscovery>");
+
+    EDPStaticXML parsed;
+    ASSERT_TRUE(parsed.loadXMLFile(xmlFilename, binaryFilename));
+    ReaderProxyData* rdata = nullptr;
+    ASSERT_TRUE(parsed.lookforReader("participant", 2, &rdata));
+    EXPECT_EQ("FirstTopic", rdata->m_topicName);
+
+    EDPStaticXML compiled;
+    ASSERT_TRUE(compiled.loadXMLFile(xmlFilename, binaryFilename));
+    ASSERT_TRUE(compiled.lookforReader("participant", 2, &rdata));
+    EXPECT_EQ("FirstTopic", rdata->m_topicName);
+
+    // A compiled file with repeated Ids in its index returns the first entry of them.
+    std::string binary = readFile(binaryFilename);
+    uint32_t readerCount = 0;
+    memcpy(&readerCount, binary.data() + 16, sizeof(readerCount));
+    ASSERT_EQ(2u, readerCount);
+    uint16_t id = 0;
+    memcpy(&id, binary.data() + c_headerSize, sizeof(id));
+    ASSERT_EQ(1u, id);
+    id = 2;
+    memcpy(&binary[c_headerSize], &id, sizeof(id));
+    writeFile(binaryFilename, binary);
+
+    EDPStaticXML duplicated;
+    ASSERT_TRUE(duplicated.loadBinaryFile(binaryFilename, xmlHashOf(binary)));
+    ASSERT_TRUE(duplicated.lookforReader("participant", 2, &rdata));
+    EXPECT_EQ("ThirdTopic", rdata->m_topicName);
+    EXPECT_FALSE(duplicated.lookforReader("participant", 1, &rdata));
+}
+
+int main(int argc, char **argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
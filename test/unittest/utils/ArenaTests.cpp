@@ -0,0 +1,112 @@
+// Copyright 2016 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fastrtps/utils/Arena.h>
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <cstdint>
+
+using namespace eprosima::fastrtps;
+
+namespace
+{
+    struct Counted
+    {
+        Counted(int* counter, const std::string& name): counter_(counter), name_(name) { ++*counter_; }
+        ~Counted() { --*counter_; }
+        int* counter_;
+        std::string name_;
+    };
+
+    struct Large
+    {
+        char data[10000];
+    };
+}
+
+/*!
+ * @fn TEST(Arena, ClearDestroysObjects)
+ * @brief This test checks that the objects are constructed with their arguments and destroyed by clear().
+ */
+TEST(Arena, ClearDestroysObjects)
+{
+    int alive = 0;
+    Arena arena;
+
+    Counted* first = arena.create<Counted>(&alive, "first");
+    Counted* second = arena.create<Counted>(&alive, "a name long enough to be stored out of the object");
+    ASSERT_EQ(alive, 2);
+    ASSERT_EQ(arena.size(), 2u);
+    ASSERT_EQ(first->name_, "first");
+    ASSERT_EQ(second->name_, "a name long enough to be stored out of the object");
+    ASSERT_TRUE(arena.owns(first));
+    ASSERT_TRUE(arena.owns(second));
+
+    arena.clear();
+    ASSERT_EQ(alive, 0);
+    ASSERT_EQ(arena.size(), 0u);
+
+    arena.create<Counted>(&alive, "third");
+    ASSERT_EQ(alive, 1);
+}
+
+/*!
+ * @fn TEST(Arena, MemoryIsReusedAfterClear)
+ * @brief This test checks that filling the arena again after clear() does not reserve more memory.
+ */
+TEST(Arena, MemoryIsReusedAfterClear)
+{
+    Arena arena(256);
+
+    for(int round = 0; round < 3; ++round)
+    {
+        for(int i = 0; i < 100; ++i)
+        {
+            uint64_t* value = arena.create<uint64_t>(i);
+            ASSERT_EQ(*value, (uint64_t)i);
+            ASSERT_EQ(reinterpret_cast<uintptr_t>(value) % 16, 0u);
+        }
+        Large* large = arena.create<Large>();
+        ASSERT_TRUE(arena.owns(large));
+
+        // 100 objects of 16 bytes in blocks of 256 bytes, plus a block for the large object.
+        ASSERT_EQ(arena.capacity(), 7 * 256u + (sizeof(Large) + 15) / 16 * 16);
+        arena.clear();
+    }
+}
+
+/*!
+ * @fn TEST(Arena, DoesNotOwnForeignMemory)
+ * @brief This test checks that memory allocated outside the arena is not reported as owned.
+ */
+TEST(Arena, DoesNotOwnForeignMemory)
+{
+    Arena arena;
+    int local = 0;
+    int* heap = new int(0);
+
+    arena.create<int>(1);
+    ASSERT_FALSE(arena.owns(&local));
+    ASSERT_FALSE(arena.owns(heap));
+
+    delete heap;
+}
+
+int main(int argc, char **argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
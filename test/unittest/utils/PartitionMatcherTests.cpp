@@ -0,0 +1,106 @@
+// Copyright 2016 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fastrtps/utils/PartitionMatcher.h>
+#include <fastrtps/utils/StringMatching.h>
+
+#include <gtest/gtest.h>
+
+using namespace eprosima::fastrtps::rtps;
+
+static bool match(const std::vector<std::string>& first, const std::vector<std::string>& second)
+{
+    PartitionMatcher firstMatcher, secondMatcher;
+    firstMatcher.compile(first);
+    secondMatcher.compile(second);
+    return firstMatcher.matches(secondMatcher);
+}
+
+/*!
+ * @fn TEST(PartitionMatcher, EmptyPartitions)
+ * @brief This test checks that an endpoint without partitions only matches the default partition.
+ */
+TEST(PartitionMatcher, EmptyPartitions)
+{
+    ASSERT_TRUE(match({}, {}));
+    ASSERT_TRUE(match({}, {"", "A"}));
+    ASSERT_TRUE(match({"A", ""}, {}));
+    ASSERT_FALSE(match({}, {"A"}));
+    ASSERT_FALSE(match({"*"}, {}));
+}
+
+/*!
+ * @fn TEST(PartitionMatcher, ExactAndWildcardNames)
+ * @brief This test checks exact names and wildcards in both directions.
+ */
+TEST(PartitionMatcher, ExactAndWildcardNames)
+{
+    ASSERT_TRUE(match({"A", "B"}, {"C", "B"}));
+    ASSERT_FALSE(match({"A", "B"}, {"C", "D"}));
+    ASSERT_TRUE(match({"sensors/*"}, {"sensors/lidar"}));
+    ASSERT_TRUE(match({"sensors/lidar"}, {"sensors/*"}));
+    ASSERT_FALSE(match({"sensors*"}, {"sensors/lidar"}));
+    ASSERT_TRUE(match({"cam?"}, {"cam1"}));
+    ASSERT_TRUE(match({"cam[0-9]"}, {"cam7"}));
+    ASSERT_FALSE(match({"cam[!0-9]"}, {"cam7"}));
+    ASSERT_TRUE(match({"a\\*"}, {"a*"}));
+    ASSERT_FALSE(match({"a\\*"}, {"ab"}));
+    ASSERT_TRUE(match({"x*"}, {"*"}));
+    ASSERT_FALSE(match({"x*"}, {"*y"}));
+}
+
+#if !defined(_WIN32)
+/*!
+ * @fn TEST(PartitionMatcher, SameResultAsStringMatching)
+ * @brief This test checks that every pair of names matches as it does with StringMatching.
+ */
+TEST(PartitionMatcher, SameResultAsStringMatching)
+{
+    std::vector<std::string> names = {"", "A", "AB", "A*", "*B", "*", "?", "A?", "[AB]", "[!A]*", "a/b", "a/*",
+        "*/b", "a*b", "a\\?", "a?", "[]]", "[a-c]x", "bx", "[[:alpha:]]", "q", "abc*def", "abcXdef", "[", "a["};
+
+    for(size_t i = 0; i < names.size(); ++i)
+    {
+        for(size_t j = 0; j < names.size(); ++j)
+        {
+            bool expected = StringMatching::matchString(names[i].c_str(), names[j].c_str());
+            ASSERT_EQ(match({names[i]}, {names[j]}), expected) << "\"" << names[i] << "\" \"" << names[j] << "\"";
+        }
+    }
+}
+#endif
+
+/*!
+ * @fn TEST(PartitionMatcher, RecompilesChangedNames)
+ * @brief This test checks that a matcher follows the names it is compiled with.
+ */
+TEST(PartitionMatcher, RecompilesChangedNames)
+{
+    PartitionMatcher reader, writer;
+    reader.compile({"A*"});
+    writer.compile({"B"});
+    ASSERT_FALSE(writer.matches(reader));
+
+    writer.compile({"B", "AC"});
+    ASSERT_TRUE(writer.matches(reader));
+
+    writer.compile({"B"});
+    ASSERT_FALSE(writer.matches(reader));
+}
+
+int main(int argc, char **argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
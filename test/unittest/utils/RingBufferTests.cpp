@@ -0,0 +1,104 @@
+// Copyright 2016 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fastrtps/utils/RingBuffer.h>
+
+#include <gtest/gtest.h>
+
+using namespace eprosima::fastrtps;
+
+/*!
+ * @fn TEST(RingBuffer, PushPopWrapsAround)
+ * @brief This test checks that elements keep their order when the buffer wraps around.
+ */
+TEST(RingBuffer, PushPopWrapsAround)
+{
+    RingBuffer<int> buffer(3);
+
+    for(int i = 0; i < 10; ++i)
+    {
+        buffer.push_back(i);
+        if(buffer.size() == 3)
+        {
+            ASSERT_EQ(buffer.front(), i - 2);
+            buffer.pop_front();
+        }
+    }
+
+    ASSERT_EQ(buffer.size(), 2u);
+    ASSERT_EQ(buffer.capacity(), 3u);
+    ASSERT_EQ(buffer.front(), 8);
+    ASSERT_EQ(buffer.back(), 9);
+}
+
+/*!
+ * @fn TEST(RingBuffer, GrowKeepsOrder)
+ * @brief This test checks that growing a wrapped buffer keeps the order of the elements.
+ */
+TEST(RingBuffer, GrowKeepsOrder)
+{
+    RingBuffer<int> buffer(2);
+
+    buffer.push_back(0);
+    buffer.push_back(1);
+    buffer.pop_front();
+    buffer.push_back(2);
+    buffer.push_back(3);
+    buffer.push_back(4);
+
+    ASSERT_EQ(buffer.size(), 4u);
+    ASSERT_EQ(buffer.capacity(), 4u);
+    for(size_t i = 0; i < buffer.size(); ++i)
+        ASSERT_EQ(buffer[i], static_cast<int>(i) + 1);
+}
+
+/*!
+ * @fn TEST(RingBuffer, EraseAndFind)
+ * @brief This test checks removing elements from any position.
+ */
+TEST(RingBuffer, EraseAndFind)
+{
+    RingBuffer<int> buffer(4);
+
+    buffer.push_back(9);
+    buffer.pop_front();
+    for(int i = 0; i < 4; ++i)
+        buffer.push_back(i);
+
+    ASSERT_EQ(buffer.find(2), 2u);
+    ASSERT_EQ(buffer.find(7), buffer.size());
+
+    // Near the front.
+    buffer.erase(1);
+    ASSERT_EQ(buffer.size(), 3u);
+    ASSERT_EQ(buffer[0], 0);
+    ASSERT_EQ(buffer[1], 2);
+    ASSERT_EQ(buffer[2], 3);
+
+    // Near the back.
+    buffer.erase(2);
+    ASSERT_EQ(buffer.size(), 2u);
+    ASSERT_EQ(buffer[0], 0);
+    ASSERT_EQ(buffer[1], 2);
+
+    buffer.erase(0);
+    buffer.erase(0);
+    ASSERT_TRUE(buffer.empty());
+}
+
+int main(int argc, char **argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}